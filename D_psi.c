@@ -504,6 +504,8 @@ void D_psi(spinor * const P, spinor * const Q){
       update_backward_gauge(g_gauge_field);
   }
 #endif
+  /* counts as the two even/odd hopping matrices */
+  g_hopping_count += 2;
 
 # if defined MPI
   xchange_lexicfield(Q);
@@ -902,6 +904,8 @@ void D_psi(spinor * const P, spinor * const Q){
     update_backward_gauge(g_gauge_field);
   }
 #endif
+  /* counts as the two even/odd hopping matrices */
+  g_hopping_count += 2;
 
 #    if (defined MPI && !(defined _NO_COMM))
   xchange_lexicfield(Q);
@@ -1151,6 +1155,8 @@ void D_psi(spinor * const P, spinor * const Q){
       update_backward_gauge(g_gauge_field);
   }
 #endif
+  /* counts as the two even/odd hopping matrices */
+  g_hopping_count += 2;
 
 # if defined MPI
   xchange_lexicfield(Q);
@@ -72,6 +72,7 @@
 #  include"DirectPut.h"
 #endif
 #include "Hopping_Matrix.h"
+#include "profile.h"
 
 #if defined _USE_HALFSPINOR
 #  include "operator/halfspinor_hopping.h"
@@ -79,6 +80,9 @@
 #  if ((defined SSE2)||(defined SSE3))
 #    include "sse.h"
 
+#  elif defined AVX2
+#    include "avx.h"
+
 #  elif (defined BGL && defined XLC)
 #    include "bgl.h"
 
@@ -90,6 +94,8 @@
 #  endif
 
 void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k) {
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
 
 #ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
@@ -100,7 +106,7 @@ void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k) {
 #ifdef OMP
 #pragma omp parallel
   {
-  su3 * restrict u0 ALIGN;
+  su3_copy * restrict u0 ALIGN;
 #endif
 
 #  include "operator/halfspinor_body.c"
@@ -108,6 +114,7 @@ void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k) {
 #  ifdef OMP
   } /* OpenMP closing brace */
 #  endif
+  _PROFILE_END(_HOPPING_FLOPS, _HOPPING_BYTES(spinor, su3));
   return;
 }
 
@@ -138,6 +145,8 @@ void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k) {
 #    ifdef XLC
 #      pragma disjoint(*l, *k)
 #    endif
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
 #    ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
     update_backward_gauge(g_gauge_field);
@@ -158,6 +167,7 @@ void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k) {
 #    ifdef OMP
   } /* OpenMP closing brace */
 #    endif
+  _PROFILE_END(_HOPPING_FLOPS, _HOPPING_BYTES(spinor, su3));
   return;
 }
 #  endif
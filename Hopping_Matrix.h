@@ -28,4 +28,10 @@
 #  include "su3.h"
 
 void Hopping_Matrix(const int ieo, spinor * const l, spinor * const k);
+
+/* nominal flops and bytes of one application to VOLUME/2 sites for */
+/* the counters of profile.h: eight links and neighbours are read   */
+/* and the result is written per site                               */
+#  define _HOPPING_FLOPS (1320.*(VOLUME/2))
+#  define _HOPPING_BYTES(SPINOR, SU3) ((8.*sizeof(SU3) + 9.*sizeof(SPINOR))*(VOLUME/2))
 #endif
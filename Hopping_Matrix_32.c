@@ -0,0 +1,99 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator 
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002 
+ * and modified and extended by Carsten Urbach from 2003-2008
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Hopping_Matrix_32 is the single precision version of
+ * the Wilson hopping matrix Hopping_Matrix
+ *
+ * for ieo = 0 this is M_{eo}, for ieo = 1
+ * it is M_{oe}
+ *
+ * l is the output, k the input field, both in single precision
+ *
+ * the gauge field is taken from g_gauge_field_copy_32, which is
+ * refreshed from g_gauge_field whenever the double precision
+ * copy is refreshed
+ *
+ * - with _USE_HALFSPINOR the halfspinor32 buffers of
+ *   init_dirac_halfspinor32() are used
+ *
+ * - otherwise the full spinor version in operator/hopping_sgl.c
+ *
+ ****************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef OMP
+#include <omp.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#ifdef MPI
+#  include "xchange_field.h"
+#  if defined _USE_HALFSPINOR
+#    include "xchange_halffield.h"
+#  endif
+#endif
+#include "boundary.h"
+#include "init_dirac_halfspinor.h"
+#include "update_backward_gauge.h"
+#include "Hopping_Matrix_32.h"
+#include "profile.h"
+
+#if defined _USE_HALFSPINOR
+#  include "operator/halfspinor_hopping_sgl.h"
+
+void Hopping_Matrix_32(const int ieo, spinor32 * const l, spinor32 * const k) {
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
+
+  if(g_update_gauge_copy) {
+    update_backward_gauge(g_gauge_field);
+  }
+  if(g_update_gauge_copy_32) {
+    update_backward_gauge_32(g_gauge_field);
+  }
+
+#ifdef OMP
+#pragma omp parallel
+  {
+  su3_copy_32 * restrict u0 ALIGN;
+#endif
+
+#  include "operator/halfspinor_body_sgl.c"
+
+#  ifdef OMP
+  } /* OpenMP closing brace */
+#  endif
+  _PROFILE_END(_HOPPING_FLOPS, _HOPPING_BYTES(spinor32, su3_32));
+  return;
+}
+
+#elif !defined _USE_TSPLITPAR
+
+#  include "operator/hopping_sgl.c"
+
+#endif /* thats _USE_HALFSPINOR */
@@ -0,0 +1,201 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator 
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002 
+ * and modified and extended by Carsten Urbach from 2003-2008
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Hopping_Matrix_nrhs applies the hopping matrix to nrhs
+ * spinor fields at once
+ *
+ * for ieo = 0 this is M_{eo}, for ieo = 1
+ * it is M_{oe}
+ *
+ * l is the output, k the input field, both store the nrhs
+ * fields interleaved, i.e. the spinor of field r at site ix
+ * is k[ix*nrhs + r]. spinor_fields_to_nrhs and 
+ * nrhs_to_spinor_fields convert from and to separate fields,
+ * Hopping_Matrix_nrhs_fields applies Hopping_Matrix_nrhs to
+ * nrhs separate fields.
+ *
+ * With _USE_HALFSPINOR the gauge links of a site are loaded
+ * once for all nrhs fields and the boundary halfspinors of
+ * all fields are exchanged in one message per direction.
+ * With g_sloppy_precision the halfspinors are exchanged in
+ * 32 bit, except for the SSE and AVX versions.
+ * Otherwise Hopping_Matrix is applied to every field.
+ *
+ ****************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef OMP
+#include <omp.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#ifdef MPI
+#  if defined _USE_HALFSPINOR
+#    include "xchange_halffield.h"
+#  endif
+#endif
+#include "boundary.h"
+#include "init_dirac_halfspinor.h"
+#include "update_backward_gauge.h"
+#include "Hopping_Matrix_nrhs.h"
+#include "profile.h"
+
+void spinor_fields_to_nrhs(spinor * const l, spinor ** const k, const int nrhs, const int N) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    for(int r = 0; r < nrhs; r++) {
+      l[ix*nrhs + r] = k[r][ix];
+    }
+  }
+}
+
+void nrhs_to_spinor_fields(spinor ** const l, spinor * const k, const int nrhs, const int N) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    for(int r = 0; r < nrhs; r++) {
+      l[r][ix] = k[ix*nrhs + r];
+    }
+  }
+}
+
+#if defined _USE_HALFSPINOR
+#  if ((defined SSE2)||(defined SSE3))
+#    include "sse.h"
+
+#  elif defined AVX2
+#    include "avx.h"
+
+#  elif (defined BGL && defined XLC)
+#    include "bgl.h"
+
+#  elif (defined BGQ && defined XLC)
+#    include "bgq.h"
+#    include "bgq2.h"
+#    include "xlc_prefetch.h"
+
+#  endif
+#  include "operator/halfspinor_hopping.h"
+
+void Hopping_Matrix_nrhs(const int ieo, spinor * const l, spinor * const k, const int nrhs) {
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count += nrhs;
+#ifdef _GAUGE_COPY
+  if(g_update_gauge_copy) {
+    update_backward_gauge(g_gauge_field);
+  }
+#endif
+  /* the layout of the buffers depends on nrhs */
+  if(g_nrhs_halfspinor != nrhs
+#  if !(defined SSE2 || defined SSE3 || defined AVX2)
+     || (g_sloppy_precision_flag == 1 && NBPointer32 != NULL && NBPointer32_nrhs == NULL)
+#  endif
+     ) {
+    if(init_dirac_halfspinor_nrhs(nrhs) != 0) {
+      fprintf(stderr, "Not enough memory for nrhs halffield! Aborting...\n");
+      exit(-1);
+    }
+  }
+
+#ifdef OMP
+#pragma omp parallel
+  {
+  su3_copy * restrict u0 ALIGN;
+#endif
+
+#  include "operator/halfspinor_body_nrhs.c"
+
+#  ifdef OMP
+  } /* OpenMP closing brace */
+#  endif
+  /* the gauge field is loaded once for all fields */
+  _PROFILE_END(nrhs*_HOPPING_FLOPS, (8.*sizeof(su3) + 9.*nrhs*sizeof(spinor))*(VOLUME/2));
+  return;
+}
+
+#else /* thats _USE_HALFSPINOR */
+
+#  include "Hopping_Matrix.h"
+
+static spinor * tmp_nrhs_ = NULL;
+static int tmp_nrhs_size = 0;
+
+void Hopping_Matrix_nrhs(const int ieo, spinor * const l, spinor * const k, const int nrhs) {
+  _PROFILE_BEGIN(__func__);
+  spinor * tmp[2];
+
+  if(tmp_nrhs_size == 0) {
+    tmp_nrhs_ = (spinor*)calloc(VOLUMEPLUSRAND+1, sizeof(spinor));
+    if(tmp_nrhs_ == NULL) {
+      fprintf(stderr, "Not enough memory in Hopping_Matrix_nrhs! Aborting...\n");
+      exit(-1);
+    }
+    tmp_nrhs_size = VOLUMEPLUSRAND;
+  }
+  tmp[0] = (spinor*)(((unsigned long int)(tmp_nrhs_)+ALIGN_BASE)&~ALIGN_BASE);
+  tmp[1] = tmp[0] + VOLUMEPLUSRAND/2;
+
+  for(int r = 0; r < nrhs; r++) {
+    for(int ix = 0; ix < VOLUME/2; ix++) {
+      tmp[0][ix] = k[ix*nrhs + r];
+    }
+    Hopping_Matrix(ieo, tmp[1], tmp[0]);
+    for(int ix = 0; ix < VOLUME/2; ix++) {
+      l[ix*nrhs + r] = tmp[1][ix];
+    }
+  }
+  _PROFILE_END(nrhs*_HOPPING_FLOPS, nrhs*_HOPPING_BYTES(spinor, su3));
+  return;
+}
+
+#endif /* thats _USE_HALFSPINOR */
+
+/* interleaved copies of the fields of Hopping_Matrix_nrhs_fields */
+static spinor * fields_nrhs_ = NULL;
+static spinor * fields_nrhs[2];
+static int fields_nrhs_size = 0;
+
+void Hopping_Matrix_nrhs_fields(const int ieo, spinor ** const l, spinor ** const k, const int nrhs) {
+  if(nrhs > fields_nrhs_size) {
+    free(fields_nrhs_);
+    if((void*)(fields_nrhs_ = (spinor*)calloc(2*nrhs*(VOLUMEPLUSRAND/2)+1, sizeof(spinor))) == NULL) {
+      fprintf(stderr, "Not enough memory in Hopping_Matrix_nrhs_fields! Aborting...\n");
+      exit(-1);
+    }
+    fields_nrhs[0] = (spinor*)(((unsigned long int)(fields_nrhs_)+ALIGN_BASE)&~ALIGN_BASE);
+    fields_nrhs[1] = fields_nrhs[0] + nrhs*(VOLUMEPLUSRAND/2);
+    fields_nrhs_size = nrhs;
+  }
+  spinor_fields_to_nrhs(fields_nrhs[0], k, nrhs, VOLUME/2);
+  Hopping_Matrix_nrhs(ieo, fields_nrhs[1], fields_nrhs[0], nrhs);
+  nrhs_to_spinor_fields(l, fields_nrhs[1], nrhs, VOLUME/2);
+  return;
+}
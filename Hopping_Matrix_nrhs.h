@@ -0,0 +1,30 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _HOPPING_MATRIX_NRHS_H
+#  define _HOPPING_MATRIX_NRHS_H
+
+#  include "su3.h"
+#  include "Hopping_Matrix.h"
+
+void Hopping_Matrix_nrhs(const int ieo, spinor * const l, spinor * const k, const int nrhs);
+void spinor_fields_to_nrhs(spinor * const l, spinor ** const k, const int nrhs, const int N);
+void nrhs_to_spinor_fields(spinor ** const l, spinor * const k, const int nrhs, const int N);
+void Hopping_Matrix_nrhs_fields(const int ieo, spinor ** const l, spinor ** const k, const int nrhs);
+#endif
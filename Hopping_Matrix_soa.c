@@ -0,0 +1,379 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002
+ * and modified and extended by Carsten Urbach from 2003-2008
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Hopping_Matrix_soa is the hopping matrix for fields in the
+ * site fused layout of su3_soa.h
+ *
+ * for ieo = 0 this is M_{eo}, for ieo = 1
+ * it is M_{oe}
+ *
+ * The local time extent is cut into SOA_W pieces of T/SOA_W
+ * time slices each, lane n of a soa_spinor holds the site in
+ * piece n. So the SOA_W sites in one soa_spinor have the same
+ * neighbour soa_spinor in all directions, only hops across the
+ * pieces in time direction need a rotation of the lanes.
+ * T/SOA_W must be even such that all lanes have the same parity.
+ *
+ * init_soa_geometry sets up the index tables, update_soa_gauge
+ * must be called whenever the gauge field changed and
+ * spinor_to_soa and soa_to_spinor convert from and to the
+ * even/odd ordering of geometry_eo.c.
+ *
+ * Only a single process is supported, there is no communication.
+ *
+ ****************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#ifdef OMP
+#include <omp.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "su3_soa.h"
+#include "boundary.h"
+#include "Hopping_Matrix_soa.h"
+
+int soa_volume = 0;
+
+/* eo (sub) index of lane n of soa_spinor b: soa_site[ieo][b*SOA_W + n] */
+static int * soa_site[2] = {NULL, NULL};
+/* neighbour soa_spinor and lane rotation in the order t+, t-, x+, ... z- */
+static int * soa_nb[2] = {NULL, NULL};
+static int * soa_rot[2] = {NULL, NULL};
+/* U_mu(x) and U_mu(x-mu) in the same order as soa_nb */
+static soa_su3 * soa_gauge_[2] = {NULL, NULL};
+static soa_su3 * soa_gauge[2] = {NULL, NULL};
+
+static void soa_spinor_rotate(soa_spinor * const r, const soa_spinor * const s, const int shift) {
+  double * rd = (double*) r;
+  const double * sd = (const double*) s;
+  for(int i = 0; i < 24; i++) {
+    for(int n = 0; n < SOA_W; n++) {
+      rd[i*SOA_W + n] = sd[i*SOA_W + (n + shift + SOA_W) % SOA_W];
+    }
+  }
+}
+
+int init_soa_geometry() {
+  const int Tr = T/SOA_W;
+  int * blk, c[2] = {0, 0};
+
+  free_soa_geometry();
+  if(g_nproc != 1) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "The site fused layout is only available for a single process\n");
+    }
+    return(-1);
+  }
+  if(T % (2*SOA_W) != 0) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "The site fused layout needs T to be a multiple of %d\n", 2*SOA_W);
+    }
+    return(-1);
+  }
+  soa_volume = VOLUME/2/SOA_W;
+  blk = (int*)malloc(Tr*LX*LY*LZ*sizeof(int));
+  for(int ieo = 0; ieo < 2; ieo++) {
+    soa_site[ieo] = (int*)malloc(soa_volume*SOA_W*sizeof(int));
+    soa_nb[ieo] = (int*)malloc(8*soa_volume*sizeof(int));
+    soa_rot[ieo] = (int*)malloc(8*soa_volume*sizeof(int));
+    soa_gauge_[ieo] = (soa_su3*)calloc(8*soa_volume+1, sizeof(soa_su3));
+    if(blk == NULL || soa_site[ieo] == NULL || soa_nb[ieo] == NULL
+       || soa_rot[ieo] == NULL || soa_gauge_[ieo] == NULL) {
+      free(blk);
+      free_soa_geometry();
+      return(-1);
+    }
+    soa_gauge[ieo] = (soa_su3*)(((unsigned long int)(soa_gauge_[ieo])+ALIGN_BASE)&~ALIGN_BASE);
+  }
+
+  /* number the soa_spinors of each parity in lexicographic order */
+  for(int t = 0; t < Tr; t++) {
+    for(int x = 0; x < LX; x++) {
+      for(int y = 0; y < LY; y++) {
+	for(int z = 0; z < LZ; z++) {
+	  const int ieo = (g_lexic2eo[ g_ipt[t][x][y][z] ] < (VOLUME+RAND)/2) ? 0 : 1;
+	  const int b = c[ieo]++;
+	  blk[((t*LX + x)*LY + y)*LZ + z] = b;
+	  for(int n = 0; n < SOA_W; n++) {
+	    soa_site[ieo][b*SOA_W + n] = g_lexic2eosub[ g_ipt[n*Tr + t][x][y][z] ];
+	  }
+	}
+      }
+    }
+  }
+
+  for(int t = 0; t < Tr; t++) {
+    for(int x = 0; x < LX; x++) {
+      for(int y = 0; y < LY; y++) {
+	for(int z = 0; z < LZ; z++) {
+	  const int ieo = (g_lexic2eo[ g_ipt[t][x][y][z] ] < (VOLUME+RAND)/2) ? 0 : 1;
+	  const int b = blk[((t*LX + x)*LY + y)*LZ + z];
+	  int * nb = soa_nb[ieo] + 8*b;
+	  int * rot = soa_rot[ieo] + 8*b;
+
+	  nb[0] = blk[((((t+1)%Tr)*LX + x)*LY + y)*LZ + z];
+	  rot[0] = (t == Tr-1) ? 1 : 0;
+	  nb[1] = blk[((((t+Tr-1)%Tr)*LX + x)*LY + y)*LZ + z];
+	  rot[1] = (t == 0) ? -1 : 0;
+	  nb[2] = blk[((t*LX + (x+1)%LX)*LY + y)*LZ + z];
+	  nb[3] = blk[((t*LX + (x+LX-1)%LX)*LY + y)*LZ + z];
+	  nb[4] = blk[((t*LX + x)*LY + (y+1)%LY)*LZ + z];
+	  nb[5] = blk[((t*LX + x)*LY + (y+LY-1)%LY)*LZ + z];
+	  nb[6] = blk[((t*LX + x)*LY + y)*LZ + (z+1)%LZ];
+	  nb[7] = blk[((t*LX + x)*LY + y)*LZ + (z+LZ-1)%LZ];
+	  for(int mu = 1; mu < 4; mu++) {
+	    rot[2*mu] = 0;
+	    rot[2*mu+1] = 0;
+	  }
+
+	  /* compare with the neighbours of geometry_eo.c */
+	  for(int n = 0; n < SOA_W; n++) {
+	    const int ix = g_ipt[n*Tr + t][x][y][z];
+	    for(int mu = 0; mu < 4; mu++) {
+	      if(soa_site[1-ieo][nb[2*mu]*SOA_W + (n + rot[2*mu] + SOA_W) % SOA_W] != g_lexic2eosub[ g_iup[ix][mu] ] ||
+		 soa_site[1-ieo][nb[2*mu+1]*SOA_W + (n + rot[2*mu+1] + SOA_W) % SOA_W] != g_lexic2eosub[ g_idn[ix][mu] ]) {
+		fprintf(stderr, "Inconsistent site fused geometry at %d %d! Aborting...\n", ix, mu);
+		free(blk);
+		free_soa_geometry();
+		return(-2);
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  free(blk);
+  return(0);
+}
+
+void free_soa_geometry() {
+  for(int ieo = 0; ieo < 2; ieo++) {
+    free(soa_site[ieo]);
+    free(soa_nb[ieo]);
+    free(soa_rot[ieo]);
+    free(soa_gauge_[ieo]);
+    soa_site[ieo] = NULL;
+    soa_nb[ieo] = NULL;
+    soa_rot[ieo] = NULL;
+    soa_gauge_[ieo] = NULL;
+    soa_gauge[ieo] = NULL;
+  }
+  soa_volume = 0;
+}
+
+static void su3_to_soa_lane(soa_su3 * const r, const int n, su3 * const u) {
+  double * rd = (double*) r;
+  double * ud = (double*) u;
+  for(int i = 0; i < 9; i++) {
+    rd[2*i*SOA_W + n] = ud[2*i];
+    rd[(2*i+1)*SOA_W + n] = ud[2*i+1];
+  }
+}
+
+void update_soa_gauge(su3 ** const gf) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int b = 0; b < 2*soa_volume; b++) {
+    const int ieo = b/soa_volume;
+    const int bb = b%soa_volume;
+    for(int n = 0; n < SOA_W; n++) {
+      const int ix = g_eo2lexic[ soa_site[ieo][bb*SOA_W + n] + ieo*(VOLUME+RAND)/2 ];
+      for(int mu = 0; mu < 4; mu++) {
+	su3_to_soa_lane(soa_gauge[ieo] + 8*bb + 2*mu, n, &gf[ix][mu]);
+	su3_to_soa_lane(soa_gauge[ieo] + 8*bb + 2*mu + 1, n, &gf[ g_idn[ix][mu] ][mu]);
+      }
+    }
+  }
+  return;
+}
+
+/* s is the even (ieo = 0) or odd (ieo = 1) half field */
+void spinor_to_soa(soa_spinor * const r, spinor * const s, const int ieo) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int b = 0; b < soa_volume; b++) {
+    double * rd = (double*) (r + b);
+    for(int n = 0; n < SOA_W; n++) {
+      double * sd = (double*) (s + soa_site[ieo][b*SOA_W + n]);
+      for(int i = 0; i < 12; i++) {
+	rd[2*i*SOA_W + n] = sd[2*i];
+	rd[(2*i+1)*SOA_W + n] = sd[2*i+1];
+      }
+    }
+  }
+  return;
+}
+
+void soa_to_spinor(spinor * const r, soa_spinor * const s, const int ieo) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int b = 0; b < soa_volume; b++) {
+    double * sd = (double*) (s + b);
+    for(int n = 0; n < SOA_W; n++) {
+      double * rd = (double*) (r + soa_site[ieo][b*SOA_W + n]);
+      for(int i = 0; i < 12; i++) {
+	rd[2*i] = sd[2*i*SOA_W + n];
+	rd[2*i+1] = sd[(2*i+1)*SOA_W + n];
+      }
+    }
+  }
+  return;
+}
+
+/* the projections are the ones of operator/hopping.h */
+
+#define _soa_hop_p(up, sp, ka, _proj_a, _proj_b, _rec_a, _rec_b)	\
+  _proj_a(psi, (sp)->s0, (sp)->s2, (sp)->s3);				\
+  _soa_su3_multiply(chi, (up), psi);					\
+  _soa_complex_times_vector(psi, ka, chi);				\
+  _soa_vector_add_assign(temp.s0, psi);					\
+  _rec_a(temp, psi);							\
+  _proj_b(psi, (sp)->s1, (sp)->s3, (sp)->s2);				\
+  _soa_su3_multiply(chi, (up), psi);					\
+  _soa_complex_times_vector(psi, ka, chi);				\
+  _soa_vector_add_assign(temp.s1, psi);					\
+  _rec_b(temp, psi);
+
+#define _soa_hop_m(um, sm, ka, _proj_a, _proj_b, _rec_a, _rec_b)	\
+  _proj_a(psi, (sm)->s0, (sm)->s2, (sm)->s3);				\
+  _soa_su3_inverse_multiply(chi, (um), psi);				\
+  _soa_complexcjg_times_vector(psi, ka, chi);				\
+  _soa_vector_add_assign(temp.s0, psi);					\
+  _rec_a(temp, psi);							\
+  _proj_b(psi, (sm)->s1, (sm)->s3, (sm)->s2);				\
+  _soa_su3_inverse_multiply(chi, (um), psi);				\
+  _soa_complexcjg_times_vector(psi, ka, chi);				\
+  _soa_vector_add_assign(temp.s1, psi);					\
+  _rec_b(temp, psi);
+
+/* projections: r = a +- b2 (t), a +- i b3 (x), a +- b3 (y), a +- i b2 (z) */
+#define _pr_t_p(r, a, b2, b3) _soa_vector_add(r, a, b2)
+#define _pr_t_m(r, a, b2, b3) _soa_vector_sub(r, a, b2)
+#define _pr_x_p(r, a, b2, b3) _soa_vector_i_add(r, a, b3)
+#define _pr_x_m(r, a, b2, b3) _soa_vector_i_sub(r, a, b3)
+#define _pr_y_p(r, a, b2, b3) _soa_vector_add(r, a, b3)
+#define _pr_y_m(r, a, b2, b3) _soa_vector_sub(r, a, b3)
+#define _pr_z_p(r, a, b2, b3) _soa_vector_i_add(r, a, b2)
+#define _pr_z_m(r, a, b2, b3) _soa_vector_i_sub(r, a, b2)
+
+/* reconstruction of the lower components */
+#define _rc_t_m0(r, p) _soa_vector_sub_assign((r).s2, p)
+#define _rc_t_m1(r, p) _soa_vector_sub_assign((r).s3, p)
+#define _rc_x_p0(r, p) _soa_vector_i_sub_assign((r).s3, p)
+#define _rc_x_p1(r, p) _soa_vector_i_sub_assign((r).s2, p)
+#define _rc_x_m0(r, p) _soa_vector_i_add_assign((r).s3, p)
+#define _rc_x_m1(r, p) _soa_vector_i_add_assign((r).s2, p)
+#define _rc_y_p0(r, p) _soa_vector_add_assign((r).s3, p)
+#define _rc_y_p1(r, p) _soa_vector_sub_assign((r).s2, p)
+#define _rc_y_m0(r, p) _soa_vector_sub_assign((r).s3, p)
+#define _rc_y_m1(r, p) _soa_vector_add_assign((r).s2, p)
+#define _rc_z_p0(r, p) _soa_vector_i_sub_assign((r).s2, p)
+#define _rc_z_p1(r, p) _soa_vector_i_add_assign((r).s3, p)
+#define _rc_z_m0(r, p) _soa_vector_i_add_assign((r).s2, p)
+#define _rc_z_m1(r, p) _soa_vector_i_sub_assign((r).s3, p)
+
+/* the neighbour in direction d, rotated into rs if needed */
+#define _soa_neighbour(d)			\
+  if(rot[d] == 0) {				\
+    sp = k + nb[d];				\
+  }						\
+  else {					\
+    soa_spinor_rotate(&rs, k + nb[d], rot[d]);	\
+    sp = &rs;					\
+  }
+
+void Hopping_Matrix_soa(const int ieo, soa_spinor * const l, soa_spinor * const k) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  soa_su3_vector ALIGN psi, chi;
+  soa_spinor ALIGN temp, rs;
+  const soa_spinor * restrict sp;
+  const soa_su3 * restrict up;
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int b = 0; b < soa_volume; b++) {
+    const int * nb = soa_nb[ieo] + 8*b;
+    const int * rot = soa_rot[ieo] + 8*b;
+    up = soa_gauge[ieo] + 8*b;
+
+    /*********************** direction +t ************************/
+    _soa_neighbour(0);
+    _pr_t_p(psi, sp->s0, sp->s2, sp->s3);
+    _soa_su3_multiply(chi, up[0], psi);
+    _soa_complex_times_vector(temp.s0, ka0, chi);
+    _soa_vector_assign(temp.s2, temp.s0);
+    _pr_t_p(psi, sp->s1, sp->s3, sp->s2);
+    _soa_su3_multiply(chi, up[0], psi);
+    _soa_complex_times_vector(temp.s1, ka0, chi);
+    _soa_vector_assign(temp.s3, temp.s1);
+
+    /*********************** direction -t ************************/
+    _soa_neighbour(1);
+    _soa_hop_m(up[1], sp, ka0, _pr_t_m, _pr_t_m, _rc_t_m0, _rc_t_m1);
+
+    /*********************** direction +1 ************************/
+    sp = k + nb[2];
+    _soa_hop_p(up[2], sp, ka1, _pr_x_p, _pr_x_p, _rc_x_p0, _rc_x_p1);
+
+    /*********************** direction -1 ************************/
+    sp = k + nb[3];
+    _soa_hop_m(up[3], sp, ka1, _pr_x_m, _pr_x_m, _rc_x_m0, _rc_x_m1);
+
+    /*********************** direction +2 ************************/
+    sp = k + nb[4];
+    _soa_hop_p(up[4], sp, ka2, _pr_y_p, _pr_y_m, _rc_y_p0, _rc_y_p1);
+
+    /*********************** direction -2 ************************/
+    sp = k + nb[5];
+    _soa_hop_m(up[5], sp, ka2, _pr_y_m, _pr_y_p, _rc_y_m0, _rc_y_m1);
+
+    /*********************** direction +3 ************************/
+    sp = k + nb[6];
+    _soa_hop_p(up[6], sp, ka3, _pr_z_p, _pr_z_m, _rc_z_p0, _rc_z_p1);
+
+    /*********************** direction -3 ************************/
+    sp = k + nb[7];
+    _soa_hop_m(up[7], sp, ka3, _pr_z_m, _pr_z_p, _rc_z_m0, _rc_z_m1);
+
+    l[b] = temp;
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
@@ -0,0 +1,36 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _HOPPING_MATRIX_SOA_H
+#  define _HOPPING_MATRIX_SOA_H
+
+#  include "su3.h"
+#  include "su3_soa.h"
+
+/* number of soa_spinor per even or odd half field */
+extern int soa_volume;
+
+int init_soa_geometry();
+void free_soa_geometry();
+void update_soa_gauge(su3 ** const gf);
+void spinor_to_soa(soa_spinor * const r, spinor * const s, const int ieo);
+void soa_to_spinor(spinor * const r, soa_spinor * const s, const int ieo);
+void Hopping_Matrix_soa(const int ieo, soa_spinor * const l, soa_spinor * const k);
+
+#endif
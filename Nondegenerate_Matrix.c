@@ -34,6 +34,7 @@
 #include "global.h"
 #include "su3.h"
 #include "Hopping_Matrix.h"
+#include "Hopping_Matrix_nrhs.h"
 #include "phmc.h"
 #include "gamma.h"
 #include "linsolve.h"
@@ -59,6 +60,142 @@ void Qtm_pm_psi(spinor *l,spinor *k);
 
 /* external functions */
 
+/******************************************
+ *
+ * The doublet operators below work on the
+ * two flavours interleaved as in
+ * Hopping_Matrix_nrhs with nrhs = 2, i.e.
+ * the strange spinor of site ix is k[2*ix]
+ * and the charm spinor k[2*ix+1]. This is
+ * also the memory layout of a bispinor
+ * field. The hopping matrix is applied to
+ * both flavours at once such that the gauge
+ * field is loaded only once per doublet,
+ * the mubar/epsbar flavour mixing, tau_1
+ * and gamma_5 are applied in single loops
+ * over the sites.
+ *
+ ******************************************/
+
+/* r = a x + b y with complex a and real b */
+#define _vector_nd_lin2(r, a, x, b, y)		\
+  (r).c0 = (a) * (x).c0 + (b) * (y).c0;		\
+  (r).c1 = (a) * (x).c1 + (b) * (y).c1;		\
+  (r).c2 = (a) * (x).c2 + (b) * (y).c2;
+
+/* r = a x + b y + c z with complex a and real b, c */
+#define _vector_nd_lin3(r, a, x, b, y, c, z)			\
+  (r).c0 = (a) * (x).c0 + (b) * (y).c0 + (c) * (z).c0;		\
+  (r).c1 = (a) * (x).c1 + (b) * (y).c1 + (c) * (z).c1;		\
+  (r).c2 = (a) * (x).c2 + (b) * (y).c2 + (c) * (z).c2;
+
+/* interleaved work fields */
+#define ND_WORK_FIELDS 5
+static spinor * nd_work_ = NULL;
+static spinor * nd_work[ND_WORK_FIELDS];
+
+static void init_nd_work() {
+  if(nd_work_ == NULL) {
+    if((void*)(nd_work_ = (spinor*)calloc(ND_WORK_FIELDS*VOLUMEPLUSRAND+1, sizeof(spinor))) == NULL) {
+      fprintf(stderr, "Not enough memory for the doublet work fields in Nondegenerate_Matrix.c! Aborting...\n");
+      exit(-1);
+    }
+#if ( defined SSE || defined SSE2 || defined SSE3)
+    nd_work[0] = (spinor*)(((unsigned long int)(nd_work_)+ALIGN_BASE)&~ALIGN_BASE);
+#else
+    nd_work[0] = nd_work_;
+#endif
+    for(int i = 1; i < ND_WORK_FIELDS; i++) {
+      nd_work[i] = nd_work[i-1] + VOLUMEPLUSRAND;
+    }
+  }
+  return;
+}
+
+/******************************************
+ * M_ee^-1 of one site
+ *
+ * l_strange = nrm [(1-i\mubar\gamma_5) k_strange + \epsbar k_charm]
+ * l_charm   = nrm [(1+i\mubar\gamma_5) k_charm + \epsbar k_strange]
+ ******************************************/
+static inline void mee_inv_nd_site(spinor * const ls, spinor * const lc,
+				   const spinor * const ks, const spinor * const kc,
+				   const double nrm) {
+  const _Complex double zm = nrm * (1. - g_mubar * I);
+  const _Complex double zp = nrm * (1. + g_mubar * I);
+  const double e = nrm * g_epsbar;
+
+  _vector_nd_lin2(ls->s0, zm, ks->s0, e, kc->s0);
+  _vector_nd_lin2(ls->s1, zm, ks->s1, e, kc->s1);
+  _vector_nd_lin2(ls->s2, zp, ks->s2, e, kc->s2);
+  _vector_nd_lin2(ls->s3, zp, ks->s3, e, kc->s3);
+  _vector_nd_lin2(lc->s0, zp, kc->s0, e, ks->s0);
+  _vector_nd_lin2(lc->s1, zp, kc->s1, e, ks->s1);
+  _vector_nd_lin2(lc->s2, zm, kc->s2, e, ks->s2);
+  _vector_nd_lin2(lc->s3, zm, kc->s3, e, ks->s3);
+}
+
+/******************************************
+ * gamma_5 (M_oo k - u) of one site, times fac
+ *
+ * l_strange = fac gamma_5 [(1+i\mubar\gamma_5) k_strange - \epsbar k_charm - u_strange]
+ * l_charm   = fac gamma_5 [(1-i\mubar\gamma_5) k_charm - \epsbar k_strange - u_charm]
+ ******************************************/
+static inline void moo_nd_site(spinor * const ls, spinor * const lc,
+			       const spinor * const ks, const spinor * const kc,
+			       const spinor * const us, const spinor * const uc,
+			       const double fac) {
+  const _Complex double zm = fac * (1. - g_mubar * I);
+  const _Complex double zp = fac * (1. + g_mubar * I);
+  const double e = fac * g_epsbar;
+
+  _vector_nd_lin3(ls->s0, zp, ks->s0, -e, kc->s0, -fac, us->s0);
+  _vector_nd_lin3(ls->s1, zp, ks->s1, -e, kc->s1, -fac, us->s1);
+  _vector_nd_lin3(ls->s2, -zm, ks->s2, e, kc->s2, fac, us->s2);
+  _vector_nd_lin3(ls->s3, -zm, ks->s3, e, kc->s3, fac, us->s3);
+  _vector_nd_lin3(lc->s0, zm, kc->s0, -e, ks->s0, -fac, uc->s0);
+  _vector_nd_lin3(lc->s1, zm, kc->s1, -e, ks->s1, -fac, uc->s1);
+  _vector_nd_lin3(lc->s2, -zp, kc->s2, e, ks->s2, fac, uc->s2);
+  _vector_nd_lin3(lc->s3, -zp, kc->s3, e, ks->s3, fac, uc->s3);
+}
+
+/******************************************
+ *
+ * l = Qhat(2x2) tau_1^t k
+ *
+ * on interleaved doublets, for t = 1 tau_1
+ * only exchanges the flavour the site
+ * kernels read from. The result is
+ * normalised by phmc_invmaxev. Uses the
+ * work fields 3 and 4.
+ *
+ ******************************************/
+static void Q_nd_interleaved(spinor * const l, spinor * const k, const int t) {
+  spinor * const h = nd_work[3], * const a = nd_work[4];
+  const double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
+  const double fac = phmc_invmaxev;
+
+  /* Here the  M_oe Mee^-1 M_eo  implementation  */
+  Hopping_Matrix_nrhs(EO, h, k, 2);
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < VOLUME/2; ix++) {
+    mee_inv_nd_site(a + 2*ix, a + 2*ix + 1, h + 2*ix + t, h + 2*ix + 1 - t, nrm);
+  }
+  Hopping_Matrix_nrhs(OE, h, a, 2);
+
+  /* Here the M_oo  implementation and gamma_5 */
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < VOLUME/2; ix++) {
+    moo_nd_site(l + 2*ix, l + 2*ix + 1, k + 2*ix + t, k + 2*ix + 1 - t,
+		h + 2*ix, h + 2*ix + 1, fac);
+  }
+  return;
+}
+
 /******************************************
  *
  * This is the implementation of
@@ -74,44 +211,14 @@ void Qtm_pm_psi(spinor *l,spinor *k);
  ******************************************/
 void QNon_degenerate(spinor * const l_strange, spinor * const l_charm,
                      spinor * const k_strange, spinor * const k_charm){
+  spinor * k[2] = {k_strange, k_charm};
+  spinor * l[2] = {l_strange, l_charm};
 
-  double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], k_strange);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k_charm);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+4], nrm, g_spinor_field[DUM_MATRIX+4], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  /* where nrm (= 1/(1+mu^2 -eps^2)) has been defined at the beginning of 
-     the subroutine */
-  
-  Hopping_Matrix(OE, l_strange, g_spinor_field[DUM_MATRIX+4]);
-  Hopping_Matrix(OE, l_charm, g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX], k_strange);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+1], k_charm);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX], k_charm, -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+1], k_strange, -g_epsbar, VOLUME/2);
-   
-  diff(l_strange, g_spinor_field[DUM_MATRIX], l_strange, VOLUME/2);
-  diff(l_charm, g_spinor_field[DUM_MATRIX+1], l_charm, VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(l_strange, l_strange, VOLUME/2);
-  gamma5(l_charm, l_charm, VOLUME/2);
-
-  /* At the end, the normalisation by the max. eigenvalue  */
-  mul_r(l_strange, phmc_invmaxev, l_strange, VOLUME/2);
-  mul_r(l_charm, phmc_invmaxev, l_charm, VOLUME/2);
+  init_nd_work();
+  spinor_fields_to_nrhs(nd_work[0], k, 2, VOLUME/2);
+  Q_nd_interleaved(nd_work[1], nd_work[0], 0);
+  nrhs_to_spinor_fields(l, nd_work[1], 2, VOLUME/2);
+  return;
 }
 
 /******************************************
@@ -133,45 +240,15 @@ void QNon_degenerate(spinor * const l_strange, spinor * const l_charm,
  ******************************************/
 void QdaggerNon_degenerate(spinor * const l_strange, spinor * const l_charm,
                            spinor * const k_strange, spinor * const k_charm){
-
-  double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], k_charm);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k_strange);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+2], nrm, g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  /* where nrm (= 1/(1+mu^2 -eps^2)) has been defined at the beginning of 
-     the subroutine */
-  
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+2]);
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+2], k_charm);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+3], k_strange);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], k_strange, -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], k_charm, -g_epsbar, VOLUME/2);
-   
-  diff(l_charm, g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX], VOLUME/2);
-  diff(l_strange, g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1], VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(l_charm, l_charm, VOLUME/2);
-  gamma5(l_strange, l_strange, VOLUME/2);
-
-  /* At the end, the normalisation by the max. eigenvalue  */
-  mul_r(l_charm, phmc_invmaxev, l_charm, VOLUME/2);
-  mul_r(l_strange, phmc_invmaxev, l_strange, VOLUME/2);
-
+  spinor * k[2] = {k_strange, k_charm};
+  /* the final tau_1 exchanges the output fields */
+  spinor * l[2] = {l_charm, l_strange};
+
+  init_nd_work();
+  spinor_fields_to_nrhs(nd_work[0], k, 2, VOLUME/2);
+  Q_nd_interleaved(nd_work[1], nd_work[0], 1);
+  nrhs_to_spinor_fields(l, nd_work[1], 2, VOLUME/2);
+  return;
 }
 
 
@@ -181,6 +258,7 @@ void QdaggerNon_degenerate(spinor * const l_strange, spinor * const l_charm,
  * 
  * Qhat(2x2) Qhat(2x2)^dagger 
  *
+ *   = Qhat(2x2) tau_1 Qhat(2x2) tau_1
  *
  * For details, see documentation and comments of the 
  * above mentioned routines 
@@ -193,89 +271,15 @@ void QdaggerNon_degenerate(spinor * const l_strange, spinor * const l_charm,
  ******************************************/
 void Q_Qdagger_ND(spinor * const l_strange, spinor * const l_charm,
                            spinor * const k_strange, spinor * const k_charm){
-
-  double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
-
-  /* FIRST THE  Qhat(2x2)^dagger  PART*/
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], k_charm);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k_strange);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+2], nrm, g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+2]);
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+2], k_charm);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+3], k_strange);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], k_strange, -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], k_charm, -g_epsbar, VOLUME/2);
-   
-  diff(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX], VOLUME/2);
-  diff(g_spinor_field[DUM_MATRIX+5], g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1], VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+4], VOLUME/2);
-  gamma5(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+5], VOLUME/2);
-
-  /* The normalisation by the max. eigenvalue  is done twice at the end */
-
-
-  /* We have to reassigin as follows to avoid overwriting */
-  /* Recall in fact that   Q^hat = tau_1 Q tau_1  , hence  */
-
-  /*  ABOVE: dum_matrix+2  is  l_charm   goes to  dum_matrix+6 :BELOW */
-  /*  ABOVE: dum_matrix+3  is  l_strange   goes to  dum_matrix+7 :BELOW */
-  assign(g_spinor_field[DUM_MATRIX+6], g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  assign(g_spinor_field[DUM_MATRIX+7], g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-
-
-  /* AND THEN THE  Qhat(2x2)  PART */
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+7]);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+6]);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+2], nrm, g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
- 
-  Hopping_Matrix(OE, l_strange, g_spinor_field[DUM_MATRIX+2]);
-  Hopping_Matrix(OE, l_charm, g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+7]);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+6]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+6], -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+7], -g_epsbar, VOLUME/2);
-   
-  diff(l_strange, g_spinor_field[DUM_MATRIX], l_strange, VOLUME/2);
-  diff(l_charm, g_spinor_field[DUM_MATRIX+1], l_charm, VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(l_strange, l_strange, VOLUME/2);
-  gamma5(l_charm, l_charm, VOLUME/2);
-
-
-  /* At the end, the normalisation by the max. eigenvalue  */ 
-  /* Twice  phmc_invmaxev  since we consider here  D Ddag  !!! */
-  mul_r(l_charm, phmc_invmaxev*phmc_invmaxev, l_charm, VOLUME/2);
-  mul_r(l_strange, phmc_invmaxev*phmc_invmaxev, l_strange, VOLUME/2);
+  spinor * k[2] = {k_strange, k_charm};
+  spinor * l[2] = {l_strange, l_charm};
+
+  init_nd_work();
+  spinor_fields_to_nrhs(nd_work[0], k, 2, VOLUME/2);
+  /* The normalisation by the max. eigenvalue is done in both factors */
+  Q_nd_interleaved(nd_work[2], nd_work[0], 1);
+  Q_nd_interleaved(nd_work[1], nd_work[2], 1);
+  nrhs_to_spinor_fields(l, nd_work[1], 2, VOLUME/2);
   return;
 }
 
@@ -304,105 +308,37 @@ void Q_Qdagger_ND(spinor * const l_strange, spinor * const l_charm,
  ******************************************/
 void Q_tau1_min_cconst_ND(spinor * const l_strange, spinor * const l_charm,
                      spinor * const k_strange, spinor * const k_charm, const _Complex double z){
+  spinor * k[2] = {k_strange, k_charm};
+  spinor * q;
+  /* Finally, we multiply by the constant  phmc_Cpol  */
+  /* which renders the polynomial in monomials  */
+  /* identical to the polynomial a la clenshaw */
+  const _Complex double mz = -phmc_Cpol * z;
 
-  int ix;
-  spinor *r, *s;
-  su3_vector ALIGN phi1;
-  double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
-
-  /*   tau_1   inverts the   k_charm  <->  k_strange   spinors */
-  /*  Apply first  Qhat(2x2)  and finally substract the constant  */
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], k_charm);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k_strange);
-
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+4], nrm, g_spinor_field[DUM_MATRIX+4], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  /* where nrm (= 1/(1+mu^2 -eps^2)) has been defined at the beginning of
-     the subroutine */
-
-
-  Hopping_Matrix(OE, l_strange, g_spinor_field[DUM_MATRIX+4]);
-  Hopping_Matrix(OE, l_charm, g_spinor_field[DUM_MATRIX+3]);
-
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX], k_charm);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+1], k_strange);
-
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX], k_strange, -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+1], k_charm, -g_epsbar, VOLUME/2);
-
-
-  diff(l_strange, g_spinor_field[DUM_MATRIX], l_strange, VOLUME/2);
-  diff(l_charm, g_spinor_field[DUM_MATRIX+1], l_charm, VOLUME/2);
-
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(l_strange, l_strange, VOLUME/2);
-  gamma5(l_charm, l_charm, VOLUME/2);
-
-  /* At the end, the normalisation by the max. eigenvalue  */
-  mul_r(l_strange, phmc_invmaxev, l_strange, VOLUME/2);
-  mul_r(l_charm, phmc_invmaxev, l_charm, VOLUME/2);
-
-  /*     
-  printf(" IN UP: %f %f \n", l_strange[0].creal(s2.c1), l_strange[0].cimag(s2.c1));
-  printf(" IN DN: %f %f \n", l_charm[0].creal(s2.c1), l_charm[0].cimag(s2.c1));
-  */
+  init_nd_work();
+  q = nd_work[1];
+  spinor_fields_to_nrhs(nd_work[0], k, 2, VOLUME/2);
+  Q_nd_interleaved(q, nd_work[0], 1);
 
   /*  AND FINALLY WE SUBSTRACT THE C-CONSTANT  */
-
-
-  /************ loop over all lattice sites ************/
-
 #ifdef OMP
-#pragma omp parallel for private(r) private(s) private(phi1) private(ix)
+#pragma omp parallel for
 #endif
-  for(ix = 0; ix < (VOLUME/2); ix++){
-
-    r=l_strange + ix;
-    s=k_strange + ix;
-
-    _complex_times_vector(phi1, z, s->s0);
-    _vector_sub_assign(r->s0, phi1);
-    _complex_times_vector(phi1, z, s->s1);
-    _vector_sub_assign(r->s1, phi1);
-    _complex_times_vector(phi1, z, s->s2);
-    _vector_sub_assign(r->s2, phi1);
-    _complex_times_vector(phi1, z, s->s3);
-    _vector_sub_assign(r->s3, phi1);
-    
-    r=l_charm + ix;
-    s=k_charm + ix;
-
-    _complex_times_vector(phi1, z, s->s0);
-    _vector_sub_assign(r->s0, phi1);
-    _complex_times_vector(phi1, z, s->s1);
-    _vector_sub_assign(r->s1, phi1);
-    _complex_times_vector(phi1, z, s->s2);
-    _vector_sub_assign(r->s2, phi1);
-    _complex_times_vector(phi1, z, s->s3);
-    _vector_sub_assign(r->s3, phi1);    
+  for(int ix = 0; ix < (VOLUME/2); ix++){
+    spinor * r = l_strange + ix, * s = k_strange + ix, * p = q + 2*ix;
+
+    _vector_nd_lin2(r->s0, mz, s->s0, phmc_Cpol, p->s0);
+    _vector_nd_lin2(r->s1, mz, s->s1, phmc_Cpol, p->s1);
+    _vector_nd_lin2(r->s2, mz, s->s2, phmc_Cpol, p->s2);
+    _vector_nd_lin2(r->s3, mz, s->s3, phmc_Cpol, p->s3);
+
+    r = l_charm + ix; s = k_charm + ix; p++;
+    _vector_nd_lin2(r->s0, mz, s->s0, phmc_Cpol, p->s0);
+    _vector_nd_lin2(r->s1, mz, s->s1, phmc_Cpol, p->s1);
+    _vector_nd_lin2(r->s2, mz, s->s2, phmc_Cpol, p->s2);
+    _vector_nd_lin2(r->s3, mz, s->s3, phmc_Cpol, p->s3);
   }
-
-  /* Finally, we multiply by the constant  phmc_Cpol  */
-  /* which renders the polynomial in monomials  */
-  /* identical to the polynomial a la clenshaw */;
-  mul_r(l_strange, phmc_Cpol, l_strange, VOLUME/2);
-  mul_r(l_charm, phmc_Cpol, l_charm, VOLUME/2);
-
+  return;
 }
 
 
@@ -416,141 +352,21 @@ void Q_tau1_min_cconst_ND(spinor * const l_strange, spinor * const l_charm,
  *
  *
  *  but now input and output are bispinors !!!!
+ *  which are already interleaved doublets,
+ *  sp_up being strange and sp_dn charm
  *
  * For details, see documentation and comments of the 
  * above mentioned routines 
  *
- * k_charm and k_strange are the input fields
- * l_* the output fields
- *
  * it acts only on the odd part or only
  * on a half spinor
  ******************************************/
 void Q_Qdagger_ND_BI(bispinor * const bisp_l, bispinor * const bisp_k){
 
-  double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
-  static int memalloc = 0;
-
-  static spinor *k_strange, *k_charm;
-  static spinor *l_strange, *l_charm;
-
-#if ( defined SSE || defined SSE2 || defined SSE3)
-  static spinor *k_strange_, *k_charm_;
-  static spinor *l_strange_, *l_charm_;
-  if(memalloc == 0) {
-    memalloc = 1;
-    k_strange_ = (spinor*)calloc(VOLUMEPLUSRAND/2+1, sizeof(spinor));
-    k_strange  = (spinor *)(((unsigned long int)(k_strange_)+ALIGN_BASE)&~ALIGN_BASE);
-    k_charm_   = (spinor*)calloc(VOLUMEPLUSRAND/2+1, sizeof(spinor));
-    k_charm    = (spinor *)(((unsigned long int)(k_charm_)+ALIGN_BASE)&~ALIGN_BASE);
-
-    l_strange_ = (spinor*)calloc(VOLUMEPLUSRAND/2+1, sizeof(spinor));
-    l_strange  = (spinor *)(((unsigned long int)(l_strange_)+ALIGN_BASE)&~ALIGN_BASE);
-    l_charm_   = (spinor*)calloc(VOLUMEPLUSRAND/2+1, sizeof(spinor));
-    l_charm    = (spinor *)(((unsigned long int)(l_charm_)+ALIGN_BASE)&~ALIGN_BASE);
-  }
-#else
-  if(memalloc == 0) {
-    memalloc = 1;
-    k_strange  = (spinor*)calloc(VOLUMEPLUSRAND/2, sizeof(spinor));
-    k_charm    = (spinor*)calloc(VOLUMEPLUSRAND/2, sizeof(spinor));
-    
-    l_strange  = (spinor*)calloc(VOLUMEPLUSRAND/2, sizeof(spinor));
-    l_charm    = (spinor*)calloc(VOLUMEPLUSRAND/2, sizeof(spinor));
-  }
-#endif
-
-  /*  CREATE 2 SPINORS OUT OF 1 (INPUT) BISPINOR  */
-  decompact(k_strange, k_charm, bisp_k);
-
-  /* FIRST THE  Qhat(2x2)^dagger  PART*/
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], k_charm);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k_strange);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+2], nrm, g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  /* where nrm (= 1/(1+mu^2 -eps^2)) has been defined at the beginning of 
-     the subroutine */
-
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+2]);
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+2], k_charm);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+3], k_strange);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], k_strange, -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], k_charm, -g_epsbar, VOLUME/2);
-   
-  diff(g_spinor_field[DUM_MATRIX+4], g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX], VOLUME/2);
-  diff(g_spinor_field[DUM_MATRIX+5], g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1], VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+4], VOLUME/2);
-  gamma5(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+5], VOLUME/2);
-
-  /* The normalisation by the max. eigenvalue  is done twice at the end */
-
-
-  /* We have to reassigin as follows to avoid overwriting */
-  /* Recall in fact that   Q^hat = tau_1 Q tau_1  , hence  */
-
-  /*  ABOVE: dum_matrix+2  is  l_charm   goes to  dum_matrix+6 :BELOW */
-  /*  ABOVE: dum_matrix+3  is  l_strange   goes to  dum_matrix+7 :BELOW */
-  assign(g_spinor_field[DUM_MATRIX+6], g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  assign(g_spinor_field[DUM_MATRIX+7], g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-
-
-  /* AND THEN THE  Qhat(2x2)  PART */
-
-  /* Here the  M_oe Mee^-1 M_eo  implementation  */
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+7]);
-  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+6]);
-
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX]);
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX+1]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+2], g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+3], g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-
-  mul_r(g_spinor_field[DUM_MATRIX+2], nrm, g_spinor_field[DUM_MATRIX+2], VOLUME/2);
-  mul_r(g_spinor_field[DUM_MATRIX+3], nrm, g_spinor_field[DUM_MATRIX+3], VOLUME/2);
-  /* where nrm (= 1/(1+mu^2 -eps^2)) has been defined at the beginning of 
-     the subroutine */
-
-  Hopping_Matrix(OE, l_strange, g_spinor_field[DUM_MATRIX+2]);
-  Hopping_Matrix(OE, l_charm, g_spinor_field[DUM_MATRIX+3]);
-
-  /* Here the M_oo  implementation  */
-  mul_one_plus_imubar(g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+7]);
-  mul_one_minus_imubar(g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+6]);
-
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+6], -g_epsbar, VOLUME/2);
-  assign_add_mul_r(g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX+7], -g_epsbar, VOLUME/2);
-   
-  diff(l_strange, g_spinor_field[DUM_MATRIX], l_strange, VOLUME/2);
-  diff(l_charm, g_spinor_field[DUM_MATRIX+1], l_charm, VOLUME/2);
-
-  /* and finally the  gamma_5  multiplication  */
-  gamma5(l_strange, l_strange, VOLUME/2);
-  gamma5(l_charm, l_charm, VOLUME/2);
-
-  /* At the end, the normalisation by the max. eigenvalue  */
-  /* Twice  phmc_invmaxev  since we consider here  D Ddag  !!! */
-  mul_r(l_charm, phmc_invmaxev*phmc_invmaxev, l_charm, VOLUME/2);
-  mul_r(l_strange, phmc_invmaxev*phmc_invmaxev, l_strange, VOLUME/2);
-
-
-  /*  CREATE 1 (OUTPUT) BISPINOR OUT OF 2 SPINORS  */
-  compact(bisp_l, l_strange, l_charm);
+  init_nd_work();
+  Q_nd_interleaved(nd_work[2], (spinor*)bisp_k, 1);
+  Q_nd_interleaved((spinor*)bisp_l, nd_work[2], 1);
+  return;
 }
 
 
@@ -570,23 +386,24 @@ void Q_Qdagger_ND_BI(bispinor * const bisp_l, bispinor * const bisp_k){
 void H_eo_ND(spinor * const l_strange, spinor * const l_charm, 
              spinor * const k_strange, spinor * const k_charm, 
 	     const int ieo) {
-
+  spinor * k[2] = {k_strange, k_charm};
+  spinor * h;
   double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
 
+  init_nd_work();
+  h = nd_work[1];
+  spinor_fields_to_nrhs(nd_work[0], k, 2, VOLUME/2);
+  Hopping_Matrix_nrhs(ieo, h, nd_work[0], 2);
 
   /* recall:   strange <-> up    while    charm <-> dn   */
-  Hopping_Matrix(ieo, g_spinor_field[DUM_MATRIX], k_strange);
-  Hopping_Matrix(ieo, g_spinor_field[DUM_MATRIX+1], k_charm);
-
-  mul_one_minus_imubar(l_strange, g_spinor_field[DUM_MATRIX+1]);
-  mul_one_plus_imubar(l_charm, g_spinor_field[DUM_MATRIX]);
-
-  assign_add_mul_r(l_strange, g_spinor_field[DUM_MATRIX], g_epsbar, VOLUME/2);
-  assign_add_mul_r(l_charm, g_spinor_field[DUM_MATRIX+1], g_epsbar, VOLUME/2);
-
-  mul_r(l_strange, nrm, l_strange, VOLUME/2);
-  mul_r(l_charm, nrm, l_charm, VOLUME/2);
-
+  /* the strange output gets the charm hopping term      */
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < (VOLUME/2); ix++) {
+    mee_inv_nd_site(l_strange + ix, l_charm + ix, h + 2*ix + 1, h + 2*ix, nrm);
+  }
+  return;
 }
 
 void M_ee_inv_ND(spinor * const l_strange, spinor * const l_charm, 
@@ -594,18 +411,14 @@ void M_ee_inv_ND(spinor * const l_strange, spinor * const l_charm,
   
   double nrm = 1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar);
 
-
   /* recall:   strange <-> up    while    charm <-> dn   */
-
-  mul_one_minus_imubar(l_strange, k_strange);
-  mul_one_plus_imubar(l_charm, k_charm);
-
-  assign_add_mul_r(l_strange, k_charm, g_epsbar, VOLUME/2);
-  assign_add_mul_r(l_charm, k_strange, g_epsbar, VOLUME/2);
-
-  mul_r(l_strange, nrm, l_strange, VOLUME/2);
-  mul_r(l_charm, nrm, l_charm, VOLUME/2);
-
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < (VOLUME/2); ix++) {
+    mee_inv_nd_site(l_strange + ix, l_charm + ix, k_strange + ix, k_charm + ix, nrm);
+  }
+  return;
 }
 
 
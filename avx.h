@@ -0,0 +1,254 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+#ifndef _AVX_H
+#define _AVX_H
+
+#if (defined AVX2 || defined AVX512)
+
+/*******************************************************************************
+ *
+ * Macros for SU(3) vectors, SU(3) matrices and spinors using
+ * AVX2+FMA intrinsics (and AVX-512F for the linear algebra)
+ *
+ * halfspinor part:
+ * one __m256d holds two complex numbers. The macros work on
+ * "pairs" of su3_vectors v and w, stored in a __m256d r[3] as
+ * r[0] = [v.c0, w.c0], r[1] = [v.c1, w.c1], r[2] = [v.c2, w.c2]
+ * such that the two components of a halfspinor (or two Dirac
+ * components of a spinor) are processed with one SU(3) multiply
+ *
+ * linear algebra part:
+ * _avx_vec is __m512d if AVX512 is defined and __m256d otherwise,
+ * a spinor is _avx_nspinor such vectors
+ *
+ *******************************************************************************/
+
+#include <immintrin.h>
+
+#define _prefetch_spinor(addr)				\
+  __builtin_prefetch((char*)(addr), 0, 3);		\
+  __builtin_prefetch(((char*)(addr))+128, 0, 3);
+
+#define _prefetch_halfspinor(addr)		\
+  __builtin_prefetch((char*)(addr), 0, 3);
+
+#define _prefetch_su3(addr)				\
+  __builtin_prefetch((char*)(addr), 0, 3);		\
+  __builtin_prefetch(((char*)(addr))+128, 0, 3);
+
+/* swap real and imaginary parts in both complex numbers */
+#define _avx_swap_ri(x) _mm256_permute_pd((x), 0x5)
+/* swap the two complex numbers */
+#define _avx_swap_hl(x) _mm256_permute2f128_pd((x), (x), 0x1)
+/* [re(z), re(z), re(z), re(z)] and the same for im(z) */
+#define _avx_splat_re(z) _mm256_broadcast_sd((double*)&(z))
+#define _avx_splat_im(z) _mm256_broadcast_sd(((double*)&(z))+1)
+
+/*
+ * r = x * z for the complex number z, on both halves
+ */
+
+#define _avx_cmplx_mul(r, x, z)						\
+  (r) = _mm256_fmaddsub_pd((x), _avx_splat_re(z),			\
+			   _mm256_mul_pd(_avx_swap_ri(x), _avx_splat_im(z)));
+
+/*
+ * r = x * conj(z)
+ */
+
+#define _avx_cmplxcg_mul(r, x, z)					\
+  (r) = _mm256_fmsubadd_pd((x), _avx_splat_re(z),			\
+			   _mm256_mul_pd(_avx_swap_ri(x), _avx_splat_im(z)));
+
+/*
+ * r = i * x
+ */
+
+#define _avx_i_mul(r, x)						\
+  (r) = _mm256_addsub_pd(_mm256_setzero_pd(), _avx_swap_ri(x));
+
+/*
+ * r = [v.c, w.c] for c = c0, c1, c2
+ */
+
+#define _avx_load_pair(r, v, w)						\
+  (r)[0] = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd((double*)&(v).c0)), \
+				_mm_loadu_pd((double*)&(w).c0), 1);	\
+  (r)[1] = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd((double*)&(v).c1)), \
+				_mm_loadu_pd((double*)&(w).c1), 1);	\
+  (r)[2] = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd((double*)&(v).c2)), \
+				_mm_loadu_pd((double*)&(w).c2), 1);
+
+#define _avx_store_pair(v, w, r)					\
+  _mm_storeu_pd((double*)&(v).c0, _mm256_castpd256_pd128((r)[0]));	\
+  _mm_storeu_pd((double*)&(w).c0, _mm256_extractf128_pd((r)[0], 1));	\
+  _mm_storeu_pd((double*)&(v).c1, _mm256_castpd256_pd128((r)[1]));	\
+  _mm_storeu_pd((double*)&(w).c1, _mm256_extractf128_pd((r)[1], 1));	\
+  _mm_storeu_pd((double*)&(v).c2, _mm256_castpd256_pd128((r)[2]));	\
+  _mm_storeu_pd((double*)&(w).c2, _mm256_extractf128_pd((r)[2], 1));
+
+/*
+ * elementwise operations on pairs
+ */
+
+#define _avx_pair_add(r, x, y)				\
+  (r)[0] = _mm256_add_pd((x)[0], (y)[0]);		\
+  (r)[1] = _mm256_add_pd((x)[1], (y)[1]);		\
+  (r)[2] = _mm256_add_pd((x)[2], (y)[2]);
+
+#define _avx_pair_sub(r, x, y)				\
+  (r)[0] = _mm256_sub_pd((x)[0], (y)[0]);		\
+  (r)[1] = _mm256_sub_pd((x)[1], (y)[1]);		\
+  (r)[2] = _mm256_sub_pd((x)[2], (y)[2]);
+
+/* r = x + sgn * y with sgn a __m256d of +-1 */
+#define _avx_pair_sgn_add(r, x, sgn, y)			\
+  (r)[0] = _mm256_fmadd_pd((sgn), (y)[0], (x)[0]);	\
+  (r)[1] = _mm256_fmadd_pd((sgn), (y)[1], (x)[1]);	\
+  (r)[2] = _mm256_fmadd_pd((sgn), (y)[2], (x)[2]);
+
+/* r = x - sgn * y */
+#define _avx_pair_sgn_sub(r, x, sgn, y)			\
+  (r)[0] = _mm256_fnmadd_pd((sgn), (y)[0], (x)[0]);	\
+  (r)[1] = _mm256_fnmadd_pd((sgn), (y)[1], (x)[1]);	\
+  (r)[2] = _mm256_fnmadd_pd((sgn), (y)[2], (x)[2]);
+
+/* exchange v and w */
+#define _avx_pair_swap_hl(r, x)			\
+  (r)[0] = _avx_swap_hl((x)[0]);			\
+  (r)[1] = _avx_swap_hl((x)[1]);			\
+  (r)[2] = _avx_swap_hl((x)[2]);
+
+#define _avx_pair_i_mul(r, x)			\
+  _avx_i_mul((r)[0], (x)[0]);			\
+  _avx_i_mul((r)[1], (x)[1]);			\
+  _avx_i_mul((r)[2], (x)[2]);
+
+#define _avx_pair_cmplx_mul(r, x, z)		\
+  _avx_cmplx_mul((r)[0], (x)[0], z);		\
+  _avx_cmplx_mul((r)[1], (x)[1], z);		\
+  _avx_cmplx_mul((r)[2], (x)[2], z);
+
+#define _avx_pair_cmplxcg_mul(r, x, z)		\
+  _avx_cmplxcg_mul((r)[0], (x)[0], z);		\
+  _avx_cmplxcg_mul((r)[1], (x)[1], z);		\
+  _avx_cmplxcg_mul((r)[2], (x)[2], z);
+
+/*
+ * one row of u*x: r = u0 x[0] + u1 x[1] + u2 x[2]
+ * y[c] is x[c] with real and imaginary parts swapped
+ */
+
+#define _avx_su3_row(r, u0, u1, u2, x, y)				\
+  {									\
+    __m256d _t;								\
+    (r) = _mm256_mul_pd((x)[0], _avx_splat_re(u0));			\
+    _t = _mm256_mul_pd((y)[0], _avx_splat_im(u0));			\
+    (r) = _mm256_fmadd_pd((x)[1], _avx_splat_re(u1), (r));		\
+    _t = _mm256_fmadd_pd((y)[1], _avx_splat_im(u1), _t);		\
+    _t = _mm256_fmadd_pd((y)[2], _avx_splat_im(u2), _t);		\
+    (r) = _mm256_add_pd((r), _mm256_fmaddsub_pd((x)[2], _avx_splat_re(u2), _t)); \
+  }
+
+/* the same with conj(u0), conj(u1), conj(u2) */
+#define _avx_su3_inverse_row(r, u0, u1, u2, x, y)			\
+  {									\
+    __m256d _t;								\
+    (r) = _mm256_mul_pd((x)[0], _avx_splat_re(u0));			\
+    _t = _mm256_mul_pd((y)[0], _avx_splat_im(u0));			\
+    (r) = _mm256_fmadd_pd((x)[1], _avx_splat_re(u1), (r));		\
+    _t = _mm256_fmadd_pd((y)[1], _avx_splat_im(u1), _t);		\
+    _t = _mm256_fmadd_pd((y)[2], _avx_splat_im(u2), _t);		\
+    (r) = _mm256_add_pd((r), _mm256_fmsubadd_pd((x)[2], _avx_splat_re(u2), _t)); \
+  }
+
+/*
+ * r = u * x on a pair, r and x must be different
+ */
+
+#define _avx_su3_multiply(r, u, x)					\
+  {									\
+    __m256d _y[3];							\
+    _y[0] = _avx_swap_ri((x)[0]);					\
+    _y[1] = _avx_swap_ri((x)[1]);					\
+    _y[2] = _avx_swap_ri((x)[2]);					\
+    _avx_su3_row((r)[0], (u).c00, (u).c01, (u).c02, x, _y);		\
+    _avx_su3_row((r)[1], (u).c10, (u).c11, (u).c12, x, _y);		\
+    _avx_su3_row((r)[2], (u).c20, (u).c21, (u).c22, x, _y);		\
+  }
+
+/*
+ * r = u^dagger * x on a pair, r and x must be different
+ */
+
+#define _avx_su3_inverse_multiply(r, u, x)				\
+  {									\
+    __m256d _y[3];							\
+    _y[0] = _avx_swap_ri((x)[0]);					\
+    _y[1] = _avx_swap_ri((x)[1]);					\
+    _y[2] = _avx_swap_ri((x)[2]);					\
+    _avx_su3_inverse_row((r)[0], (u).c00, (u).c10, (u).c20, x, _y);	\
+    _avx_su3_inverse_row((r)[1], (u).c01, (u).c11, (u).c21, x, _y);	\
+    _avx_su3_inverse_row((r)[2], (u).c02, (u).c12, (u).c22, x, _y);	\
+  }
+
+/*
+ * linear algebra on whole spinors
+ */
+
+#if defined AVX512
+
+#  define _avx_vec __m512d
+#  define _avx_nd 8
+#  define _avx_load(p) _mm512_loadu_pd(p)
+#  define _avx_store(p, x) _mm512_storeu_pd((p), (x))
+#  define _avx_splat(c) _mm512_set1_pd(c)
+#  define _avx_zero() _mm512_setzero_pd()
+#  define _avx_add(x, y) _mm512_add_pd((x), (y))
+#  define _avx_sub(x, y) _mm512_sub_pd((x), (y))
+#  define _avx_mul(x, y) _mm512_mul_pd((x), (y))
+#  define _avx_fmadd(x, y, z) _mm512_fmadd_pd((x), (y), (z))
+#  define _avx_hsum(x) _mm512_reduce_add_pd(x)
+
+#else
+
+#  define _avx_vec __m256d
+#  define _avx_nd 4
+#  define _avx_load(p) _mm256_loadu_pd(p)
+#  define _avx_store(p, x) _mm256_storeu_pd((p), (x))
+#  define _avx_splat(c) _mm256_set1_pd(c)
+#  define _avx_zero() _mm256_setzero_pd()
+#  define _avx_add(x, y) _mm256_add_pd((x), (y))
+#  define _avx_sub(x, y) _mm256_sub_pd((x), (y))
+#  define _avx_mul(x, y) _mm256_mul_pd((x), (y))
+#  define _avx_fmadd(x, y, z) _mm256_fmadd_pd((x), (y), (z))
+#  define _avx_hsum(x) _avx_hsum256(x)
+
+static inline double _avx_hsum256(__m256d x) {
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+  return(_mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h))));
+}
+
+#endif
+
+/* number of _avx_vec per spinor */
+#define _avx_nspinor (24/_avx_nd)
+
+#endif
+#endif
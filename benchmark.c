@@ -47,6 +47,7 @@
 # include "init_omp_accumulators.h"
 #endif
 #include "gettime.h"
+#include "profile.h"
 #include "su3.h"
 #include "su3adj.h"
 #include "ranlxd.h"
@@ -56,6 +57,9 @@
 #include "boundary.h"
 #include "Hopping_Matrix.h"
 #include "Hopping_Matrix_nocom.h"
+#include "Hopping_Matrix_nrhs.h"
+#include "Hopping_Matrix_soa.h"
+#include "linalg_eo.h"
 #include "tm_operators.h"
 #include "global.h"
 #include "xchange.h"
@@ -69,6 +73,7 @@
 #include "D_psi.h"
 #include "phmc.h"
 #include "mpi_init.h"
+#include "tuning.h"
 
 #ifdef PARALLELT
 #  define SLICE (LX*LY*LZ/2)
@@ -99,14 +104,14 @@ int main(int argc,char *argv[])
   static double t1,t2,dt,sdt,dts,qdt,sqdt;
   double antioptaway=0.0;
 
-#ifdef MPI
-  static double dt2;
-  
   DUM_DERI = 6;
   DUM_SOLVER = DUM_DERI+2;
   DUM_MATRIX = DUM_SOLVER+6;
   NO_OF_SPINORFIELDS = DUM_MATRIX+2;
 
+#ifdef MPI
+  static double dt2;
+  
 #  ifdef OMP
   int mpi_thread_provided;
   MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &mpi_thread_provided);
@@ -155,6 +160,12 @@ int main(int argc,char *argv[])
 #ifdef SSE3
     printf("# The code was compiled with SSE3 instructions\n");
 #endif
+#ifdef AVX2
+    printf("# The code was compiled with AVX2 instructions\n");
+#endif
+#ifdef AVX512
+    printf("# The code was compiled with AVX-512 instructions\n");
+#endif
 #ifdef P4
     printf("# The code was compiled for Pentium4\n");
 #endif
@@ -164,6 +175,18 @@ int main(int argc,char *argv[])
 #ifdef _GAUGE_COPY
     printf("# The code was compiled with -D_GAUGE_COPY\n");
 #endif
+#ifdef _GAUGE_COMPRESSION
+    printf("# The code was compiled with -D_GAUGE_COMPRESSION\n");
+#endif
+#ifdef _TILED_OPERATORS
+    printf("# The code was compiled with -D_TILED_OPERATORS\n");
+#endif
+#ifdef _REPRODUCIBLE_REDUCTIONS
+    printf("# The code was compiled with -D_REPRODUCIBLE_REDUCTIONS\n");
+#endif
+#ifdef _PROFILE
+    printf("# The code was compiled with -D_PROFILE\n");
+#endif
 #ifdef BGL
     printf("# The code was compiled for Blue Gene/L\n");
 #endif
@@ -183,6 +206,15 @@ int main(int argc,char *argv[])
 #  ifdef _NON_BLOCKING
     printf("# The code was compiled for non-blocking MPI calls (spinor and gauge)\n");
 #  endif
+#  ifdef _SHM_HALO
+    printf("# The code was compiled with -D_SHM_HALO\n");
+#  endif
+#  ifdef _OVERLAP_COMM
+    printf("# The code was compiled with -D_OVERLAP_COMM\n");
+#  endif
+#  ifdef _COMM_THREAD
+    printf("# The code was compiled with -D_COMM_THREAD\n");
+#  endif
 #endif
     printf("\n");
     fflush(stdout);
@@ -197,7 +229,8 @@ int main(int argc,char *argv[])
   init_geometry_indices(VOLUMEPLUSRAND + g_dbw2rand);
 
   if(even_odd_flag) {
-    j = init_spinor_field(VOLUMEPLUSRAND/2, 2*k_max+1);
+    /* the operators in tune_operators need the DUM_MATRIX fields */
+    j = init_spinor_field(VOLUMEPLUSRAND/2, NO_OF_SPINORFIELDS);
   }
   else {
     j = init_spinor_field(VOLUMEPLUSRAND, 2*k_max);
@@ -251,6 +284,13 @@ int main(int argc,char *argv[])
   init_xchange_halffield();
 #  endif
 #endif  
+  if(g_sloppy_precision_flag == 1) {
+    j = init_gauge_field_32(VOLUMEPLUSRAND);
+    if ( j!= 0) {
+      fprintf(stderr, "Not enough memory for 32-Bit gauge field copy! Aborting...\n");
+      exit(0);
+    }
+  }
 
   status = check_geometry();
   if (status != 0) {
@@ -269,6 +309,9 @@ int main(int argc,char *argv[])
   xchange_gauge(g_gauge_field);
 #endif
 
+#ifdef _PROFILE
+  profile_reset();
+#endif
   if(even_odd_flag) {
     /*initialize the pseudo-fermion fields*/
     j_max=2048;
@@ -318,10 +361,109 @@ int main(int argc,char *argv[])
       printf("# Communication switched on:\n# (%d Mflops [%d bit arithmetic])\n", (int)(1608.0f/sdt),(int)sizeof(spinor)/3);
 #ifdef OMP
       printf("# Mflops per OpenMP thread ~ %d\n",(int)(1608.0f/(omp_num_threads*sdt)));
+#endif
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+      print_xchange_halffield_stats();
 #endif
       printf("\n");
       fflush(stdout);
     }
+
+    /* the same for nrhs interleaved fields with Hopping_Matrix_nrhs */
+    {
+      const int nrhs = 12;
+      spinor * nrhs_field_ = NULL, * nrhs_field[2];
+      int j_nrhs = (j_max + nrhs - 1)/nrhs;
+      if((void*)(nrhs_field_ = (spinor*)calloc(2*nrhs*(VOLUMEPLUSRAND/2)+1, sizeof(spinor))) == NULL) {
+        fprintf(stderr, "Not enough memory for %d right hand sides! Aborting...\n", nrhs);
+        exit(0);
+      }
+      nrhs_field[0] = (spinor*)(((unsigned long int)(nrhs_field_)+ALIGN_BASE)&~ALIGN_BASE);
+      nrhs_field[1] = nrhs_field[0] + nrhs*(VOLUMEPLUSRAND/2);
+      random_spinor_field(nrhs_field[0], nrhs*VOLUME/2, 0);
+      /* allocate the halfspinor buffers outside the timing */
+      Hopping_Matrix_nrhs(0, nrhs_field[1], nrhs_field[0], nrhs);
+#ifdef MPI
+      MPI_Barrier(MPI_COMM_WORLD);
+#endif
+      t1 = gettime();
+      antioptaway=0.0;
+      for (j = 0; j < j_nrhs; j++) {
+        Hopping_Matrix_nrhs(0, nrhs_field[1], nrhs_field[0], nrhs);
+        Hopping_Matrix_nrhs(1, nrhs_field[0], nrhs_field[1], nrhs);
+        antioptaway+=creal(nrhs_field[0][0].s0.c0);
+      }
+      t2 = gettime();
+      dt = t2-t1;
+#ifdef MPI
+      MPI_Allreduce (&dt, &sdt, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#else
+      sdt = dt;
+#endif
+      sdt=sdt/((double)g_nproc);
+      sdt=1.0e6f*sdt/((double)(nrhs*j_nrhs*(VOLUME)));
+      if(g_proc_id==0) {
+        printf("# The following result is just to make sure that the calculation is not optimized away: %e\n", antioptaway);
+        printf("# Hopping_Matrix_nrhs with %d right hand sides, communication switched on:\n# (%d Mflops [%d bit arithmetic])\n", 
+               nrhs, (int)(1608.0f/sdt),(int)sizeof(spinor)/3);
+#ifdef OMP
+        printf("# Mflops per OpenMP thread ~ %d\n",(int)(1608.0f/(omp_num_threads*sdt)));
+#endif
+        printf("\n");
+        fflush(stdout);
+      }
+      free(nrhs_field_);
+    }
+
+    /* the same for the site fused (SoA) layout with Hopping_Matrix_soa */
+    if(init_soa_geometry() == 0) {
+      soa_spinor * soa_field_ = NULL, * soa_field[2];
+      double rdiff;
+      if((void*)(soa_field_ = (soa_spinor*)calloc(2*soa_volume+1, sizeof(soa_spinor))) == NULL) {
+        fprintf(stderr, "Not enough memory for the site fused fields! Aborting...\n");
+        exit(0);
+      }
+      soa_field[0] = (soa_spinor*)(((unsigned long int)(soa_field_)+ALIGN_BASE)&~ALIGN_BASE);
+      soa_field[1] = soa_field[0] + soa_volume;
+      update_soa_gauge(g_gauge_field);
+
+      /* compare to the standard layout */
+      spinor_to_soa(soa_field[0], g_spinor_field[0], 1);
+      Hopping_Matrix_soa(0, soa_field[1], soa_field[0]);
+      soa_to_spinor(g_spinor_field[2*k_max], soa_field[1], 0);
+      Hopping_Matrix(0, g_spinor_field[k_max], g_spinor_field[0]);
+      diff(g_spinor_field[2*k_max], g_spinor_field[2*k_max], g_spinor_field[k_max], VOLUME/2);
+      rdiff = sqrt(square_norm(g_spinor_field[2*k_max], VOLUME/2, 1)/square_norm(g_spinor_field[k_max], VOLUME/2, 1));
+
+      t1 = gettime();
+      antioptaway=0.0;
+      for (j = 0; j < j_max; j++) {
+        for (k = 0; k < k_max; k++) {
+          Hopping_Matrix_soa(0, soa_field[1], soa_field[0]);
+          Hopping_Matrix_soa(1, soa_field[0], soa_field[1]);
+          antioptaway+=soa_field[0][0].s0.c0.re[0];
+        }
+      }
+      t2 = gettime();
+      dt = t2-t1;
+      sdt=1.0e6f*dt/((double)(k_max*j_max*(VOLUME)));
+      if(g_proc_id==0) {
+        printf("# The following result is just to make sure that the calculation is not optimized away: %e\n", antioptaway);
+        printf("# Hopping_Matrix_soa with %d sites per vector, relative difference to Hopping_Matrix %e:\n# (%d Mflops [%d bit arithmetic])\n", 
+               SOA_W, rdiff, (int)(1608.0f/sdt), 64);
+#ifdef OMP
+        printf("# Mflops per OpenMP thread ~ %d\n",(int)(1608.0f/(omp_num_threads*sdt)));
+#endif
+        printf("\n");
+        fflush(stdout);
+      }
+      free(soa_field_);
+      free_soa_geometry();
+    }
+    else if(g_proc_id==0) {
+      printf("# Site fused (SoA) layout not available for this lattice or process grid, skipping Hopping_Matrix_soa\n\n");
+      fflush(stdout);
+    }
     
 #ifdef MPI
     /* isolated computation */
@@ -365,6 +507,12 @@ int main(int argc,char *argv[])
     }
 #endif
     fflush(stdout);
+#ifdef _PROFILE
+    profile_print("benchmark");
+#endif
+
+    /* try the runtime variants and write the fastest to the tuning file */
+    tune_operators(tuning_filename);
   }
   else {
     /* the non even/odd case now */
@@ -439,6 +587,9 @@ int main(int argc,char *argv[])
   free_omp_accumulators();
 #endif
   free_gauge_field();
+  if(g_sloppy_precision_flag == 1) {
+    free_gauge_field_32();
+  }
   free_geometry_indices();
   free_spinor_field();
   free_moment_field();
@@ -34,6 +34,7 @@
   
 _Complex double ALIGN ka0, ka1, ka2, ka3;
 _Complex double ALIGN phase_0, phase_1, phase_2, phase_3;
+_Complex float ALIGN ka0_32, ka1_32, ka2_32, ka3_32;
 const double PI_ = 3.14159265358979;
 double X0, X1, X2, X3;
 
@@ -52,4 +53,8 @@ void boundary(const double kappa)
   phase_1 = -ka1;
   phase_2 = -ka2;
   phase_3 = -ka3;
+  ka0_32 = ka0;
+  ka1_32 = ka1;
+  ka2_32 = ka2;
+  ka3_32 = ka3;
 }
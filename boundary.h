@@ -24,6 +24,7 @@
 
 extern _Complex double ka0, ka1, ka2, ka3;
 extern _Complex double phase_0, phase_1, phase_2, phase_3;
+extern _Complex float ka0_32, ka1_32, ka2_32, ka3_32;
 void boundary(const double kappa);
 
 #endif
@@ -38,6 +38,7 @@
 #include "Hopping_Matrix.h"
 #include "tm_operators.h"
 #include "clover.h"
+#include "tiled_operators.h"
 
 
 su3 *** sw;
@@ -119,6 +120,12 @@ void Qsw_sq_psi(spinor * const l, spinor * const k) {
 }
 
 void Qsw_pm_psi(spinor * const l, spinor * const k) {
+#if (defined _TILED_OPERATORS && !defined MPI)
+  if(g_tiled_operators && l != k && init_tiled_operators() == 0) {
+    Qsw_pm_psi_tiled(l, k);
+    return;
+  }
+#endif
   /* \hat Q_{-} */
   Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k);
   clover_inv(EE, g_spinor_field[DUM_MATRIX+1], -g_mu);
@@ -82,12 +82,10 @@ void cloverdet_derivative(const int id, hamiltonian_field_t * const hf) {
   
   // Invert Q_{+} Q_{-}
   // X_o -> DUM_DERI+1
-  chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-	       mnl->csg_N, mnl->csg_n, VOLUME/2, mnl->Qsq);
+  chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_N, VOLUME/2, mnl->Qsq);
   mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->maxiter, mnl->forceprec, 
 		       g_relative_precision_flag, VOLUME/2, mnl->Qsq);
-  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-		      mnl->csg_N, &mnl->csg_n, VOLUME/2);
+  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME/2, mnl->Qsq);
   
   // Y_o -> DUM_DERI
   mnl->Qm(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
@@ -142,8 +140,6 @@ void cloverdet_heatbath(const int id, hamiltonian_field_t * const hf) {
   g_mu3 = mnl->rho;
   g_c_sw = mnl->c_sw;
   boundary(mnl->kappa);
-  mnl->csg_n = 0;
-  mnl->csg_n2 = 0;
   mnl->iter0 = 0;
   mnl->iter1 = 0;
 
@@ -155,8 +151,6 @@ void cloverdet_heatbath(const int id, hamiltonian_field_t * const hf) {
   mnl->energy0 = square_norm(g_spinor_field[2], VOLUME/2, 1);
   
   mnl->Qp(mnl->pf, g_spinor_field[2]);
-  chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		      mnl->csg_N, &mnl->csg_n, VOLUME/2);
 
   g_mu = g_mu1;
   g_mu3 = 0.;
@@ -180,8 +174,7 @@ double cloverdet_acc(const int id, hamiltonian_field_t * const hf) {
   sw_term( (const su3**) hf->gaugefield, mnl->kappa, mnl->c_sw); 
   sw_invert(EE, mnl->mu);
 
-  chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-	       mnl->csg_N, mnl->csg_n, VOLUME/2, mnl->Qsq);
+  chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_N, VOLUME/2, mnl->Qsq);
   g_sloppy_precision_flag = 0;
   mnl->iter0 = cg_her(g_spinor_field[2], mnl->pf, mnl->maxiter, mnl->accprec,  
 		      g_relative_precision_flag, VOLUME/2, mnl->Qsq); 
@@ -86,12 +86,10 @@ void cloverdetratio_derivative_orig(const int no, hamiltonian_field_t * const hf
 
   /* Invert Q_{+} Q_{-} */
   /* X_W -> DUM_DERI+1 */
-  chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_field, 
-	       mnl->csg_index_array, mnl->csg_N, mnl->csg_n, VOLUME/2, mnl->Qsq);
+  chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_N, VOLUME/2, mnl->Qsq);
   mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->maxiter, 
 		       mnl->forceprec, g_relative_precision_flag, VOLUME/2, mnl->Qsq);
-  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-		      mnl->csg_N, &mnl->csg_n, VOLUME/2);
+  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME/2, mnl->Qsq);
   /* Y_W -> DUM_DERI  */
   mnl->Qm(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
   
@@ -195,12 +193,10 @@ void cloverdetratio_derivative(const int no, hamiltonian_field_t * const hf) {
 
   // Invert Q_{+} Q_{-}
   // X_W -> DUM_DERI+1 
-  chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_field, 
-	       mnl->csg_index_array, mnl->csg_N, mnl->csg_n, VOLUME/2, mnl->Qsq);
+  chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_N, VOLUME/2, mnl->Qsq);
   mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->maxiter, 
 		       mnl->forceprec, g_relative_precision_flag, VOLUME/2, mnl->Qsq);
-  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-		      mnl->csg_N, &mnl->csg_n, VOLUME/2);
+  chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME/2, mnl->Qsq);
   // Apply Q_{-} to get Y_W -> DUM_DERI 
   mnl->Qm(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
   // Compute phi - Y_W -> DUM_DERI
@@ -244,8 +240,6 @@ void cloverdetratio_heatbath(const int id, hamiltonian_field_t * const hf) {
   g_mu = mnl->mu;
   g_c_sw = mnl->c_sw;
   boundary(mnl->kappa);
-  mnl->csg_n = 0;
-  mnl->csg_n2 = 0;
   mnl->iter0 = 0;
   mnl->iter1 = 0;
   
@@ -264,8 +258,6 @@ void cloverdetratio_heatbath(const int id, hamiltonian_field_t * const hf) {
   mnl->iter0 = cg_her(mnl->pf, g_spinor_field[3], mnl->maxiter, mnl->accprec,  
 		      g_relative_precision_flag, VOLUME/2, mnl->Qsq); 
 
-  chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		      mnl->csg_N, &mnl->csg_n, VOLUME/2);
   mnl->Qm(mnl->pf, mnl->pf);
 
   if(g_proc_id == 0 && g_debug_level > 3) {
@@ -288,8 +280,7 @@ double cloverdetratio_acc(const int id, hamiltonian_field_t * const hf) {
   mnl->Qp(g_spinor_field[DUM_DERI+5], mnl->pf);
   g_mu3 = mnl->rho;
 
-  chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_field, mnl->csg_index_array, 
-	       mnl->csg_N, mnl->csg_n, VOLUME/2, &Qtm_plus_psi);
+  chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_N, VOLUME/2, mnl->Qsq);
   g_sloppy_precision_flag = 0;    
   mnl->iter0 += cg_her(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->maxiter, mnl->accprec,  
 		      g_relative_precision_flag, VOLUME/2, mnl->Qsq);
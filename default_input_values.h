@@ -93,7 +93,9 @@
 #define _default_return_check_interval 100
 #define _default_g_debug_level 1
 #define _default_g_csg_N 0
+#define _default_csg_memory 0.
 #define _default_2mn_lambda 0.1938
+#define _default_tune_acceptance 0.8
 #define _default_source_format_flag 0
 #define _default_source_time_slice 0
 #define _default_automaticTS 0
@@ -105,6 +107,7 @@
 #define _default_prop_precision_flag 32
 #define _default_reproduce_randomnumber_flag 0
 #define _default_g_sloppy_precision_flag 0
+#define _default_g_monomial_force_flag 0
 #define _default_stout_rho 0.1
 #define _default_rho 0.
 #define _default_rho2 0.
@@ -117,6 +120,7 @@
 #define _default_stilde_max 3.
 #define _default_stilde_min 0.01
 #define _default_degree_of_p 48
+#define _default_degree_of_rational 10
 #define _default_propagator_splitted 1
 #define _default_source_splitted 1
 #define _default_source_location 0
@@ -163,6 +167,10 @@
 /* default OpenMP values */
 #define _default_omp_num_threads 0
 
+/* lexicographic site order in the Dirac operator */
+#define _default_g_site_order_type 0
+#define _default_tuning_filename "tmlqcd.tuning"
+
 #define _default_use_preconditioning 0
 
 #endif
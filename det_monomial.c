@@ -37,6 +37,7 @@
 #include "deriv_Sb_D_psi.h"
 #include "gamma.h"
 #include "tm_operators.h"
+#include "tm_operators_32.h"
 #include "hybrid_update.h"
 #include "Hopping_Matrix.h"
 #include "solver/chrono_guess.h"
@@ -70,18 +71,22 @@ void det_derivative(const int id, hamiltonian_field_t * const hf) {
     g_mu = mnl->mu;
     boundary(mnl->kappa);
 
-    if(mnl->solver != CG) {
+    if(mnl->solver != CG && mnl->solver != MIXEDCG) {
       fprintf(stderr, "Bicgstab currently not implemented, using CG instead! (det_monomial.c)\n");
     }
     
     /* Invert Q_{+} Q_{-} */
     /* X_o -> DUM_DERI+1 */
-    chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		 mnl->csg_N, mnl->csg_n, VOLUME/2, &Qtm_pm_psi);
-    mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->maxiter, mnl->forceprec, 
-			 g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
-    chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
+    chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
+    if(mnl->solver == MIXEDCG) {
+      mnl->iter1 += mixed_cg_her(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->maxiter, mnl->forceprec, 
+				 g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi, &Qtm_pm_psi_32);
+    }
+    else {
+      mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->maxiter, mnl->forceprec, 
+			   g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
+    }
+    chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
     
     /* Y_o -> DUM_DERI  */
     Qtm_minus_psi(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
@@ -110,13 +115,11 @@ void det_derivative(const int id, hamiltonian_field_t * const hf) {
     if(mnl->solver == CG) {
       /* Invert Q_{+} Q_{-} */
       /* X -> DUM_DERI+1 */
-      chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		   mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_pm_psi);
+      chrono_guess(g_spinor_field[DUM_DERI+1], mnl->pf, mnl->csg_N, VOLUME, &Q_pm_psi);
       mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], mnl->pf, 
 			mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 			VOLUME, &Q_pm_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-			  mnl->csg_N, &mnl->csg_n, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME, &Q_pm_psi);
 
       /* Y -> DUM_DERI  */
       Q_minus_psi(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
@@ -125,24 +128,20 @@ void det_derivative(const int id, hamiltonian_field_t * const hf) {
     else {
       /* Invert first Q_+ */
       /* Y -> DUM_DERI  */
-      chrono_guess(g_spinor_field[DUM_DERI], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		   mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_plus_psi);
+      chrono_guess(g_spinor_field[DUM_DERI], mnl->pf, mnl->csg_N, VOLUME, &Q_plus_psi);
       mnl->iter1 += bicgstab_complex(g_spinor_field[DUM_DERI], mnl->pf, 
 				     mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 				     VOLUME,  Q_plus_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI], mnl->csg_field, mnl->csg_index_array,
-			  mnl->csg_N, &mnl->csg_n, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI], mnl->csg_N, VOLUME, &Q_plus_psi);
       
       /* Now Q_- */
       /* X -> DUM_DERI+1 */
       g_mu = -g_mu;
-      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI], mnl->csg_field2, 
-		   mnl->csg_index_array2, mnl->csg_N2, mnl->csg_n2, VOLUME/2, &Q_minus_psi);
+      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI], mnl->csg_N2, VOLUME, &Q_minus_psi);
       mnl->iter1 += bicgstab_complex(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI], 
 				     mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 				     VOLUME, Q_minus_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field2, mnl->csg_index_array2,
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N2, VOLUME, &Q_minus_psi);
       g_mu = -g_mu;   
     }
     
@@ -161,8 +160,6 @@ void det_heatbath(const int id, hamiltonian_field_t * const hf) {
   monomial * mnl = &monomial_list[id];
   g_mu = mnl->mu;
   boundary(mnl->kappa);
-  mnl->csg_n = 0;
-  mnl->csg_n2 = 0;
   mnl->iter0 = 0;
   mnl->iter1 = 0;
 
@@ -171,24 +168,12 @@ void det_heatbath(const int id, hamiltonian_field_t * const hf) {
     mnl->energy0 = square_norm(g_spinor_field[2], VOLUME/2, 1);
 
     Qtm_plus_psi(mnl->pf, g_spinor_field[2]);
-    chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
-    if(mnl->solver != CG) {
-      chrono_add_solution(mnl->pf, mnl->csg_field2, mnl->csg_index_array2, 
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
-    }
   }
   else {
     random_spinor_field(g_spinor_field[2], VOLUME, mnl->rngrepro);
     mnl->energy0 = square_norm(g_spinor_field[2], VOLUME, 1);
 
     Q_plus_psi(mnl->pf, g_spinor_field[2]);
-    chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
-    if(mnl->solver != CG) {
-      chrono_add_solution(mnl->pf, mnl->csg_field2, mnl->csg_index_array2, 
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
-    }
   }
   g_mu = g_mu1;
   boundary(g_kappa);
@@ -208,21 +193,25 @@ double det_acc(const int id, hamiltonian_field_t * const hf) {
   boundary(mnl->kappa);
   if(mnl->even_odd_flag) {
 
-    if(mnl->solver == CG) {
-      ITER_MAX_BCG = 0;
-    }
-    chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		 mnl->csg_N, mnl->csg_n, VOLUME/2, &Qtm_plus_psi);
     g_sloppy_precision_flag = 0;
-    mnl->iter0 = bicg(g_spinor_field[2], mnl->pf, mnl->accprec, g_relative_precision_flag);
+    if(mnl->solver == CG || mnl->solver == MIXEDCG) {
+      /* X_o with the history of the derivative, Y_o = Q_- X_o */
+      chrono_guess(g_spinor_field[DUM_DERI+5], mnl->pf, mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
+      mnl->iter0 = cg_her(g_spinor_field[DUM_DERI+5], mnl->pf, mnl->maxiter, mnl->accprec, 
+			  g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
+      Qtm_minus_psi(g_spinor_field[2], g_spinor_field[DUM_DERI+5]);
+    }
+    else {
+      chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_N, VOLUME/2, &Qtm_plus_psi);
+      mnl->iter0 = bicg(g_spinor_field[2], mnl->pf, mnl->accprec, g_relative_precision_flag);
+    }
     g_sloppy_precision_flag = save_sloppy;
     /* Compute the energy contr. from first field */
     mnl->energy1 = square_norm(g_spinor_field[2], VOLUME/2, 1);
   }
   else {
     if(mnl->solver == CG) {
-      chrono_guess(g_spinor_field[DUM_DERI+5], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		   mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_pm_psi);
+      chrono_guess(g_spinor_field[DUM_DERI+5], mnl->pf, mnl->csg_N, VOLUME, &Q_pm_psi);
       mnl->iter0 = cg_her(g_spinor_field[DUM_DERI+5], mnl->pf, 
 			  mnl->maxiter, mnl->accprec, g_relative_precision_flag, 
 			  VOLUME, Q_pm_psi);
@@ -231,8 +220,7 @@ double det_acc(const int id, hamiltonian_field_t * const hf) {
       mnl->energy1 = square_norm(g_spinor_field[2], VOLUME, 1);
     }
     else {
-      chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_field, mnl->csg_index_array,
-		   mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_plus_psi);
+      chrono_guess(g_spinor_field[2], mnl->pf, mnl->csg_N, VOLUME, &Q_plus_psi);
       mnl->iter0 += bicgstab_complex(g_spinor_field[2], mnl->pf, 
 				     mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 				     VOLUME,  Q_plus_psi);
@@ -37,6 +37,7 @@
 #include "deriv_Sb_D_psi.h"
 #include "gamma.h"
 #include "tm_operators.h"
+#include "tm_operators_32.h"
 #include "hybrid_update.h"
 #include "Hopping_Matrix.h"
 #include "solver/chrono_guess.h"
@@ -77,7 +78,7 @@ void detratio_derivative(const int no, hamiltonian_field_t * const hf) {
     g_mu = mnl->mu2;
     boundary(mnl->kappa2);
 
-    if(mnl->solver != CG) {
+    if(mnl->solver != CG && mnl->solver != MIXEDCG) {
       fprintf(stderr, "Bicgstab currently not implemented, using CG instead! (detratio_monomial.c)\n");
     }
 
@@ -86,12 +87,17 @@ void detratio_derivative(const int no, hamiltonian_field_t * const hf) {
     boundary(mnl->kappa);
     /* Invert Q_{+} Q_{-} */
     /* X_W -> DUM_DERI+1 */
-    chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_field, 
-		 mnl->csg_index_array, mnl->csg_N, mnl->csg_n, VOLUME/2, &Qtm_pm_psi);
-    mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->maxiter, 
-			 mnl->forceprec, g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
-    chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
+    chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
+    if(mnl->solver == MIXEDCG) {
+      mnl->iter1 += mixed_cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->maxiter, 
+				 mnl->forceprec, g_relative_precision_flag, VOLUME/2, 
+				 &Qtm_pm_psi, &Qtm_pm_psi_32);
+    }
+    else {
+      mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->maxiter, 
+			   mnl->forceprec, g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
+    }
+    chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
     /* Y_W -> DUM_DERI  */
     Qtm_minus_psi(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
     
@@ -143,13 +149,11 @@ void detratio_derivative(const int no, hamiltonian_field_t * const hf) {
       /*       gamma5(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], VOLUME/2); */
       /* Invert Q_{+} Q_{-} */
       /* X_W -> DUM_DERI+1 */
-      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_field, 
-		   mnl->csg_index_array, mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_pm_psi);
+      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], mnl->csg_N, VOLUME, &Q_pm_psi);
       mnl->iter1 += cg_her(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+2], 
 			   mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 			   VOLUME, &Q_pm_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field, mnl->csg_index_array,
-			  mnl->csg_N, &mnl->csg_n, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N, VOLUME, &Q_pm_psi);
       
       /* Y_W -> DUM_DERI  */
       Q_minus_psi(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1]);
@@ -158,26 +162,22 @@ void detratio_derivative(const int no, hamiltonian_field_t * const hf) {
       /* Invert first Q_+ */
       /* Y_o -> DUM_DERI  */
 
-      chrono_guess(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+2], mnl->csg_field, mnl->csg_index_array,
-		   mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_plus_psi);
+      chrono_guess(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+2], mnl->csg_N, VOLUME, &Q_plus_psi);
       gamma5(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI], VOLUME);
       mnl->iter1 += bicgstab_complex(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+2], 
 				     mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 				     VOLUME, Q_plus_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI], mnl->csg_field, mnl->csg_index_array,
-			  mnl->csg_N, &mnl->csg_n, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI], mnl->csg_N, VOLUME, &Q_plus_psi);
 
       /* Now Q_- */
       /* X_o -> DUM_DERI+1 */
       g_mu = -g_mu;
-      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI], mnl->csg_field2, 
-		   mnl->csg_index_array2, mnl->csg_N2, mnl->csg_n2, VOLUME/2, &Q_minus_psi);
+      chrono_guess(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI], mnl->csg_N2, VOLUME, &Q_minus_psi);
       gamma5(g_spinor_field[DUM_DERI+1], g_spinor_field[DUM_DERI+1], VOLUME);
       mnl->iter1 += bicgstab_complex(g_spinor_field[DUM_DERI+1],g_spinor_field[DUM_DERI], 
 				     mnl->maxiter, mnl->forceprec, g_relative_precision_flag, 
 				     VOLUME, Q_minus_psi);
-      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_field2, mnl->csg_index_array2,
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
+      chrono_add_solution(g_spinor_field[DUM_DERI+1], mnl->csg_N2, VOLUME, &Q_minus_psi);
       g_mu = -g_mu;   
     }
 
@@ -208,8 +208,6 @@ void detratio_heatbath(const int id, hamiltonian_field_t * const hf) {
 
   g_mu = mnl->mu;
   boundary(mnl->kappa);
-  mnl->csg_n = 0;
-  mnl->csg_n2 = 0;
   mnl->iter0 = 0;
   mnl->iter1 = 0;
   if(mnl->even_odd_flag) {
@@ -220,16 +218,10 @@ void detratio_heatbath(const int id, hamiltonian_field_t * const hf) {
     g_mu = mnl->mu2;
     boundary(mnl->kappa2);
     zero_spinor_field(mnl->pf,VOLUME/2);
-    if(mnl->solver == CG) ITER_MAX_BCG = 0;
+    if(mnl->solver == CG || mnl->solver == MIXEDCG) ITER_MAX_BCG = 0;
     ITER_MAX_CG = mnl->maxiter;
     mnl->iter0 += bicg(mnl->pf, g_spinor_field[3], mnl->accprec, g_relative_precision_flag);
 
-    chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
-    if(mnl->solver != CG) {
-      chrono_add_solution(mnl->pf, mnl->csg_field2, mnl->csg_index_array2,
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
-    }
   }
   else {
     random_spinor_field(g_spinor_field[4], VOLUME, mnl->rngrepro);
@@ -241,12 +233,6 @@ void detratio_heatbath(const int id, hamiltonian_field_t * const hf) {
     zero_spinor_field(mnl->pf,VOLUME);
     mnl->iter0 += bicgstab_complex(mnl->pf, g_spinor_field[3], mnl->maxiter, mnl->accprec, 
 				   g_relative_precision_flag, VOLUME, Q_plus_psi);
-    chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-			mnl->csg_N, &mnl->csg_n, VOLUME/2);
-    if(mnl->solver != CG) {
-      chrono_add_solution(mnl->pf, mnl->csg_field2, mnl->csg_index_array2,
-			  mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
-    }
   }
   if(g_proc_id == 0 && g_debug_level > 3) {
     printf("called detratio_heatbath for id %d %d energy %f\n", id, mnl->even_odd_flag, mnl->energy0);
@@ -268,12 +254,19 @@ double detratio_acc(const int id, hamiltonian_field_t * const hf) {
     Qtm_plus_psi(g_spinor_field[DUM_DERI+5], mnl->pf);
     g_mu = mnl->mu;
     boundary(mnl->kappa);
-    if(mnl->solver == CG) ITER_MAX_BCG = 0;
-    ITER_MAX_CG = mnl->maxiter;
-    chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_field, mnl->csg_index_array, 
-		 mnl->csg_N, mnl->csg_n, VOLUME/2, &Qtm_plus_psi);
     g_sloppy_precision_flag = 0;    
-    mnl->iter0 += bicg(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->accprec, g_relative_precision_flag); 
+    if(mnl->solver == CG || mnl->solver == MIXEDCG) {
+      /* with the history of the derivative */
+      chrono_guess(g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+5], mnl->csg_N, VOLUME/2, &Qtm_pm_psi);
+      mnl->iter0 += cg_her(g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+5], mnl->maxiter, mnl->accprec, 
+			   g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi);
+      Qtm_minus_psi(g_spinor_field[3], g_spinor_field[DUM_DERI+6]);
+    }
+    else {
+      ITER_MAX_CG = mnl->maxiter;
+      chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_N, VOLUME/2, &Qtm_plus_psi);
+      mnl->iter0 += bicg(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->accprec, g_relative_precision_flag); 
+    }
     g_sloppy_precision_flag = save_sloppy;
     /*     ITER_MAX_BCG = *saveiter_max; */
     /* Compute the energy contr. from second field */
@@ -283,8 +276,7 @@ double detratio_acc(const int id, hamiltonian_field_t * const hf) {
     Q_plus_psi(g_spinor_field[DUM_DERI+5], mnl->pf);
     g_mu = mnl->mu;
     boundary(mnl->kappa);
-    chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_field, mnl->csg_index_array, 
-		 mnl->csg_N, mnl->csg_n, VOLUME/2, &Q_plus_psi);
+    chrono_guess(g_spinor_field[3], g_spinor_field[DUM_DERI+5], mnl->csg_N, VOLUME, &Q_plus_psi);
     mnl->iter0 += bicgstab_complex(g_spinor_field[3], g_spinor_field[DUM_DERI+5], 
 				   mnl->maxiter, mnl->accprec, g_relative_precision_flag, 
 				   VOLUME, Q_plus_psi); 
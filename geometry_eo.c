@@ -42,6 +42,7 @@
 #include "su3.h"
 #include "su3adj.h"
 #include "mpi_init.h"
+#include "site_order.h"
 
 void Hopping_Matrix_Indices(void);
 
@@ -1276,6 +1277,14 @@ void geometry(){
   MPI_Type_commit(&field_z_slice_even_up);
   MPI_Type_commit(&field_z_slice_odd_dn);
   MPI_Type_commit(&field_z_slice_odd_up);
+  MPI_Type_indexed(T*LX*LY/2,ones,g_field_z_disp_even_dn,field_point32,&field_z_slice_even_dn32);
+  MPI_Type_indexed(T*LX*LY/2,ones,g_field_z_disp_even_up,field_point32,&field_z_slice_even_up32);
+  MPI_Type_indexed(T*LX*LY/2,ones,g_field_z_disp_odd_dn,field_point32,&field_z_slice_odd_dn32);
+  MPI_Type_indexed(T*LX*LY/2,ones,g_field_z_disp_odd_up,field_point32,&field_z_slice_odd_up32);
+  MPI_Type_commit(&field_z_slice_even_dn32);
+  MPI_Type_commit(&field_z_slice_even_up32);
+  MPI_Type_commit(&field_z_slice_odd_dn32);
+  MPI_Type_commit(&field_z_slice_odd_up32);
   free(ones);
 
 #  if defined _USE_TSPLITPAR
@@ -1533,6 +1542,15 @@ void geometry(){
     g_t[ix] = x0;
   }
 
+  /* the traversal order of the halfspinor Dirac operator */
+  if(init_site_order(g_site_order_type, g_site_tile) != 0) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "Falling back to the lexicographic site order\n");
+    }
+    g_site_order_type = SITE_ORDER_LEXIC;
+    init_site_order(g_site_order_type, g_site_tile);
+  }
+
   free(xeven);
 }
 
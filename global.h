@@ -70,6 +70,7 @@ EXTERN int DUM_BI_DERI, DUM_BI_SOLVER, DUM_BI_MATRIX;
 EXTERN int NO_OF_BISPINORFIELDS;
 
 EXTERN int g_update_gauge_copy;
+EXTERN int g_update_gauge_copy_32;
 EXTERN int g_update_gauge_energy;
 EXTERN int g_update_rectangle_energy;
 EXTERN int g_relative_precision_flag;
@@ -90,8 +91,18 @@ EXTERN int * g_lexic2eo;
 /* translates from even/odd order to lexicograhic order  */
 EXTERN int * g_eo2lexic;
 EXTERN int * g_lexic2eosub;
+/* order in which the halfspinor Dirac operator visits the even   */
+/* (first VOLUME/2) and the odd sites, see site_order.c           */
+EXTERN int * g_eo_site_order;
+EXTERN int g_site_order_type;
+EXTERN int g_site_tile[4];
 EXTERN int g_sloppy_precision_flag;
 EXTERN int g_sloppy_precision;
+/* measure the force of every monomial, see monomial_cost.h */
+EXTERN int g_monomial_force_flag;
+/* applications of the even/odd hopping matrix, for the cost */
+/* accounting of the monomials in monomial_cost.c            */
+EXTERN unsigned long g_hopping_count;
 
 EXTERN int **** g_ipt;
 EXTERN int ** g_iup;
@@ -173,13 +184,19 @@ EXTERN int g_running_phmc;
 
 EXTERN su3 ** g_gauge_field;
 #ifdef _USE_HALFSPINOR
-EXTERN su3 *** g_gauge_field_copy;
+EXTERN su3_copy *** g_gauge_field_copy;
 #elif (defined _USE_TSPLITPAR )
 EXTERN su3 ** g_gauge_field_copyt;
 EXTERN su3 ** g_gauge_field_copys;
 #else
 EXTERN su3 ** g_gauge_field_copy;
 #endif
+/* single precision copy of the gauge field, same layout as g_gauge_field_copy */
+#ifdef _USE_HALFSPINOR
+EXTERN su3_copy_32 *** g_gauge_field_copy_32;
+#else
+EXTERN su3_copy_32 ** g_gauge_field_copy_32;
+#endif
 
 /*for temporalgauge in GPU part*/
 EXTERN su3 ** g_tempgauge_field;
@@ -60,6 +60,7 @@
 #endif
 #include "read_input.h"
 #include "mpi_init.h"
+#include "tuning.h"
 #include "sighandler.h"
 #include "update_tm.h"
 #include "init_gauge_field.h"
@@ -75,7 +76,9 @@
 #include "boundary.h"
 #include "phmc.h"
 #include "solver/solver.h"
+#include "solver/solver_field.h"
 #include "monomial.h"
+#include "monomial_cost.h"
 #include "integrator.h"
 #include "sighandler.h"
 #include "measurements.h"
@@ -107,8 +110,8 @@ int main(int argc,char *argv[]) {
   char nstore_filename[50];
   char tmp_filename[50];
   char *input_filename = NULL;
-  int status = 0, accept = 0;
-  int j,ix,mu, trajectory_counter=1;
+  int status = 0, accept = 0, use_32 = 0;
+  int j,ix,mu, trajectory_counter=1, repro_seed;
   struct timeval t1;
 
   /* Energy corresponding to the Gauge part */
@@ -215,11 +218,15 @@ int main(int argc,char *argv[]) {
   DUM_DERI = 6;
   DUM_SOLVER = DUM_DERI+8;
   DUM_MATRIX = DUM_SOLVER+6;
+  NO_OF_SPINORFIELDS = DUM_MATRIX+6;
+  /* the non-degenerate operators need two more fields */
   if(g_running_phmc) {
     NO_OF_SPINORFIELDS = DUM_MATRIX+8;
   }
-  else {
-    NO_OF_SPINORFIELDS = DUM_MATRIX+6;
+  for(j = 0; j < no_monomials; j++) {
+    if(monomial_list[j].type == NDRAT) {
+      NO_OF_SPINORFIELDS = DUM_MATRIX+8;
+    }
   }
   DUM_BI_DERI = 6;
   DUM_BI_SOLVER = DUM_BI_DERI+7;
@@ -229,6 +236,9 @@ int main(int argc,char *argv[]) {
 
   tmlqcd_mpi_init(argc, argv);
 
+  /* the fastest settings found by benchmark on this machine */
+  read_tuning_file(tuning_filename);
+
   if(even_odd_flag) {
     j = init_monomials(VOLUMEPLUSRAND/2, even_odd_flag);
   }
@@ -293,16 +303,6 @@ int main(int argc,char *argv[]) {
     fprintf(stderr, "Not enough memory for spinor fields! Aborting...\n");
     exit(0);
   }
-  if(even_odd_flag) {
-    j = init_csg_field(VOLUMEPLUSRAND/2);
-  }
-  else {
-    j = init_csg_field(VOLUMEPLUSRAND);
-  }
-  if (j != 0) {
-    fprintf(stderr, "Not enough memory for csg fields! Aborting...\n");
-    exit(0);
-  }
   j = init_moment_field(VOLUME, VOLUMEPLUSRAND + g_dbw2rand);
   if (j != 0) {
     fprintf(stderr, "Not enough memory for moment fields! Aborting...\n");
@@ -367,8 +367,33 @@ int main(int argc,char *argv[]) {
 #  endif
 #endif
 
+  /* single precision gauge copy for the mixed precision CG */
+  use_32 = g_sloppy_precision_flag;
+  for(j = 0; j < no_monomials; j++) {
+    if(monomial_list[j].solver == MIXEDCG) use_32 = 1;
+  }
+  if(use_32) {
+#ifdef _USE_HALFSPINOR
+    if(g_sloppy_precision_flag != 1) {
+      j = init_dirac_halfspinor32();
+      if (j != 0) {
+        fprintf(stderr, "Not enough memory for 32-bit halffield! Aborting...\n");
+        exit(-1);
+      }
+    }
+#endif
+    j = init_gauge_field_32(VOLUMEPLUSRAND);
+    if (j != 0) {
+      fprintf(stderr, "Not enough memory for 32-bit gauge field copy! Aborting...\n");
+      exit(-1);
+    }
+  }
+
   /* Initialise random number generator */
-  start_ranlux(rlxd_level, random_seed^(nstore+1) );
+  /* the counter based generator is keyed with the same seed, such */
+  /* that a restart with a new store counter gets new random fields */
+  repro_seed = random_seed^(nstore+1);
+  start_ranlux(rlxd_level, repro_seed);
 
   /* Set up the gauge field */
   /* continue and restart */
@@ -455,9 +480,11 @@ int main(int argc,char *argv[]) {
     }
 
     return_check = return_check_flag && (trajectory_counter%return_check_interval == 0);
+    start_repro_random(repro_seed, trajectory_counter);
 
     accept = update_tm(&plaquette_energy, &rectangle_energy, datafilename, return_check, Ntherm<trajectory_counter);
     Rate += accept;
+    write_monomial_cost("monomials.data", trajectory_counter);
 
     /* Save gauge configuration all Nsave times */
     if((Nsave !=0) && (trajectory_counter%Nsave == 0) && (trajectory_counter!=0)) {
@@ -570,14 +597,25 @@ int main(int argc,char *argv[]) {
     fclose(parameterfile);
   }
 
+  if(g_proc_id == 0 && g_debug_level > 0) {
+    print_solver_field_pool_stats();
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+    print_xchange_halffield_stats();
+#endif
+  }
+
 #ifdef MPI
   MPI_Finalize();
 #endif
 #ifdef OMP
   free_omp_accumulators();
 #endif
+  free_solver_field_pool();
   free_gauge_tmp();
   free_gauge_field();
+  if(use_32) {
+    free_gauge_field_32();
+  }
   free_geometry_indices();
   free_spinor_field();
   free_moment_field();
@@ -22,6 +22,7 @@
 #endif
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <errno.h>
 #if (defined SPI)
 # include "DirectPut.h"
@@ -29,6 +30,9 @@
 #include "global.h"
 #include "su3.h"
 #include "init_dirac_halfspinor.h"
+#ifdef _SHM_HALO
+# include "shm_halo.h"
+#endif
 
 #ifdef BGQ
 #  define SPI_ALIGN_BASE 0x7f
@@ -42,6 +46,11 @@ halfspinor * HalfSpinor ALIGN;
 halfspinor *** NBPointer;
 halfspinor * sendBuffer, * recvBuffer;
 halfspinor * sendBuffer_, * recvBuffer_;
+#if (defined _OVERLAP_COMM && defined MPI)
+int * NBOrder_ = NULL;
+int ** NBOrder = NULL;
+int NBOrderSplit[4];
+#endif
 
 /* The single precision versions */
 halfspinor32 ** NBPointer32_;
@@ -52,6 +61,47 @@ halfspinor32 * sendBuffer32, * recvBuffer32;
 halfspinor32 * sendBuffer32_, * recvBuffer32_;
 
 
+#if (defined _OVERLAP_COMM && defined MPI)
+/* site orderings for overlapping the exchange with computation:  */
+/* for ieo = 0,1 the sites writing to sendBuffer come first,      */
+/* for ieo = 2,3 the sites not reading from recvBuffer come first */
+/* NBOrderSplit[ieo] is the number of sites in the first group,   */
+/* within the groups the sites keep the order of g_eo_site_order  */
+int init_nborder() {
+  if(NBOrder == NULL) {
+    NBOrder = (int**) calloc(4, sizeof(int*));
+    if((void*)(NBOrder_ = (int*)calloc(4*(VOLUME/2), sizeof(int))) == NULL) {
+      printf ("malloc errno : %d\n",errno); 
+      errno = 0;
+      return(1);
+    }
+  }
+  for(int ieo = 0; ieo < 4; ieo++) {
+    halfspinor * buffer = (ieo < 2) ? sendBuffer : recvBuffer;
+    const int * order = g_eo_site_order + ((ieo < 2) ? (ieo+1)%2 : ieo%2)*(VOLUME/2);
+    int first = (ieo < 2) ? 1 : 0;
+    int n = 0;
+    NBOrder[ieo] = NBOrder_ + ieo*(VOLUME/2);
+    for(int pass = 0; pass < 2; pass++) {
+      if(pass == 1) NBOrderSplit[ieo] = n;
+      for(int m = 0; m < VOLUME/2; m++) {
+	const int i = order[m];
+	int bnd = 0;
+	for(int mu = 0; mu < 8; mu++) {
+	  if(NBPointer[ieo][8*i + mu] >= buffer && NBPointer[ieo][8*i + mu] < buffer + RAND/2) {
+	    bnd = 1;
+	  }
+	}
+	if((pass == 0 && bnd == first) || (pass == 1 && bnd != first)) {
+	  NBOrder[ieo][n++] = i;
+	}
+      }
+    }
+  }
+  return(0);
+}
+#endif
+
 int init_dirac_halfspinor() {
   int j=0, k;
   int x, y, z, t;
@@ -72,11 +122,21 @@ int init_dirac_halfspinor() {
   HalfSpinor = (halfspinor*)(((unsigned long int)(HalfSpinor_)+ALIGN_BASE+1)&~ALIGN_BASE);
 
 #ifdef MPI
+#  ifdef _SHM_HALO
+  /* the neighbours on the node read the send buffer directly */
+  if((void*)(sendBuffer_ = (halfspinor*)shm_alloc((RAND/2+8)*sizeof(halfspinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  memset(sendBuffer_, 0, (RAND/2+8)*sizeof(halfspinor));
+#  else
   if((void*)(sendBuffer_ = (halfspinor*)calloc(RAND/2+8, sizeof(halfspinor))) == NULL) {
     printf ("malloc errno : %d\n",errno); 
     errno = 0;
     return(1);
   }
+#  endif
   sendBuffer = (halfspinor*)(((unsigned long int)(sendBuffer_)+SPI_ALIGN_BASE+1)&~SPI_ALIGN_BASE);
   if((void*)(recvBuffer_ = (halfspinor*)calloc(RAND/2+8, sizeof(halfspinor))) == NULL) {
     printf ("malloc errno : %d\n",errno); 
@@ -197,6 +257,11 @@ int init_dirac_halfspinor() {
       }
     }
   }
+#if (defined _OVERLAP_COMM && defined MPI)
+  if(init_nborder() != 0) {
+    return(1);
+  }
+#endif
 #if (defined SPI && defined MPI)
   // here comes the SPI initialisation
   uint64_t messageSizes[NUM_DIRS];
@@ -569,3 +634,170 @@ int init_dirac_halfspinor32() {
 #endif
   return(0);
 }
+
+
+/* The multiple right hand side versions                  */
+/* nrhs halfspinors belonging to the same site and        */
+/* direction are stored consecutively, the pointer tables */
+/* are derived from NBPointer, so init_dirac_halfspinor() */
+/* must have been called before                           */
+
+halfspinor ** NBPointer_nrhs_;
+halfspinor * HalfSpinor_nrhs_;
+halfspinor * HalfSpinor_nrhs ALIGN;
+halfspinor *** NBPointer_nrhs;
+halfspinor * sendBuffer_nrhs, * recvBuffer_nrhs;
+halfspinor * sendBuffer_nrhs_, * recvBuffer_nrhs_;
+halfspinor32 ** NBPointer32_nrhs_;
+halfspinor32 * HalfSpinor32_nrhs_;
+halfspinor32 * HalfSpinor32_nrhs ALIGN;
+halfspinor32 *** NBPointer32_nrhs = NULL;
+halfspinor32 * sendBuffer32_nrhs, * recvBuffer32_nrhs;
+halfspinor32 * sendBuffer32_nrhs_, * recvBuffer32_nrhs_;
+int g_nrhs_halfspinor = 0;
+
+static halfspinor * nrhs_pointer(halfspinor * const p, const int nrhs) {
+  if(p >= HalfSpinor && p < HalfSpinor + 4*VOLUME) {
+    return(HalfSpinor_nrhs + (p - HalfSpinor)*nrhs);
+  }
+#ifdef MPI
+  if(p >= sendBuffer && p < sendBuffer + RAND/2) {
+    return(sendBuffer_nrhs + (p - sendBuffer)*nrhs);
+  }
+  if(p >= recvBuffer && p < recvBuffer + RAND/2) {
+    return(recvBuffer_nrhs + (p - recvBuffer)*nrhs);
+  }
+#endif
+  return(NULL);
+}
+
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
+static halfspinor32 * nrhs_pointer32(halfspinor32 * const p, const int nrhs) {
+  if(p >= HalfSpinor32 && p < HalfSpinor32 + 4*VOLUME) {
+    return(HalfSpinor32_nrhs + (p - HalfSpinor32)*nrhs);
+  }
+#ifdef MPI
+  if(p >= sendBuffer32 && p < sendBuffer32 + RAND/2) {
+    return(sendBuffer32_nrhs + (p - sendBuffer32)*nrhs);
+  }
+  if(p >= recvBuffer32 && p < recvBuffer32 + RAND/2) {
+    return(recvBuffer32_nrhs + (p - recvBuffer32)*nrhs);
+  }
+#endif
+  return(NULL);
+}
+#endif
+
+int init_dirac_halfspinor_nrhs(const int nrhs) {
+
+  if(NBPointer == NULL) {
+    printf("init_dirac_halfspinor_nrhs: init_dirac_halfspinor must be called first\n");
+    return(2);
+  }
+  if(g_nrhs_halfspinor > 0) {
+    free_dirac_halfspinor_nrhs();
+  }
+
+  NBPointer_nrhs = (halfspinor***) calloc(4,sizeof(halfspinor**));
+
+  if((void*)(NBPointer_nrhs_ = (halfspinor**) calloc(16,(VOLUME+RAND)*sizeof(halfspinor*))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  for(int ieo = 0; ieo < 4; ieo++) {
+    NBPointer_nrhs[ieo] = NBPointer_nrhs_ + (ieo*8*(VOLUME+RAND)/2);
+  }
+
+  if((void*)(HalfSpinor_nrhs_ = (halfspinor*)calloc(4*(VOLUME)*nrhs+1, sizeof(halfspinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  HalfSpinor_nrhs = (halfspinor*)(((unsigned long int)(HalfSpinor_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+
+#ifdef MPI
+  if((void*)(sendBuffer_nrhs_ = (halfspinor*)calloc(RAND/2*nrhs+8, sizeof(halfspinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  sendBuffer_nrhs = (halfspinor*)(((unsigned long int)(sendBuffer_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+  if((void*)(recvBuffer_nrhs_ = (halfspinor*)calloc(RAND/2*nrhs+8, sizeof(halfspinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  recvBuffer_nrhs = (halfspinor*)(((unsigned long int)(recvBuffer_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+#endif
+
+  for(int ieo = 0; ieo < 4; ieo++) {
+    for(int i = 0; i < 8*(VOLUME+RAND)/2; i++) {
+      NBPointer_nrhs[ieo][i] = nrhs_pointer(NBPointer[ieo][i], nrhs);
+    }
+  }
+
+  /* the 32 bit fields for g_sloppy_precision, the SSE and */
+  /* AVX versions of the hopping matrix do not use them    */
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
+  if(g_sloppy_precision_flag == 1 && NBPointer32 != NULL) {
+    NBPointer32_nrhs = (halfspinor32***) calloc(4,sizeof(halfspinor32**));
+    if((void*)(NBPointer32_nrhs_ = (halfspinor32**) calloc(16,(VOLUME+RAND)*sizeof(halfspinor32*))) == NULL) {
+      printf ("malloc errno : %d\n",errno); 
+      errno = 0;
+      return(1);
+    }
+    for(int ieo = 0; ieo < 4; ieo++) {
+      NBPointer32_nrhs[ieo] = NBPointer32_nrhs_ + (ieo*8*(VOLUME+RAND)/2);
+    }
+    if((void*)(HalfSpinor32_nrhs_ = (halfspinor32*)calloc(4*(VOLUME)*nrhs+2, sizeof(halfspinor32))) == NULL) {
+      printf ("malloc errno : %d\n",errno); 
+      errno = 0;
+      return(1);
+    }
+    HalfSpinor32_nrhs = (halfspinor32*)(((unsigned long int)(HalfSpinor32_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+#ifdef MPI
+    if((void*)(sendBuffer32_nrhs_ = (halfspinor32*)calloc(RAND/2*nrhs+16, sizeof(halfspinor32))) == NULL) {
+      printf ("malloc errno : %d\n",errno); 
+      errno = 0;
+      return(1);
+    }
+    sendBuffer32_nrhs = (halfspinor32*)(((unsigned long int)(sendBuffer32_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+    if((void*)(recvBuffer32_nrhs_ = (halfspinor32*)calloc(RAND/2*nrhs+16, sizeof(halfspinor32))) == NULL) {
+      printf ("malloc errno : %d\n",errno); 
+      errno = 0;
+      return(1);
+    }
+    recvBuffer32_nrhs = (halfspinor32*)(((unsigned long int)(recvBuffer32_nrhs_)+ALIGN_BASE+1)&~ALIGN_BASE);
+#endif
+    for(int ieo = 0; ieo < 4; ieo++) {
+      for(int i = 0; i < 8*(VOLUME+RAND)/2; i++) {
+        NBPointer32_nrhs[ieo][i] = nrhs_pointer32(NBPointer32[ieo][i], nrhs);
+      }
+    }
+  }
+#endif
+  g_nrhs_halfspinor = nrhs;
+  return(0);
+}
+
+void free_dirac_halfspinor_nrhs() {
+  free(HalfSpinor_nrhs_);
+  free(NBPointer_nrhs_);
+  free(NBPointer_nrhs);
+#ifdef MPI
+  free(sendBuffer_nrhs_);
+  free(recvBuffer_nrhs_);
+#endif
+  if(NBPointer32_nrhs != NULL) {
+    free(HalfSpinor32_nrhs_);
+    free(NBPointer32_nrhs_);
+    free(NBPointer32_nrhs);
+#ifdef MPI
+    free(sendBuffer32_nrhs_);
+    free(recvBuffer32_nrhs_);
+#endif
+    NBPointer32_nrhs = NULL;
+  }
+  g_nrhs_halfspinor = 0;
+}
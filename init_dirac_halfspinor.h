@@ -26,8 +26,23 @@ extern halfspinor32 * HalfSpinor32 ALIGN;
 extern halfspinor32 *** NBPointer32;
 extern halfspinor * ALIGN sendBuffer, * ALIGN recvBuffer;
 extern halfspinor32 * ALIGN sendBuffer32, * ALIGN recvBuffer32;
+extern halfspinor * HalfSpinor_nrhs ALIGN;
+extern halfspinor *** NBPointer_nrhs;
+extern halfspinor * ALIGN sendBuffer_nrhs, * ALIGN recvBuffer_nrhs;
+extern halfspinor32 * HalfSpinor32_nrhs ALIGN;
+extern halfspinor32 *** NBPointer32_nrhs;
+extern halfspinor32 * ALIGN sendBuffer32_nrhs, * ALIGN recvBuffer32_nrhs;
+extern int g_nrhs_halfspinor;
+#if (defined _OVERLAP_COMM && defined MPI)
+extern int ** NBOrder;
+extern int NBOrderSplit[4];
+/* (re)computes NBOrder, needed after g_eo_site_order changed */
+int init_nborder();
+#endif
 
 int init_dirac_halfspinor();
 int init_dirac_halfspinor32();
+int init_dirac_halfspinor_nrhs(const int nrhs);
+void free_dirac_halfspinor_nrhs();
 
 #endif
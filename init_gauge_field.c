@@ -32,9 +32,12 @@ su3 * gauge_field = NULL;
 #ifdef _USE_TSPLITPAR
 su3 * gauge_field_copyt = NULL;
 su3 * gauge_field_copys = NULL;
+#elif defined _USE_HALFSPINOR
+su3_copy * gauge_field_copy = NULL;
 #else
 su3 * gauge_field_copy = NULL;
 #endif
+su3_copy_32 * gauge_field_copy_32 = NULL;
 
 int init_gauge_field(const int V, const int back) {
   int i=0;
@@ -70,24 +73,24 @@ int init_gauge_field(const int V, const int back) {
     /*
       g_gauge_field_copy[ieo][PM][sites/2][mu]
     */
-    if((void*)(g_gauge_field_copy = (su3***)calloc(2, sizeof(su3**))) == NULL) {
+    if((void*)(g_gauge_field_copy = (su3_copy***)calloc(2, sizeof(su3_copy**))) == NULL) {
       printf ("malloc errno : %d\n",errno); 
       errno = 0;
       return(3);
     }
-    if((void*)(g_gauge_field_copy[0] = (su3**)calloc(VOLUME, sizeof(su3*))) == NULL) {
+    if((void*)(g_gauge_field_copy[0] = (su3_copy**)calloc(VOLUME, sizeof(su3_copy*))) == NULL) {
       printf ("malloc errno : %d\n",errno); 
       errno = 0;
       return(3);
     }
     g_gauge_field_copy[1] = g_gauge_field_copy[0] + (VOLUME)/2;
-    if((void*)(gauge_field_copy = (su3*)calloc(4*(VOLUME)+1, sizeof(su3))) == NULL) {
+    if((void*)(gauge_field_copy = (su3_copy*)calloc(4*(VOLUME)+1, sizeof(su3_copy))) == NULL) {
       printf ("malloc errno : %d\n",errno); 
       errno = 0;
       return(4);
     }
 #    if (defined SSE || defined SSE2 || defined SSE3)
-    g_gauge_field_copy[0][0] = (su3*)(((unsigned long int)(gauge_field_copy)+ALIGN_BASE)&~ALIGN_BASE);
+    g_gauge_field_copy[0][0] = (su3_copy*)(((unsigned long int)(gauge_field_copy)+ALIGN_BASE)&~ALIGN_BASE);
 #    else
     g_gauge_field_copy[0][0] = gauge_field_copy;
 #    endif
@@ -171,3 +174,78 @@ void free_gauge_field() {
   free(gauge_field_copy);
 #  endif
 }
+
+/* single precision copy of the gauge field with the same layout as  */
+/* g_gauge_field_copy, used by Hopping_Matrix_32                     */
+/* not available with _USE_TSPLITPAR                                 */
+int init_gauge_field_32(const int V) {
+  int i=0;
+
+  g_gauge_field_copy_32 = NULL;
+#  if defined _USE_HALFSPINOR
+  if((void*)(g_gauge_field_copy_32 = (su3_copy_32***)calloc(2, sizeof(su3_copy_32**))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  if((void*)(g_gauge_field_copy_32[0] = (su3_copy_32**)calloc(VOLUME, sizeof(su3_copy_32*))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  g_gauge_field_copy_32[1] = g_gauge_field_copy_32[0] + (VOLUME)/2;
+  if((void*)(gauge_field_copy_32 = (su3_copy_32*)calloc(4*(VOLUME)+1, sizeof(su3_copy_32))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(2);
+  }
+#    if (defined SSE || defined SSE2 || defined SSE3)
+  g_gauge_field_copy_32[0][0] = (su3_copy_32*)(((unsigned long int)(gauge_field_copy_32)+ALIGN_BASE)&~ALIGN_BASE);
+#    else
+  g_gauge_field_copy_32[0][0] = gauge_field_copy_32;
+#    endif
+  for(i = 1; i < (VOLUME)/2; i++) {
+    g_gauge_field_copy_32[0][i] = g_gauge_field_copy_32[0][i-1]+4;
+  }
+  g_gauge_field_copy_32[1][0] = g_gauge_field_copy_32[0][0] + 2*VOLUME; 
+  for(i = 1; i < (VOLUME)/2; i++) {
+    g_gauge_field_copy_32[1][i] = g_gauge_field_copy_32[1][i-1]+4;
+  }
+#  elif defined _USE_TSPLITPAR
+  printf("init_gauge_field_32: single precision gauge copy not available with _USE_TSPLITPAR\n");
+  return(3);
+#  else
+  if((void*)(g_gauge_field_copy_32 = (su3_copy_32**)calloc((VOLUME+RAND), sizeof(su3_copy_32*))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  if((void*)(gauge_field_copy_32 = (su3_copy_32*)calloc(8*(VOLUME+RAND)+1, sizeof(su3_copy_32))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(2);
+  }
+#  if (defined SSE || defined SSE2 || defined SSE3)
+  g_gauge_field_copy_32[0] = (su3_copy_32*)(((unsigned long int)(gauge_field_copy_32)+ALIGN_BASE)&~ALIGN_BASE);
+#  else
+  g_gauge_field_copy_32[0] = gauge_field_copy_32;
+#  endif
+  for(i = 1; i < (VOLUME+RAND); i++) {
+    g_gauge_field_copy_32[i] = g_gauge_field_copy_32[i-1]+8;
+  }
+#  endif
+  g_update_gauge_copy_32 = 1;
+  return(0);
+}
+
+void free_gauge_field_32() {
+  free(gauge_field_copy_32);
+#  if defined _USE_HALFSPINOR
+  if(g_gauge_field_copy_32 != NULL) {
+    free(g_gauge_field_copy_32[0]);
+  }
+#  endif
+  free(g_gauge_field_copy_32);
+  gauge_field_copy_32 = NULL;
+  g_gauge_field_copy_32 = NULL;
+}
@@ -21,5 +21,7 @@
 
 int init_gauge_field(const int V, const int back);
 void free_gauge_field();
+int init_gauge_field_32(const int V);
+void free_gauge_field_32();
 
 #endif
@@ -57,6 +57,8 @@ int init_geometry_indices(const int V) {
   if((void*)g_lexic2eosub == NULL) return(10);
   g_eo2lexic = (int*)calloc(V, sizeof(int));
   if((void*)g_eo2lexic == NULL) return(11);
+  g_eo_site_order = (int*)calloc(VOLUME, sizeof(int));
+  if((void*)g_eo_site_order == NULL) return(41);
 
 #if ( defined PARALLELXYZT || defined PARALLELXYZ )
   g_field_z_ipt_even = (int*)calloc(T*LX*LY, sizeof(int));
@@ -178,6 +180,7 @@ void free_geometry_indices() {
   free(g_idn);
   free(g_iup);
   free(g_eo2lexic);
+  free(g_eo_site_order);
   free(g_lexic2eosub);
   free(g_lexic2eo);
 #if ( defined PARALLELXYZT || defined PARALLELXYZ )
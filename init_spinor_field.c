@@ -22,6 +22,7 @@
 #endif
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <errno.h>
 #ifdef _USE_SHMEM
 # include <mpp/shmem.h>
@@ -30,9 +31,11 @@
 #include "su3.h"
 #include "sse.h"
 #include "monomial.h"
+#ifdef _SHM_HALO
+# include "shm_halo.h"
+#endif
 
 spinor * sp = NULL;
-spinor * sp_csg = NULL;
 spinor * sp_tbuff = NULL;
 
 int init_spinor_field(const int V, const int nr) {
@@ -44,6 +47,14 @@ int init_spinor_field(const int V, const int nr) {
     errno = 0;
     return(1);
   }
+#elif (defined _SHM_HALO && defined MPI)
+  /* the neighbours on the node read the boundaries directly */
+  if((void*)(sp = (spinor*)shm_alloc((nr*V+1)*sizeof(spinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+  memset(sp, 0, (nr*V+1)*sizeof(spinor));
 #else
   if((void*)(sp = (spinor*)calloc(nr*V+1, sizeof(spinor))) == NULL) {
     printf ("malloc errno : %d\n",errno); 
@@ -72,10 +83,10 @@ int init_spinor_field(const int V, const int nr) {
 void free_spinor_field() {
 #if (defined _USE_SHMEM && !(defined _USE_HALFSPINOR))
   shfree(sp);
-  shfree(sp_csg);
+#elif (defined _SHM_HALO && defined MPI)
+  shm_free(sp);
 #else
   free(sp);
-  free(sp_csg);
 #endif
 }
 
@@ -127,72 +138,6 @@ void free_spinor_field_array(spinor** sp) {
 
 
 
-#ifndef _BENCH_ONLY
-int init_csg_field(const int V) {
-  int i = 0, j = 0, sum = 0;
-  spinor * s;
-  for(i = 0; i < no_monomials; i++) {
-    sum += monomial_list[i].csg_N;
-    sum += monomial_list[i].csg_N2;
-  }
-
-  /* if all histories are zero, we do not need initialisation */
-  if(sum != 0) {
-#if (defined _USE_SHMEM && !(defined _USE_HALFSPINOR))
-    sp_csg = (spinor*)shmalloc((sum*V+1)*sizeof(spinor));
-#else
-    sp_csg = (spinor*)calloc(sum*V+1, sizeof(spinor));
-#endif
-    if(errno == ENOMEM) {
-      return(1);
-    }
-    for(i = 0; i < no_monomials; i++) {
-      monomial_list[i].csg_field = malloc((monomial_list[i].csg_N+1)*sizeof(spinor*));
-      if(errno == ENOMEM) {
-	return(2);
-      }
-      monomial_list[i].csg_field2 = malloc(monomial_list[i].csg_N2*sizeof(spinor*));
-      if(errno == ENOMEM) {
-	return(2);
-      }
-    }
-#if ( defined SSE || defined SSE2 || defined SSE3)
-    s = (spinor*)(((unsigned long int)(sp_csg)+ALIGN_BASE)&~ALIGN_BASE);
-#else
-    s = sp_csg;
-#endif
-    for(j = 0; j < no_monomials; j++) {
-      if(monomial_list[j].csg_N != 0) {
-	for(i = 0; i < monomial_list[j].csg_N; i++) {
-	  monomial_list[j].csg_field[i] = s;
-	  s = s + V;
-	}
-      }
-    }
-    for(j = 0; j < no_monomials; j++) {
-      if(monomial_list[j].csg_N2 != 0) {
-	for(i = 0; i < monomial_list[j].csg_N2; i++) {
-	  monomial_list[j].csg_field2[i] = s;
-	  s = s + V;
-	}
-      }
-    }
-    
-    monomial_list[0].csg_index_array = (int*) malloc(sum*sizeof(int));
-    for(i = 1; i < no_monomials; i++) {
-      monomial_list[i].csg_index_array = monomial_list[i-1].csg_index_array + monomial_list[i-1].csg_N;
-    }
-    monomial_list[0].csg_index_array2 = monomial_list[no_monomials-1].csg_index_array 
-      + monomial_list[no_monomials-1].csg_N;
-    for(i = 1; i < no_monomials; i++) {
-      monomial_list[i].csg_index_array2 = monomial_list[i-1].csg_index_array2 + monomial_list[i-1].csg_N2;
-    }
-  }
-  return(0);
-}
-
-#endif
-
 int init_timslice_buffer_field(const int t_slice) {
   
   if((void*)(sp_tbuff = (spinor*)calloc(t_slice+1, sizeof(spinor))) == NULL) {
@@ -40,6 +40,9 @@
 #include "update_gauge.h"
 #include "hamiltonian_field.h"
 #include "integrator.h"
+#include "integrator_tuning.h"
+#include "monomial_cost.h"
+#include "solver/chrono_guess.h"
 
 integrator Integrator;
 
@@ -49,6 +52,29 @@ void integrate_2mn(const double tau, const int S, const int halfstep);
 void integrate_2mnp(const double tau, const int S, const int halfstep);
 /* Leap Frog integration scheme */
 void integrate_leap_frog(const double tau, const int S, const int halfstep);
+/* integration scheme of the table schemes[S], see below */
+void integrate_scheme(const double tau, const int S, const int halfstep);
+
+/* An integration scheme as a sequence of stages: momentum updates    */
+/* with the force of the timescale (STAGE_P), the same with the force */
+/* gradient term (STAGE_FG) and updates of the gauge field or of the  */
+/* next lower timescale (STAGE_U), each with coefficient c times the  */
+/* step size. For STAGE_FG the force is taken at the gauge field      */
+/* moved by c2 times the step size squared along the force.           */
+#define STAGE_P 0
+#define STAGE_U 1
+#define STAGE_FG 2
+
+typedef struct {
+  int no_stages;
+  int kind[12];
+  double c[12], c2[12];
+  /* the lambda the coefficients were computed with */
+  double lambda;
+} scheme;
+
+static scheme schemes[10];
+static void init_scheme(const int S);
 
 /* function to initialise the integrator, to be called once at the beginning */
 
@@ -60,7 +86,19 @@ int init_integrator() {
   for(i = 0; i < 10; i++) {
     Integrator.no_mnls_per_ts[i] = 0;
   }
-  if(Integrator.type[Integrator.no_timescales-1] == MN2p) {
+  for(i = 0; i < Integrator.no_timescales; i++) {
+    if(Integrator.type[i] == OMF4 || Integrator.type[i] == FG4) break;
+  }
+  if(i < Integrator.no_timescales) {
+    /* the fourth order schemes do not merge the momentum updates at */
+    /* the ends of the steps with the next lower timescale, so all   */
+    /* timescales are integrated with the same kind of function      */
+    for(i = 0; i < Integrator.no_timescales; i++) {
+      init_scheme(i);
+      Integrator.integrate[i] = &integrate_scheme;
+    }
+  }
+  else if(Integrator.type[Integrator.no_timescales-1] == MN2p) {
     for(i = 0; i < Integrator.no_timescales; i++) {
       Integrator.type[i] = MN2p;
       Integrator.integrate[i] = &integrate_2mnp;
@@ -266,3 +304,182 @@ void integrate_leap_frog(const double tau, const int S, const int halfstep) {
     update_momenta(itgr->mnls_per_ts[0], 0.5*eps, itgr->no_mnls_per_ts[0], &itgr->hf);
   }
 }
+
+/* Omelyan, Mryglod and Folk, Comput. Phys. Commun. 151 (2003) 272 */
+#define OMF4_R1 0.08398315262876693
+#define OMF4_R2 0.2539785108410595
+#define OMF4_R3 0.6822365335719091
+#define OMF4_R4 -0.03230286765269967
+
+static void add_stage(scheme * const s, const int kind, const double c, const double c2) {
+  s->kind[s->no_stages] = kind;
+  s->c[s->no_stages] = c;
+  s->c2[s->no_stages] = c2;
+  s->no_stages++;
+}
+
+static void init_scheme(const int S) {
+  scheme * s = &schemes[S];
+  const double l = Integrator.lambda[S];
+
+  s->no_stages = 0;
+  s->lambda = l;
+  if(Integrator.type[S] == LEAPFROG) {
+    add_stage(s, STAGE_P, 0.5, 0.);
+    add_stage(s, STAGE_U, 1., 0.);
+    add_stage(s, STAGE_P, 0.5, 0.);
+  }
+  else if(Integrator.type[S] == MN2p) {
+    add_stage(s, STAGE_U, l, 0.);
+    add_stage(s, STAGE_P, 0.5, 0.);
+    add_stage(s, STAGE_U, 1.-2.*l, 0.);
+    add_stage(s, STAGE_P, 0.5, 0.);
+    add_stage(s, STAGE_U, l, 0.);
+  }
+  else if(Integrator.type[S] == OMF4) {
+    add_stage(s, STAGE_P, OMF4_R1, 0.);
+    add_stage(s, STAGE_U, OMF4_R2, 0.);
+    add_stage(s, STAGE_P, OMF4_R3, 0.);
+    add_stage(s, STAGE_U, OMF4_R4, 0.);
+    add_stage(s, STAGE_P, 0.5-OMF4_R1-OMF4_R3, 0.);
+    add_stage(s, STAGE_U, 1.-2.*(OMF4_R2+OMF4_R4), 0.);
+    add_stage(s, STAGE_P, 0.5-OMF4_R1-OMF4_R3, 0.);
+    add_stage(s, STAGE_U, OMF4_R4, 0.);
+    add_stage(s, STAGE_P, OMF4_R3, 0.);
+    add_stage(s, STAGE_U, OMF4_R2, 0.);
+    add_stage(s, STAGE_P, OMF4_R1, 0.);
+  }
+  else if(Integrator.type[S] == FG4) {
+    /* the force gradient term eps^3/72 {S,{S,T}} is approximated  */
+    /* by the force at the gauge field moved by eps^2/24 along the */
+    /* force (Yin and Mawhinney)                                   */
+    add_stage(s, STAGE_P, 1./6., 0.);
+    add_stage(s, STAGE_U, 0.5, 0.);
+    add_stage(s, STAGE_FG, 2./3., 1./24.);
+    add_stage(s, STAGE_U, 0.5, 0.);
+    add_stage(s, STAGE_P, 1./6., 0.);
+  }
+  else {
+    add_stage(s, STAGE_P, l, 0.);
+    add_stage(s, STAGE_U, 0.5, 0.);
+    add_stage(s, STAGE_P, 1.-2.*l, 0.);
+    add_stage(s, STAGE_U, 0.5, 0.);
+    add_stage(s, STAGE_P, l, 0.);
+  }
+  return;
+}
+
+static su3 * fg_gauge_ = NULL;
+static su3adj * fg_momenta_ = NULL;
+static su3adj ** fg_momenta = NULL;
+
+/* momentum update with the forces of timescale S taken at the gauge */
+/* field exp(-delta F) U, the gauge field is restored afterwards     */
+static void update_momenta_fg(const int S, const double step, const double delta) {
+  integrator * itgr = &Integrator;
+  hamiltonian_field_t hf = itgr->hf;
+  const int VR = VOLUMEPLUSRAND + g_dbw2rand;
+
+  if(fg_gauge_ == NULL) {
+    fg_gauge_ = (su3*)calloc(4*VR, sizeof(su3));
+    fg_momenta_ = (su3adj*)calloc(4*VOLUME, sizeof(su3adj));
+    fg_momenta = (su3adj**)calloc(VOLUME, sizeof(su3adj*));
+    if(fg_gauge_ == NULL || fg_momenta_ == NULL || fg_momenta == NULL) {
+      fprintf(stderr, "Not enough memory for the force gradient integrator! Aborting...\n");
+      exit(-1);
+    }
+    for(int i = 0; i < VOLUME; i++) {
+      fg_momenta[i] = fg_momenta_ + 4*i;
+    }
+  }
+  integrator_tuning_pause(1);
+
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < VR; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      _su3_assign(fg_gauge_[4*i+mu], hf.gaugefield[i][mu]);
+    }
+  }
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < VOLUME; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      _zero_su3adj(fg_momenta[i][mu]);
+    }
+  }
+  /* fg_momenta = -F, to move the gauge field along the force.   */
+  /* This is no force of the trajectory, so it is neither counted */
+  /* in the monomial cost nor stored in the chrono histories      */
+  monomial_cost_pause(1);
+  chrono_pause(1);
+  hf.momenta = fg_momenta;
+  update_momenta(itgr->mnls_per_ts[S], 1., itgr->no_mnls_per_ts[S], &hf);
+  chrono_pause(0);
+  monomial_cost_pause(0);
+  update_gauge(delta, &hf);
+
+  update_momenta(itgr->mnls_per_ts[S], step, itgr->no_mnls_per_ts[S], &itgr->hf);
+
+  /* the boundaries are restored as well, no exchange needed */
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < VR; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      _su3_assign(hf.gaugefield[i][mu], fg_gauge_[4*i+mu]);
+    }
+  }
+  itgr->hf.update_gauge_copy = 1;
+  g_update_gauge_copy = 1;
+  itgr->hf.update_gauge_energy = 1;
+  g_update_gauge_energy = 1;
+  itgr->hf.update_rectangle_energy = 1;
+  g_update_rectangle_energy = 1;
+
+  integrator_tuning_pause(0);
+  return;
+}
+
+/* Integrates tau with n_int[S] steps of schemes[S], where the      */
+/* momentum updates at the end of one step and at the beginning of */
+/* the next are merged. halfstep is not used.                       */
+void integrate_scheme(const double tau, const int S, const int halfstep) {
+  integrator * itgr = &Integrator;
+  const scheme * const s = &schemes[S];
+  const double eps = tau/((double)itgr->n_int[S]);
+  double kick = 0.;
+
+  /* lambda may have been changed by the integrator tuning */
+  if(s->lambda != itgr->lambda[S]) {
+    init_scheme(S);
+  }
+
+  for(int i = 0; i < itgr->n_int[S]; i++) {
+    for(int j = 0; j < s->no_stages; j++) {
+      if(s->kind[j] == STAGE_P) {
+        kick += s->c[j];
+        continue;
+      }
+      if(kick != 0.) {
+        update_momenta(itgr->mnls_per_ts[S], kick*eps, itgr->no_mnls_per_ts[S], &itgr->hf);
+        kick = 0.;
+      }
+      if(s->kind[j] == STAGE_FG) {
+        update_momenta_fg(S, s->c[j]*eps, s->c2[j]*eps*eps);
+      }
+      else if(S == 0) {
+        update_gauge(s->c[j]*eps, &itgr->hf);
+      }
+      else {
+        itgr->integrate[S-1](s->c[j]*eps, S-1, 0);
+      }
+    }
+  }
+  if(kick != 0.) {
+    update_momenta(itgr->mnls_per_ts[S], kick*eps, itgr->no_mnls_per_ts[S], &itgr->hf);
+  }
+  return;
+}
@@ -30,6 +30,8 @@
 #define IMPRLEAPFROG 5
 #define MN2 6
 #define MN2p 7
+#define OMF4 8
+#define FG4 9
 
 typedef void (*integratefk)(const double, const int, const int);
 
@@ -52,6 +54,10 @@ typedef struct {
   int no_mnls_per_ts[10];
   /* function pointers to integration scheme functions */
   integratefk integrate[10];
+  /* tuning of n_int and lambda, see integrator_tuning.h */
+  int tune_trajectories;
+  int tune_apply;
+  double tune_acceptance;
 } integrator;
 
 extern integrator Integrator;
@@ -0,0 +1,385 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Tuning of the integrator from measured forces, see integrator_tuning.h
+ *
+ * For a second order scheme with step size eps the shadow Hamiltonian
+ * of one timescale is H + eps^2 (a {S,{S,T}} + b {T,{S,T}}), with
+ *
+ *   a = (6 lambda^2 - 6 lambda + 1)/12,  b = (1 - 6 lambda)/24
+ *
+ * for the 2MN scheme (for 2MNPOSITION S and T are exchanged and the
+ * leap frog is 2MN with lambda = 1/2). The Poisson brackets are not
+ * computed, but estimated from quantities available in update_momenta
+ * at no extra cost:
+ *
+ *   {S,{S,T}} ~ <|F|^2>
+ *   {T,{S,T}} ~ rms(dF/dt) * rms(p)
+ *
+ * with the mean over all links and force computations of a timescale,
+ * where dF/dt is taken from two successive forces of the timescale and
+ * the molecular dynamics time between them. The variance of dH is then
+ * modelled as
+ *
+ *   <dH^2> = kappa sum_i (eps_i^2 E_i)^2,  E_i^2 = a^2 B1_i^2 + b^2 B2_i^2
+ *
+ * and kappa is fixed by the <dH^2> measured with the current steps.
+ * The acceptance follows from <dH^2> with erfc(sqrt(<dH^2>/8)).
+ *
+ * For the fourth order schemes OMF4 and FG4 the same E_i (with
+ * coefficient one) is taken with eps_i^4 instead of eps_i^2. This is a
+ * rough guess only, the fourth order Poisson brackets are not estimated.
+ *
+ * The proposal takes for every 2MN timescale the lambda minimising E_i
+ * and then adds integration steps where they reduce <dH^2> most per
+ * additional time spent in force computations (measured per timescale
+ * with the monomial cost accounting), until the target acceptance is
+ * reached, and removes again steps not needed.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "su3adj.h"
+#include "monomial.h"
+#include "integrator.h"
+#include "integrator_tuning.h"
+
+#define MAX_TUNE_STEPS 100
+/* the timescales of the integrator, as in integrator.h */
+#define MAX_TIMESCALES 10
+
+static int tuning = 0, paused = 0, no_traj = 0;
+static double md_time = 0., sum_dh2 = 0.;
+/* local sums per timescale */
+static double f2[MAX_TIMESCALES], df2[MAX_TIMESCALES], p2[MAX_TIMESCALES];
+static double links_f[MAX_TIMESCALES], links_df[MAX_TIMESCALES];
+static double deri_time[MAX_TIMESCALES], evals[MAX_TIMESCALES];
+/* last force of every timescale */
+static double last_time[MAX_TIMESCALES];
+static int last_valid[MAX_TIMESCALES];
+static su3adj * last_force[MAX_TIMESCALES];
+
+static void integrator_tuning_propose();
+
+void integrator_tuning_begin() {
+  if(no_traj < Integrator.tune_trajectories) {
+    tuning = 1;
+    for(int i = 0; i < MAX_TIMESCALES; i++) {
+      last_valid[i] = 0;
+    }
+  }
+  return;
+}
+
+void integrator_tuning_pause(const int pause) {
+  paused = pause;
+  return;
+}
+
+void integrator_tuning_gauge(const double step) {
+  if(tuning && !paused) md_time += step;
+  return;
+}
+
+void integrator_tuning_force(const int ts, hamiltonian_field_t * const hf) {
+  double sf = 0., sd = 0., sp = 0., dt = 0.;
+
+  if(!tuning || paused || ts < 0 || ts >= Integrator.no_timescales) return;
+  if(last_force[ts] == NULL) {
+    if((last_force[ts] = (su3adj*)calloc(4*VOLUME, sizeof(su3adj))) == NULL) {
+      fprintf(stderr, "Not enough memory for the integrator tuning! Aborting...\n");
+      exit(-1);
+    }
+  }
+  dt = fabs(md_time - last_time[ts]);
+
+#ifdef OMP
+#pragma omp parallel for reduction(+: sf, sd, sp)
+#endif
+  for(int i = 0; i < VOLUME; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      su3adj * const l = &last_force[ts][4*i+mu];
+      su3adj d = hf->derivative[i][mu];
+      _sub_su3adj(d, *l);
+      sf += _su3adj_square_norm(hf->derivative[i][mu]);
+      sd += _su3adj_square_norm(d);
+      sp += _su3adj_square_norm(hf->momenta[i][mu]);
+      *l = hf->derivative[i][mu];
+    }
+  }
+
+  f2[ts] += sf;
+  p2[ts] += sp;
+  links_f[ts] += 4.*VOLUME;
+  /* two forces at the same time carry no information on dF/dt */
+  if(last_valid[ts] && dt > 1.e-10*Integrator.tau) {
+    df2[ts] += sd/(dt*dt);
+    links_df[ts] += 4.*VOLUME;
+  }
+  last_time[ts] = md_time;
+  last_valid[ts] = 1;
+  return;
+}
+
+void integrator_tuning_end(const double dh) {
+  if(!tuning) return;
+  sum_dh2 += dh*dh;
+  for(int i = 0; i < Integrator.no_timescales; i++) {
+    for(int j = 0; j < Integrator.no_mnls_per_ts[i]; j++) {
+      deri_time[i] += monomial_list[ Integrator.mnls_per_ts[i][j] ].deri_time;
+    }
+    evals[i] += monomial_list[ Integrator.mnls_per_ts[i][0] ].no_derivatives;
+  }
+  tuning = 0;
+  no_traj++;
+  if(no_traj == Integrator.tune_trajectories) {
+    integrator_tuning_propose();
+  }
+  return;
+}
+
+/* E of the shadow Hamiltonian for lambda on a timescale of type */
+static double shadow_coefficient(const int type, const double lambda,
+                                 const double b1, const double b2) {
+  const double l = (type == LEAPFROG) ? 0.5 : lambda;
+  const double a = (6.*l*l - 6.*l + 1.)/12., b = (1. - 6.*l)/24.;
+  if(type == OMF4 || type == FG4) {
+    return(sqrt(b1*b1 + b2*b2));
+  }
+  if(type == MN2p) {
+    return(sqrt(a*a*b2*b2 + b*b*b1*b1));
+  }
+  return(sqrt(a*a*b1*b1 + b*b*b2*b2));
+}
+
+/* golden section search for the minimum in [0,1/2] */
+static double optimal_lambda(const int type, const double b1, const double b2) {
+  const double g = 0.5*(sqrt(5.) - 1.);
+  double l0 = 0., l1 = 0.5, x0, x1;
+
+  for(int i = 0; i < 60; i++) {
+    x0 = l1 - g*(l1 - l0);
+    x1 = l0 + g*(l1 - l0);
+    if(shadow_coefficient(type, x0, b1, b2) < shadow_coefficient(type, x1, b1, b2)) {
+      l1 = x1;
+    }
+    else {
+      l0 = x0;
+    }
+  }
+  return(0.5*(l0 + l1));
+}
+
+/* steps per trajectory and force computations per trajectory of  */
+/* every timescale for the integration steps n                    */
+static void integrator_steps(const int * const n, double * const steps, double * const forces) {
+  const int N = Integrator.no_timescales;
+
+  steps[N-1] = n[N-1];
+  for(int i = N-2; i > -1; i--) {
+    /* number of integrations of timescale i per step of i+1 */
+    double m = 2.;
+    if(Integrator.type[i+1] == LEAPFROG) m = 1.;
+    else if(Integrator.type[i+1] == MN2p) m = 3.;
+    else if(Integrator.type[i+1] == OMF4) m = 5.;
+    steps[i] = n[i]*m*steps[i+1];
+  }
+  for(int i = 0; i < N; i++) {
+    /* force computations per step */
+    double f = 2.;
+    if(Integrator.type[i] == LEAPFROG) f = 1.;
+    else if(Integrator.type[i] == OMF4) f = 5.;
+    else if(Integrator.type[i] == FG4) f = 3.;
+    forces[i] = f*steps[i];
+  }
+  return;
+}
+
+static double shadow_variance(const int * const n, const double * const lambda,
+                              const double * const b1, const double * const b2) {
+  double steps[MAX_TIMESCALES], forces[MAX_TIMESCALES], v = 0.;
+
+  integrator_steps(n, steps, forces);
+  for(int i = 0; i < Integrator.no_timescales; i++) {
+    const double eps = Integrator.tau/steps[i];
+    const double order = (Integrator.type[i] == OMF4 || Integrator.type[i] == FG4) ? 4. : 2.;
+    const double e = pow(eps, order)*shadow_coefficient(Integrator.type[i], lambda[i], b1[i], b2[i]);
+    v += e*e;
+  }
+  return(v);
+}
+
+static double force_cost(const int * const n, const double * const cost) {
+  double steps[MAX_TIMESCALES], forces[MAX_TIMESCALES], c = 0.;
+
+  integrator_steps(n, steps, forces);
+  for(int i = 0; i < Integrator.no_timescales; i++) {
+    c += forces[i]*cost[i];
+  }
+  return(c);
+}
+
+static double acceptance(const double dh2) {
+  return(erfc(sqrt(dh2/8.)));
+}
+
+static const char * type_name(const int type) {
+  if(type == LEAPFROG) return("LEAPFROG");
+  if(type == MN2p) return("2MNPOSITION");
+  if(type == OMF4) return("OMF4");
+  if(type == FG4) return("FORCEGRADIENT");
+  return("2MN");
+}
+
+static void integrator_tuning_propose() {
+  const int N = (Integrator.no_timescales < MAX_TIMESCALES) ? Integrator.no_timescales : MAX_TIMESCALES;
+  double b1[MAX_TIMESCALES], b2[MAX_TIMESCALES], cost[MAX_TIMESCALES], lambda[MAX_TIMESCALES];
+  double kappa, v0, c0;
+  int n[MAX_TIMESCALES], changed;
+  FILE * ofs;
+
+#ifdef MPI
+  {
+    /* all timescales, the unused ones are zero */
+    double buf[5*MAX_TIMESCALES], sum[5*MAX_TIMESCALES];
+    for(int i = 0; i < MAX_TIMESCALES; i++) {
+      buf[5*i] = f2[i]; buf[5*i+1] = df2[i]; buf[5*i+2] = p2[i];
+      buf[5*i+3] = links_f[i]; buf[5*i+4] = links_df[i];
+    }
+    MPI_Allreduce(buf, sum, 5*MAX_TIMESCALES, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    for(int i = 0; i < MAX_TIMESCALES; i++) {
+      f2[i] = sum[5*i]; df2[i] = sum[5*i+1]; p2[i] = sum[5*i+2];
+      links_f[i] = sum[5*i+3]; links_df[i] = sum[5*i+4];
+    }
+    /* the same times on all processes, such that they all agree */
+    for(int i = 0; i < MAX_TIMESCALES; i++) buf[i] = deri_time[i];
+    MPI_Allreduce(buf, deri_time, MAX_TIMESCALES, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  }
+#endif
+
+  for(int i = 0; i < N; i++) {
+    b1[i] = (links_f[i] > 0.) ? f2[i]/links_f[i] : 0.;
+    b2[i] = (links_df[i] > 0. && links_f[i] > 0.) ? sqrt(df2[i]/links_df[i])*sqrt(p2[i]/links_f[i]) : 0.;
+    /* a lower bound, such that every step has a price */
+    cost[i] = (evals[i] > 0. && deri_time[i] > 1.e-9*evals[i]) ? deri_time[i]/evals[i] : 1.e-9;
+    lambda[i] = (Integrator.type[i] == MN2 || Integrator.type[i] == MN2p) ?
+      optimal_lambda(Integrator.type[i], b1[i], b2[i]) : Integrator.lambda[i];
+    n[i] = Integrator.n_int[i];
+  }
+
+  v0 = shadow_variance(Integrator.n_int, Integrator.lambda, b1, b2);
+  if(v0 <= 0. || sum_dh2 <= 0.) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "Warning: no forces or no dH measured, the integrator could not be tuned\n");
+    }
+    return;
+  }
+  kappa = sum_dh2/no_traj/v0;
+
+  /* add steps where they help most per time */
+  for(int i = 0; i < N; i++) {
+    n[i] = 1;
+  }
+  while(acceptance(kappa*shadow_variance(n, lambda, b1, b2)) < Integrator.tune_acceptance) {
+    double best_gain = -1.;
+    int best = -1;
+    v0 = shadow_variance(n, lambda, b1, b2);
+    c0 = force_cost(n, cost);
+    for(int i = 0; i < N; i++) {
+      if(n[i] >= MAX_TUNE_STEPS) continue;
+      n[i]++;
+      const double gain = (v0 - shadow_variance(n, lambda, b1, b2))/(force_cost(n, cost) - c0);
+      n[i]--;
+      if(gain > best_gain) {
+        best_gain = gain;
+        best = i;
+      }
+    }
+    if(best < 0) break;
+    n[best]++;
+  }
+  /* and remove the ones not needed in the end */
+  do {
+    changed = 0;
+    for(int i = N-1; i > -1; i--) {
+      if(n[i] < 2) continue;
+      n[i]--;
+      if(acceptance(kappa*shadow_variance(n, lambda, b1, b2)) >= Integrator.tune_acceptance) {
+        changed = 1;
+      }
+      else {
+        n[i]++;
+      }
+    }
+  } while(changed);
+
+  if(g_proc_id == 0) {
+    printf("# Integrator tuning after %d trajectories, <dH^2> = %e\n", no_traj, sum_dh2/no_traj);
+    printf("# %2s %12s %12s %12s %14s %6s %8s %6s %8s\n", "ts", "type", "<|F|^2>", "|dF/dt||p|",
+           "time/force[s]", "steps", "lambda", "steps", "lambda");
+    for(int i = 0; i < N; i++) {
+      printf("# %2d %12s %12.4e %12.4e %14.4e %6d %8.5f %6d %8.5f\n", i, type_name(Integrator.type[i]),
+             b1[i], b2[i], cost[i], Integrator.n_int[i], Integrator.lambda[i], n[i], lambda[i]);
+    }
+    printf("# predicted acceptance %f -> %f, force time per trajectory %e s -> %e s\n",
+           acceptance(sum_dh2/no_traj), acceptance(kappa*shadow_variance(n, lambda, b1, b2)),
+           force_cost(Integrator.n_int, cost), force_cost(n, cost));
+
+    if((ofs = fopen("integrator.proposal", "w")) == NULL) {
+      fprintf(stderr, "Could not open file integrator.proposal for writing\n");
+    }
+    else {
+      fprintf(ofs, "BeginIntegrator\n");
+      for(int i = 0; i < N; i++) {
+        fprintf(ofs, "  Type%d = %s\n", i, type_name(Integrator.type[i]));
+        fprintf(ofs, "  IntegrationSteps%d = %d\n", i, n[i]);
+        if(Integrator.type[i] == MN2 || Integrator.type[i] == MN2p) {
+          fprintf(ofs, "  Lambda%d = %f\n", i, lambda[i]);
+        }
+      }
+      fprintf(ofs, "  Tau = %f\n", Integrator.tau);
+      fprintf(ofs, "  NumberOfTimescales = %d\n", N);
+      fprintf(ofs, "EndIntegrator\n");
+      fclose(ofs);
+    }
+    fflush(stdout);
+  }
+
+  if(Integrator.tune_apply) {
+    for(int i = 0; i < N; i++) {
+      Integrator.n_int[i] = n[i];
+      Integrator.lambda[i] = lambda[i];
+    }
+    if(g_proc_id == 0) {
+      printf("# The proposed integration steps are used from now on\n");
+    }
+  }
+  return;
+}
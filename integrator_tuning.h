@@ -0,0 +1,45 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _INTEGRATOR_TUNING_H
+#define _INTEGRATOR_TUNING_H
+
+#include "hamiltonian_field.h"
+
+/* Tuning of the integration steps and of the 2MN lambda parameters,  */
+/* switched on with TuneTrajectories in the integrator input. During  */
+/* the first TuneTrajectories trajectories the forces of every        */
+/* timescale and their cost are measured, then new IntegrationSteps   */
+/* and Lambda values are proposed and written to integrator.proposal, */
+/* with TuneApply = yes they are used for the following trajectories. */
+
+/* to be called at the beginning of every trajectory */
+void integrator_tuning_begin();
+/* to be called for every gauge field update with its step size */
+void integrator_tuning_gauge(const double step);
+/* with pause = 1 the following gauge updates and forces are not */
+/* measured, until called again with pause = 0                   */
+void integrator_tuning_pause(const int pause);
+/* to be called with the summed force of timescale ts */
+void integrator_tuning_force(const int ts, hamiltonian_field_t * const hf);
+/* to be called at the end of every trajectory with its dH, */
+/* collective under MPI                                      */
+void integrator_tuning_end(const double dh);
+
+#endif
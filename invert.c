@@ -57,9 +57,11 @@
 #include <io/utils.h>
 #include "read_input.h"
 #include "mpi_init.h"
+#include "tuning.h"
 #include "sighandler.h"
 #include "boundary.h"
 #include "solver/solver.h"
+#include "solver/solver_field.h"
 #include "init_gauge_field.h"
 #include "init_geometry_indices.h"
 #include "init_spinor_field.h"
@@ -112,7 +114,7 @@ int check_geometry();
 int main(int argc, char *argv[])
 {
   FILE *parameterfile = NULL;
-  int c, j, i, ix = 0, isample = 0, op_id = 0;
+  int c, j, i, ix = 0, isample = 0, op_id = 0, use_32 = 0;
   char * filename = NULL;
   char datafilename[50];
   char parameterfilename[50];
@@ -225,6 +227,9 @@ int main(int argc, char *argv[])
 
   tmlqcd_mpi_init(argc, argv);
 
+  /* the fastest settings found by benchmark on this machine */
+  read_tuning_file(tuning_filename);
+
   g_dbw2rand = 0;
 
   /* starts the single and double precision random number */
@@ -329,6 +334,30 @@ int main(int argc, char *argv[])
 #  endif
 #endif
 
+  /* single precision gauge copy for the mixed precision CG */
+  use_32 = g_sloppy_precision_flag;
+  for(j = 0; j < no_operators; j++) {
+    if(operator_list[j].solver == MIXEDCG) use_32 = 1;
+  }
+  if (use_32) {
+#ifdef _USE_HALFSPINOR
+    if (g_sloppy_precision_flag != 1) {
+      j = init_dirac_halfspinor32();
+      if (j != 0)
+      {
+        fprintf(stderr, "Not enough memory for 32-bit halffield! Aborting...\n");
+        exit(-1);
+      }
+    }
+#endif
+    j = init_gauge_field_32(VOLUMEPLUSRAND);
+    if (j != 0)
+    {
+      fprintf(stderr, "Not enough memory for 32-bit gauge field copy! Aborting...\n");
+      exit(-1);
+    }
+  }
+
   for (j = 0; j < Nmeas; j++) {
     sprintf(conf_filename, "%s.%.4d", gauge_input_filename, nstore);
     if (g_cart_id == 0) {
@@ -506,16 +535,23 @@ int main(int argc, char *argv[])
         }
       }
 
-      for(isample = 0; isample < no_samples; isample++) {
-        for (ix = index_start; ix < index_end; ix++) {
-          if (g_cart_id == 0) {
-            fprintf(stdout, "#\n"); /*Indicate starting of new index*/
+      if(operator_list[op_id].solver == BCG) {
+        /* all sources of this operator in one block solve, the */
+        /* operator is applied to all of them with Hopping_Matrix_nrhs */
+        op_invert_block(op_id, index_start, index_end, nstore, read_source_flag, source_location);
+      }
+      else {
+        for(isample = 0; isample < no_samples; isample++) {
+          for (ix = index_start; ix < index_end; ix++) {
+            if (g_cart_id == 0) {
+              fprintf(stdout, "#\n"); /*Indicate starting of new index*/
+            }
+            /* we use g_spinor_field[0-7] for sources and props for the moment */
+            /* 0-3 in case of 1 flavour  */
+            /* 0-7 in case of 2 flavours */
+            prepare_source(nstore, isample, ix, op_id, read_source_flag, source_location);
+            operator_list[op_id].inverter(op_id, index_start);
           }
-          /* we use g_spinor_field[0-7] for sources and props for the moment */
-          /* 0-3 in case of 1 flavour  */
-          /* 0-7 in case of 2 flavours */
-          prepare_source(nstore, isample, ix, op_id, read_source_flag, source_location);
-          operator_list[op_id].inverter(op_id, index_start);
         }
       }
 
@@ -534,15 +570,26 @@ int main(int argc, char *argv[])
     nstore += Nsave;
   }
 
+  if (g_proc_id == 0 && g_debug_level > 0) {
+    print_solver_field_pool_stats();
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+    print_xchange_halffield_stats();
+#endif
+  }
+
 #ifdef MPI
   MPI_Finalize();
 #endif
 #ifdef OMP
   free_omp_accumulators();
 #endif
+  free_solver_field_pool();
   free_blocks();
   free_dfl_subspace();
   free_gauge_field();
+  if (use_32) {
+    free_gauge_field_32();
+  }
   free_geometry_indices();
   free_spinor_field();
   free_moment_field();
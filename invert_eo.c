@@ -41,7 +41,9 @@
 #include"global.h"
 #include"linalg_eo.h"
 #include"tm_operators.h"
+#include"tm_operators_32.h"
 #include"Hopping_Matrix.h"
+#include"Hopping_Matrix_nrhs.h"
 #include"D_psi.h"
 #include"linsolve.h"
 #include"gamma.h"
@@ -50,6 +52,7 @@
 #include"xchange.h"
 #include"solver/poly_precon.h"
 #include"solver/dfl_projector.h"
+#include"solver/solver_field.h"
 #include"invert_eo.h"
 #include "solver/dirac_operator_eigenvectors.h"
 
@@ -174,7 +177,29 @@ int invert_eo(spinor * const Even_new, spinor * const Odd_new,
       gamma5(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI], VOLUME/2);
       if(g_proc_id == 0) {printf("# Using Mixed Precision CG!\n"); fflush(stdout);}
       iter = mixed_cg_her(Odd_new, g_spinor_field[DUM_DERI], max_iter, precision, rel_prec, 
-			  VOLUME/2, &Qtm_pm_psi);
+			  VOLUME/2, &Qtm_pm_psi, &Qtm_pm_psi_32);
+      Qtm_minus_psi(Odd_new, Odd_new);
+    }
+    else if(solver_flag == BCG) {
+      /* block CG with a single right hand side is plain CG */
+      spinor * bsrc[1], * bsol[1];
+      gamma5(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI], VOLUME/2);
+      if(g_proc_id == 0) {printf("# Using block CG with one right hand side!\n"); fflush(stdout);}
+      bsrc[0] = g_spinor_field[DUM_DERI];
+      bsol[0] = Odd_new;
+      iter = bcg_her(bsol, bsrc, 1, max_iter, precision, rel_prec, VOLUME/2, &Qtm_pm_psi_nrhs);
+      Qtm_minus_psi(Odd_new, Odd_new);
+    }
+    else if(solver_flag == CGCG) {
+      /* Here we invert the hermitean operator squared */
+      gamma5(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI], VOLUME/2);
+      if(g_proc_id == 0) {
+	printf("# Using Chronopoulos-Gear CG!\n"); 
+	printf("# mu = %f, kappa = %f\n", g_mu/2./g_kappa, g_kappa);
+	fflush(stdout);
+      }
+      iter = cgcg_her(Odd_new, g_spinor_field[DUM_DERI], max_iter, precision, rel_prec, 
+		      VOLUME/2, &Qtm_pm_psi);
       Qtm_minus_psi(Odd_new, Odd_new);
     }
     else if(solver_flag == CG) {
@@ -431,3 +456,58 @@ int invert_eo(spinor * const Even_new, spinor * const Odd_new,
   return(iter);
 }
 
+
+
+/* invert_eo_block solves nrhs even/odd preconditioned tm systems
+ * at once with the block CG solver bcg_her, the operator is applied
+ * to the whole block with Qtm_pm_psi_nrhs and Hopping_Matrix_nrhs.
+ * Even[j], Odd[j] are the sources, Even_new[j], Odd_new[j] the
+ * initial guesses on input and the solutions on output.
+ * All systems share g_mu and g_kappa.
+ *
+ * returns the number of block iterations or -1 if the solver
+ * did not converge
+ */
+
+int invert_eo_block(spinor ** const Even_new, spinor ** const Odd_new,
+                    spinor ** const Even, spinor ** const Odd,
+                    const int nrhs, const double precision, const int max_iter,
+                    const int rel_prec) {
+  int iter = 0;
+  spinor ** solver_field = NULL;
+
+  init_solver_field(&solver_field, VOLUMEPLUSRAND/2, nrhs);
+
+  if(g_proc_id == 0) {
+    printf("# Using even/odd preconditioning!\n");
+    printf("# Using block CG with %d right hand sides!\n", nrhs);
+    printf("# mu = %f, kappa = %f\n", g_mu/2./g_kappa, g_kappa);
+    fflush(stdout);
+  }
+
+  /* the hopping matrices are applied to all sources at once */
+  for(int j = 0; j < nrhs; j++) {
+    assign_mul_one_pm_imu_inv(Even_new[j], Even[j], +1., VOLUME/2);
+  }
+  Hopping_Matrix_nrhs_fields(OE, solver_field, Even_new, nrhs);
+  for(int j = 0; j < nrhs; j++) {
+    /* The sign is plus, since in Hopping_Matrix */
+    /* the minus is missing                      */
+    assign_mul_add_r(solver_field[j], +1., Odd[j], VOLUME/2);
+    gamma5(solver_field[j], solver_field[j], VOLUME/2);
+  }
+
+  iter = bcg_her(Odd_new, solver_field, nrhs, max_iter, precision, rel_prec,
+                 VOLUME/2, &Qtm_pm_psi_nrhs);
+
+  Qtm_minus_psi_nrhs(Odd_new, Odd_new, nrhs);
+  /* Reconstruct the even sites, solver_field is free again */
+  Hopping_Matrix_nrhs_fields(EO, solver_field, Odd_new, nrhs);
+  for(int j = 0; j < nrhs; j++) {
+    mul_one_pm_imu_inv(solver_field[j], +1., VOLUME/2);
+    assign_add_mul_r(Even_new[j], solver_field[j], +1., VOLUME/2);
+  }
+
+  finalize_solver(solver_field, nrhs);
+  return(iter);
+}
@@ -35,4 +35,9 @@ int invert_eo(spinor * const Even_new, spinor * const Odd_new,
         const int no_extra_masses, double * const extra_masses,
         const int id );
 
+int invert_eo_block(spinor ** const Even_new, spinor ** const Odd_new,
+                    spinor ** const Even, spinor ** const Odd,
+                    const int nrhs, const double precision, const int max_iter,
+                    const int rel_prec);
+
 #endif
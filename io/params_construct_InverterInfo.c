@@ -71,6 +71,12 @@ paramsInverterInfo *construct_paramsInverterInfo(double const epssq, const int i
   case CGS:
     strcpy(info->inverter, "CGS");
     break;
+  case BCG:
+    strcpy(info->inverter, "BCG");
+    break;
+  case CGCG:
+    strcpy(info->inverter, "CGCG");
+    break;
   default:
     strcpy(info->inverter, "other");
     break;
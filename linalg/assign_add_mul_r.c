@@ -87,6 +87,39 @@ void assign_add_mul_r(spinor * const P, spinor * const Q, const double c, const
 #endif
 }
 
+#elif (defined AVX2)
+#include "avx.h"
+
+/*   (*R) = (*R) + c(*S)        c is a real constant   */
+
+void assign_add_mul_r(spinor * const R, spinor * const S, const double c, const int N) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _avx_vec x, y, k;
+  double *s, *r;
+
+  k = _avx_splat(c);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int i = 0; i < N; i++) {
+    s = (double*)(S + i);
+    r = (double*)(R + i);
+    for(int j = 0; j < 24; j += _avx_nd) {
+      x = _avx_load(r + j);
+      y = _avx_load(s + j);
+      _avx_store(r + j, _avx_fmadd(k, y, x));
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
+
 #elif (defined BGQ && defined XLC)
 
 void assign_add_mul_r(spinor * const R, spinor * const S, const double c, const int N) {
@@ -79,6 +79,39 @@ void assign_mul_add_r(spinor * const R, const double c, const spinor * const S,
 #endif  
 }
 
+#elif (defined AVX2)
+#include "avx.h"
+
+/*   (*R) = c*(*R) + (*S)        c is a real constant   */
+
+void assign_mul_add_r(spinor * const R, const double c, const spinor * const S, const int N) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _avx_vec x, y, k;
+  double *s, *r;
+
+  k = _avx_splat(c);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int i = 0; i < N; i++) {
+    s = (double*)(S + i);
+    r = (double*)(R + i);
+    for(int j = 0; j < 24; j += _avx_nd) {
+      x = _avx_load(r + j);
+      y = _avx_load(s + j);
+      _avx_store(r + j, _avx_fmadd(k, x, y));
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
+
 #elif (defined BGQ && defined XLC)
 
 void assign_mul_add_r(spinor * const R, const double c, const spinor * const S, const int N) {
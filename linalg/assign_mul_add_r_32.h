@@ -0,0 +1,28 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _ASSIGN_MUL_ADD_R_32_H
+#define _ASSIGN_MUL_ADD_R_32_H
+
+#include "su3.h"
+
+/* (*R) = c*(*R) + (*S), c is a real constant, single precision */
+void assign_mul_add_r_32(spinor32 * const R, const float c, spinor32 * const S, const int N);
+
+#endif
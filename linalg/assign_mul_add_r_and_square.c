@@ -30,9 +30,49 @@
 #endif
 #include "su3.h"
 #include "assign_mul_add_r_and_square.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+
+#if (defined _REPRODUCIBLE_REDUCTIONS)
+
+double assign_mul_add_r_and_square(spinor * const R, const double c, const spinor * const S, 
+				   const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  double *r;
+  const double *s;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    r = (double*)(R + ix);
+    s = (const double*)(S + ix);
+    for(int j = 0; j < 24; j++) {
+      r[j] = c * r[j] + s[j];
+    }
+    repro_sum_add(&lacc, repro_site_dot(r, r, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
 
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
 
-#if (defined BGQ && defined XLC)
+#elif (defined BGQ && defined XLC)
 
 double assign_mul_add_r_and_square(spinor * const R, const double c, spinor * const S, 
 				   const int N, const int parallel) {
@@ -128,6 +168,58 @@ double assign_mul_add_r_and_square(spinor * const R, const double c, spinor * co
   return(res);
 }
 
+#elif (defined AVX2)
+#include "avx.h"
+
+/* R inoutput , c,S input*/
+/*   (*R) = c*(*R) + (*S)        c is a real constant   */
+
+double assign_mul_add_r_and_square(spinor * const R, const double c, const spinor * const S, 
+				   const int N, const int parallel) {
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel reduction(+: res)
+  {
+#endif
+  _avx_vec x, y, z, k, acc;
+  double *s, *r;
+  res = 0.0;
+
+  k = _avx_splat(c);
+  acc = _avx_zero();
+
+#ifdef OMP
+#pragma omp for 
+#endif
+  for(int i = 0; i < N; i++) {
+    s = (double*)(S + i);
+    r = (double*)(R + i);
+    for(int j = 0; j < 24; j += _avx_nd) {
+      x = _avx_load(r + j);
+      y = _avx_load(s + j);
+      z = _avx_fmadd(k, x, y);
+      _avx_store(r + j, z);
+      acc = _avx_fmadd(z, z, acc);
+    }
+  }
+  res = _avx_hsum(acc);
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif  
+#  ifdef MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return(mres);
+  }
+#endif
+  return(res);
+}
+
 #else
 
 /* R inoutput , c,S input*/
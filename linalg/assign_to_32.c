@@ -0,0 +1,59 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#ifdef OMP
+# include <omp.h>
+#endif
+#include "su3.h"
+#include "assign_to_32.h"
+
+/* S input, R output                          */
+/* converts a double precision spinor field S */
+/* to the single precision field R            */
+void assign_to_32(spinor32 * const R, spinor * const S, const int N)
+{
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  spinor32 *r;
+  spinor *s;
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for (int ix = 0; ix < N; ++ix) 
+  {
+    r = R + ix;
+    s = S + ix;
+    _vector_assign(r->s0, s->s0);
+    _vector_assign(r->s1, s->s1);
+    _vector_assign(r->s2, s->s2);
+    _vector_assign(r->s3, s->s3);
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
@@ -26,6 +26,47 @@
 #endif
 #include "su3.h"
 #include "diff_and_square_norm.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+double diff_and_square_norm(spinor * const Q, spinor * const R, const int N) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  double *q;
+  const double *r;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    q = (double*)(Q + ix);
+    r = (const double*)(R + ix);
+    for(int j = 0; j < 24; j++) {
+      q[j] = r[j] - q[j];
+    }
+    repro_sum_add(&lacc, repro_site_dot(q, q, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, 1);
+  return res;
+}
+
+#else
 
 double diff_and_square_norm(spinor * const Q, spinor * const R, const int N) {
   int ix;
@@ -80,3 +121,5 @@ double diff_and_square_norm(spinor * const Q, spinor * const R, const int N) {
 #endif
 
 }
+
+#endif
@@ -36,7 +36,7 @@
 #include <math.h>
 #include "su3.h"
 #include "mul_r.h"
-#include "linalg_eo.h"
+#include "mul_r_bi.h"
 
 void mul_r_bi(bispinor * const R, const double cup, const double cdn, bispinor * const S, const int N)
 {
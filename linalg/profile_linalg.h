@@ -0,0 +1,365 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+/* Included by linalg_eo.h with _PROFILE: every linear algebra      */
+/* routine of linalg_eo.h which works on N sites is replaced by a   */
+/* wrapper which counts its calls, time, flops and bytes, see       */
+/* profile.h. The flops are counted per real addition or            */
+/* multiplication, the bytes are the fields read plus the fields    */
+/* written. The implementations in linalg/ do not include           */
+/* linalg_eo.h and are not affected.                                */
+
+#ifndef _PROFILE_LINALG_H
+#define _PROFILE_LINALG_H
+
+#include "profile.h"
+
+#define _PS ((double)sizeof(spinor))
+#define _PV ((double)sizeof(su3_vector))
+#define _PB ((double)sizeof(bispinor))
+#define _P32 ((double)sizeof(spinor32))
+
+/* spinor fields */
+
+static inline void _profile_diff(spinor * const Q, const spinor * const R, const spinor * const S, const int N) {
+  _PROFILE_BEGIN("diff"); diff(Q, R, S, N); _PROFILE_END(24.*N, 3.*N*_PS);
+}
+#define diff(Q, R, S, N) _profile_diff(Q, R, S, N)
+
+static inline void _profile_add(spinor * const Q, const spinor * const R, const spinor * const S, const int N) {
+  _PROFILE_BEGIN("add"); add(Q, R, S, N); _PROFILE_END(24.*N, 3.*N*_PS);
+}
+#define add(Q, R, S, N) _profile_add(Q, R, S, N)
+
+static inline void _profile_assign(spinor * const R, spinor * const S, const int N) {
+  _PROFILE_BEGIN("assign"); assign(R, S, N); _PROFILE_END(0., 2.*N*_PS);
+}
+#define assign(R, S, N) _profile_assign(R, S, N)
+
+static inline void _profile_mul_r(spinor * const R, const double c, spinor * const S, const int N) {
+  _PROFILE_BEGIN("mul_r"); mul_r(R, c, S, N); _PROFILE_END(24.*N, 2.*N*_PS);
+}
+#define mul_r(R, c, S, N) _profile_mul_r(R, c, S, N)
+
+static inline void _profile_mul(spinor * const R, const _Complex double c, spinor * const S, const int N) {
+  _PROFILE_BEGIN("mul"); mul(R, c, S, N); _PROFILE_END(72.*N, 2.*N*_PS);
+}
+#define mul(R, c, S, N) _profile_mul(R, c, S, N)
+
+static inline double _profile_square_norm(const spinor * const P, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("square_norm"); r = square_norm(P, N, parallel); _PROFILE_END(48.*N, N*_PS);
+  return(r);
+}
+#define square_norm(P, N, parallel) _profile_square_norm(P, N, parallel)
+
+static inline double _profile_scalar_prod_r(const spinor * const S, const spinor * const R, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("scalar_prod_r"); r = scalar_prod_r(S, R, N, parallel); _PROFILE_END(48.*N, 2.*N*_PS);
+  return(r);
+}
+#define scalar_prod_r(S, R, N, parallel) _profile_scalar_prod_r(S, R, N, parallel)
+
+static inline double _profile_scalar_prod_i(spinor * const S, spinor * const R, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("scalar_prod_i"); r = scalar_prod_i(S, R, N, parallel); _PROFILE_END(48.*N, 2.*N*_PS);
+  return(r);
+}
+#define scalar_prod_i(S, R, N, parallel) _profile_scalar_prod_i(S, R, N, parallel)
+
+static inline _Complex double _profile_scalar_prod(const spinor * const S, const spinor * const R, const int N, const int parallel) {
+  _Complex double r;
+  _PROFILE_BEGIN("scalar_prod"); r = scalar_prod(S, R, N, parallel); _PROFILE_END(96.*N, 2.*N*_PS);
+  return(r);
+}
+#define scalar_prod(S, R, N, parallel) _profile_scalar_prod(S, R, N, parallel)
+
+static inline void _profile_square_and_prod_r(double * const x1, double * const x2, const spinor * const S, const spinor * const R,
+                                              const int N, const int parallel) {
+  _PROFILE_BEGIN("square_and_prod_r"); square_and_prod_r(x1, x2, S, R, N, parallel); _PROFILE_END(96.*N, 2.*N*_PS);
+}
+#define square_and_prod_r(x1, x2, S, R, N, parallel) _profile_square_and_prod_r(x1, x2, S, R, N, parallel)
+
+static inline double _profile_diff_and_square_norm(spinor * const Q, spinor * const R, const int N) {
+  double r;
+  _PROFILE_BEGIN("diff_and_square_norm"); r = diff_and_square_norm(Q, R, N); _PROFILE_END(72.*N, 3.*N*_PS);
+  return(r);
+}
+#define diff_and_square_norm(Q, R, N) _profile_diff_and_square_norm(Q, R, N)
+
+static inline void _profile_assign_add_mul_r(spinor * const P, spinor * const Q, const double c, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_r"); assign_add_mul_r(P, Q, c, N); _PROFILE_END(48.*N, 3.*N*_PS);
+}
+#define assign_add_mul_r(P, Q, c, N) _profile_assign_add_mul_r(P, Q, c, N)
+
+static inline void _profile_assign_mul_add_r(spinor * const R, const double c, const spinor * const S, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_r"); assign_mul_add_r(R, c, S, N); _PROFILE_END(48.*N, 3.*N*_PS);
+}
+#define assign_mul_add_r(R, c, S, N) _profile_assign_mul_add_r(R, c, S, N)
+
+static inline double _profile_assign_mul_add_r_and_square(spinor * const R, const double c, const spinor * const S,
+                                                          const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("assign_mul_add_r_and_square"); r = assign_mul_add_r_and_square(R, c, S, N, parallel); _PROFILE_END(96.*N, 3.*N*_PS);
+  return(r);
+}
+#define assign_mul_add_r_and_square(R, c, S, N, parallel) _profile_assign_mul_add_r_and_square(R, c, S, N, parallel)
+
+static inline void _profile_assign_mul_bra_add_mul_r(spinor * const R, const double c0, const double c, spinor * const S, const int N) {
+  _PROFILE_BEGIN("assign_mul_bra_add_mul_r"); assign_mul_bra_add_mul_r(R, c0, c, S, N); _PROFILE_END(72.*N, 3.*N*_PS);
+}
+#define assign_mul_bra_add_mul_r(R, c0, c, S, N) _profile_assign_mul_bra_add_mul_r(R, c0, c, S, N)
+
+static inline void _profile_assign_add_mul_r_add_mul(spinor * const R, spinor * const S, spinor * const U,
+                                                     const double c1, const double c2, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_r_add_mul"); assign_add_mul_r_add_mul(R, S, U, c1, c2, N); _PROFILE_END(96.*N, 4.*N*_PS);
+}
+#define assign_add_mul_r_add_mul(R, S, U, c1, c2, N) _profile_assign_add_mul_r_add_mul(R, S, U, c1, c2, N)
+
+static inline void _profile_assign_mul_bra_add_mul_ket_add_r(spinor * const R, spinor * const S, spinor * const U,
+                                                             const double c1, const double c2, const int N) {
+  _PROFILE_BEGIN("assign_mul_bra_add_mul_ket_add_r"); assign_mul_bra_add_mul_ket_add_r(R, S, U, c1, c2, N); _PROFILE_END(96.*N, 4.*N*_PS);
+}
+#define assign_mul_bra_add_mul_ket_add_r(R, S, U, c1, c2, N) _profile_assign_mul_bra_add_mul_ket_add_r(R, S, U, c1, c2, N)
+
+static inline void _profile_assign_mul_add_mul_add_mul_add_mul_r(spinor * const R, spinor * const S, spinor * const U, spinor * const V,
+                                                                 const double c1, const double c2, const double c3, const double c4,
+                                                                 const int N) {
+  _PROFILE_BEGIN("assign_mul_add_mul_add_mul_add_mul_r");
+  assign_mul_add_mul_add_mul_add_mul_r(R, S, U, V, c1, c2, c3, c4, N);
+  _PROFILE_END(168.*N, 5.*N*_PS);
+}
+#define assign_mul_add_mul_add_mul_add_mul_r(R, S, U, V, c1, c2, c3, c4, N) \
+  _profile_assign_mul_add_mul_add_mul_add_mul_r(R, S, U, V, c1, c2, c3, c4, N)
+
+static inline void _profile_assign_mul_add_mul_r(spinor * const R, spinor * const S, const double c1, const double c2, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_mul_r"); assign_mul_add_mul_r(R, S, c1, c2, N); _PROFILE_END(72.*N, 3.*N*_PS);
+}
+#define assign_mul_add_mul_r(R, S, c1, c2, N) _profile_assign_mul_add_mul_r(R, S, c1, c2, N)
+
+static inline void _profile_assign_mul_add_mul_add_mul_r(spinor * const R, spinor * const S, spinor * const U,
+                                                         const double c1, const double c2, const double c3, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_mul_add_mul_r"); assign_mul_add_mul_add_mul_r(R, S, U, c1, c2, c3, N); _PROFILE_END(120.*N, 4.*N*_PS);
+}
+#define assign_mul_add_mul_add_mul_r(R, S, U, c1, c2, c3, N) _profile_assign_mul_add_mul_add_mul_r(R, S, U, c1, c2, c3, N)
+
+static inline void _profile_mul_add_mul_r(spinor * const R, spinor * const S, spinor * const U,
+                                          const double c1, const double c2, const int N) {
+  _PROFILE_BEGIN("mul_add_mul_r"); mul_add_mul_r(R, S, U, c1, c2, N); _PROFILE_END(72.*N, 3.*N*_PS);
+}
+#define mul_add_mul_r(R, S, U, c1, c2, N) _profile_mul_add_mul_r(R, S, U, c1, c2, N)
+
+static inline double _profile_update_x_and_r_and_square(spinor * const X, spinor * const R, const spinor * const P,
+                                                        const spinor * const Q, const double c, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("update_x_and_r_and_square"); r = update_x_and_r_and_square(X, R, P, Q, c, N, parallel); _PROFILE_END(144.*N, 6.*N*_PS);
+  return(r);
+}
+#define update_x_and_r_and_square(X, R, P, Q, c, N, parallel) _profile_update_x_and_r_and_square(X, R, P, Q, c, N, parallel)
+
+static inline void _profile_update_x_r_p_and_s(spinor * const X, spinor * const R, spinor * const P, spinor * const S,
+                                               const spinor * const W, const double a, const double b, const int N) {
+  _PROFILE_BEGIN("update_x_r_p_and_s"); update_x_r_p_and_s(X, R, P, S, W, a, b, N); _PROFILE_END(192.*N, 9.*N*_PS);
+}
+#define update_x_r_p_and_s(X, R, P, S, W, a, b, N) _profile_update_x_r_p_and_s(X, R, P, S, W, a, b, N)
+
+static inline void _profile_assign_add_mul(spinor * const P, spinor * const Q, const _Complex double c, const int N) {
+  _PROFILE_BEGIN("assign_add_mul"); assign_add_mul(P, Q, c, N); _PROFILE_END(96.*N, 3.*N*_PS);
+}
+#define assign_add_mul(P, Q, c, N) _profile_assign_add_mul(P, Q, c, N)
+
+static inline void _profile_assign_diff_mul(spinor * const S, spinor * const R, const _Complex double c, const int N) {
+  _PROFILE_BEGIN("assign_diff_mul"); assign_diff_mul(S, R, c, N); _PROFILE_END(96.*N, 3.*N*_PS);
+}
+#define assign_diff_mul(S, R, c, N) _profile_assign_diff_mul(S, R, c, N)
+
+static inline void _profile_mul_diff_mul(spinor * const R, spinor * const S, spinor * const U,
+                                         const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("mul_diff_mul"); mul_diff_mul(R, S, U, c1, c2, N); _PROFILE_END(168.*N, 3.*N*_PS);
+}
+#define mul_diff_mul(R, S, U, c1, c2, N) _profile_mul_diff_mul(R, S, U, c1, c2, N)
+
+static inline void _profile_mul_add_mul(spinor * const R, spinor * const S, spinor * const U,
+                                        const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("mul_add_mul"); mul_add_mul(R, S, U, c1, c2, N); _PROFILE_END(168.*N, 3.*N*_PS);
+}
+#define mul_add_mul(R, S, U, c1, c2, N) _profile_mul_add_mul(R, S, U, c1, c2, N)
+
+static inline void _profile_assign_add_mul_add_mul(spinor * const R, spinor * const S, spinor * const U,
+                                                   const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_add_mul"); assign_add_mul_add_mul(R, S, U, c1, c2, N); _PROFILE_END(192.*N, 4.*N*_PS);
+}
+#define assign_add_mul_add_mul(R, S, U, c1, c2, N) _profile_assign_add_mul_add_mul(R, S, U, c1, c2, N)
+
+static inline void _profile_assign_mul_bra_add_mul_ket_add(spinor * const R, spinor * const S, spinor * const U,
+                                                           const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("assign_mul_bra_add_mul_ket_add"); assign_mul_bra_add_mul_ket_add(R, S, U, c1, c2, N); _PROFILE_END(192.*N, 4.*N*_PS);
+}
+#define assign_mul_bra_add_mul_ket_add(R, S, U, c1, c2, N) _profile_assign_mul_bra_add_mul_ket_add(R, S, U, c1, c2, N)
+
+/* colour vector fields */
+
+static inline void _profile_diff_su3vect(su3_vector * const Q, su3_vector * const R, su3_vector * const S, const int N) {
+  _PROFILE_BEGIN("diff_su3vect"); diff_su3vect(Q, R, S, N); _PROFILE_END(6.*N, 3.*N*_PV);
+}
+#define diff_su3vect(Q, R, S, N) _profile_diff_su3vect(Q, R, S, N)
+
+static inline void _profile_assign_su3vect(su3_vector * const R, su3_vector * const S, const int N) {
+  _PROFILE_BEGIN("assign_su3vect"); assign_su3vect(R, S, N); _PROFILE_END(0., 2.*N*_PV);
+}
+#define assign_su3vect(R, S, N) _profile_assign_su3vect(R, S, N)
+
+static inline double _profile_square_norm_su3vect(su3_vector * const P, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("square_norm_su3vect"); r = square_norm_su3vect(P, N, parallel); _PROFILE_END(12.*N, N*_PV);
+  return(r);
+}
+#define square_norm_su3vect(P, N, parallel) _profile_square_norm_su3vect(P, N, parallel)
+
+static inline double _profile_scalar_prod_r_su3vect(su3_vector * const S, su3_vector * const R, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("scalar_prod_r_su3vect"); r = scalar_prod_r_su3vect(S, R, N, parallel); _PROFILE_END(12.*N, 2.*N*_PV);
+  return(r);
+}
+#define scalar_prod_r_su3vect(S, R, N, parallel) _profile_scalar_prod_r_su3vect(S, R, N, parallel)
+
+static inline _Complex double _profile_scalar_prod_su3vect(su3_vector * const S, su3_vector * const R, const int N, const int parallel) {
+  _Complex double r;
+  _PROFILE_BEGIN("scalar_prod_su3vect"); r = scalar_prod_su3vect(S, R, N, parallel); _PROFILE_END(24.*N, 2.*N*_PV);
+  return(r);
+}
+#define scalar_prod_su3vect(S, R, N, parallel) _profile_scalar_prod_su3vect(S, R, N, parallel)
+
+static inline void _profile_assign_add_mul_r_su3vect(su3_vector * const P, su3_vector * const Q, const double c, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_r_su3vect"); assign_add_mul_r_su3vect(P, Q, c, N); _PROFILE_END(12.*N, 3.*N*_PV);
+}
+#define assign_add_mul_r_su3vect(P, Q, c, N) _profile_assign_add_mul_r_su3vect(P, Q, c, N)
+
+static inline void _profile_assign_mul_add_r_su3vect(su3_vector * const R, const double c, su3_vector * const S, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_r_su3vect"); assign_mul_add_r_su3vect(R, c, S, N); _PROFILE_END(12.*N, 3.*N*_PV);
+}
+#define assign_mul_add_r_su3vect(R, c, S, N) _profile_assign_mul_add_r_su3vect(R, c, S, N)
+
+/* bispinor fields */
+
+static inline double _profile_square_norm_bi(bispinor * const P, const int N) {
+  double r;
+  _PROFILE_BEGIN("square_norm_bi"); r = square_norm_bi(P, N); _PROFILE_END(96.*N, N*_PB);
+  return(r);
+}
+#define square_norm_bi(P, N) _profile_square_norm_bi(P, N)
+
+static inline void _profile_assign_bi(bispinor * const R, bispinor * const S, const int N) {
+  _PROFILE_BEGIN("assign_bi"); assign_bi(R, S, N); _PROFILE_END(0., 2.*N*_PB);
+}
+#define assign_bi(R, S, N) _profile_assign_bi(R, S, N)
+
+static inline _Complex double _profile_scalar_prod_bi(bispinor * const S, bispinor * const R, const int N) {
+  _Complex double r;
+  _PROFILE_BEGIN("scalar_prod_bi"); r = scalar_prod_bi(S, R, N); _PROFILE_END(192.*N, 2.*N*_PB);
+  return(r);
+}
+#define scalar_prod_bi(S, R, N) _profile_scalar_prod_bi(S, R, N)
+
+static inline double _profile_scalar_prod_r_bi(bispinor * const S, bispinor * const R, const int N) {
+  double r;
+  _PROFILE_BEGIN("scalar_prod_r_bi"); r = scalar_prod_r_bi(S, R, N); _PROFILE_END(96.*N, 2.*N*_PB);
+  return(r);
+}
+#define scalar_prod_r_bi(S, R, N) _profile_scalar_prod_r_bi(S, R, N)
+
+static inline void _profile_diff_bi(bispinor * const Q, bispinor * const R, bispinor * const S, const int N) {
+  _PROFILE_BEGIN("diff_bi"); diff_bi(Q, R, S, N); _PROFILE_END(48.*N, 3.*N*_PB);
+}
+#define diff_bi(Q, R, S, N) _profile_diff_bi(Q, R, S, N)
+
+static inline void _profile_mul_r_bi(bispinor * const R, const double cup, const double cdn, bispinor * const S, const int N) {
+  _PROFILE_BEGIN("mul_r_bi"); mul_r_bi(R, cup, cdn, S, N); _PROFILE_END(48.*N, 2.*N*_PB);
+}
+#define mul_r_bi(R, cup, cdn, S, N) _profile_mul_r_bi(R, cup, cdn, S, N)
+
+static inline void _profile_assign_add_mul_r_bi(bispinor * const P, bispinor * const Q, const double c, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_r_bi"); assign_add_mul_r_bi(P, Q, c, N); _PROFILE_END(96.*N, 3.*N*_PB);
+}
+#define assign_add_mul_r_bi(P, Q, c, N) _profile_assign_add_mul_r_bi(P, Q, c, N)
+
+static inline void _profile_assign_mul_add_r_bi(bispinor * const S, const double c, bispinor * const R, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_r_bi"); assign_mul_add_r_bi(S, c, R, N); _PROFILE_END(96.*N, 3.*N*_PB);
+}
+#define assign_mul_add_r_bi(S, c, R, N) _profile_assign_mul_add_r_bi(S, c, R, N)
+
+static inline void _profile_assign_diff_mul_bi(bispinor * const S, bispinor * const R, const _Complex double c, const int N) {
+  _PROFILE_BEGIN("assign_diff_mul_bi"); assign_diff_mul_bi(S, R, c, N); _PROFILE_END(192.*N, 3.*N*_PB);
+}
+#define assign_diff_mul_bi(S, R, c, N) _profile_assign_diff_mul_bi(S, R, c, N)
+
+static inline void _profile_assign_add_mul_add_mul_bi(bispinor * const R, bispinor * const S, bispinor * const U,
+                                                      const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_add_mul_bi"); assign_add_mul_add_mul_bi(R, S, U, c1, c2, N); _PROFILE_END(384.*N, 4.*N*_PB);
+}
+#define assign_add_mul_add_mul_bi(R, S, U, c1, c2, N) _profile_assign_add_mul_add_mul_bi(R, S, U, c1, c2, N)
+
+static inline void _profile_assign_mul_bra_add_mul_ket_add_bi(bispinor * const R, bispinor * const S, bispinor * const U,
+                                                              const _Complex double c1, const _Complex double c2, const int N) {
+  _PROFILE_BEGIN("assign_mul_bra_add_mul_ket_add_bi"); assign_mul_bra_add_mul_ket_add_bi(R, S, U, c1, c2, N); _PROFILE_END(384.*N, 4.*N*_PB);
+}
+#define assign_mul_bra_add_mul_ket_add_bi(R, S, U, c1, c2, N) _profile_assign_mul_bra_add_mul_ket_add_bi(R, S, U, c1, c2, N)
+
+/* single precision fields */
+
+static inline void _profile_assign_to_32(spinor32 * const R, spinor * const S, const int N) {
+  _PROFILE_BEGIN("assign_to_32"); assign_to_32(R, S, N); _PROFILE_END(0., N*(_PS + _P32));
+}
+#define assign_to_32(R, S, N) _profile_assign_to_32(R, S, N)
+
+static inline void _profile_assign_to_64(spinor * const R, spinor32 * const S, const int N) {
+  _PROFILE_BEGIN("assign_to_64"); assign_to_64(R, S, N); _PROFILE_END(0., N*(_PS + _P32));
+}
+#define assign_to_64(R, S, N) _profile_assign_to_64(R, S, N)
+
+static inline double _profile_square_norm_32(const spinor32 * const P, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("square_norm_32"); r = square_norm_32(P, N, parallel); _PROFILE_END(48.*N, N*_P32);
+  return(r);
+}
+#define square_norm_32(P, N, parallel) _profile_square_norm_32(P, N, parallel)
+
+static inline double _profile_scalar_prod_r_32(const spinor32 * const S, const spinor32 * const R, const int N, const int parallel) {
+  double r;
+  _PROFILE_BEGIN("scalar_prod_r_32"); r = scalar_prod_r_32(S, R, N, parallel); _PROFILE_END(48.*N, 2.*N*_P32);
+  return(r);
+}
+#define scalar_prod_r_32(S, R, N, parallel) _profile_scalar_prod_r_32(S, R, N, parallel)
+
+static inline void _profile_assign_add_mul_r_32(spinor32 * const P, spinor32 * const Q, const float c, const int N) {
+  _PROFILE_BEGIN("assign_add_mul_r_32"); assign_add_mul_r_32(P, Q, c, N); _PROFILE_END(48.*N, 3.*N*_P32);
+}
+#define assign_add_mul_r_32(P, Q, c, N) _profile_assign_add_mul_r_32(P, Q, c, N)
+
+static inline void _profile_assign_mul_add_r_32(spinor32 * const R, const float c, spinor32 * const S, const int N) {
+  _PROFILE_BEGIN("assign_mul_add_r_32"); assign_mul_add_r_32(R, c, S, N); _PROFILE_END(48.*N, 3.*N*_P32);
+}
+#define assign_mul_add_r_32(R, c, S, N) _profile_assign_mul_add_r_32(R, c, S, N)
+
+#undef _PS
+#undef _PV
+#undef _PB
+#undef _P32
+
+#endif
@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <math.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#include "repro_sum.h"
+
+/* bring the limbs into the unique form with all but the
+ * most significant one in [0, 2^32) */
+static void repro_sum_normalise(repro_sum * const s) {
+  int64_t low, carry;
+  for(int k = 0; k < REPRO_NLIMB-1; k++) {
+    low = s->limb[k] & 0xffffffffLL;
+    carry = (s->limb[k] - low) / 4294967296LL;
+    s->limb[k] = low;
+    s->limb[k+1] += carry;
+  }
+}
+
+void repro_sum_merge(repro_sum * const to, repro_sum * const from, const int n) {
+  for(int i = 0; i < n; i++) {
+    repro_sum_normalise(from + i);
+  }
+#ifdef OMP
+#pragma omp critical(repro_sum_merge)
+#endif
+  for(int i = 0; i < n; i++) {
+    for(int k = 0; k < REPRO_NLIMB; k++) {
+      to[i].limb[k] += from[i].limb[k];
+    }
+    to[i].special += from[i].special;
+  }
+}
+
+#ifdef MPI
+/* elementwise sum of repro_sum accumulators, the limbs are added exactly */
+static void repro_sum_op(void * in, void * inout, int * len, MPI_Datatype * type) {
+  repro_sum * const a = (repro_sum*)in;
+  repro_sum * const b = (repro_sum*)inout;
+  for(int i = 0; i < *len; i++) {
+    for(int k = 0; k < REPRO_NLIMB; k++) {
+      b[i].limb[k] += a[i].limb[k];
+    }
+    b[i].special += a[i].special;
+  }
+}
+
+static int repro_sum_mpi_init = 0;
+static MPI_Datatype repro_sum_type;
+static MPI_Op repro_sum_mpi_op;
+#endif
+
+void repro_sum_finalize(double * const res, repro_sum * const s, const int n, const int parallel) {
+  double r;
+
+  for(int i = 0; i < n; i++) {
+    repro_sum_normalise(s + i);
+  }
+#ifdef MPI
+  if(parallel) {
+    if(!repro_sum_mpi_init) {
+      MPI_Type_contiguous(sizeof(repro_sum), MPI_BYTE, &repro_sum_type);
+      MPI_Type_commit(&repro_sum_type);
+      MPI_Op_create(repro_sum_op, 1, &repro_sum_mpi_op);
+      repro_sum_mpi_init = 1;
+    }
+    /* the normalised limbs are smaller than 2^32, the sum over the
+       processes cannot overflow; limbs and special values go in one
+       reduction, in place, so no buffer is needed */
+    MPI_Allreduce(MPI_IN_PLACE, s, n, repro_sum_type, repro_sum_mpi_op, MPI_COMM_WORLD);
+    for(int i = 0; i < n; i++) {
+      repro_sum_normalise(s + i);
+    }
+  }
+#endif
+  /* the representation is unique now, so is the rounding */
+  for(int i = 0; i < n; i++) {
+    r = 0.;
+    for(int k = REPRO_NLIMB-1; k >= 0; k--) {
+      r += ldexp((double)s[i].limb[k], 32*k - REPRO_OFFSET);
+    }
+    res[i] = r + s[i].special;
+  }
+}
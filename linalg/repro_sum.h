@@ -0,0 +1,141 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _REPRO_SUM_H
+#define _REPRO_SUM_H
+
+#include <stdint.h>
+#include <string.h>
+#if (defined AVX2)
+# include "avx.h"
+#endif
+
+/*
+ * Reproducible global sums
+ *
+ * Every summand (one per lattice site) is added exactly to a fixed point
+ * accumulator of REPRO_NLIMB limbs with 32 bit each. The least significant
+ * bit has the weight 2^-REPRO_OFFSET, bits below are truncated for each
+ * summand separately. Integer addition is associative, so the result does
+ * not depend on the order of the summation and thereby neither on the
+ * number of threads nor on the number of MPI processes. Summands larger
+ * than 2^596 and non-finite ones are summed in plain double precision.
+ */
+
+#define REPRO_NLIMB 40
+#define REPRO_OFFSET 640
+
+typedef struct {
+  int64_t limb[REPRO_NLIMB];
+  double special;
+} repro_sum;
+
+static inline void repro_sum_zero(repro_sum * const s, const int n) {
+  memset(s, 0, n*sizeof(repro_sum));
+}
+
+static inline void repro_sum_add(repro_sum * const s, const double x) {
+  uint64_t b, m;
+  int p, k;
+  memcpy(&b, &x, sizeof(double));
+  const int e = (int)((b >> 52) & 0x7ff);
+  /* zero and subnormal numbers are below the resolution */
+  if(e == 0) return;
+  /* weight of the least significant mantissa bit in the accumulator */
+  p = e - 1075 + REPRO_OFFSET;
+  if(e == 0x7ff || p >= 32*(REPRO_NLIMB-3)) {
+    s->special += x;
+    return;
+  }
+  m = (b & 0xfffffffffffffULL) | 0x10000000000000ULL;
+  if(p < 0) {
+    if(p <= -53) return;
+    m >>= -p;
+    p = 0;
+  }
+  k = p >> 5;
+  p &= 31;
+  /* at most 85 bits, distributed over three limbs */
+  const int64_t c0 = (int64_t)((m << p) & 0xffffffffULL);
+  const int64_t c1 = (int64_t)((m >> (32-p)) & 0xffffffffULL);
+  const int64_t c2 = p ? (int64_t)(m >> (64-p)) : 0;
+  if(b >> 63) {
+    s->limb[k] -= c0;
+    s->limb[k+1] -= c1;
+    s->limb[k+2] -= c2;
+  }
+  else {
+    s->limb[k] += c0;
+    s->limb[k+1] += c1;
+    s->limb[k+2] += c2;
+  }
+}
+
+/* contributions of one site, the order of the operations is fixed */
+#if (defined AVX2)
+static inline double repro_site_dot(const double * const a, const double * const b, const int n) {
+  _avx_vec d = _avx_zero();
+  for(int j = 0; j < n; j += _avx_nd) {
+    d = _avx_fmadd(_avx_load(a + j), _avx_load(b + j), d);
+  }
+  return(_avx_hsum(d));
+}
+#else
+static inline double repro_site_dot(const double * const a, const double * const b, const int n) {
+  double d0 = 0., d1 = 0., d2 = 0., d3 = 0.;
+  for(int j = 0; j < n; j += 4) {
+    d0 += a[j]*b[j];
+    d1 += a[j+1]*b[j+1];
+    d2 += a[j+2]*b[j+2];
+    d3 += a[j+3]*b[j+3];
+  }
+  return((d0 + d1) + (d2 + d3));
+}
+#endif
+
+/* imaginary part of conj(a) b */
+static inline double repro_site_dot_i(const double * const a, const double * const b, const int n) {
+  double d0 = 0., d1 = 0.;
+  for(int j = 0; j < n; j += 4) {
+    d0 += a[j]*b[j+1] - a[j+1]*b[j];
+    d1 += a[j+2]*b[j+3] - a[j+3]*b[j+2];
+  }
+  return(d0 + d1);
+}
+
+static inline double repro_site_dot_32(const float * const a, const float * const b, const int n) {
+  double d0 = 0., d1 = 0., d2 = 0., d3 = 0.;
+  for(int j = 0; j < n; j += 4) {
+    d0 += (double)a[j]*b[j];
+    d1 += (double)a[j+1]*b[j+1];
+    d2 += (double)a[j+2]*b[j+2];
+    d3 += (double)a[j+3]*b[j+3];
+  }
+  return((d0 + d1) + (d2 + d3));
+}
+
+/* adds the n thread local sums in from to the n shared ones in to,
+ * to be called by every thread of a parallel region */
+void repro_sum_merge(repro_sum * const to, repro_sum * const from, const int n);
+
+/* sums the n accumulators over all processes if parallel is set and
+ * rounds them to double precision */
+void repro_sum_finalize(double * const res, repro_sum * const s, const int n, const int parallel);
+
+#endif
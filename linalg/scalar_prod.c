@@ -30,8 +30,46 @@
 #endif
 #include "su3.h"
 #include "scalar_prod.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
 
 /*  <S,R>=S^* times R */
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+_Complex double scalar_prod(const spinor * const S, const spinor * const R, const int N, const int parallel) {
+  double ALIGN res[2];
+  repro_sum acc[2];
+
+  repro_sum_zero(acc, 2);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc[2];
+  const double *s, *r;
+  repro_sum_zero(lacc, 2);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc[0], repro_site_dot(s, r, 24));
+    repro_sum_add(&lacc[1], repro_site_dot_i(s, r, 24));
+  }
+  repro_sum_merge(acc, lacc, 2);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(res, acc, 2, parallel);
+  return(res[0] + I*res[1]);
+}
+
+#else
+
 _Complex double scalar_prod(const spinor * const S, const spinor * const R, const int N, const int parallel) {
   _Complex double ALIGN res = 0.0;
 #ifdef MPI
@@ -100,6 +138,8 @@ _Complex double scalar_prod(const spinor * const S, const spinor * const R, cons
   return(res);
 }
 
+#endif
+
 #ifdef WITHLAPH
 _Complex double scalar_prod_su3vect(su3_vector * const S, su3_vector * const R, const int N, const int parallel)
 {
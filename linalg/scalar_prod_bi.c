@@ -35,9 +35,47 @@
 #endif
 #include "su3.h"
 #include "scalar_prod_bi.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
 
 
 /*  <S,R>=S^* times R */
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+_Complex double scalar_prod_bi(bispinor * const S, bispinor * const R, const int N) {
+  double ALIGN res[2];
+  repro_sum acc[2];
+
+  repro_sum_zero(acc, 2);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc[2];
+  const double *s, *r;
+  repro_sum_zero(lacc, 2);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc[0], repro_site_dot(s, r, 48));
+    repro_sum_add(&lacc[1], repro_site_dot_i(s, r, 48));
+  }
+  repro_sum_merge(acc, lacc, 2);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(res, acc, 2, 1);
+  return(res[0] + I*res[1]);
+}
+
+#else
+
 _Complex double scalar_prod_bi(bispinor * const S, bispinor * const R, const int N){
 
   _Complex double ks,kc,ds,tr,ts,tt;
@@ -84,3 +122,5 @@ _Complex double scalar_prod_bi(bispinor * const S, bispinor * const R, const int
   return(c);
 
 }
+
+#endif
@@ -37,9 +37,46 @@
 #include <complex.h>
 #include "su3.h"
 #include "scalar_prod_i.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
 
 /*  R input, S input */
 
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+double scalar_prod_i(spinor * const S, spinor * const R, const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const double *s, *r;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc, repro_site_dot_i(s, r, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
+
+#else
+
 double scalar_prod_i(spinor * const S,spinor * const R, const int N, const int parallel)
 {
   static double ks,kc,ds,tr,ts,tt;
@@ -79,3 +116,5 @@ double scalar_prod_i(spinor * const S,spinor * const R, const int N, const int p
 
   return kc;
 }
+
+#endif
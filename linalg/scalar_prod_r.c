@@ -35,12 +35,47 @@
 #endif
 #include "su3.h"
 #include "scalar_prod_r.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
 
 /*  R input, S input */
 
 #include <complex.h>
 
-#if (defined BGQ && defined XLC)
+#if (defined _REPRODUCIBLE_REDUCTIONS)
+
+double scalar_prod_r(const spinor * const S, const spinor * const R, const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const double *s, *r;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc, repro_site_dot(s, r, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
+
+#elif (defined BGQ && defined XLC)
 
 double scalar_prod_r(const spinor * const S, const spinor * const R, const int N, const int parallel) {
   double ALIGN res = 0.0;
@@ -130,6 +165,65 @@ double scalar_prod_r(const spinor * const S, const spinor * const R, const int N
   return (res);
 }
 
+#elif (defined AVX2)
+#include "avx.h"
+
+double scalar_prod_r(const spinor * const S, const spinor * const R, const int N, const int parallel) {
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel
+  {
+  int thread_num = omp_get_thread_num();
+#endif
+  _avx_vec x, y, ds, tr, ts, tt, ks, kc;
+  double *s, *r;
+
+  ks = _avx_zero();
+  kc = _avx_zero();
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for (int ix = 0; ix < N; ++ix) {
+    s = (double*)(S + ix);
+    r = (double*)(R + ix);
+    ds = _avx_zero();
+    for(int j = 0; j < 24; j += _avx_nd) {
+      x = _avx_load(s + j);
+      y = _avx_load(r + j);
+      ds = _avx_fmadd(x, y, ds);
+    }
+
+    tr = _avx_add(ds, kc);
+    ts = _avx_add(tr, ks);
+    tt = _avx_sub(ts, ks);
+    ks = ts;
+    kc = _avx_sub(tr, tt);
+  }
+
+#ifdef OMP
+  g_omp_acc_re[thread_num] = _avx_hsum(_avx_add(kc, ks));
+  } /* OpenMP parallel closing brace */
+  for( int i = 0; i < omp_num_threads; ++i)
+    res += g_omp_acc_re[i];
+#else
+  res = _avx_hsum(_avx_add(kc, ks));
+#endif
+
+#if defined MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return(mres);
+  }
+#endif
+
+  return (res);
+}
+
 #else
 
 double scalar_prod_r(const spinor * const S, const spinor * const R, const int N, const int parallel)
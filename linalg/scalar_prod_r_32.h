@@ -0,0 +1,28 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _SCALAR_PROD_R_32_H
+#define _SCALAR_PROD_R_32_H
+
+#include "su3.h"
+
+/* Returns the real part of the scalar product (*R,*S), accumulated in double precision */
+double scalar_prod_r_32(const spinor32 * const S, const spinor32 * const R, const int N, const int parallel);
+
+#endif
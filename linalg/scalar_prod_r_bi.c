@@ -40,9 +40,46 @@
 #endif
 #include "su3.h"
 #include "scalar_prod_r_bi.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
 
 
 /*  R input, S input */
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+double scalar_prod_r_bi(bispinor * const S, bispinor * const R, const int N) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const double *s, *r;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc, repro_site_dot(s, r, 48));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, 1);
+  return res;
+}
+
+#else
+
 double scalar_prod_r_bi(bispinor * const S,bispinor * const R, const int N){
 
 
@@ -88,3 +125,4 @@ double scalar_prod_r_bi(bispinor * const S,bispinor * const R, const int N){
 }
  
 
+#endif
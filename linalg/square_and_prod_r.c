@@ -20,9 +20,11 @@
  *
  * File square_and_prod_r.c
  *
- *   void square_and_prod_r(double * const x1, double * const x2, spinor * const S, spinor * const R)
+ *   void square_and_prod_r(double * const x1, double * const x2, spinor * const S, spinor * const R,
+ *                          const int N, const int parallel)
  *     Returns the real part of (*R,*S) and the square norm of *S
  *     It's faster than using "scalar_prod_r" and "square_norm"
+ *     Both are summed up in a single MPI_Allreduce
  *       
  *******************************************************************************/
 
@@ -32,18 +34,73 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <complex.h>
 #ifdef MPI
 # include <mpi.h>
 #endif
+#ifdef OMP
+# include <omp.h>
+# include <global.h>
+#endif
 #include "su3.h"
 #include "square_and_prod_r.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+void square_and_prod_r(double * const x1, double * const x2, const spinor * const S, const spinor * const R,
+		       const int N, const int parallel) {
+  double ALIGN res[2];
+  repro_sum acc[2];
+
+  repro_sum_zero(acc, 2);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc[2];
+  const double *s, *r;
+  repro_sum_zero(lacc, 2);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(S + ix);
+    r = (const double*)(R + ix);
+    repro_sum_add(&lacc[0], repro_site_dot(s, s, 24));
+    repro_sum_add(&lacc[1], repro_site_dot(s, r, 24));
+  }
+  repro_sum_merge(acc, lacc, 2);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(res, acc, 2, parallel);
+  *x1 = res[0];
+  *x2 = res[1];
+}
+
+#else
 
-void square_and_prod_r(double * const x1, double * const x2, spinor * const S, spinor * const R, const int N)
+void square_and_prod_r(double * const x1, double * const x2, const spinor * const S, const spinor * const R,
+		       const int N, const int parallel)
 {
-  int ix;
+  double ALIGN res[2];
+#ifdef MPI
+  double ALIGN mres[2];
+#endif
+
+#ifdef OMP
+#pragma omp parallel
+  {
+  int thread_num = omp_get_thread_num();
+#endif
   double ALIGN ks,kc,ds,tr,ts,tt;
   double ALIGN xks,xkc,xds,xtr,xts,xtt;
-  spinor *s,*r;
+  const spinor *s,*r;
   
   ks=0.0;
   kc=0.0;
@@ -56,20 +113,23 @@ void square_and_prod_r(double * const x1, double * const x2, spinor * const S, s
   __alignx(16, R);
 #endif
   
-  for (ix = 0; ix < N; ix++)
+#ifdef OMP
+#pragma omp for
+#endif
+  for (int ix = 0; ix < N; ix++)
   {
-    s=(spinor *) S + ix;
-    r=(spinor *) R + ix;
-
-    ds= r->s0.c0 * conj(s->s0.c0) + r->s0.c1 * conj(s->s0.c1) + r->s0.c2 * conj(s->s0.c2) +  
-        r->s1.c0 * conj(s->s1.c0) + r->s1.c1 * conj(s->s1.c1) + r->s1.c2 * conj(s->s1.c2) +  
-        r->s2.c0 * conj(s->s2.c0) + r->s2.c1 * conj(s->s2.c1) + r->s2.c2 * conj(s->s2.c2) + 
-        r->s3.c0 * conj(s->s3.c0) + r->s3.c1 * conj(s->s3.c1) + r->s3.c2 * conj(s->s3.c2);
-
-    xds=s->s0.c0 * conj(s->s0.c0) + s->s0.c1 * conj(s->s0.c1) + s->s0.c2 * conj(s->s0.c2) +  
-        s->s1.c0 * conj(s->s1.c0) + s->s1.c1 * conj(s->s1.c1) + s->s1.c2 * conj(s->s1.c2) +  
-        s->s2.c0 * conj(s->s2.c0) + s->s2.c1 * conj(s->s2.c1) + s->s2.c2 * conj(s->s2.c2) +
-        s->s3.c0 * conj(s->s3.c0) + s->s3.c1 * conj(s->s3.c1) + s->s3.c2 * conj(s->s3.c2);
+    s = S + ix;
+    r = R + ix;
+
+    ds= creal(r->s0.c0 * conj(s->s0.c0)) + creal(r->s0.c1 * conj(s->s0.c1)) + creal(r->s0.c2 * conj(s->s0.c2)) +
+      creal(r->s1.c0 * conj(s->s1.c0)) + creal(r->s1.c1 * conj(s->s1.c1)) + creal(r->s1.c2 * conj(s->s1.c2)) +
+      creal(r->s2.c0 * conj(s->s2.c0)) + creal(r->s2.c1 * conj(s->s2.c1)) + creal(r->s2.c2 * conj(s->s2.c2)) +
+      creal(r->s3.c0 * conj(s->s3.c0)) + creal(r->s3.c1 * conj(s->s3.c1)) + creal(r->s3.c2 * conj(s->s3.c2));
+
+    xds= creal(s->s0.c0 * conj(s->s0.c0)) + creal(s->s0.c1 * conj(s->s0.c1)) + creal(s->s0.c2 * conj(s->s0.c2)) +
+      creal(s->s1.c0 * conj(s->s1.c0)) + creal(s->s1.c1 * conj(s->s1.c1)) + creal(s->s1.c2 * conj(s->s1.c2)) +
+      creal(s->s2.c0 * conj(s->s2.c0)) + creal(s->s2.c1 * conj(s->s2.c1)) + creal(s->s2.c2 * conj(s->s2.c2)) +
+      creal(s->s3.c0 * conj(s->s3.c0)) + creal(s->s3.c1 * conj(s->s3.c1)) + creal(s->s3.c2 * conj(s->s3.c2));
     
     tr=ds + kc;
     ts=tr + ks;
@@ -84,20 +144,33 @@ void square_and_prod_r(double * const x1, double * const x2, spinor * const S, s
     xkc=xtr-xtt;
   }
   xkc=xks + xkc;
-  *x1=xkc;
-
-#if defined MPI
+  kc=ks + kc;
 
-  MPI_Allreduce(&xkc, x1, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#ifdef OMP
+  /* the square norm in the real, the scalar product in the imaginary part */
+  g_omp_acc_cp[thread_num] = xkc + I*kc;
+  } /* OpenMP closing brace */
 
+  res[0] = 0.;
+  res[1] = 0.;
+  for(int i = 0; i < omp_num_threads; ++i) {
+    res[0] += creal(g_omp_acc_cp[i]);
+    res[1] += cimag(g_omp_acc_cp[i]);
+  }
+#else
+  res[0] = xkc;
+  res[1] = kc;
 #endif
-  kc=ks + kc;
-  *x2=kc;
 
 #if defined MPI
-
-    MPI_Allreduce(&kc, x2, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-
+  if(parallel) {
+    MPI_Allreduce(res, mres, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    res[0] = mres[0];
+    res[1] = mres[1];
+  }
 #endif
+  *x1 = res[0];
+  *x2 = res[1];
 }
 
+#endif
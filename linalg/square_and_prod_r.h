@@ -22,8 +22,10 @@
 
 #include "su3.h"
 
-/*  Returns the real part of (*R,*S) and the square norm of *S 
- *  It's faster than using "scalar_prod_r" and "square_norm"  */
-void square_and_prod_r(double * const x1, double * const x2, spinor * const S, spinor * const R, const int N);
+/*  Returns the real part of (*R,*S) in x2 and the square norm of *S in x1
+ *  It's faster than using "scalar_prod_r" and "square_norm"
+ *  and needs only one global reduction */
+void square_and_prod_r(double * const x1, double * const x2, const spinor * const S, const spinor * const R,
+		       const int N, const int parallel);
 
 #endif
@@ -40,10 +40,46 @@
 #include "su3.h"
 #if (defined SSE || defined SSE2 || defined SSE3)
 # include "sse.h"
+#elif (defined AVX2)
+# include "avx.h"
 #endif
 #include "square_norm.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#if (defined _REPRODUCIBLE_REDUCTIONS)
+
+double square_norm(const spinor * const P, const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const double *s;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(P + ix);
+    repro_sum_add(&lacc, repro_site_dot(s, s, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
 
-#if ((defined BGL) && (defined XLC))
+#elif ((defined BGL) && (defined XLC))
 
 /***************************************
  *
@@ -172,6 +208,65 @@ double square_norm(spinor * const P, const int N, const int parallel) {
   return res;
 }
 
+#elif (defined AVX2)
+
+/* Kahan summation per vector lane as in the BGQ version */
+
+double square_norm(const spinor * const P, const int N, const int parallel) {
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel
+  {
+    int thread_num = omp_get_thread_num();
+#endif
+  _avx_vec x, ds, tt, tr, ts, kc, ks;
+  double *s;
+
+  ks = _avx_zero();
+  kc = _avx_zero();
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int i = 0; i < N; i++) {
+    s = (double*)(P + i);
+    ds = _avx_zero();
+    for(int j = 0; j < 24; j += _avx_nd) {
+      x = _avx_load(s + j);
+      ds = _avx_fmadd(x, x, ds);
+    }
+
+    tr = _avx_add(ds, kc);
+    ts = _avx_add(tr, ks);
+    tt = _avx_sub(ts, ks);
+    ks = ts;
+    kc = _avx_sub(tr, tt);
+  }
+
+#ifdef OMP
+  g_omp_acc_re[thread_num] = _avx_hsum(_avx_add(kc, ks));
+  } /* OpenMP closing brace */
+
+  for(int i = 0; i < omp_num_threads; ++i)
+    res += g_omp_acc_re[i];
+#else
+  res = _avx_hsum(_avx_add(kc, ks));
+#endif
+
+#  ifdef MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return mres;
+  }
+#  endif
+
+  return res;
+}
+
 #elif (defined BGQ && defined XLC)
 
 double square_norm(spinor * const P, const int N, const int parallel) {
@@ -0,0 +1,142 @@
+/***********************************************************************
+ * Copyright (C) 2002,2003,2004,2005,2006,2007,2008 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#ifdef OMP
+# include <omp.h>
+# include "global.h"
+#endif
+#include <complex.h>
+#include "su3.h"
+#include "square_norm_32.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+double square_norm_32(const spinor32 * const P, const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const float *s;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const float*)(P + ix);
+    repro_sum_add(&lacc, repro_site_dot_32(s, s, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
+
+#else
+
+/* the single precision site contributions are summed up */
+/* in double precision with Kahan summation              */
+double square_norm_32(const spinor32 * const P, const int N, const int parallel)
+{
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel
+  {
+    int thread_num = omp_get_thread_num();
+    g_omp_acc_re[thread_num] = 0.0;
+#endif
+  double ALIGN ks,kc,ds,tr,ts,tt;
+  const spinor32 *s;
+  
+  ks = 0.0;
+  kc = 0.0;
+  
+#ifdef OMP
+#pragma omp for
+#endif    
+  for (int ix  =  0; ix < N; ix++) {
+    s = P + ix;
+    
+    ds = conjf(s->s0.c0) * s->s0.c0 +
+         conjf(s->s0.c1) * s->s0.c1 +
+         conjf(s->s0.c2) * s->s0.c2 +
+         conjf(s->s1.c0) * s->s1.c0 +
+         conjf(s->s1.c1) * s->s1.c1 +
+         conjf(s->s1.c2) * s->s1.c2 +
+         conjf(s->s2.c0) * s->s2.c0 +
+         conjf(s->s2.c1) * s->s2.c1 +
+         conjf(s->s2.c2) * s->s2.c2 +
+         conjf(s->s3.c0) * s->s3.c0 +
+         conjf(s->s3.c1) * s->s3.c1 +
+         conjf(s->s3.c2) * s->s3.c2;
+
+    tr = ds + kc;
+    ts = tr + ks;
+    tt = ts-ks;
+    ks = ts;
+    kc = tr-tt;
+  }
+  kc=ks+kc;
+
+#ifdef OMP
+  g_omp_acc_re[thread_num] = kc;
+
+  } /* OpenMP closing brace */
+
+  for(int i = 0; i < omp_num_threads; ++i)
+    res += g_omp_acc_re[i];
+#else
+  res = kc;
+#endif
+
+#  ifdef MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return mres;
+  }
+#endif
+
+  return res;
+}
+
+#endif
@@ -40,6 +40,42 @@
 #include "su3.h"
 #include "sse.h"
 #include "square_norm_bi.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+double square_norm_bi(bispinor * const P, const int N) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  const double *s;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    s = (const double*)(P + ix);
+    repro_sum_add(&lacc, repro_site_dot(s, s, 48));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, 1);
+  return res;
+}
+
+#else
 
 double square_norm_bi(bispinor  *  const P, const int N) {
   int ix;
@@ -96,3 +132,5 @@ double square_norm_bi(bispinor  *  const P, const int N) {
 #endif
  
 }
+
+#endif
@@ -0,0 +1,171 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#ifdef MPI
+# include<mpi.h>
+#endif
+#include <stdlib.h>
+#ifdef OMP
+# include <omp.h>
+#endif
+#include "su3.h"
+#include "update_x_and_r_and_square.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "repro_sum.h"
+#endif
+
+#if (defined _REPRODUCIBLE_REDUCTIONS)
+
+double update_x_and_r_and_square(spinor * const X, spinor * const R, const spinor * const P,
+				 const spinor * const Q, const double c, const int N, const int parallel) {
+  double ALIGN res;
+  repro_sum acc;
+
+  repro_sum_zero(&acc, 1);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc;
+  double *x, *r;
+  const double *p, *q;
+  repro_sum_zero(&lacc, 1);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    x = (double*)(X + ix);
+    r = (double*)(R + ix);
+    p = (const double*)(P + ix);
+    q = (const double*)(Q + ix);
+    for(int j = 0; j < 24; j++) {
+      x[j] += c * p[j];
+      r[j] -= c * q[j];
+    }
+    repro_sum_add(&lacc, repro_site_dot(r, r, 24));
+  }
+  repro_sum_merge(&acc, &lacc, 1);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(&res, &acc, 1, parallel);
+  return res;
+}
+
+#elif (defined AVX2)
+#include "avx.h"
+
+double update_x_and_r_and_square(spinor * const X, spinor * const R, const spinor * const P,
+				 const spinor * const Q, const double c, const int N, const int parallel) {
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel reduction(+: res)
+  {
+#endif
+  _avx_vec k, mk, z, acc;
+  double *x, *r;
+  const double *p, *q;
+  res = 0.0;
+
+  k = _avx_splat(c);
+  mk = _avx_splat(-c);
+  acc = _avx_zero();
+
+#ifdef OMP
+#pragma omp for 
+#endif
+  for(int i = 0; i < N; i++) {
+    x = (double*)(X + i);
+    r = (double*)(R + i);
+    p = (const double*)(P + i);
+    q = (const double*)(Q + i);
+    for(int j = 0; j < 24; j += _avx_nd) {
+      _avx_store(x + j, _avx_fmadd(k, _avx_load(p + j), _avx_load(x + j)));
+      z = _avx_fmadd(mk, _avx_load(q + j), _avx_load(r + j));
+      _avx_store(r + j, z);
+      acc = _avx_fmadd(z, z, acc);
+    }
+  }
+  res = _avx_hsum(acc);
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif  
+#  ifdef MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return(mres);
+  }
+#endif
+  return(res);
+}
+
+#else
+
+double update_x_and_r_and_square(spinor * const X, spinor * const R, const spinor * const P,
+				 const spinor * const Q, const double c, const int N, const int parallel) {
+  double ALIGN res = 0.0;
+#ifdef MPI
+  double ALIGN mres;
+#endif
+
+#ifdef OMP
+#pragma omp parallel reduction(+ : res)
+  {
+#endif
+  double *x, *r;
+  const double *p, *q;
+  res = 0.0;
+
+#ifdef OMP
+#pragma omp for 
+#endif
+  for (int ix = 0; ix < N; ++ix) {
+    x = (double*)(X + ix);
+    r = (double*)(R + ix);
+    p = (const double*)(P + ix);
+    q = (const double*)(Q + ix);
+    for(int j = 0; j < 24; j++) {
+      x[j] += c * p[j];
+      r[j] -= c * q[j];
+      res += r[j] * r[j];
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+#  ifdef MPI
+  if(parallel) {
+    MPI_Allreduce(&res, &mres, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return(mres);
+  }
+#endif
+  return(res);
+}
+
+#endif
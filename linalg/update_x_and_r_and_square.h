@@ -0,0 +1,31 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _UPDATE_X_AND_R_AND_SQUARE_H
+#define _UPDATE_X_AND_R_AND_SQUARE_H
+
+#include "su3.h"
+
+/*   (*X) = (*X) + c*(*P)
+ *   (*R) = (*R) - c*(*Q)        c is a real constant
+ *   returns the square norm of the new (*R)  */
+double update_x_and_r_and_square(spinor * const X, spinor * const R, const spinor * const P,
+				 const spinor * const Q, const double c, const int N, const int parallel);
+
+#endif
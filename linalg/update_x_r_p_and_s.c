@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#ifdef OMP
+# include <omp.h>
+#endif
+#include "su3.h"
+#include "update_x_r_p_and_s.h"
+
+#if (defined AVX2)
+#include "avx.h"
+
+void update_x_r_p_and_s(spinor * const X, spinor * const R, spinor * const P, spinor * const S,
+			const spinor * const W, const double a, const double b, const int N) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _avx_vec ka, mka, kb, zp, zs;
+  double *x, *r, *p, *s;
+  const double *w;
+
+  ka = _avx_splat(a);
+  mka = _avx_splat(-a);
+  kb = _avx_splat(b);
+
+#ifdef OMP
+#pragma omp for 
+#endif
+  for(int i = 0; i < N; i++) {
+    x = (double*)(X + i);
+    r = (double*)(R + i);
+    p = (double*)(P + i);
+    s = (double*)(S + i);
+    w = (const double*)(W + i);
+    for(int j = 0; j < 24; j += _avx_nd) {
+      zp = _avx_fmadd(kb, _avx_load(p + j), _avx_load(r + j));
+      zs = _avx_fmadd(kb, _avx_load(s + j), _avx_load(w + j));
+      _avx_store(p + j, zp);
+      _avx_store(s + j, zs);
+      _avx_store(x + j, _avx_fmadd(ka, zp, _avx_load(x + j)));
+      _avx_store(r + j, _avx_fmadd(mka, zs, _avx_load(r + j)));
+    }
+  }
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif  
+  return;
+}
+
+#else
+
+void update_x_r_p_and_s(spinor * const X, spinor * const R, spinor * const P, spinor * const S,
+			const spinor * const W, const double a, const double b, const int N) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  double *x, *r, *p, *s;
+  const double *w;
+
+#ifdef OMP
+#pragma omp for 
+#endif
+  for (int ix = 0; ix < N; ++ix) {
+    x = (double*)(X + ix);
+    r = (double*)(R + ix);
+    p = (double*)(P + ix);
+    s = (double*)(S + ix);
+    w = (const double*)(W + ix);
+    for(int j = 0; j < 24; j++) {
+      p[j] = r[j] + b * p[j];
+      s[j] = w[j] + b * s[j];
+      x[j] += a * p[j];
+      r[j] -= a * s[j];
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
+
+#endif
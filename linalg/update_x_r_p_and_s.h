@@ -0,0 +1,33 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _UPDATE_X_R_P_AND_S_H
+#define _UPDATE_X_R_P_AND_S_H
+
+#include "su3.h"
+
+/*   (*P) = (*R) + b*(*P)
+ *   (*S) = (*W) + b*(*S)
+ *   (*X) = (*X) + a*(*P)
+ *   (*R) = (*R) - a*(*S)        a, b are real constants
+ *   the vector update of the Chronopoulos-Gear CG in one sweep  */
+void update_x_r_p_and_s(spinor * const X, spinor * const R, spinor * const P, spinor * const S,
+			const spinor * const W, const double a, const double b, const int N);
+
+#endif
@@ -36,6 +36,8 @@
 /* #include "linalg/deri_linalg.h" */
 #include "linalg/assign_mul_add_r.h"
 #include "linalg/assign_mul_add_r_and_square.h"
+#include "linalg/update_x_and_r_and_square.h"
+#include "linalg/update_x_r_p_and_s.h"
 #include "linalg/scalar_prod.h"
 #include "linalg/mul_diff_mul.h"
 #include "linalg/assign_add_mul.h"
@@ -66,4 +68,15 @@
 
 #include "linalg/convert_eo_to_lexic.h"
 
+#include "linalg/assign_to_32.h"
+#include "linalg/assign_to_64.h"
+#include "linalg/square_norm_32.h"
+#include "linalg/scalar_prod_r_32.h"
+#include "linalg/assign_add_mul_r_32.h"
+#include "linalg/assign_mul_add_r_32.h"
+
+#ifdef _PROFILE
+# include "linalg/profile_linalg.h"
+#endif
+
 #endif
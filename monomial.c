@@ -63,14 +63,8 @@ int add_monomial(const int type) {
 
   monomial_list[no_monomials].pf = NULL;
   monomial_list[no_monomials].pf2 = NULL;
-  monomial_list[no_monomials].csg_field = NULL;
-  monomial_list[no_monomials].csg_field2 = NULL;
-  monomial_list[no_monomials].csg_index_array = NULL;
-  monomial_list[no_monomials].csg_index_array2 = NULL;
   monomial_list[no_monomials].csg_N = 0;
   monomial_list[no_monomials].csg_N2 = 0;
-  monomial_list[no_monomials].csg_n = 1;
-  monomial_list[no_monomials].csg_n2 = 1;
   monomial_list[no_monomials].kappa = _default_g_kappa;
   monomial_list[no_monomials].kappa2 = _default_g_kappa;
   monomial_list[no_monomials].mu = _default_g_mu;
@@ -111,6 +105,16 @@ int add_monomial(const int type) {
   monomial_list[no_monomials].MDPolyLocNormConst = _default_MDPolyLocNormConst;
   monomial_list[no_monomials].MDPolyDetRatio = _default_MDPolyDetRatio;
   monomial_list[no_monomials].MaxPtildeDegree = NTILDE_CHEBYMAX;
+  /* rat monomial */
+  monomial_list[no_monomials].StildeMin = _default_stilde_min;
+  monomial_list[no_monomials].StildeMax = _default_stilde_max;
+  monomial_list[no_monomials].rat.np = _default_degree_of_rational;
+  monomial_list[no_monomials].rat.mu = NULL;
+  monomial_list[no_monomials].rat.rmu = NULL;
+  monomial_list[no_monomials].rat.nu = NULL;
+  monomial_list[no_monomials].rat.rnu = NULL;
+  monomial_list[no_monomials].rat_fields = NULL;
+  monomial_list[no_monomials].rat_memory = NULL;
 
   monomial_list[no_monomials].initialised = 1;
   if(monomial_list[no_monomials].type == NDDETRATIO) {
@@ -130,7 +134,8 @@ int init_monomials(const int V, const int even_odd_flag) {
   for(i = 0; i < no_monomials; i++) {
     if((monomial_list[i].type != GAUGE) && (monomial_list[i].type != SFGAUGE)) no++;
     /* non-degenerate monomials need two pseudo fermion fields */
-    if((monomial_list[i].type == NDPOLY) || (monomial_list[i].type == NDDETRATIO)) no++;
+    if((monomial_list[i].type == NDPOLY) || (monomial_list[i].type == NDDETRATIO)
+       || (monomial_list[i].type == NDRAT)) no++;
   }
   if(no_monomials > 0) {
     if((void*)(_pf = (spinor*)calloc(no*V+1, sizeof(spinor))) == NULL) {
@@ -225,6 +230,30 @@ int init_monomials(const int V, const int even_odd_flag) {
 	monomial_list[i].timescale = -5;
 	no++;
       }
+      else if(monomial_list[i].type == RAT) {
+	if(!even_odd_flag || monomial_list[i].mu != 0.) {
+	  fprintf(stderr, "RAT monomial %d needs even/odd preconditioning and 2KappaMu = 0!\n", i);
+	  return(1);
+	}
+	monomial_list[i].hbfunction = &rat_heatbath;
+	monomial_list[i].accfunction = &rat_acc;
+	monomial_list[i].derivativefunction = &rat_derivative;
+	retval = init_rat_monomial(V, i);
+	if(retval != 0) return(retval);
+      }
+      else if(monomial_list[i].type == NDRAT) {
+	if(!even_odd_flag) {
+	  fprintf(stderr, "NDRAT monomial %d needs even/odd preconditioning!\n", i);
+	  return(1);
+	}
+	monomial_list[i].hbfunction = &ndrat_heatbath;
+	monomial_list[i].accfunction = &ndrat_acc;
+	monomial_list[i].derivativefunction = &ndrat_derivative;
+	monomial_list[i].pf2 = __pf+no*V;
+	no++;
+	retval = init_rat_monomial(V, i);
+	if(retval != 0) return(retval);
+      }
     }
     else {
       monomial_list[i].pf = NULL;
@@ -275,11 +304,54 @@ int init_monomials(const int V, const int even_odd_flag) {
 
 void free_monomials() {
   
+  for(int i = 0; i < no_monomials; i++) {
+    if(monomial_list[i].rat_fields != NULL) {
+      free(monomial_list[i].rat_memory);
+      free(monomial_list[i].rat_fields);
+      free_rational(&monomial_list[i].rat);
+    }
+  }
   free(_pf);
   return;
 }
 
 
+int init_rat_monomial(const int V, const int id) {
+  monomial * mnl = &monomial_list[id];
+  const int nf = (mnl->type == NDRAT) ? 2 : 1;
+  const int np = mnl->rat.np;
+
+  if(np > MAX_EXTRA_MASSES) {
+    fprintf(stderr, "DegreeOfRational %d of monomial %d exceeds the maximum %d of the multi-shift solver\n",
+	    np, id, MAX_EXTRA_MASSES);
+    return(1);
+  }
+  if(init_rational(&mnl->rat, np, mnl->StildeMin, mnl->StildeMax) != 0) {
+    return(2);
+  }
+
+  if((void*)(mnl->rat_memory = (spinor*)calloc(nf*np*V+1, sizeof(spinor))) == NULL ||
+     (void*)(mnl->rat_fields = (spinor**)calloc(nf*np, sizeof(spinor*))) == NULL) {
+    printf ("malloc errno in init_rat_monomial fields: %d\n",errno); 
+    errno = 0;
+    return(3);
+  }
+#if ( defined SSE || defined SSE2 || defined SSE3)
+  mnl->rat_fields[0] = (spinor*)(((unsigned long int)(mnl->rat_memory)+ALIGN_BASE)&~ALIGN_BASE);
+#else
+  mnl->rat_fields[0] = mnl->rat_memory;
+#endif
+  for(int i = 1; i < nf*np; i++) {
+    mnl->rat_fields[i] = mnl->rat_fields[i-1]+V;
+  }
+  if(g_proc_id == 0) {
+    printf("# Initialised %s monomial %d with %d poles, relative error %e on [%e, %e]\n",
+	   mnl->name, id, np, mnl->rat.delta, mnl->StildeMin, mnl->StildeMax);
+  }
+  return(0);
+}
+
+
 int init_poly_monomial(const int V,const int id){
 
   monomial * mnl = &monomial_list[id];
@@ -419,3 +491,11 @@ double dummy_acc(const int id, hamiltonian_field_t * const hf) {
   }
   return(0.);
 }
+
+#ifdef _PROFILE
+int monomial_profile_id(const int no, const char * const function) {
+  char name[64];
+  snprintf(name, 64, "%s %d %s", monomial_list[no].name, no, function);
+  return(profile_register(name));
+}
+#endif
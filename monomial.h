@@ -25,6 +25,7 @@
 #include "su3.h"
 #include "su3spinor.h"
 #include "hamiltonian_field.h"
+#include "rational.h"
 
 
 #define DET 0
@@ -38,6 +39,8 @@
 #define CLOVERTRLOG 8
 #define CLOVERDET 9
 #define CLOVERDETRATIO 10
+#define RAT 11
+#define NDRAT 12
 
 #define max_no_monomials 20
 
@@ -53,9 +56,7 @@ typedef struct {
   int solver;
   int iter0, iter1, iter2;
   int csg_N, csg_N2;
-  int csg_n, csg_n2;
   int use_rectangles;
-  int * csg_index_array, *csg_index_array2;
   /* det or detratio related */
   double mu, mu2, kappa, kappa2;
   /* clover coefficient */
@@ -79,6 +80,11 @@ typedef struct {
   double c1ss, c1tss, c1tts;
   /* some book-keeping */
   char name[100];
+  /* cost and forces in the current trajectory, see monomial_cost.h */
+  int no_derivatives;
+  unsigned long hopping;
+  double hb_time, acc_time, deri_time;
+  double force_max, force_sq;
   /* pseudo fermion field */
   /* second one needed for ND monomials */
   spinor * pf, * pf2;
@@ -95,9 +101,9 @@ typedef struct {
   double PrecisionPtilde;
   double PrecisionHfinal;
   double StildeMin, StildeMax;
-  /* chronological solver fields */
-  spinor ** csg_field;
-  spinor ** csg_field2;
+  /* rational approximation for RAT and NDRAT */
+  rational_t rat;
+  spinor ** rat_fields, * rat_memory;
   /* functions for the HMC update */
   void (*hbfunction) (const int no, hamiltonian_field_t * const hf);
   double (*accfunction) (const int no, hamiltonian_field_t * const hf);
@@ -118,6 +124,8 @@ typedef struct {
 #include "clover_trlog_monomial.h"
 #include "cloverdet_monomial.h"
 #include "cloverdetratio_monomial.h"
+#include "rat_monomial.h"
+#include "ndrat_monomial.h"
 
 /* list of all monomials */
 extern monomial monomial_list[max_no_monomials];
@@ -137,6 +145,8 @@ void free_monomials();
 
 /* initialisation function for a poly monomial */
 int init_poly_monomial(const int V,const int id);
+/* initialisation function for a rat or ndrat monomial */
+int init_rat_monomial(const int V, const int id);
 
 
 /* some dummy functions */
@@ -144,4 +154,18 @@ void dummy_derivative(const int id, hamiltonian_field_t * const hf);
 void dummy_heatbath(const int id, hamiltonian_field_t * const hf);
 double dummy_acc(const int id, hamiltonian_field_t * const hf);
 
+#include "profile.h"
+#ifdef _PROFILE
+/* counter of profile.h for the function ("heatbath", "acc" or   */
+/* "derivative") of monomial no                                   */
+int monomial_profile_id(const int no, const char * const function);
+#  define _PROFILE_MONOMIAL_BEGIN(no, function)                         \
+  const int _profile_mnl_id = monomial_profile_id(no, function);      \
+  profile_begin(_profile_mnl_id)
+#  define _PROFILE_MONOMIAL_END() profile_end(_profile_mnl_id, 0., 0.)
+#else
+#  define _PROFILE_MONOMIAL_BEGIN(no, function)
+#  define _PROFILE_MONOMIAL_END()
+#endif
+
 #endif
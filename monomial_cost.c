@@ -0,0 +1,235 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Cost and force accounting of the monomials, see monomial_cost.h
+ *
+ * During a trajectory every monomial accumulates the wall clock time
+ * spent in its heatbath, acceptance and derivative functions, the
+ * number of calls of the derivative and the number of applications of
+ * the even/odd hopping matrix (g_hopping_count) made by them.
+ *
+ * The derivatives of all monomials of a timescale are summed up in the
+ * same field. To get the force of a single monomial the field is saved
+ * before its derivative is computed, the difference is exchanged such
+ * that the contributions written to the boundary are added to the
+ * local sites and the norm |F|^2 = sum_a F_a^2 of the su3adj force is
+ * taken on every link. The field used for the momentum update itself
+ * is not touched. Since this costs a copy and an exchange of the field
+ * per derivative it is only done with MonomialForces = yes, otherwise
+ * the force columns are zero.
+ *
+ * write_monomial_cost appends per trajectory one line per monomial
+ * with the columns
+ *
+ *   traj id name timescale t_heatbath t_acc t_derivative
+ *   n_derivative iter0 iter1 n_hopping max|F| rms|F|
+ *
+ * where the times are the maximum over all processes, max|F| is the
+ * largest norm of the force on a link and rms|F| the square root of
+ * the mean of |F|^2 over all links and all calls of the derivative.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <errno.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "su3adj.h"
+#include "sse.h"
+#include "xchange_deri.h"
+#include "monomial.h"
+#include "monomial_cost.h"
+
+static su3adj * df_saved_ = NULL;
+static su3adj ** df_saved = NULL;
+static int df_saved_size = 0;
+int monomial_cost_paused = 0;
+
+static int init_df_saved(const int VR) {
+  if(df_saved_size == VR) return(0);
+  free(df_saved_);
+  free(df_saved);
+  df_saved_size = 0;
+  if((void*)(df_saved_ = (su3adj*)calloc(4*VR+1, sizeof(su3adj))) == NULL) {
+    printf ("malloc errno : %d\n",errno);
+    errno = 0;
+    return(1);
+  }
+  if((void*)(df_saved = (su3adj**)calloc(VR, sizeof(su3adj*))) == NULL) {
+    printf ("malloc errno : %d\n",errno);
+    errno = 0;
+    return(2);
+  }
+#if ( defined SSE || defined SSE2 || defined SSE3)
+  df_saved[0] = (su3adj*)(((unsigned long int)(df_saved_)+ALIGN_BASE)&~ALIGN_BASE);
+#else
+  df_saved[0] = df_saved_;
+#endif
+  for(int i = 1; i < VR; i++) {
+    df_saved[i] = df_saved[i-1]+4;
+  }
+  df_saved_size = VR;
+  return(0);
+}
+
+void reset_monomial_cost() {
+  for(int i = 0; i < no_monomials; i++) {
+    monomial_list[i].no_derivatives = 0;
+    monomial_list[i].hopping = 0;
+    monomial_list[i].hb_time = 0.;
+    monomial_list[i].acc_time = 0.;
+    monomial_list[i].deri_time = 0.;
+    monomial_list[i].force_max = 0.;
+    monomial_list[i].force_sq = 0.;
+  }
+  return;
+}
+
+void monomial_cost_pause(const int pause) {
+  monomial_cost_paused = pause;
+  return;
+}
+
+void save_monomial_force(su3adj ** const df) {
+  const int VR = VOLUMEPLUSRAND + g_dbw2rand;
+
+  if(monomial_cost_paused) return;
+  if(init_df_saved(VR) != 0) {
+    fprintf(stderr, "Not enough memory for the force accounting of the monomials! Aborting...\n");
+    exit(-1);
+  }
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < VR; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      df_saved[i][mu] = df[i][mu];
+    }
+  }
+  return;
+}
+
+void add_monomial_force(const int no, su3adj ** const df) {
+  const int VR = VOLUMEPLUSRAND + g_dbw2rand;
+  double fmax = 0., fsq = 0.;
+
+  if(monomial_cost_paused) return;
+  /* df_saved becomes the force of this monomial alone */
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < VR; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      su3adj f = df[i][mu];
+      _sub_su3adj(f, df_saved[i][mu]);
+      df_saved[i][mu] = f;
+    }
+  }
+#ifdef MPI
+  xchange_deri(df_saved);
+#endif
+
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  double tmax = 0., tsq = 0., n;
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int i = 0; i < VOLUME; i++) {
+    for(int mu = 0; mu < 4; mu++) {
+      n = _su3adj_square_norm(df_saved[i][mu]);
+      tsq += n;
+      if(n > tmax) tmax = n;
+    }
+  }
+#ifdef OMP
+#pragma omp critical(monomial_cost)
+#endif
+  {
+    fsq += tsq;
+    if(tmax > fmax) fmax = tmax;
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  monomial_list[no].no_derivatives++;
+  monomial_list[no].force_sq += fsq;
+  if(sqrt(fmax) > monomial_list[no].force_max) {
+    monomial_list[no].force_max = sqrt(fmax);
+  }
+  return;
+}
+
+int write_monomial_cost(const char * const filename, const int traj) {
+  double tmax[3*max_no_monomials], fmax[max_no_monomials], fsq[max_no_monomials];
+  FILE * ofs;
+  int newfile;
+
+  for(int i = 0; i < no_monomials; i++) {
+    tmax[3*i] = monomial_list[i].hb_time;
+    tmax[3*i+1] = monomial_list[i].acc_time;
+    tmax[3*i+2] = monomial_list[i].deri_time;
+    fmax[i] = monomial_list[i].force_max;
+    fsq[i] = monomial_list[i].force_sq;
+  }
+#ifdef MPI
+  {
+    double tmp[3*max_no_monomials];
+    for(int i = 0; i < 3*no_monomials; i++) tmp[i] = tmax[i];
+    MPI_Reduce(tmp, tmax, 3*no_monomials, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    for(int i = 0; i < no_monomials; i++) tmp[i] = fmax[i];
+    MPI_Reduce(tmp, fmax, no_monomials, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    for(int i = 0; i < no_monomials; i++) tmp[i] = fsq[i];
+    MPI_Reduce(tmp, fsq, no_monomials, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  }
+#endif
+  if(g_proc_id != 0) return(0);
+
+  ofs = fopen(filename, "r");
+  newfile = (ofs == NULL);
+  if(ofs != NULL) fclose(ofs);
+  if((ofs = fopen(filename, "a")) == NULL) {
+    fprintf(stderr, "Could not open file %s for writing the monomial cost\n", filename);
+    return(-1);
+  }
+  if(newfile) {
+    fprintf(ofs, "# traj id name timescale t_heatbath t_acc t_derivative n_derivative iter0 iter1 n_hopping max|F| rms|F|\n");
+  }
+  for(int i = 0; i < no_monomials; i++) {
+    const monomial * const mnl = &monomial_list[i];
+    const double links = 4.*VOLUME*g_nproc*mnl->no_derivatives;
+    fprintf(ofs, "%d %d %s %d %e %e %e %d %d %d %lu %e %e\n", traj, i, mnl->name, mnl->timescale,
+            tmax[3*i], tmax[3*i+1], tmax[3*i+2], mnl->no_derivatives, mnl->iter0, mnl->iter1,
+            mnl->hopping, fmax[i], (links > 0.) ? sqrt(fsq[i]/links) : 0.);
+  }
+  fclose(ofs);
+  return(0);
+}
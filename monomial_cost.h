@@ -0,0 +1,67 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _MONOMIAL_COST_H
+#define _MONOMIAL_COST_H
+
+#include "su3adj.h"
+#include "gettime.h"
+#include "monomial.h"
+
+/* Per trajectory accounting of the cost and of the forces of every  */
+/* monomial. A call of one of the monomial functions is accounted    */
+/* with                                                              */
+/*                                                                   */
+/*   _MONOMIAL_COST_BEGIN;                                           */
+/*   ...                                                             */
+/*   _MONOMIAL_COST_END(no, hb_time);                                */
+/*                                                                   */
+/* in the same block, where the second argument is the time field    */
+/* of the monomial struct the wall clock time is added to. Nothing   */
+/* is accounted while monomial_cost_pause(1) is in effect.            */
+
+extern int monomial_cost_paused;
+
+#define _MONOMIAL_COST_BEGIN                                  \
+  const double _cost_time = gettime();                        \
+  const unsigned long _cost_hopping = g_hopping_count
+
+#define _MONOMIAL_COST_END(no, field)                                   \
+  if(!monomial_cost_paused) {                                           \
+    monomial_list[no].field += gettime() - _cost_time;                  \
+    monomial_list[no].hopping += g_hopping_count - _cost_hopping;       \
+  }
+
+/* sets the accounting of all monomials to zero */
+void reset_monomial_cost();
+/* with pause = 1 the following calls are not accounted, */
+/* until called again with pause = 0                     */
+void monomial_cost_pause(const int pause);
+/* the following two are only called with MonomialForces = yes,    */
+/* since they copy and exchange the derivative field on every call */
+/* saves the derivative df before the force of a monomial is added */
+void save_monomial_force(su3adj ** const df);
+/* accumulates the norm of the force which monomial no added to df */
+/* since save_monomial_force, collective under MPI                 */
+void add_monomial_force(const int no, su3adj ** const df);
+/* appends one line per monomial for trajectory traj to filename,  */
+/* collective under MPI, only process 0 writes                     */
+int write_monomial_cost(const char * const filename, const int traj);
+
+#endif
@@ -31,6 +31,9 @@
 #include "global.h"
 #include "read_input.h"
 #include "mpi_init.h"
+#ifdef _SHM_HALO
+# include "shm_halo.h"
+#endif
 
 #ifdef MPI
 /* Datatypes for the data exchange */
@@ -79,6 +82,16 @@ MPI_Datatype lfield_z_slice_gath;
 MPI_Datatype lfield_z_slice_cont;
 MPI_Datatype field_z_slice_half;
 
+MPI_Datatype field_point32;
+MPI_Datatype field_time_slice_cont32;
+MPI_Datatype field_x_slice_cont32;
+MPI_Datatype field_x_subslice32;
+MPI_Datatype field_x_slice_gath32;
+MPI_Datatype field_y_slice_cont32;
+MPI_Datatype field_y_subslice32;
+MPI_Datatype field_y_slice_gath32;
+MPI_Datatype field_z_slice_cont32;
+
 MPI_Datatype deri_y_slice_cont;
 MPI_Datatype deri_y_subslice;
 MPI_Datatype deri_y_slice_gath;
@@ -159,6 +172,10 @@ MPI_Datatype field_z_slice_even_dn;
 MPI_Datatype field_z_slice_even_up;
 MPI_Datatype field_z_slice_odd_dn;
 MPI_Datatype field_z_slice_odd_up;
+MPI_Datatype field_z_slice_even_dn32;
+MPI_Datatype field_z_slice_even_up32;
+MPI_Datatype field_z_slice_odd_dn32;
+MPI_Datatype field_z_slice_odd_up32;
 
 # if (!defined _INDEX_INDEP_GEOM)
 spinor * field_buffer_z ALIGN;
@@ -398,6 +415,25 @@ void tmlqcd_mpi_init(int argc,char *argv[]) {
   g_nb_list[6] = g_nb_z_up;  
   g_nb_list[7] = g_nb_z_dn;
 #  endif
+#  ifdef _SHM_HALO
+  init_shm_halo();
+#  endif
+#  ifdef _COMM_THREAD
+  {
+    /* only the master thread calls MPI */
+    int provided;
+    MPI_Query_thread(&provided);
+    if(provided < MPI_THREAD_FUNNELED) {
+      if(g_proc_id == 0) {
+	fprintf(stderr, "--with-committhread needs at least MPI_THREAD_FUNNELED\n");
+	fprintf(stderr, "Aborting...!\n");
+      }
+      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Finalize();
+      exit(-1);
+    }
+  }
+#  endif
 
 
 #  if ((defined _INDEX_INDEP_GEOM) && (defined _USE_HALFSPINOR))
@@ -579,6 +615,23 @@ void tmlqcd_mpi_init(int argc,char *argv[]) {
   MPI_Type_commit(&lfield_z_slice_cont);
   MPI_Type_commit(&lfield_z_slice_gath);
 
+  /* single precision even/odd spinor fields, same structure as above */
+  MPI_Type_contiguous(24, MPI_FLOAT, &field_point32);
+  MPI_Type_contiguous(LX*LY*LZ/2, field_point32, &field_time_slice_cont32);
+  MPI_Type_commit(&field_time_slice_cont32);
+  MPI_Type_contiguous(T*LY*LZ/2, field_point32, &field_x_slice_cont32); 
+  MPI_Type_contiguous(LY*LZ/2, field_point32, &field_x_subslice32);
+  MPI_Type_vector(T, 1, LX, field_x_subslice32, &field_x_slice_gath32); 
+  MPI_Type_commit(&field_x_slice_gath32);
+  MPI_Type_commit(&field_x_slice_cont32);
+  MPI_Type_contiguous(T*LX*LZ/2, field_point32, &field_y_slice_cont32); 
+  MPI_Type_contiguous(LZ/2, field_point32, &field_y_subslice32);
+  MPI_Type_vector(T*LX, 1, LY, field_y_subslice32, &field_y_slice_gath32); 
+  MPI_Type_commit(&field_y_slice_gath32);
+  MPI_Type_commit(&field_y_slice_cont32);
+  MPI_Type_contiguous(T*LX*LY/2, field_point32, &field_z_slice_cont32);
+  MPI_Type_commit(&field_z_slice_cont32);
+
 #ifdef _USE_TSPLITPAR
   /* here I construct the xt yt zt edges for use in _USE_TSPLITPAR  */
   MPI_Type_contiguous(LY*LZ/2, field_point, &field_xt_slice_int); /* OK */
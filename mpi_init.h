@@ -86,6 +86,15 @@ extern MPI_Datatype lfield_z_slice_cont;
 extern MPI_Datatype lfield_z_slice_gath;
 extern MPI_Datatype field_z_slice_half;
 
+/* single precision spinor fields */
+extern MPI_Datatype field_point32;
+extern MPI_Datatype field_time_slice_cont32;
+extern MPI_Datatype field_x_slice_cont32;
+extern MPI_Datatype field_x_slice_gath32;
+extern MPI_Datatype field_y_slice_cont32;
+extern MPI_Datatype field_y_slice_gath32;
+extern MPI_Datatype field_z_slice_cont32;
+
 extern MPI_Datatype halffield_point;
 extern MPI_Datatype halffield_time_slice_cont;
 extern MPI_Datatype halffield_x_slice_cont;
@@ -128,6 +137,10 @@ extern MPI_Datatype field_z_slice_even_dn;
 extern MPI_Datatype field_z_slice_even_up;
 extern MPI_Datatype field_z_slice_odd_dn;
 extern MPI_Datatype field_z_slice_odd_up;
+extern MPI_Datatype field_z_slice_even_dn32;
+extern MPI_Datatype field_z_slice_even_up32;
+extern MPI_Datatype field_z_slice_odd_dn32;
+extern MPI_Datatype field_z_slice_odd_up32;
 
 # if (!defined _INDEX_INDEP_GEOM)
 extern spinor * field_buffer_z ALIGN;
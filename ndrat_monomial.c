@@ -0,0 +1,194 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+/*******************************************************************************
+ *
+ * Rational HMC monomial for the non-degenerate doublet
+ *
+ *   S = phi^dagger r(H^2) phi ,  r(x) ~ 1/sqrt(x)
+ *
+ * with the hermitian H = \hat Q tau_1 on (pf, pf2), H^2 = Q_Qdagger_ND,
+ * and the Zolotarev approximation of rational.h. This is the rational
+ * counterpart of NDPOLY, all poles are solved for at once with the
+ * doublet multi-shift solver cg_mms_tm_nd.
+ *
+ * The operators in Nondegenerate_Matrix.c are normalised with the
+ * global phmc_invmaxev and H is in addition scaled with the NDPOLY
+ * constant phmc_Cpol. Both are set to one while this monomial is
+ * evaluated, the spectrum is covered by StildeMin and StildeMax.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include "global.h"
+#include "su3.h"
+#include "start.h"
+#include "linalg_eo.h"
+#include "deriv_Sb.h"
+#include "Hopping_Matrix.h"
+#include "Nondegenerate_Matrix.h"
+#include "phmc.h"
+#include "solver/cg_mms_tm.h"
+#include "read_input.h"
+#include "hamiltonian_field.h"
+#include "boundary.h"
+#include "monomial.h"
+#include "ndrat_monomial.h"
+
+static double save_invmaxev, save_Cpol;
+
+static void ndrat_set_parameters(monomial * const mnl) {
+  save_invmaxev = phmc_invmaxev;
+  save_Cpol = phmc_Cpol;
+  phmc_invmaxev = 1.;
+  phmc_Cpol = 1.;
+  g_mubar = mnl->mubar;
+  g_epsbar = mnl->epsbar;
+  boundary(mnl->kappa);
+  return;
+}
+
+static void ndrat_reset_parameters() {
+  phmc_invmaxev = save_invmaxev;
+  phmc_Cpol = save_Cpol;
+  boundary(g_kappa);
+  return;
+}
+
+void ndrat_derivative(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+  spinor ** const xup = mnl->rat_fields;
+  spinor ** const xdn = mnl->rat_fields + np;
+
+  ndrat_set_parameters(mnl);
+  /* Recall:  The GAMMA_5 left of  delta M_eo  is done in  deriv_Sb !!! */
+
+  /* X_i = (H^2 + mu_i)^{-1} phi for all poles */
+  mnl->iter1 += cg_mms_tm_nd(xup, xdn, mnl->pf, mnl->pf2, mnl->maxiter, mnl->forceprec,
+			     g_relative_precision_flag, &Q_Qdagger_ND, np, mnl->rat.mu);
+
+  for(int i = 0; i < np; i++) {
+    mnl->forcefactor = mnl->rat.A*mnl->rat.rmu[i];
+
+    /* Y_i = H X_i -> DUM_DERI+2, DUM_DERI+3 */
+    Q_tau1_min_cconst_ND(g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+3],
+			 xup[i], xdn[i], 0.);
+
+    /* even sites of Y_i, \delta Q sandwitched by Y_e^\dagger and X_o */
+    H_eo_ND(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1],
+	    g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+3], EO);
+    deriv_Sb(EO, g_spinor_field[DUM_DERI], xup[i], hf, mnl->forcefactor);
+    deriv_Sb(EO, g_spinor_field[DUM_DERI+1], xdn[i], hf, mnl->forcefactor);
+
+    /* even sites of X_i, \delta Q sandwitched by Y_o^\dagger and X_e */
+    H_eo_ND(g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1], xup[i], xdn[i], EO);
+    deriv_Sb(OE, g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI], hf, mnl->forcefactor);
+    deriv_Sb(OE, g_spinor_field[DUM_DERI+3], g_spinor_field[DUM_DERI+1], hf, mnl->forcefactor);
+  }
+
+  ndrat_reset_parameters();
+  return;
+}
+
+
+void ndrat_heatbath(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+  spinor ** const xup = mnl->rat_fields;
+  spinor ** const xdn = mnl->rat_fields + np;
+
+  ndrat_set_parameters(mnl);
+  mnl->iter0 = 0;
+  mnl->iter1 = 0;
+
+  random_spinor_field(g_spinor_field[DUM_DERI+4], VOLUME/2, mnl->rngrepro);
+  random_spinor_field(g_spinor_field[DUM_DERI+5], VOLUME/2, mnl->rngrepro);
+  mnl->energy0 = square_norm(g_spinor_field[DUM_DERI+4], VOLUME/2, 1);
+  mnl->energy0 += square_norm(g_spinor_field[DUM_DERI+5], VOLUME/2, 1);
+
+  /* X_i = (H^2 + nu_i)^{-1} R */
+  mnl->iter0 = cg_mms_tm_nd(xup, xdn, g_spinor_field[DUM_DERI+4], g_spinor_field[DUM_DERI+5],
+			    mnl->maxiter, mnl->accprec, g_relative_precision_flag,
+			    &Q_Qdagger_ND, np, mnl->rat.nu);
+
+  /* phi = A^{-1/2} (R + H sum_i rnu_i X_i - i sum_i rnu_i sqrt(nu_i) X_i) */
+  for(int k = 0; k < 4; k++) {
+    zero_spinor_field(g_spinor_field[DUM_DERI+k], VOLUME/2);
+  }
+  for(int i = 0; i < np; i++) {
+    const _Complex double c = -I*sqrt(mnl->rat.nu[i])*mnl->rat.rnu[i];
+    assign_add_mul(g_spinor_field[DUM_DERI], xup[i], mnl->rat.rnu[i], VOLUME/2);
+    assign_add_mul(g_spinor_field[DUM_DERI+1], xdn[i], mnl->rat.rnu[i], VOLUME/2);
+    assign_add_mul(g_spinor_field[DUM_DERI+2], xup[i], c, VOLUME/2);
+    assign_add_mul(g_spinor_field[DUM_DERI+3], xdn[i], c, VOLUME/2);
+  }
+  Q_tau1_min_cconst_ND(g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+7],
+		       g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+1], 0.);
+  add(g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+2], VOLUME/2);
+  add(g_spinor_field[DUM_DERI+7], g_spinor_field[DUM_DERI+7], g_spinor_field[DUM_DERI+3], VOLUME/2);
+  add(g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+6], g_spinor_field[DUM_DERI+4], VOLUME/2);
+  add(g_spinor_field[DUM_DERI+7], g_spinor_field[DUM_DERI+7], g_spinor_field[DUM_DERI+5], VOLUME/2);
+  mul_r(mnl->pf, 1./sqrt(mnl->rat.A), g_spinor_field[DUM_DERI+6], VOLUME/2);
+  mul_r(mnl->pf2, 1./sqrt(mnl->rat.A), g_spinor_field[DUM_DERI+7], VOLUME/2);
+
+  ndrat_reset_parameters();
+  if(g_proc_id == 0 && g_debug_level > 3) {
+    printf("called ndrat_heatbath for id %d\n", id);
+  }
+  return;
+}
+
+
+double ndrat_acc(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+  spinor ** const xup = mnl->rat_fields;
+  spinor ** const xdn = mnl->rat_fields + np;
+  int save_sloppy = g_sloppy_precision_flag;
+
+  ndrat_set_parameters(mnl);
+  g_sloppy_precision_flag = 0;
+
+  /* X_i = (H^2 + mu_i)^{-1} phi */
+  mnl->iter0 += cg_mms_tm_nd(xup, xdn, mnl->pf, mnl->pf2, mnl->maxiter, mnl->accprec,
+			     g_relative_precision_flag, &Q_Qdagger_ND, np, mnl->rat.mu);
+  g_sloppy_precision_flag = save_sloppy;
+
+  /* the partial fractions reuse the same solutions */
+  mnl->energy1 = square_norm(mnl->pf, VOLUME/2, 1) + square_norm(mnl->pf2, VOLUME/2, 1);
+  for(int i = 0; i < np; i++) {
+    mnl->energy1 += mnl->rat.rmu[i]*(scalar_prod_r(mnl->pf, xup[i], VOLUME/2, 1)
+				     + scalar_prod_r(mnl->pf2, xdn[i], VOLUME/2, 1));
+  }
+  mnl->energy1 *= mnl->rat.A;
+
+  ndrat_reset_parameters();
+  if(g_proc_id == 0 && g_debug_level > 3) {
+    printf("called ndrat_acc for id %d dH = %1.4e\n", 
+	   id, mnl->energy1 - mnl->energy0);
+  }
+  return(mnl->energy1 - mnl->energy0);
+}
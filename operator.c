@@ -41,6 +41,7 @@
 #include "Nondegenerate_Matrix.h"
 #include "Hopping_Matrix.h"
 #include "invert_eo.h"
+#include "prepare_source.h"
 #include "invert_doublet_eo.h"
 #include "invert_overlap.h"
 #include "invert_clover_eo.h"
@@ -177,6 +178,16 @@ int init_operators() {
           fprintf(stderr, "CGMMS doesn't need AddDownPropagator! Switching Off!\n");
         optr->DownProp = 0;
       }
+      if(optr->solver == BCG && (optr->even_odd_flag == 0 || optr->c_sw > 0)) {
+        if (g_cart_id == 0)
+          fprintf(stderr, "Block CG works only with even/odd and without clover term! Forcing CG!\n");
+        optr->solver = CG;
+      }
+      if(optr->solver == CGCG && (optr->even_odd_flag == 0 || optr->c_sw > 0)) {
+        if (g_cart_id == 0)
+          fprintf(stderr, "CGCG works only with even/odd and without clover term! Forcing CG!\n");
+        optr->solver = CG;
+      }
     }
     else if(optr->type == OVERLAP) {
       optr->even_odd_flag = 0;
@@ -193,6 +204,16 @@ int init_operators() {
       /* 	exit(0); */
       /*       } */
     }
+    if(optr->solver == BCG && optr->type != TMWILSON && optr->type != WILSON) {
+      if (g_cart_id == 0)
+        fprintf(stderr, "Block CG is only available for (twisted mass) Wilson operators! Forcing CG!\n");
+      optr->solver = CG;
+    }
+    if(optr->solver == CGCG && optr->type != TMWILSON && optr->type != WILSON) {
+      if (g_cart_id == 0)
+        fprintf(stderr, "CGCG is only available for (twisted mass) Wilson operators! Forcing CG!\n");
+      optr->solver = CG;
+    }
   }
   return(0);
 }
@@ -384,6 +405,141 @@ void op_invert(const int op_id, const int index_start) {
   return;
 }
 
+/* op_invert_block prepares all no_samples*(index_end-index_start)
+ * sources of operator op_id and inverts them in a single call
+ * to the block CG solver. The propagators are written in the
+ * same order as by the source by source loop in invert.c
+ */
+
+void op_invert_block(const int op_id, const int index_start, const int index_end,
+                     const int nstore, const int read_source_flag, const int source_location) {
+  operator * optr = &operator_list[op_id];
+  const int N = VOLUMEPLUSRAND/2;
+  const int nrhs = no_samples*(index_end - index_start);
+  double atime = 0., etime = 0., nrm1 = 0., nrm2 = 0.;
+  int i, j, iter[2] = {0, 0};
+  int * sinfo = NULL;
+  double * prec = NULL;
+  spinor * sp_ = NULL, * sp = NULL;
+  spinor ** sr0, ** sr1, ** pr0[2], ** pr1[2];
+
+  sp_ = (spinor*)malloc((6*nrhs*N+1)*sizeof(spinor));
+  sr0 = (spinor**)malloc(6*nrhs*sizeof(spinor*));
+  sinfo = (int*)malloc(4*nrhs*sizeof(int));
+  prec = (double*)malloc(2*nrhs*sizeof(double));
+  if(sp_ == NULL || sr0 == NULL || sinfo == NULL || prec == NULL) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "Not enough memory for %d block CG right hand sides, inverting them one by one!\n", nrhs);
+    }
+    free(sp_); free(sr0); free(sinfo); free(prec);
+    for(int isample = 0; isample < no_samples; isample++) {
+      for(int ix = index_start; ix < index_end; ix++) {
+        prepare_source(nstore, isample, ix, op_id, read_source_flag, source_location);
+        optr->inverter(op_id, index_start);
+      }
+    }
+    return;
+  }
+  sp = (spinor*)(((unsigned long int)(sp_)+ALIGN_BASE)&~ALIGN_BASE);
+  for(j = 0; j < 6*nrhs; j++) {
+    sr0[j] = sp + j*N;
+  }
+  sr1 = sr0 + nrhs;
+  pr0[0] = sr0 + 2*nrhs;
+  pr1[0] = sr0 + 3*nrhs;
+  pr0[1] = sr0 + 4*nrhs;
+  pr1[1] = sr0 + 5*nrhs;
+
+  /* collect all sources, prepare_source uses optr->sr0 etc. */
+  j = 0;
+  for(int isample = 0; isample < no_samples; isample++) {
+    for(int ix = index_start; ix < index_end; ix++, j++) {
+      prepare_source(nstore, isample, ix, op_id, read_source_flag, source_location);
+      assign(sr0[j], optr->sr0, VOLUME/2);
+      assign(sr1[j], optr->sr1, VOLUME/2);
+      assign(pr0[0][j], optr->prop0, VOLUME/2);
+      assign(pr1[0][j], optr->prop1, VOLUME/2);
+      sinfo[4*j] = SourceInfo.nstore;
+      sinfo[4*j+1] = SourceInfo.sample;
+      sinfo[4*j+2] = SourceInfo.ix;
+      sinfo[4*j+3] = SourceInfo.t;
+    }
+  }
+
+  g_kappa = optr->kappa;
+  boundary(g_kappa);
+  g_c_sw = optr->c_sw;
+  g_precWS = NULL;
+
+  atime = gettime();
+  for(i = 0; i < 2; i++) {
+    g_mu = optr->mu;
+    if (g_cart_id == 0) {
+      printf("#\n# 2 kappa mu = %e, kappa = %e, c_sw = %e\n", g_mu, g_kappa, g_c_sw);
+    }
+    /* the second flavour starts from the solution of the first one */
+    if(i == 1) {
+      for(j = 0; j < nrhs; j++) {
+        assign(pr0[1][j], pr0[0][j], VOLUME/2);
+        assign(pr1[1][j], pr1[0][j], VOLUME/2);
+      }
+    }
+    iter[i] = invert_eo_block(pr0[i], pr1[i], sr0, sr1, nrhs,
+                              optr->eps_sq, optr->maxiter, optr->rel_prec);
+
+    for(j = 0; j < nrhs; j++) {
+      /* check result */
+      M_full(g_spinor_field[4], g_spinor_field[5], pr0[i][j], pr1[i][j]);
+      diff(g_spinor_field[4], g_spinor_field[4], sr0[j], VOLUME / 2);
+      diff(g_spinor_field[5], g_spinor_field[5], sr1[j], VOLUME / 2);
+      nrm1 = square_norm(g_spinor_field[4], VOLUME / 2, 1);
+      nrm2 = square_norm(g_spinor_field[5], VOLUME / 2, 1);
+      prec[2*j+i] = nrm1 + nrm2;
+      /* convert to standard normalisation  */
+      /* we have to mult. by 2*kappa        */
+      if (optr->kappa != 0.) {
+        mul_r(pr0[i][j], (2*optr->kappa), pr0[i][j], VOLUME / 2);
+        mul_r(pr1[i][j], (2*optr->kappa), pr1[i][j], VOLUME / 2);
+      }
+    }
+    if(optr->DownProp) {
+      optr->mu = -optr->mu;
+    } else 
+      break;
+  }
+  etime = gettime();
+
+  /* write the propagators source by source */
+  for(j = 0; j < nrhs; j++) {
+    SourceInfo.nstore = sinfo[4*j];
+    SourceInfo.sample = sinfo[4*j+1];
+    SourceInfo.ix = sinfo[4*j+2];
+    SourceInfo.t = sinfo[4*j+3];
+    assign(optr->sr0, sr0[j], VOLUME/2);
+    assign(optr->sr1, sr1[j], VOLUME/2);
+    for(i = 0; i < 1 + (optr->DownProp != 0); i++) {
+      assign(optr->prop0, pr0[i][j], VOLUME/2);
+      assign(optr->prop1, pr1[i][j], VOLUME/2);
+      optr->iterations = iter[i];
+      optr->reached_prec = prec[2*j+i];
+      optr->write_prop(op_id, index_start, i);
+      if (g_cart_id == 0 && g_debug_level > 0) {
+        fprintf(stdout, "# Inversion of source %d done in %d block iterations, squared residue = %e!\n",
+                j, optr->iterations, optr->reached_prec);
+      }
+    }
+  }
+  if (g_cart_id == 0 && g_debug_level > 0) {
+    fprintf(stdout, "# Block inversion of %d sources done in %1.2e sec. \n", nrhs, etime - atime);
+  }
+
+  free(prec);
+  free(sinfo);
+  free(sr0);
+  free(sp_);
+  return;
+}
+
 
 void op_write_prop(const int op_id, const int index_start, const int append_) {
   operator * optr = &operator_list[op_id];
@@ -113,5 +113,7 @@ extern int no_operators;
 
 int add_operator(const int type);
 int init_operators();
+void op_invert_block(const int op_id, const int index_start, const int index_end,
+                     const int nstore, const int read_source_flag, const int source_location);
 
 #endif
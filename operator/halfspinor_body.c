@@ -25,11 +25,20 @@
 
 
 int ix;
-su3 * restrict U ALIGN;
+su3_copy * restrict U ALIGN;
 spinor * restrict s ALIGN;
 halfspinor * restrict * phi ALIGN;
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
 halfspinor32 * restrict * phi32 ALIGN;
+#endif
+const int * restrict order;
+#ifndef OMP
+su3_copy * restrict u0 ALIGN;
+#endif
 _declare_hregs();
+#ifdef _GAUGE_COMPRESSION
+su3 Ur ALIGN;
+#endif
 
 #ifdef XLC
 # pragma disjoint(*l, *k)
@@ -49,41 +58,27 @@ __alignx(32, s);
 #pragma pomp inst begin(hoppingmatrix)
 #endif
 
-#ifndef OMP  
-s = k;
-_prefetch_spinor(s);
-if(ieo == 0) {
-  U = g_gauge_field_copy[0][0];
- }
- else {
-   U = g_gauge_field_copy[1][0];
- }
-_prefetch_su3(U);
-#else
 if(ieo == 0) {
   u0 = g_gauge_field_copy[0][0];
  }
  else {
    u0 = g_gauge_field_copy[1][0];
  }
-#endif
-#if (defined SSE2 || defined SSE3)
-g_sloppy_precision = 0;
-#endif
+/* the sites of k are visited in g_eo_site_order */
+order = g_eo_site_order + ((ieo+1)%2)*(VOLUME/2);
+/* the SSE and AVX2 kernels have no 32 bit halfspinors */
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
 if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
   phi32 = NBPointer32[ieo];
   
 #ifdef OMP
 #pragma omp for
-#else
-  ix=0;
 #endif
-  for(unsigned int i = 0; i < (VOLUME)/2; i++){
-#ifdef OMP
+  for(unsigned int n = 0; n < (VOLUME)/2; n++){
+    const unsigned int i = order[n];
     U=u0+i*4;
     s=k+i;
     ix=i*8;
-#endif
     _hop_t_p_pre32();
     U++;
     ix++;
@@ -110,11 +105,6 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
     ix++;
     
     _hop_z_m_pre32();
-    
-#ifndef OMP
-    s++;
-    ix++;
-#endif
   }
   
 #ifdef OMP
@@ -154,36 +144,24 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
   }
 #endif
   
-#ifndef OMP
-  s = l;
-  if(ieo == 0) {
-    U = g_gauge_field_copy[1][0];
-  }
-  else {
-    U = g_gauge_field_copy[0][0];
-  }
-#else
   if(ieo == 0) {
     u0 = g_gauge_field_copy[1][0];
   }
   else {
     u0 = g_gauge_field_copy[0][0];
   }
-#endif
+  order = g_eo_site_order + ieo*(VOLUME/2);
   
   phi32 = NBPointer32[2 + ieo];
   
 #ifdef OMP
 #pragma omp for
-#else
-  ix = 0;
 #endif
-  for(unsigned int i = 0; i < (VOLUME)/2; i++){
-#ifdef OMP
+  for(unsigned int n = 0; n < (VOLUME)/2; n++){
+    const unsigned int i = order[n];
     ix=i*8;
     s=l+i;
     U=u0+i*4;
-#endif
 #ifdef _TM_SUB_HOP
      pn=p+i;
 #endif
@@ -220,30 +198,28 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
 #else
     _hop_store_post(s);
 #endif
-    
-#ifndef OMP
-    U++;
-    ix++;
-    s++;
-#endif
   }
  }
  else {
+#endif
+#if (defined _OVERLAP_COMM && defined MPI && !defined _NO_COMM && !defined SPI)
+   if(g_overlap_comm) {
+#  include "operator/halfspinor_body_overlap.c"
+   }
+   else {
+#endif
    phi = NBPointer[ieo];
    
 #ifdef OMP
 #pragma omp for
-#else
-   ix=0;
 #endif
-   for(unsigned int i = 0; i < (VOLUME)/2; i++){
-#ifdef OMP
+   for(unsigned int n = 0; n < (VOLUME)/2; n++){
+     const unsigned int i = order[n];
      s=k+i;
      _prefetch_spinor(s);
      ix=i*8;
      U=u0+i*4;
      _prefetch_su3(U);
-#endif
      
      _hop_t_p_pre();
      U++;
@@ -271,11 +247,6 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
      ix++;
      
      _hop_z_m_pre();
-     
-#ifndef OMP
-     s++;            
-     ix++;
-#endif
    }
    
 #ifdef OMP
@@ -316,40 +287,27 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
    }
 #endif
    
-#ifndef OMP
-   s = l;
-   if(ieo == 0) {
-     U = g_gauge_field_copy[1][0];
-   }
-   else {
-     U = g_gauge_field_copy[0][0];
-   }
-   _prefetch_su3(U);
-#else
    if(ieo == 0) {
      u0 = g_gauge_field_copy[1][0];
    }
    else {
      u0 = g_gauge_field_copy[0][0];
    }
-#endif
+   order = g_eo_site_order + ieo*(VOLUME/2);
    
    phi = NBPointer[2 + ieo];
    
 #ifdef OMP
 #pragma omp for
-#else
-   ix = 0;
 #endif
    /* #pragma ivdep */
-   for(unsigned int i = 0; i < (VOLUME)/2; i++){
-#ifdef OMP
+   for(unsigned int n = 0; n < (VOLUME)/2; n++){
+     const unsigned int i = order[n];
      ix=i*8;
      U=u0+i*4;
      _prefetch_su3(U);
      s=l+i;
      _prefetch_spinor(s);
-#endif
 #ifdef _TM_SUB_HOP
      pn=p+i;
 #endif
@@ -386,14 +344,13 @@ if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
 #else
      _hop_store_post(s);
 #endif
-     
-#ifndef OMP
-     U++;
-     ix++;
-     s++;
-#endif
    }
+#if (defined _OVERLAP_COMM && defined MPI && !defined _NO_COMM && !defined SPI)
+   }
+#endif /* _OVERLAP_COMM */
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
  }
+#endif
 #ifdef _KOJAK_INST
 #pragma pomp inst end(hoppingmatrix)
 #endif
@@ -0,0 +1,293 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2003, 2004, 2005, 2006, 2007, 2008, 2012 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator 
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002 
+ * this is a new version based on the aforementioned implementations
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * multiple right hand side version of halfspinor_body.c
+ *
+ * the loops run over sites and within a site over the nrhs
+ * fields, so the four gauge links of a site are read from
+ * memory once and stay in cache for all fields. The macros
+ * of halfspinor_hopping.h are used unchanged, phi points to
+ * the eight halfspinors of the current site and field.
+ * With g_sloppy_precision the halfspinors are stored and
+ * exchanged in 32 bit, as in halfspinor_body.c.
+ *
+ **********************************************************************/
+
+
+int ix;
+su3_copy * restrict U ALIGN;
+spinor * restrict s ALIGN;
+halfspinor * phi[12] ALIGN;
+halfspinor ** nbp;
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
+halfspinor32 * phi32[12] ALIGN;
+halfspinor32 ** nbp32;
+#endif
+_declare_hregs();
+#ifdef _GAUGE_COMPRESSION
+su3 Ur ALIGN;
+#endif
+
+#ifndef OMP
+su3_copy * restrict u0 ALIGN;
+#endif
+
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
+if(g_sloppy_precision == 1 && g_sloppy_precision_flag == 1) {
+  if(ieo == 0) {
+    u0 = g_gauge_field_copy[0][0];
+  }
+  else {
+    u0 = g_gauge_field_copy[1][0];
+  }
+  nbp32 = NBPointer32_nrhs[ieo];
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(unsigned int i = 0; i < (VOLUME)/2; i++){
+    for(int r = 0; r < nrhs; r++) {
+      U = u0 + i*4;
+      s = k + i*nrhs + r;
+      for(ix = 0; ix < 8; ix++) {
+        phi32[ix] = nbp32[8*i + ix] + r;
+      }
+      for(ix = 8; ix < 12; ix++) {
+        phi32[ix] = phi32[0];
+      }
+      ix = 0;
+      _hop_t_p_pre32();
+      U++;
+      ix++;
+      
+      _hop_t_m_pre32();
+      ix++;
+      
+      _hop_x_p_pre32();
+      U++;
+      ix++;
+      
+      _hop_x_m_pre32();
+      ix++;
+      
+      _hop_y_p_pre32();
+      U++;
+      ix++;
+      
+      _hop_y_m_pre32();
+      ix++;
+      
+      _hop_z_p_pre32();
+      U++;
+      ix++;
+      
+      _hop_z_m_pre32();
+    }
+  }
+
+#ifdef OMP
+#pragma omp single
+  {
+#endif
+    
+#    if (defined MPI && !defined _NO_COMM)
+    xchange_halffield32_nrhs(nrhs); 
+#    endif
+    
+#ifdef OMP
+  }
+#endif
+
+  if(ieo == 0) {
+    u0 = g_gauge_field_copy[1][0];
+  }
+  else {
+    u0 = g_gauge_field_copy[0][0];
+  }
+  nbp32 = NBPointer32_nrhs[2 + ieo];
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(unsigned int i = 0; i < (VOLUME)/2; i++){
+    for(int r = 0; r < nrhs; r++) {
+      U = u0 + i*4;
+      s = l + i*nrhs + r;
+      for(ix = 0; ix < 8; ix++) {
+        phi32[ix] = nbp32[8*i + ix] + r;
+      }
+      for(ix = 8; ix < 12; ix++) {
+        phi32[ix] = phi32[0];
+      }
+      ix = 0;
+      _hop_t_p_post32();
+      ix++;
+      
+      _hop_t_m_post32();
+      ix++;
+      U++;
+      
+      _hop_x_p_post32();
+      ix++;
+      
+      _hop_x_m_post32();
+      U++;
+      ix++;
+      
+      _hop_y_p_post32();
+      ix++;
+      
+      _hop_y_m_post32();
+      U++;
+      ix++;
+      
+      _hop_z_p_post32();
+      ix++;
+      
+      _hop_z_m_post32();
+      
+      _hop_store_post(s);
+    }
+  }
+ }
+ else {
+#endif
+if(ieo == 0) {
+  u0 = g_gauge_field_copy[0][0];
+ }
+ else {
+   u0 = g_gauge_field_copy[1][0];
+ }
+nbp = NBPointer_nrhs[ieo];
+
+#ifdef OMP
+#pragma omp for
+#endif
+for(unsigned int i = 0; i < (VOLUME)/2; i++){
+  for(int r = 0; r < nrhs; r++) {
+    U = u0 + i*4;
+    s = k + i*nrhs + r;
+    for(ix = 0; ix < 8; ix++) {
+      phi[ix] = nbp[8*i + ix] + r;
+    }
+    for(ix = 8; ix < 12; ix++) {
+      phi[ix] = phi[0];
+    }
+    ix = 0;
+    _hop_t_p_pre();
+    U++;
+    ix++;
+    
+    _hop_t_m_pre();
+    ix++;
+    
+    _hop_x_p_pre();
+    U++;
+    ix++;
+    
+    _hop_x_m_pre();
+    ix++;
+    
+    _hop_y_p_pre();
+    U++;
+    ix++;
+    
+    _hop_y_m_pre();
+    ix++;
+    
+    _hop_z_p_pre();
+    U++;
+    ix++;
+    
+    _hop_z_m_pre();
+  }
+ }
+
+#ifdef OMP
+#pragma omp single
+{
+#endif
+  
+#    if (defined MPI && !defined _NO_COMM)
+  xchange_halffield_nrhs(nrhs); 
+#    endif
+  
+#ifdef OMP
+}
+#endif
+
+if(ieo == 0) {
+  u0 = g_gauge_field_copy[1][0];
+ }
+ else {
+   u0 = g_gauge_field_copy[0][0];
+ }
+nbp = NBPointer_nrhs[2 + ieo];
+
+#ifdef OMP
+#pragma omp for
+#endif
+for(unsigned int i = 0; i < (VOLUME)/2; i++){
+  for(int r = 0; r < nrhs; r++) {
+    U = u0 + i*4;
+    s = l + i*nrhs + r;
+    for(ix = 0; ix < 8; ix++) {
+      phi[ix] = nbp[8*i + ix] + r;
+    }
+    for(ix = 8; ix < 12; ix++) {
+      phi[ix] = phi[0];
+    }
+    ix = 0;
+    _hop_t_p_post();
+    ix++;
+    
+    _hop_t_m_post();
+    ix++;
+    U++;
+    
+    _hop_x_p_post();
+    ix++;
+    
+    _hop_x_m_post();
+    U++;
+    ix++;
+    
+    _hop_y_p_post();
+    ix++;
+    
+    _hop_y_m_post();
+    U++;
+    ix++;
+    
+    _hop_z_p_post();
+    ix++;
+    
+    _hop_z_m_post();
+    
+    _hop_store_post(s);
+  }
+ }
+#if !(defined SSE2 || defined SSE3 || defined AVX2)
+ }
+#endif
@@ -0,0 +1,273 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2003, 2004, 2005, 2006, 2007, 2008, 2012 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * double precision part of halfspinor_body.c with the halfspinor
+ * exchange overlapped with computation:
+ *
+ * 1. project the sites which fill sendBuffer
+ * 2. post the sends and receives
+ * 3. project the remaining sites
+ * 4. reconstruct the sites which don't need recvBuffer
+ * 5. wait for the exchange
+ * 6. reconstruct the sites which need recvBuffer
+ *
+ * the site orderings are NBOrder from init_dirac_halfspinor
+ *
+ * with _COMM_THREAD the master thread only progresses the exchange
+ * (MPI_THREAD_FUNNELED is enough) until it is complete, the other
+ * threads take the sites of 3. and 4. in chunks. The master joins
+ * the remaining chunks once the exchange is done.
+ *
+ **********************************************************************/
+
+su3_copy * restrict ub ALIGN;
+
+#define _hop_pre_site()				\
+  _hop_t_p_pre();				\
+  U++;						\
+  ix++;						\
+  _hop_t_m_pre();				\
+  ix++;						\
+  _hop_x_p_pre();				\
+  U++;						\
+  ix++;						\
+  _hop_x_m_pre();				\
+  ix++;						\
+  _hop_y_p_pre();				\
+  U++;						\
+  ix++;						\
+  _hop_y_m_pre();				\
+  ix++;						\
+  _hop_z_p_pre();				\
+  U++;						\
+  ix++;						\
+  _hop_z_m_pre();
+
+#define _hop_post_site()			\
+  _hop_t_p_post();				\
+  ix++;						\
+  _hop_t_m_post();				\
+  ix++;						\
+  U++;						\
+  _hop_x_p_post();				\
+  ix++;						\
+  _hop_x_m_post();				\
+  U++;						\
+  ix++;						\
+  _hop_y_p_post();				\
+  ix++;						\
+  _hop_y_m_post();				\
+  U++;						\
+  ix++;						\
+  _hop_z_p_post();				\
+  ix++;						\
+  _hop_z_m_post();
+
+if(ieo == 0) {
+  ub = g_gauge_field_copy[0][0];
+ }
+ else {
+   ub = g_gauge_field_copy[1][0];
+ }
+phi = NBPointer[ieo];
+
+#if (defined _COMM_THREAD && defined OMP)
+/* next chunk of 3. and 4., shared by the threads */
+static int ct_next[2];
+#  define _CT_CHUNK 32
+#pragma omp master
+{
+  ct_next[0] = 0;
+  ct_next[1] = 0;
+}
+#endif
+
+/* 1. boundary sites, their halfspinors go to sendBuffer */
+#ifdef OMP
+#pragma omp for
+#endif
+for(int n = 0; n < NBOrderSplit[ieo]; n++) {
+  const int i = NBOrder[ieo][n];
+  s = k + i;
+  _prefetch_spinor(s);
+  ix = i*8;
+  U = ub + i*4;
+  _prefetch_su3(U);
+  _hop_pre_site();
+ }
+
+/* 2. the implicit barrier above makes sendBuffer complete */
+#ifdef OMP
+#pragma omp master
+#endif
+xchange_halffield_start();
+
+/* 3. interior sites */
+#if (defined _COMM_THREAD && defined OMP)
+{
+  const int comm_thread = (omp_get_thread_num() == 0 && omp_get_num_threads() > 1);
+  const int nchunks = ((VOLUME)/2 - NBOrderSplit[ieo] + _CT_CHUNK - 1)/_CT_CHUNK;
+  int c, left;
+  for(;;) {
+    if(comm_thread && !xchange_halffield_test()) {
+#pragma omp atomic read
+      left = ct_next[0];
+      if(left >= nchunks) break;
+      continue;
+    }
+#pragma omp atomic capture
+    c = ct_next[0]++;
+    if(c >= nchunks) break;
+    const int nend = NBOrderSplit[ieo] + (c+1)*_CT_CHUNK < (VOLUME)/2 ? NBOrderSplit[ieo] + (c+1)*_CT_CHUNK : (VOLUME)/2;
+    for(int n = NBOrderSplit[ieo] + c*_CT_CHUNK; n < nend; n++) {
+      const int i = NBOrder[ieo][n];
+      s = k + i;
+      _prefetch_spinor(s);
+      ix = i*8;
+      U = ub + i*4;
+      _prefetch_su3(U);
+      _hop_pre_site();
+    }
+  }
+}
+#pragma omp barrier
+#else
+#ifdef OMP
+#pragma omp for
+#endif
+for(int n = NBOrderSplit[ieo]; n < (VOLUME)/2; n++) {
+  const int i = NBOrder[ieo][n];
+  s = k + i;
+  _prefetch_spinor(s);
+  ix = i*8;
+  U = ub + i*4;
+  _prefetch_su3(U);
+  _hop_pre_site();
+ }
+#endif
+
+if(ieo == 0) {
+  ub = g_gauge_field_copy[1][0];
+ }
+ else {
+   ub = g_gauge_field_copy[0][0];
+ }
+phi = NBPointer[2 + ieo];
+
+/* 4. sites with all neighbours local, the thread */
+/*    finishing first goes on to the wait         */
+#if (defined _COMM_THREAD && defined OMP)
+{
+  const int comm_thread = (omp_get_thread_num() == 0 && omp_get_num_threads() > 1);
+  const int nchunks = (NBOrderSplit[2 + ieo] + _CT_CHUNK - 1)/_CT_CHUNK;
+  int c, left;
+  for(;;) {
+    if(comm_thread && !xchange_halffield_test()) {
+#pragma omp atomic read
+      left = ct_next[1];
+      if(left >= nchunks) break;
+      continue;
+    }
+#pragma omp atomic capture
+    c = ct_next[1]++;
+    if(c >= nchunks) break;
+    const int nend = (c+1)*_CT_CHUNK < NBOrderSplit[2 + ieo] ? (c+1)*_CT_CHUNK : NBOrderSplit[2 + ieo];
+    for(int n = c*_CT_CHUNK; n < nend; n++) {
+      const int i = NBOrder[2 + ieo][n];
+      ix = i*8;
+      U = ub + i*4;
+      _prefetch_su3(U);
+      s = l + i;
+      _prefetch_spinor(s);
+#ifdef _TM_SUB_HOP
+      pn = p + i;
+#endif
+      _hop_post_site();
+#ifdef _MUL_G5_CMPLX
+      _hop_mul_g5_cmplx_and_store(s);
+#elif defined _TM_SUB_HOP
+      _g5_cmplx_sub_hop_and_g5store(s);
+#else
+      _hop_store_post(s);
+#endif
+    }
+  }
+}
+#  undef _CT_CHUNK
+#else
+#ifdef OMP
+#pragma omp for nowait
+#endif
+for(int n = 0; n < NBOrderSplit[2 + ieo]; n++) {
+  const int i = NBOrder[2 + ieo][n];
+  ix = i*8;
+  U = ub + i*4;
+  _prefetch_su3(U);
+  s = l + i;
+  _prefetch_spinor(s);
+#ifdef _TM_SUB_HOP
+  pn = p + i;
+#endif
+  _hop_post_site();
+#ifdef _MUL_G5_CMPLX
+  _hop_mul_g5_cmplx_and_store(s);
+#elif defined _TM_SUB_HOP
+  _g5_cmplx_sub_hop_and_g5store(s);
+#else
+  _hop_store_post(s);
+#endif
+ }
+#endif
+
+/* 5. */
+#ifdef OMP
+#pragma omp master
+#endif
+xchange_halffield_wait();
+#ifdef OMP
+#pragma omp barrier
+#endif
+
+/* 6. sites reading recvBuffer */
+#ifdef OMP
+#pragma omp for
+#endif
+for(int n = NBOrderSplit[2 + ieo]; n < (VOLUME)/2; n++) {
+  const int i = NBOrder[2 + ieo][n];
+  ix = i*8;
+  U = ub + i*4;
+  _prefetch_su3(U);
+  s = l + i;
+  _prefetch_spinor(s);
+#ifdef _TM_SUB_HOP
+  pn = p + i;
+#endif
+  _hop_post_site();
+#ifdef _MUL_G5_CMPLX
+  _hop_mul_g5_cmplx_and_store(s);
+#elif defined _TM_SUB_HOP
+  _g5_cmplx_sub_hop_and_g5store(s);
+#else
+  _hop_store_post(s);
+#endif
+ }
+
+#undef _hop_pre_site
+#undef _hop_post_site
@@ -0,0 +1,181 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2003, 2004, 2005, 2006, 2007, 2008, 2012 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002
+ * this is a new version based on the aforementioned implementations
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * single precision version of halfspinor_body.c
+ * in- and output fields are spinor32, the gauge field is
+ * g_gauge_field_copy_32 and the halfspinor buffers and
+ * communication are the ones of init_dirac_halfspinor32
+ *
+ **********************************************************************/
+
+
+int ix;
+su3_copy_32 * restrict U ALIGN;
+spinor32 * restrict s ALIGN;
+halfspinor32 * restrict * phi32 ALIGN;
+_declare_hregs_sgl();
+#ifdef _GAUGE_COMPRESSION
+su3_32 Ur ALIGN;
+#endif
+
+#ifndef OMP
+s = k;
+if(ieo == 0) {
+  U = g_gauge_field_copy_32[0][0];
+ }
+ else {
+   U = g_gauge_field_copy_32[1][0];
+ }
+#else
+if(ieo == 0) {
+  u0 = g_gauge_field_copy_32[0][0];
+ }
+ else {
+   u0 = g_gauge_field_copy_32[1][0];
+ }
+#endif
+
+phi32 = NBPointer32[ieo];
+
+#ifdef OMP
+#pragma omp for
+#else
+ix=0;
+#endif
+for(unsigned int i = 0; i < (VOLUME)/2; i++){
+#ifdef OMP
+  U=u0+i*4;
+  s=k+i;
+  ix=i*8;
+#endif
+  _hop_t_p_pre_sgl();
+  U++;
+  ix++;
+
+  _hop_t_m_pre_sgl();
+  ix++;
+
+  _hop_x_p_pre_sgl();
+  U++;
+  ix++;
+
+  _hop_x_m_pre_sgl();
+  ix++;
+
+  _hop_y_p_pre_sgl();
+  U++;
+  ix++;
+
+  _hop_y_m_pre_sgl();
+  ix++;
+
+  _hop_z_p_pre_sgl();
+  U++;
+  ix++;
+
+  _hop_z_m_pre_sgl();
+
+#ifndef OMP
+  s++;
+  ix++;
+#endif
+ }
+
+#ifdef OMP
+#pragma omp single
+{
+#endif
+
+#    if (defined MPI && !defined _NO_COMM)
+  xchange_halffield32();
+#    endif
+
+#ifdef OMP
+}
+#endif
+
+#ifndef OMP
+s = l;
+if(ieo == 0) {
+  U = g_gauge_field_copy_32[1][0];
+ }
+ else {
+   U = g_gauge_field_copy_32[0][0];
+ }
+#else
+if(ieo == 0) {
+  u0 = g_gauge_field_copy_32[1][0];
+ }
+ else {
+   u0 = g_gauge_field_copy_32[0][0];
+ }
+#endif
+
+phi32 = NBPointer32[2 + ieo];
+
+#ifdef OMP
+#pragma omp for
+#else
+ix = 0;
+#endif
+for(unsigned int i = 0; i < (VOLUME)/2; i++){
+#ifdef OMP
+  ix=i*8;
+  s=l+i;
+  U=u0+i*4;
+#endif
+  _hop_t_p_post_sgl();
+  ix++;
+
+  _hop_t_m_post_sgl();
+  ix++;
+  U++;
+
+  _hop_x_p_post_sgl();
+  ix++;
+
+  _hop_x_m_post_sgl();
+  U++;
+  ix++;
+
+  _hop_y_p_post_sgl();
+  ix++;
+
+  _hop_y_m_post_sgl();
+  U++;
+  ix++;
+
+  _hop_z_p_post_sgl();
+  ix++;
+
+  _hop_z_m_post_sgl();
+
+  _hop_store_post_sgl(s);
+
+#ifndef OMP
+  U++;
+  ix++;
+  s++;
+#endif
+ }
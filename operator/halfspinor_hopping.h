@@ -28,7 +28,178 @@
 #ifndef _HALFSPINOR_HOPPING_H
 #define _HALFSPINOR_HOPPING_H
 
-#if (defined SSE2 || defined SSE3)
+#if (defined AVX2)
+
+/*
+ * AVX2+FMA version, see avx.h for the pair layout
+ * hA = [s0, s1], hB = [s2, s3] and hC = [s3, s2] of the input
+ * spinor are loaded in _hop_t_p_pre and kept in registers for
+ * the remaining directions, the result accumulates in
+ * hR = [s0, s1] and hQ = [s2, s3] and is written by the store macros
+ * hpm = (+1, +1, -1, -1) flips the sign of the second su3_vector
+ */
+
+#define _hop_t_p_pre32()
+#define _hop_t_m_pre32()
+#define _hop_x_p_pre32()
+#define _hop_x_m_pre32()
+#define _hop_y_p_pre32()
+#define _hop_y_m_pre32()
+#define _hop_z_p_pre32()
+#define _hop_z_m_pre32()
+#define _hop_t_p_post32()
+#define _hop_t_m_post32()
+#define _hop_x_p_post32()
+#define _hop_x_m_post32()
+#define _hop_y_p_post32()
+#define _hop_y_m_post32()
+#define _hop_z_p_post32()
+#define _hop_z_m_post32()
+
+#define _hop_t_p_pre()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_load_pair(hA, s->s0, s->s1);			\
+  _avx_load_pair(hB, s->s2, s->s3);			\
+  _avx_pair_swap_hl(hC, hB);				\
+  _avx_pair_add(hH, hA, hB);				\
+  _avx_su3_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplx_mul(hH, hG, ka0);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_t_m_pre()					\
+  _avx_pair_sub(hH, hA, hB);				\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_x_p_pre()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_pair_i_mul(hD, hC);				\
+  _avx_pair_add(hH, hA, hD);				\
+  _avx_su3_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplx_mul(hH, hG, ka1);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_x_m_pre()					\
+  _avx_pair_sub(hH, hA, hD);				\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_y_p_pre()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_pair_sgn_add(hH, hA, hpm, hC);			\
+  _avx_su3_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplx_mul(hH, hG, ka2);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_y_m_pre()					\
+  _avx_pair_sgn_sub(hH, hA, hpm, hC);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_z_p_pre()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_pair_i_mul(hD, hB);				\
+  _avx_pair_sgn_add(hH, hA, hpm, hD);			\
+  _avx_su3_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplx_mul(hH, hG, ka3);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_z_m_pre()					\
+  _avx_pair_sgn_sub(hH, hA, hpm, hD);			\
+  _avx_store_pair(phi[ix]->s0, phi[ix]->s1, hH);
+
+#define _hop_t_p_post()					\
+  _avx_load_pair(hR, phi[ix]->s0, phi[ix]->s1);		\
+  hQ[0] = hR[0];					\
+  hQ[1] = hR[1];					\
+  hQ[2] = hR[2];
+
+#define _hop_t_m_post()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_su3_inverse_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplxcg_mul(hH, hG, ka0);			\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_sub(hQ, hQ, hH);
+
+#define _hop_x_p_post()					\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_swap_hl(hG, hH);				\
+  _avx_pair_i_mul(hH, hG);				\
+  _avx_pair_sub(hQ, hQ, hH);
+
+#define _hop_x_m_post()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_su3_inverse_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplxcg_mul(hH, hG, ka1);			\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_swap_hl(hG, hH);				\
+  _avx_pair_i_mul(hH, hG);				\
+  _avx_pair_add(hQ, hQ, hH);
+
+#define _hop_y_p_post()					\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_swap_hl(hG, hH);				\
+  _avx_pair_sgn_sub(hQ, hQ, hpm, hG);
+
+#define _hop_y_m_post()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_su3_inverse_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplxcg_mul(hH, hG, ka2);			\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_swap_hl(hG, hH);				\
+  _avx_pair_sgn_add(hQ, hQ, hpm, hG);
+
+#define _hop_z_p_post()					\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_i_mul(hG, hH);				\
+  _avx_pair_sgn_sub(hQ, hQ, hpm, hG);
+
+#define _hop_z_m_post()					\
+  _su3_copy_load(Ur, U);				\
+  _prefetch_su3(U+predist);				\
+  _avx_load_pair(hH, phi[ix]->s0, phi[ix]->s1);		\
+  _avx_su3_inverse_multiply(hG, _su3_copy_link(Ur, U), hH);	\
+  _avx_pair_cmplxcg_mul(hH, hG, ka3);			\
+  _avx_pair_add(hR, hR, hH);				\
+  _avx_pair_i_mul(hG, hH);				\
+  _avx_pair_sgn_add(hQ, hQ, hpm, hG);
+
+#define _hop_mul_g5_cmplx_and_store(res)		\
+  _avx_pair_cmplx_mul(hH, hR, cf);			\
+  _avx_store_pair((res)->s0, (res)->s1, hH);		\
+  _avx_pair_cmplxcg_mul(hH, hQ, cf);			\
+  _avx_store_pair((res)->s2, (res)->s3, hH);
+
+#define _g5_cmplx_sub_hop_and_g5store(res)		\
+  _avx_load_pair(hG, pn->s0, pn->s1);			\
+  _avx_pair_cmplx_mul(hH, hG, cf);			\
+  _avx_pair_sub(hH, hH, hR);				\
+  _avx_store_pair((res)->s0, (res)->s1, hH);		\
+  _avx_load_pair(hG, pn->s2, pn->s3);			\
+  _avx_pair_cmplxcg_mul(hH, hG, cf);			\
+  _avx_pair_sub(hH, hQ, hH);				\
+  _avx_store_pair((res)->s2, (res)->s3, hH);
+
+#define _hop_store_post(res)				\
+  _avx_store_pair((res)->s0, (res)->s1, hR);		\
+  _avx_store_pair((res)->s2, (res)->s3, hQ);
+
+#define _declare_hregs()						\
+  __m256d hA[3], hB[3], hC[3], hD[3], hG[3], hH[3], hR[3], hQ[3];	\
+  const __m256d hpm = _mm256_set_pd(-1., -1., 1., 1.);			\
+  const int predist=1;
+
+#elif (defined SSE2 || defined SSE3)
 
 #define _hop_t_p_pre32()
 #define _hop_t_m_pre32()
@@ -48,17 +219,18 @@
 #define _hop_z_m_post32()
 
 #define _hop_t_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _prefetch_su3(U+predist);				\
   _sse_load(s->s0);					\
   _sse_load_up(s->s2);					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka0);				\
   _sse_store_nt_up(phi[ix]->s0);			\
   _sse_load(s->s1);					\
   _sse_load_up(s->s3);					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka0);				\
   _sse_store_nt_up(phi[ix]->s1);
 
@@ -73,19 +245,20 @@
   _sse_store_nt(phi[ix]->s1);
 
 #define _hop_x_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _prefetch_su3(U+predist);				\
   _sse_load(s->s0);					\
   _sse_load_up(s->s3);					\
   _sse_vector_i_mul();					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka1);				\
   _sse_store_nt_up(phi[ix]->s0);			\
   _sse_load(s->s1);					\
   _sse_load_up(s->s2);					\
   _sse_vector_i_mul();					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka1);				\
   _sse_store_nt_up(phi[ix]->s1);
 
@@ -102,17 +275,18 @@
   _sse_store_nt(phi[ix]->s1);
 
 #define _hop_y_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _prefetch_su3(U+predist);				\
   _sse_load(s->s0);					\
   _sse_load_up(s->s3);					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka2);				\
   _sse_store_nt_up(phi[ix]->s0);			\
   _sse_load(s->s1);					\
   _sse_load_up(s->s2);					\
   _sse_vector_sub();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka2);				\
   _sse_store_nt_up(phi[ix]->s1);
 
@@ -127,20 +301,21 @@
   _sse_store_nt(phi[ix]->s1);
 
 #define _hop_z_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _prefetch_su3(U+predist);				\
   _prefetch_spinor(s+1);				\
   _sse_load(s->s0);					\
   _sse_load_up(s->s2);					\
   _sse_vector_i_mul();					\
   _sse_vector_add();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka3);				\
   _sse_store_nt_up(phi[ix]->s0);			\
   _sse_load(s->s1);					\
   _sse_load_up(s->s3);					\
   _sse_vector_i_mul();					\
   _sse_vector_sub();					\
-  _sse_su3_multiply((*U));				\
+  _sse_su3_multiply(_su3_copy_link(Ur, U));		\
   _sse_vector_cmplx_mul(ka3);				\
   _sse_store_nt_up(phi[ix]->s1);			\
 
@@ -163,9 +338,10 @@
   _vector_assign(rs.s3, phi[ix]->s1);
 
 #define _hop_t_m_post()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_su3(U+predist);			\
   _sse_load(phi[ix]->s0);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka0);			\
   _sse_load(rs.s0);				\
   _sse_vector_add();				\
@@ -174,7 +350,7 @@
   _sse_vector_sub();				\
   _sse_store(rs.s2);				\
   _sse_load(phi[ix]->s1);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka0);			\
   _sse_load(rs.s1);				\
   _sse_vector_add();				\
@@ -202,9 +378,10 @@
   _sse_store(rs.s2);       
 
 #define _hop_x_m_post()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_su3(U+predist);			\
   _sse_load(phi[ix]->s0);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka1);			\
   _sse_load(rs.s0);				\
   _sse_vector_add();				\
@@ -214,7 +391,7 @@
   _sse_vector_add();				\
   _sse_store(rs.s3);				\
   _sse_load(phi[ix]->s1);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka1);			\
   _sse_load(rs.s1);				\
   _sse_vector_add();				\
@@ -241,9 +418,10 @@
   _sse_store(rs.s2);      
 
 #define _hop_y_m_post()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_su3(U+predist);			\
   _sse_load(phi[ix]->s0);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka2);			\
   _sse_load(rs.s0);				\
   _sse_vector_add();				\
@@ -252,7 +430,7 @@
   _sse_vector_sub();				\
   _sse_store(rs.s3);				\
   _sse_load(phi[ix]->s1);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka2);			\
   _sse_load(rs.s1);				\
   _sse_vector_add();				\
@@ -280,10 +458,11 @@
   _sse_store(rs.s3);
 
 #define _hop_z_m_post()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_su3(U+predist);			\
   _prefetch_spinor(s+1);			\
   _sse_load(phi[ix]->s0);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka3);			\
   _sse_load(rs.s0);				\
   _sse_vector_add();				\
@@ -293,7 +472,7 @@
   _sse_vector_add();				\
   _sse_store_nt(s->s2);				\
   _sse_load(phi[ix]->s1);			\
-  _sse_su3_inverse_multiply((*U));		\
+  _sse_su3_inverse_multiply(_su3_copy_link(Ur, U));	\
   _sse_vector_cmplxcg_mul(ka3);			\
   _sse_load(rs.s1);				\
   _sse_vector_add();				\
@@ -362,6 +541,7 @@
     rs30, rs31, rs32;
 
 #define _hop_t_p_pre32()					\
+  _su3_copy_load(Ur, U);					\
   _bgl_load_rs0(s->s0);						\
   _bgl_load_rs1(s->s1);						\
   _bgl_load_rs2(s->s2);						\
@@ -370,7 +550,7 @@
   _prefetch_su3(U+1);						\
   _bgl_vector_add_rs2_to_rs0_reg0();				\
   _bgl_vector_add_rs3_to_rs1_reg1();				\
-  _bgl_su3_multiply_double((*U));				\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));		\
   _bgl_vector_cmplx_mul_double(ka0);				\
   _bgl_store_reg0_up_32(phi32[ix]->s0);				\
   _bgl_store_reg1_up_32(phi32[ix]->s1);
@@ -382,10 +562,11 @@
   _bgl_store_reg1_32(phi32[ix]->s1);
 
 #define _hop_x_p_pre32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_vector_i_mul_add_rs3_to_rs0_reg0();			\
   _bgl_vector_i_mul_add_rs2_to_rs1_reg1();			\
-  _bgl_su3_multiply_double((*U));				\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));		\
   _bgl_vector_cmplx_mul_double(ka1);				\
   _bgl_store_reg0_up_32(phi32[ix]->s0);				\
   _bgl_store_reg1_up_32(phi32[ix]->s1);
@@ -397,10 +578,11 @@
   _bgl_store_reg1_32(phi32[ix]->s1);
 
 #define _hop_y_p_pre32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_vector_add_rs3_to_rs0_reg0();				\
   _bgl_vector_sub_rs2_from_rs1_reg1();				\
-  _bgl_su3_multiply_double((*U));				\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));		\
   _bgl_vector_cmplx_mul_double(ka2);				\
   _bgl_store_reg0_up_32(phi32[ix]->s0);				\
   _bgl_store_reg1_up_32(phi32[ix]->s1);
@@ -412,9 +594,10 @@
   _bgl_store_reg1_32(phi32[ix]->s1);
 
 #define _hop_z_p_pre32()					\
+  _su3_copy_load(Ur, U);					\
   _bgl_vector_i_mul_add_rs2_to_rs0_reg0();			\
   _bgl_vector_i_mul_sub_rs3_from_rs1_reg1();			\
-  _bgl_su3_multiply_double((*U));				\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));		\
   _bgl_vector_cmplx_mul_double(ka3);				\
   _bgl_store_reg0_up_32(phi32[ix]->s0);				\
   _bgl_store_reg1_up_32(phi32[ix]->s1);
@@ -436,10 +619,11 @@
   rs32 = rs12;
 
 #define _hop_t_m_post32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_load_reg0_32(phi32[ix]->s0);				\
   _bgl_load_reg1_32(phi32[ix]->s1);				\
-  _bgl_su3_inverse_multiply_double((*U));			\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka0);				\
   _bgl_add_to_rs0_reg0();					\
   _bgl_sub_from_rs2_reg0();					\
@@ -455,10 +639,11 @@
   _bgl_i_mul_sub_from_rs2_reg1();
 
 #define _hop_x_m_post32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_load_reg0_32(phi32[ix]->s0);				\
   _bgl_load_reg1_32(phi32[ix]->s1);				\
-  _bgl_su3_inverse_multiply_double((*U));			\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka1);				\
   _bgl_add_to_rs0_reg0();					\
   _bgl_add_to_rs1_reg1();					\
@@ -474,10 +659,11 @@
   _bgl_add_to_rs3_reg0();
 
 #define _hop_y_m_post32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_load_reg0_32(phi32[ix]->s0);				\
   _bgl_load_reg1_32(phi32[ix]->s1);				\
-  _bgl_su3_inverse_multiply_double((*U));			\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka2);				\
   _bgl_add_to_rs0_reg0();					\
   _bgl_add_to_rs1_reg1();					\
@@ -493,10 +679,11 @@
   _bgl_i_mul_add_to_rs3_reg1();
 
 #define _hop_z_m_post32()					\
+  _su3_copy_load(Ur, U);					\
   _prefetch_su3(U+1);						\
   _bgl_load_reg0_32(phi32[ix]->s0);				\
   _bgl_load_reg1_32(phi32[ix]->s1);				\
-  _bgl_su3_inverse_multiply_double((*U));			\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka3);				\
   _bgl_add_to_rs0_reg0();					\
   _bgl_i_mul_add_to_rs2_reg0();					\
@@ -504,6 +691,7 @@
   _bgl_i_mul_sub_from_rs3_reg1();
 
 #define _hop_t_p_pre()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+4]);		\
   _bgl_load_rs0(s->s0);				\
   _bgl_load_rs1(s->s1);				\
@@ -513,7 +701,7 @@
   _prefetch_su3(U+1);				\
   _bgl_vector_add_rs2_to_rs0_reg0();		\
   _bgl_vector_add_rs3_to_rs1_reg1();		\
-  _bgl_su3_multiply_double((*U));		\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplx_mul_double(ka0);		\
   _bgl_store_reg0_up(phi[ix]->s0);		\
   _bgl_store_reg1_up(phi[ix]->s1);
@@ -526,11 +714,12 @@
   _bgl_store_reg1(phi[ix]->s1);
 
 #define _hop_x_p_pre()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+4]);		\
   _prefetch_su3(U+1);				\
   _bgl_vector_i_mul_add_rs3_to_rs0_reg0();	\
   _bgl_vector_i_mul_add_rs2_to_rs1_reg1();	\
-  _bgl_su3_multiply_double((*U));		\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplx_mul_double(ka1);		\
   _bgl_store_reg0_up(phi[ix]->s0);		\
   _bgl_store_reg1_up(phi[ix]->s1);
@@ -543,11 +732,12 @@
   _bgl_store_reg1(phi[ix]->s1);
 
 #define _hop_y_p_pre()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+4]);		\
   _prefetch_su3(U+1);				\
   _bgl_vector_add_rs3_to_rs0_reg0();		\
   _bgl_vector_sub_rs2_from_rs1_reg1();		\
-  _bgl_su3_multiply_double((*U));		\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplx_mul_double(ka2);		\
   _bgl_store_reg0_up(phi[ix]->s0);		\
   _bgl_store_reg1_up(phi[ix]->s1);
@@ -560,11 +750,12 @@
   _bgl_store_reg1(phi[ix]->s1);
 
 #define _hop_z_p_pre()				\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+4]);		\
   _prefetch_su3(U+1);				\
   _bgl_vector_i_mul_add_rs2_to_rs0_reg0();		\
   _bgl_vector_i_mul_sub_rs3_from_rs1_reg1();		\
-  _bgl_su3_multiply_double((*U));			\
+  _bgl_su3_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplx_mul_double(ka3);			\
   _bgl_store_reg0_up(phi[ix]->s0);			\
   _bgl_store_reg1_up(phi[ix]->s1);
@@ -588,11 +779,12 @@
   rs32 = rs12;
 
 #define _hop_t_m_post();			\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+3]);		\
   _prefetch_su3(U+1);				\
   _bgl_load_reg0(phi[ix]->s0);			\
   _bgl_load_reg1(phi[ix]->s1);			\
-  _bgl_su3_inverse_multiply_double((*U));	\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka0);		\
   _bgl_add_to_rs0_reg0();			\
   _bgl_sub_from_rs2_reg0();			\
@@ -609,11 +801,12 @@
   _bgl_i_mul_sub_from_rs2_reg1();
 
 #define _hop_x_m_post();			\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+3]);		\
   _prefetch_su3(U+1);				\
   _bgl_load_reg0(phi[ix]->s0);			\
   _bgl_load_reg1(phi[ix]->s1);			\
-  _bgl_su3_inverse_multiply_double((*U));	\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka1);		\
   _bgl_add_to_rs0_reg0();			\
   _bgl_add_to_rs1_reg1();			\
@@ -630,11 +823,12 @@
   _bgl_add_to_rs3_reg0();
 
 #define _hop_y_m_post();			\
+  _su3_copy_load(Ur, U);			\
   _prefetch_halfspinor(phi[ix+3]);		\
   _prefetch_su3(U+1);				\
   _bgl_load_reg0(phi[ix]->s0);			\
   _bgl_load_reg1(phi[ix]->s1);			\
-  _bgl_su3_inverse_multiply_double((*U));	\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka2);		\
   _bgl_add_to_rs0_reg0();			\
   _bgl_add_to_rs1_reg1();			\
@@ -651,12 +845,13 @@
   _bgl_i_mul_add_to_rs3_reg1();
 
 #define _hop_z_m_post();			\
+  _su3_copy_load(Ur, U);			\
   _prefetch_spinor(s);				\
   _prefetch_halfspinor(phi[ix+3]);		\
   _prefetch_su3(U+1);				\
   _bgl_load_reg0(phi[ix]->s0);			\
   _bgl_load_reg1(phi[ix]->s1);			\
-  _bgl_su3_inverse_multiply_double((*U));	\
+  _bgl_su3_inverse_multiply_double(_su3_copy_link(Ur, U));	\
   _bgl_vector_cmplxcg_mul_double(ka3);		\
   _bgl_add_to_rs0_reg0();			\
   _bgl_i_mul_add_to_rs2_reg0();			\
@@ -674,6 +869,10 @@
 
 #elif (defined BGQ && defined XLC)
 
+#ifdef _GAUGE_COMPRESSION
+#  error "gauge compression is not available for the BG/Q Dirac operator"
+#endif
+
 #define _hop_t_p_pre32()					\
   _vec_load2(rs0, rs1, rs2, s->s0);				\
   _vec_load2(rs3, rs4, rs5, s->s1);				\
@@ -1152,15 +1351,16 @@
 #define _prefetch_su3(U)
 
 #define _hop_t_p_pre32()				\
+  _su3_copy_load(Ur, U);				\
   _vector_assign(rs.s0, s->s0);				\
   _vector_assign(rs.s1, s->s1);				\
   _vector_assign(rs.s2, s->s2);				\
   _vector_assign(rs.s3, s->s3);				\
   _vector_add(psi, rs.s0, rs.s2);			\
-  _su3_multiply(chi,(*U),psi);				\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
   _complex_times_vector(phi32[ix]->s0, ka0, chi);	\
   _vector_add(psi, rs.s1, rs.s3);			\
-  _su3_multiply(chi,(*U),psi);				\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
   _complex_times_vector(phi32[ix]->s1, ka0, chi);
 
 #define _hop_t_m_pre32()				\
@@ -1168,11 +1368,12 @@
   _vector_sub(phi32[ix]->s1, rs.s1, rs.s3);
 
 #define _hop_x_p_pre32()				\
+  _su3_copy_load(Ur, U);				\
   _vector_i_add(psi, rs.s0, rs.s3);			\
-  _su3_multiply(chi, (*U), psi);			\
+  _su3_multiply(chi, _su3_copy_link(Ur, U), psi);	\
   _complex_times_vector(phi32[ix]->s0, ka1, chi);	\
   _vector_i_add(psi, rs.s1, rs.s2);			\
-  _su3_multiply(chi, (*U), psi);			\
+  _su3_multiply(chi, _su3_copy_link(Ur, U), psi);	\
   _complex_times_vector(phi32[ix]->s1, ka1, chi);
 
 #define _hop_x_m_pre32()				\
@@ -1180,11 +1381,12 @@
   _vector_i_sub(phi32[ix]->s1, rs.s1, rs.s2);
 
 #define _hop_y_p_pre32()				\
+  _su3_copy_load(Ur, U);				\
   _vector_add(psi, rs.s0, rs.s3);			\
-  _su3_multiply(chi,(*U),psi);				\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
   _complex_times_vector(phi32[ix]->s0, ka2, chi);	\
   _vector_sub(psi, rs.s1, rs.s2);			\
-  _su3_multiply(chi,(*U),psi);				\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
   _complex_times_vector(phi32[ix]->s1, ka2, chi);
 
 #define _hop_y_m_pre32()			\
@@ -1192,11 +1394,12 @@
   _vector_add(phi32[ix]->s1, rs.s1, rs.s2);
 
 #define _hop_z_p_pre32()				\
+  _su3_copy_load(Ur, U);				\
   _vector_i_add(psi, rs.s0, rs.s2);			\
-  _su3_multiply(chi, (*U), psi);			\
+  _su3_multiply(chi, _su3_copy_link(Ur, U), psi);	\
   _complex_times_vector(phi32[ix]->s0, ka3, chi);	\
   _vector_i_sub(psi, rs.s1, rs.s3);			\
-  _su3_multiply(chi,(*U),psi);				\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
   _complex_times_vector(phi32[ix]->s1, ka3, chi);
 
 #define _hop_z_m_pre32()			\
@@ -1210,13 +1413,14 @@
   _vector_assign(rs.s3, phi32[ix]->s1);		\
 
 #define _hop_t_m_post32();			\
+  _su3_copy_load(Ur, U);			\
   _vector_assign(psi, phi32[ix]->s0);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka0,chi);	\
   _vector_add_assign(rs.s0, psi);		\
   _vector_sub_assign(rs.s2, psi);		\
   _vector_assign(psi, phi32[ix]->s1);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka0,chi);	\
   _vector_add_assign(rs.s1, psi);		\
   _vector_sub_assign(rs.s3, psi);
@@ -1228,13 +1432,14 @@
   _vector_i_sub_assign(rs.s2, phi32[ix]->s1);
 
 #define _hop_x_m_post32();			\
+  _su3_copy_load(Ur, U);			\
   _vector_assign(psi, phi32[ix]->s0);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka1,chi);	\
   _vector_add_assign(rs.s0, psi);		\
   _vector_i_add_assign(rs.s3, psi);		\
   _vector_assign(psi, phi32[ix]->s1);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka1,chi);	\
   _vector_add_assign(rs.s1, psi);		\
   _vector_i_add_assign(rs.s2, psi);
@@ -1246,13 +1451,14 @@
   _vector_sub_assign(rs.s2, phi32[ix]->s1);
 
 #define _hop_y_m_post32();			\
+  _su3_copy_load(Ur, U);			\
   _vector_assign(psi, phi32[ix]->s0);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka2,chi);	\
   _vector_add_assign(rs.s0, psi);		\
   _vector_sub_assign(rs.s3, psi);		\
   _vector_assign(psi, phi32[ix]->s1);		\
-  _su3_inverse_multiply(chi, (*U), psi);	\
+  _su3_inverse_multiply(chi, _su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka2,chi);	\
   _vector_add_assign(rs.s1, psi);		\
   _vector_add_assign(rs.s2, psi);
@@ -1264,26 +1470,28 @@
   _vector_i_add_assign(rs.s3, phi32[ix]->s1);
 
 #define _hop_z_m_post32();			\
+  _su3_copy_load(Ur, U);			\
   _vector_assign(psi, phi32[ix]->s0);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka3,chi);	\
   _vector_add_assign(rs.s0, psi);		\
   _vector_i_add_assign(rs.s2, psi);		\
   _vector_assign(psi, phi32[ix]->s1);		\
-  _su3_inverse_multiply(chi,(*U), psi);		\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), psi);	\
   _complexcjg_times_vector(psi,ka3,chi);	\
   _vector_add_assign(rs.s1, psi);		\
   _vector_i_sub_assign(rs.s3, psi);
 
 #define _hop_t_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _vector_assign(rs.s0, s->s0);				\
   _vector_assign(rs.s1, s->s1);				\
   _vector_assign(rs.s2, s->s2);				\
   _vector_assign(rs.s3, s->s3);				\
   _vector_add(psi, rs.s0, rs.s2);			\
   _vector_add(psi2, rs.s1, rs.s3);			\
-  _su3_multiply(chi,(*U),psi);				\
-  _su3_multiply(chi2,(*U),psi2);			\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
+  _su3_multiply(chi2,_su3_copy_link(Ur, U),psi2);	\
   _complex_times_vector(phi[ix]->s0, ka0, chi);		\
   _complex_times_vector(phi[ix]->s1, ka0, chi2);
 
@@ -1292,10 +1500,11 @@
   _vector_sub(phi[ix]->s1, rs.s1, rs.s3);
 
 #define _hop_x_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _vector_i_add(psi, rs.s0, rs.s3);			\
   _vector_i_add(psi2, rs.s1, rs.s2);			\
-  _su3_multiply(chi, (*U), psi);			\
-  _su3_multiply(chi2, (*U), psi2);			\
+  _su3_multiply(chi, _su3_copy_link(Ur, U), psi);	\
+  _su3_multiply(chi2, _su3_copy_link(Ur, U), psi2);	\
   _complex_times_vector(phi[ix]->s0, ka1, chi);		\
   _complex_times_vector(phi[ix]->s1, ka1, chi2);
 
@@ -1304,10 +1513,11 @@
   _vector_i_sub(phi[ix]->s1, rs.s1, rs.s2);
 
 #define _hop_y_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _vector_add(psi, rs.s0, rs.s3);			\
   _vector_sub(psi2, rs.s1, rs.s2);			\
-  _su3_multiply(chi,(*U),psi);				\
-  _su3_multiply(chi2,(*U),psi2);			\
+  _su3_multiply(chi,_su3_copy_link(Ur, U),psi);		\
+  _su3_multiply(chi2,_su3_copy_link(Ur, U),psi2);	\
   _complex_times_vector(phi[ix]->s0, ka2, chi);		\
   _complex_times_vector(phi[ix]->s1, ka2, chi2);
 
@@ -1316,10 +1526,11 @@
   _vector_add(phi[ix]->s1, rs.s1, rs.s2);
 
 #define _hop_z_p_pre()					\
+  _su3_copy_load(Ur, U);				\
   _vector_i_add(psi, rs.s0, rs.s2);			\
   _vector_i_sub(psi2, rs.s1, rs.s3);			\
-  _su3_multiply(chi, (*U), psi);			\
-  _su3_multiply(chi2,(*U),psi2);			\
+  _su3_multiply(chi, _su3_copy_link(Ur, U), psi);	\
+  _su3_multiply(chi2,_su3_copy_link(Ur, U),psi2);	\
   _complex_times_vector(phi[ix]->s0, ka3, chi);		\
   _complex_times_vector(phi[ix]->s1, ka3, chi2);
 
@@ -1334,8 +1545,9 @@
   _vector_assign(rs.s3, phi[ix]->s1);
 
 #define _hop_t_m_post()					\
-  _su3_inverse_multiply(chi,(*U),phi[ix]->s0);		\
-  _su3_inverse_multiply(chi2,(*U),phi[ix]->s1);		\
+  _su3_copy_load(Ur, U);				\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U),phi[ix]->s0);	\
+  _su3_inverse_multiply(chi2,_su3_copy_link(Ur, U),phi[ix]->s1);	\
   _complexcjg_times_vector(psi,ka0,chi);		\
   _complexcjg_times_vector(psi2,ka0,chi2);		\
   _vector_add_assign(rs.s0, psi);			\
@@ -1350,8 +1562,9 @@
   _vector_i_sub_assign(rs.s2, phi[ix]->s1);
 
 #define _hop_x_m_post()					\
-  _su3_inverse_multiply(chi,(*U), phi[ix]->s0);		\
-  _su3_inverse_multiply(chi2, (*U), phi[ix]->s1);	\
+  _su3_copy_load(Ur, U);				\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), phi[ix]->s0);	\
+  _su3_inverse_multiply(chi2, _su3_copy_link(Ur, U), phi[ix]->s1);	\
   _complexcjg_times_vector(psi,ka1,chi);		\
   _complexcjg_times_vector(psi2,ka1,chi2);		\
   _vector_add_assign(rs.s0, psi);			\
@@ -1366,8 +1579,9 @@
   _vector_sub_assign(rs.s2, phi[ix]->s1);
 
 #define _hop_y_m_post()					\
-  _su3_inverse_multiply(chi,(*U), phi[ix]->s0);		\
-  _su3_inverse_multiply(chi2, (*U), phi[ix]->s1);	\
+  _su3_copy_load(Ur, U);				\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), phi[ix]->s0);	\
+  _su3_inverse_multiply(chi2, _su3_copy_link(Ur, U), phi[ix]->s1);	\
   _complexcjg_times_vector(psi,ka2,chi);		\
   _complexcjg_times_vector(psi2,ka2,chi2);		\
   _vector_add_assign(rs.s0, psi);			\
@@ -1382,8 +1596,9 @@
   _vector_i_add_assign(rs.s3, phi[ix]->s1);
 
 #define _hop_z_m_post()					\
-  _su3_inverse_multiply(chi,(*U), phi[ix]->s0);		\
-  _su3_inverse_multiply(chi2, (*U), phi[ix]->s1);	\
+  _su3_copy_load(Ur, U);				\
+  _su3_inverse_multiply(chi,_su3_copy_link(Ur, U), phi[ix]->s0);	\
+  _su3_inverse_multiply(chi2, _su3_copy_link(Ur, U), phi[ix]->s1);	\
   _complexcjg_times_vector(psi,ka3,chi);		\
   _complexcjg_times_vector(psi2,ka3,chi2);		\
   _vector_add_assign(rs.s0, psi);			\
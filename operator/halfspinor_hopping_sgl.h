@@ -0,0 +1,170 @@
+/**********************************************************************
+ *
+ * Copyright (C) 2012 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is based on an implementation of the Dirac operator
+ * written by Martin Luescher, modified by Martin Hasenbusch in 2002
+ * and modified and extended by Carsten Urbach from 2003-2008
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * single precision halfspinor hopping macros
+ * in- and output are spinor32, the gauge field is su3_32
+ * and the intermediate halfspinors are halfspinor32
+ *
+ * plain C99 complex only, there is no SSE or BG version
+ *
+ **********************************************************************/
+
+#ifndef _HALFSPINOR_HOPPING_SGL_H
+#define _HALFSPINOR_HOPPING_SGL_H
+
+#define _hop_t_p_pre_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _vector_assign(rs.s0, s->s0);					\
+  _vector_assign(rs.s1, s->s1);					\
+  _vector_assign(rs.s2, s->s2);					\
+  _vector_assign(rs.s3, s->s3);					\
+  _vector_add32(psi, rs.s0, rs.s2);				\
+  _vector_add32(psi2, rs.s1, rs.s3);				\
+  _su3_multiply32(chi,_su3_copy_link(Ur, U),psi);		\
+  _su3_multiply32(chi2,_su3_copy_link(Ur, U),psi2);		\
+  _complex_times_vector(phi32[ix]->s0, ka0_32, chi);		\
+  _complex_times_vector(phi32[ix]->s1, ka0_32, chi2);
+
+#define _hop_t_m_pre_sgl()				\
+  _vector_sub32(phi32[ix]->s0, rs.s0, rs.s2);		\
+  _vector_sub32(phi32[ix]->s1, rs.s1, rs.s3);
+
+#define _hop_x_p_pre_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _vector_i_add(psi, rs.s0, rs.s3);				\
+  _vector_i_add(psi2, rs.s1, rs.s2);				\
+  _su3_multiply32(chi, _su3_copy_link(Ur, U), psi);		\
+  _su3_multiply32(chi2, _su3_copy_link(Ur, U), psi2);		\
+  _complex_times_vector(phi32[ix]->s0, ka1_32, chi);		\
+  _complex_times_vector(phi32[ix]->s1, ka1_32, chi2);
+
+#define _hop_x_m_pre_sgl()				\
+  _vector_i_sub(phi32[ix]->s0, rs.s0, rs.s3);		\
+  _vector_i_sub(phi32[ix]->s1, rs.s1, rs.s2);
+
+#define _hop_y_p_pre_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _vector_add32(psi, rs.s0, rs.s3);				\
+  _vector_sub32(psi2, rs.s1, rs.s2);				\
+  _su3_multiply32(chi,_su3_copy_link(Ur, U),psi);		\
+  _su3_multiply32(chi2,_su3_copy_link(Ur, U),psi2);		\
+  _complex_times_vector(phi32[ix]->s0, ka2_32, chi);		\
+  _complex_times_vector(phi32[ix]->s1, ka2_32, chi2);
+
+#define _hop_y_m_pre_sgl()				\
+  _vector_sub32(phi32[ix]->s0, rs.s0, rs.s3);		\
+  _vector_add32(phi32[ix]->s1, rs.s1, rs.s2);
+
+#define _hop_z_p_pre_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _vector_i_add(psi, rs.s0, rs.s2);				\
+  _vector_i_sub(psi2, rs.s1, rs.s3);				\
+  _su3_multiply32(chi, _su3_copy_link(Ur, U), psi);		\
+  _su3_multiply32(chi2,_su3_copy_link(Ur, U),psi2);		\
+  _complex_times_vector(phi32[ix]->s0, ka3_32, chi);		\
+  _complex_times_vector(phi32[ix]->s1, ka3_32, chi2);
+
+#define _hop_z_m_pre_sgl()				\
+  _vector_i_sub(phi32[ix]->s0, rs.s0, rs.s2);		\
+  _vector_i_add(phi32[ix]->s1, rs.s1, rs.s3);
+
+#define _hop_t_p_post_sgl()				\
+  _vector_assign(rs.s0, phi32[ix]->s0);			\
+  _vector_assign(rs.s2, phi32[ix]->s0);			\
+  _vector_assign(rs.s1, phi32[ix]->s1);			\
+  _vector_assign(rs.s3, phi32[ix]->s1);
+
+#define _hop_t_m_post_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _su3_inverse_multiply32(chi,_su3_copy_link(Ur, U),phi32[ix]->s0);	\
+  _su3_inverse_multiply32(chi2,_su3_copy_link(Ur, U),phi32[ix]->s1);	\
+  _complexcjg_times_vector32(psi,ka0_32,chi);			\
+  _complexcjg_times_vector32(psi2,ka0_32,chi2);			\
+  _vector_add_assign32(rs.s0, psi);				\
+  _vector_sub_assign32(rs.s2, psi);				\
+  _vector_add_assign32(rs.s1, psi2);				\
+  _vector_sub_assign32(rs.s3, psi2);
+
+#define _hop_x_p_post_sgl()				\
+  _vector_add_assign32(rs.s0, phi32[ix]->s0);		\
+  _vector_i_sub_assign(rs.s3, phi32[ix]->s0);		\
+  _vector_add_assign32(rs.s1, phi32[ix]->s1);		\
+  _vector_i_sub_assign(rs.s2, phi32[ix]->s1);
+
+#define _hop_x_m_post_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _su3_inverse_multiply32(chi,_su3_copy_link(Ur, U), phi32[ix]->s0);	\
+  _su3_inverse_multiply32(chi2, _su3_copy_link(Ur, U), phi32[ix]->s1);	\
+  _complexcjg_times_vector32(psi,ka1_32,chi);			\
+  _complexcjg_times_vector32(psi2,ka1_32,chi2);			\
+  _vector_add_assign32(rs.s0, psi);				\
+  _vector_i_add_assign(rs.s3, psi);				\
+  _vector_add_assign32(rs.s1, psi2);				\
+  _vector_i_add_assign(rs.s2, psi2);
+
+#define _hop_y_p_post_sgl()				\
+  _vector_add_assign32(rs.s0, phi32[ix]->s0);		\
+  _vector_add_assign32(rs.s3, phi32[ix]->s0);		\
+  _vector_add_assign32(rs.s1, phi32[ix]->s1);		\
+  _vector_sub_assign32(rs.s2, phi32[ix]->s1);
+
+#define _hop_y_m_post_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _su3_inverse_multiply32(chi,_su3_copy_link(Ur, U), phi32[ix]->s0);	\
+  _su3_inverse_multiply32(chi2, _su3_copy_link(Ur, U), phi32[ix]->s1);	\
+  _complexcjg_times_vector32(psi,ka2_32,chi);			\
+  _complexcjg_times_vector32(psi2,ka2_32,chi2);			\
+  _vector_add_assign32(rs.s0, psi);				\
+  _vector_sub_assign32(rs.s3, psi);				\
+  _vector_add_assign32(rs.s1, psi2);				\
+  _vector_add_assign32(rs.s2, psi2);
+
+#define _hop_z_p_post_sgl()				\
+  _vector_add_assign32(rs.s0, phi32[ix]->s0);		\
+  _vector_i_sub_assign(rs.s2, phi32[ix]->s0);		\
+  _vector_add_assign32(rs.s1, phi32[ix]->s1);		\
+  _vector_i_add_assign(rs.s3, phi32[ix]->s1);
+
+#define _hop_z_m_post_sgl()					\
+  _su3_copy_load32(Ur, U);					\
+  _su3_inverse_multiply32(chi,_su3_copy_link(Ur, U), phi32[ix]->s0);	\
+  _su3_inverse_multiply32(chi2, _su3_copy_link(Ur, U), phi32[ix]->s1);	\
+  _complexcjg_times_vector32(psi,ka3_32,chi);			\
+  _complexcjg_times_vector32(psi2,ka3_32,chi2);			\
+  _vector_add_assign32(rs.s0, psi);				\
+  _vector_add_assign32(rs.s1, psi2);				\
+  _vector_i_add_assign(rs.s2, psi);				\
+  _vector_i_sub_assign(rs.s3, psi2);
+
+#define _hop_store_post_sgl(res)		\
+  _vector_assign(res->s0, rs.s0);		\
+  _vector_assign(res->s1, rs.s1);		\
+  _vector_assign(res->s2, rs.s2);		\
+  _vector_assign(res->s3, rs.s3);
+
+#define _declare_hregs_sgl()				\
+  spinor32 ALIGN rs;					\
+  su3_vector32 ALIGN psi, chi, psi2, chi2;
+
+#endif
@@ -26,30 +26,36 @@
  *
  **********************************************************************/
 
-static su3_vector32 psi1, psi2, psi, chi, phi1, phi3;
-
+/* single precision version of the non-halfspinor Hopping_Matrix */
+/* the gauge field is always taken from g_gauge_field_copy_32      */
 /* l output , k input*/
 /* for ieo=0, k resides on  odd sites and l on even sites */
-void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
+void Hopping_Matrix_32(const int ieo, spinor32 * const l, spinor32 * const k){
   int ix,iy;
-  int ioff,ioff2,icx,icy;
-  su332 * restrict up, * restrict um;
+  int ioff,icx,icy;
+  su3_copy_32 * restrict up, * restrict um;
   spinor32 * restrict r, * restrict sp, * restrict sm;
   spinor32 temp;
+  su3_vector32 psi, chi;
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
 
 #ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
-    update_backward_gauge();
+    update_backward_gauge(g_gauge_field);
   }
 #endif
+  if(g_update_gauge_copy_32) {
+    update_backward_gauge_32(g_gauge_field);
+  }
 
   /* for parallelization */
 #    if (defined MPI && !(defined _NO_COMM))
-  xchange_field(k, ieo);
+  xchange_field_32(k, ieo);
 #    endif
 
   if(k == l){
-    printf("Error in H_psi (simple.c):\n");
+    printf("Error in Hopping_Matrix_32:\n");
     printf("Arguments k and l must be different\n");
     printf("Program aborted\n");
     exit(1);
@@ -60,10 +66,15 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
   else{
     ioff = (VOLUME+RAND)/2;
   } 
-  ioff2 = (VOLUME+RAND)/2-ioff;
   /**************** loop over all lattice sites ****************/
 
+#ifdef OMP
+#pragma omp parallel for private(ix, iy, icy, up, um, r, sp, sm, temp, psi, chi)
+#endif
   for (icx = ioff; icx < (VOLUME/2 + ioff); icx++){
+#ifdef _GAUGE_COMPRESSION
+    su3_32 w;
+#endif
     ix=g_eo2lexic[icx];
 
     r=l+(icx-ioff);
@@ -73,24 +84,21 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
 
 
     sp=k+icy;
-#    if ((defined _GAUGE_COPY))
-    up=&g_gauge_field_copy[icx][0];
-#    else
-    up=&g_gauge_field[ix][0];
-#    endif
+    up=&g_gauge_field_copy_32[icx][0];
+    _su3_copy_load32(w, up);
       
-    _vector_add(psi,(*sp).s0,(*sp).s2);
+    _vector_add32(psi,(*sp).s0,(*sp).s2);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka0,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka0_32,chi);
       
     _vector_assign(temp.s0,psi);
     _vector_assign(temp.s2,psi);
 
-    _vector_add(psi,(*sp).s1,(*sp).s3);
+    _vector_add32(psi,(*sp).s1,(*sp).s3);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka0,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka0_32,chi);
             
     _vector_assign(temp.s1,psi);
     _vector_assign(temp.s3,psi);
@@ -100,27 +108,24 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
     iy=g_idn[ix][0]; icy=g_lexic2eosub[iy];
 
     sm=k+icy;
-#    if ((defined _GAUGE_COPY))
-    um = up+1;
-#    else
-    um=&g_gauge_field[iy][0];
-#    endif
+    um=up+1;
+    _su3_copy_load32(w, um);
 
-    _vector_sub(psi,(*sm).s0,(*sm).s2);
+    _vector_sub32(psi,(*sm).s0,(*sm).s2);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka0,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka0_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
-    _vector_sub_assign(temp.s2,psi);
+    _vector_add_assign32(temp.s0,psi);
+    _vector_sub_assign32(temp.s2,psi);
 
-    _vector_sub(psi,(*sm).s1,(*sm).s3);
+    _vector_sub32(psi,(*sm).s1,(*sm).s3);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka0,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka0_32,chi);
       
-    _vector_add_assign(temp.s1,psi);
-    _vector_sub_assign(temp.s3,psi);
+    _vector_add_assign32(temp.s1,psi);
+    _vector_sub_assign32(temp.s3,psi);
 
     /*********************** direction +1 ************************/
 
@@ -128,26 +133,23 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
 
     sp=k+icy;
 
-#    if ((defined _GAUGE_COPY))
     up=um+1;
-#    else
-    up+=1;
-#    endif
+    _su3_copy_load32(w, up);
       
     _vector_i_add(psi,(*sp).s0,(*sp).s3);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka1,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka1_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
+    _vector_add_assign32(temp.s0,psi);
     _vector_i_sub_assign(temp.s3,psi);
 
     _vector_i_add(psi,(*sp).s1,(*sp).s2);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka1,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka1_32,chi);
 
-    _vector_add_assign(temp.s1,psi);
+    _vector_add_assign32(temp.s1,psi);
     _vector_i_sub_assign(temp.s2,psi);
 
     /*********************** direction -1 ************************/
@@ -155,26 +157,23 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
     iy=g_idn[ix][1]; icy=g_lexic2eosub[iy];
 
     sm=k+icy;
-#    ifndef _GAUGE_COPY
-    um=&g_gauge_field[iy][1];
-#    else
     um=up+1;
-#    endif
+    _su3_copy_load32(w, um);
 
     _vector_i_sub(psi,(*sm).s0,(*sm).s3);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka1,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka1_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
+    _vector_add_assign32(temp.s0,psi);
     _vector_i_add_assign(temp.s3,psi);
 
     _vector_i_sub(psi,(*sm).s1,(*sm).s2);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka1,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka1_32,chi);
 
-    _vector_add_assign(temp.s1,psi);
+    _vector_add_assign32(temp.s1,psi);
     _vector_i_add_assign(temp.s2,psi);
 
     /*********************** direction +2 ************************/
@@ -182,26 +181,23 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
     iy=g_iup[ix][2]; icy=g_lexic2eosub[iy];
 
     sp=k+icy;
-#    if ((defined _GAUGE_COPY))
     up=um+1;
-#    else
-    up+=1;
-#    endif 
-    _vector_add(psi,(*sp).s0,(*sp).s3);
+    _su3_copy_load32(w, up);
+    _vector_add32(psi,(*sp).s0,(*sp).s3);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka2,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka2_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
-    _vector_add_assign(temp.s3,psi);
+    _vector_add_assign32(temp.s0,psi);
+    _vector_add_assign32(temp.s3,psi);
 
-    _vector_sub(psi,(*sp).s1,(*sp).s2);
+    _vector_sub32(psi,(*sp).s1,(*sp).s2);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka2,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka2_32,chi);
       
-    _vector_add_assign(temp.s1,psi);
-    _vector_sub_assign(temp.s2,psi);
+    _vector_add_assign32(temp.s1,psi);
+    _vector_sub_assign32(temp.s2,psi);
 
 
     /*********************** direction -2 ************************/
@@ -209,52 +205,46 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
     iy=g_idn[ix][2]; icy=g_lexic2eosub[iy];
 
     sm=k+icy;
-#    ifndef _GAUGE_COPY
-    um = &g_gauge_field[iy][2];
-#    else
-    um = up +1;
-#    endif
+    um=up+1;
+    _su3_copy_load32(w, um);
 
-    _vector_sub(psi,(*sm).s0,(*sm).s3);
+    _vector_sub32(psi,(*sm).s0,(*sm).s3);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka2,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka2_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
-    _vector_sub_assign(temp.s3,psi);
+    _vector_add_assign32(temp.s0,psi);
+    _vector_sub_assign32(temp.s3,psi);
 
-    _vector_add(psi,(*sm).s1,(*sm).s2);
+    _vector_add32(psi,(*sm).s1,(*sm).s2);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka2,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka2_32,chi);
       
-    _vector_add_assign(temp.s1,psi);
-    _vector_add_assign(temp.s2,psi);
+    _vector_add_assign32(temp.s1,psi);
+    _vector_add_assign32(temp.s2,psi);
 
     /*********************** direction +3 ************************/
 
     iy=g_iup[ix][3]; icy=g_lexic2eosub[iy];
 
     sp=k+icy;
-#    if ((defined _GAUGE_COPY))
     up=um+1;
-#    else
-    up+=1;
-#    endif 
+    _su3_copy_load32(w, up);
     _vector_i_add(psi,(*sp).s0,(*sp).s2);
       
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka3,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka3_32,chi);
 
-    _vector_add_assign(temp.s0,psi);
+    _vector_add_assign32(temp.s0,psi);
     _vector_i_sub_assign(temp.s2,psi);
 
     _vector_i_sub(psi,(*sp).s1,(*sp).s3);
 
-    _su3_multiply(chi,(*up),psi);
-    _complex_times_vector(psi,ka3,chi);
+    _su3_multiply32(chi,_su3_copy_link(w, up),psi);
+    _complex_times_vector(psi,ka3_32,chi);
 
-    _vector_add_assign(temp.s1,psi);
+    _vector_add_assign32(temp.s1,psi);
     _vector_i_add_assign(temp.s3,psi);
 
     /*********************** direction -3 ************************/
@@ -262,27 +252,25 @@ void Hopping_Matrix(int ieo, spinor32 * const l, spinor32 * const k){
     iy=g_idn[ix][3]; icy=g_lexic2eosub[iy];
 
     sm=k+icy;
-#    ifndef _GAUGE_COPY
-    um = &g_gauge_field[iy][3];
-#    else
-    um = up+1;
-#    endif
+    um=up+1;
+    _su3_copy_load32(w, um);
 
     _vector_i_sub(psi,(*sm).s0,(*sm).s2);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka3,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka3_32,chi);
       
-    _vector_add((*r).s0, temp.s0, psi);
+    _vector_add32((*r).s0, temp.s0, psi);
     _vector_i_add((*r).s2, temp.s2, psi);
 
     _vector_i_add(psi,(*sm).s1,(*sm).s3);
 
-    _su3_inverse_multiply(chi,(*um),psi);
-    _complexcjg_times_vector(psi,ka3,chi);
+    _su3_inverse_multiply32(chi,_su3_copy_link(w, um),psi);
+    _complexcjg_times_vector32(psi,ka3_32,chi);
 
-    _vector_add((*r).s1, temp.s1, psi);
+    _vector_add32((*r).s1, temp.s1, psi);
     _vector_i_sub((*r).s3, temp.s3, psi);
     /************************ end of loop ************************/
   }
+  _PROFILE_END(_HOPPING_FLOPS, _HOPPING_BYTES(spinor32, su3_32));
 }
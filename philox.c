@@ -0,0 +1,213 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Philox4x32-10 counter based random number generator, see philox.h
+ *
+ * A 128 bit counter is encrypted with a 64 bit key in ten rounds of
+ * multiplications and xors, the result are four random 32 bit words.
+ * The constants are the ones of the Random123 library, the known
+ * answer for counter 0 and key 0 is
+ *   6627e8d5 e169c58d bc57ac4c 9b00dbd8
+ *
+ * A stream uses the third word of the counter as block number, the
+ * other three words and the key are fixed at initialisation. There
+ * is no state besides the counter, so streams can be created for
+ * every site and thread independently.
+ *
+ * Philox only needs 32x32->64 bit multiplications, so
+ * philox_doubles encrypts four consecutive blocks at once with one
+ * block per 32 bit lane. With SSE2 (and the AVX paths) the products
+ * come from _mm_mul_epu32, otherwise the same loop over the lanes is
+ * left to the compiler. The numbers do not depend on the path.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdint.h>
+#if (defined SSE2 || defined SSE3 || defined AVX2 || defined AVX512)
+# include <emmintrin.h>
+# define _PHILOX_SSE2
+#endif
+#include "philox.h"
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+void philox4x32(uint32_t ctr[4], const uint32_t key[2]) {
+  uint32_t k0 = key[0], k1 = key[1];
+  uint64_t p0, p1;
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+
+  for(int r = 0; r < 10; r++) {
+    p0 = (uint64_t)PHILOX_M0 * c0;
+    p1 = (uint64_t)PHILOX_M1 * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  ctr[0] = c0;
+  ctr[1] = c1;
+  ctr[2] = c2;
+  ctr[3] = c3;
+  return;
+}
+
+/* number of blocks encrypted at once in philox_doubles */
+#define PHILOX_LANES 4
+
+/* encrypts the blocks c[.][j], j < PHILOX_LANES, with key in place */
+static void philox4x32_lanes(uint32_t c[4][PHILOX_LANES], const uint32_t key[2]) {
+#ifdef _PHILOX_SSE2
+  const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0), m1 = _mm_set1_epi32((int)PHILOX_M1);
+  __m128i c0 = _mm_loadu_si128((__m128i*)c[0]), c1 = _mm_loadu_si128((__m128i*)c[1]);
+  __m128i c2 = _mm_loadu_si128((__m128i*)c[2]), c3 = _mm_loadu_si128((__m128i*)c[3]);
+  __m128i e, o, a, b, lo0, hi0;
+  uint32_t k0 = key[0], k1 = key[1];
+
+  for(int r = 0; r < 10; r++) {
+    /* products of lanes 0,2 and 1,3, then low and high words in lane order */
+    e = _mm_mul_epu32(c0, m0);
+    o = _mm_mul_epu32(_mm_srli_epi64(c0, 32), m0);
+    a = _mm_unpacklo_epi32(e, o);
+    b = _mm_unpackhi_epi32(e, o);
+    lo0 = _mm_unpacklo_epi64(a, b);
+    hi0 = _mm_unpackhi_epi64(a, b);
+    e = _mm_mul_epu32(c2, m1);
+    o = _mm_mul_epu32(_mm_srli_epi64(c2, 32), m1);
+    a = _mm_unpacklo_epi32(e, o);
+    b = _mm_unpackhi_epi32(e, o);
+    c0 = _mm_xor_si128(_mm_xor_si128(_mm_unpackhi_epi64(a, b), c1), _mm_set1_epi32((int)k0));
+    c1 = _mm_unpacklo_epi64(a, b);
+    c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32((int)k1));
+    c3 = lo0;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  _mm_storeu_si128((__m128i*)c[0], c0);
+  _mm_storeu_si128((__m128i*)c[1], c1);
+  _mm_storeu_si128((__m128i*)c[2], c2);
+  _mm_storeu_si128((__m128i*)c[3], c3);
+#else
+  uint32_t k0 = key[0], k1 = key[1];
+  uint64_t p0, p1;
+  uint32_t t0, t1;
+
+  for(int r = 0; r < 10; r++) {
+    for(int j = 0; j < PHILOX_LANES; j++) {
+      p0 = (uint64_t)PHILOX_M0 * c[0][j];
+      p1 = (uint64_t)PHILOX_M1 * c[2][j];
+      t0 = (uint32_t)(p1 >> 32) ^ c[1][j] ^ k0;
+      t1 = (uint32_t)(p0 >> 32) ^ c[3][j] ^ k1;
+      c[1][j] = (uint32_t)p1;
+      c[3][j] = (uint32_t)p0;
+      c[0][j] = t0;
+      c[2][j] = t1;
+    }
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+#endif
+  return;
+}
+
+void philox_init(philox_stream * const s, const uint32_t k0, const uint32_t k1,
+		 const uint32_t c0, const uint32_t c1, const uint32_t c3) {
+  s->key[0] = k0;
+  s->key[1] = k1;
+  s->ctr[0] = c0;
+  s->ctr[1] = c1;
+  s->ctr[2] = 0;
+  s->ctr[3] = c3;
+  s->left = 0;
+  return;
+}
+
+static inline uint32_t philox_word(philox_stream * const s) {
+  if(s->left == 0) {
+    for(int i = 0; i < 4; i++) s->buf[i] = s->ctr[i];
+    philox4x32(s->buf, s->key);
+    s->ctr[2]++;
+    s->left = 4;
+  }
+  s->left--;
+  return(s->buf[3 - s->left]);
+}
+
+void philox_words(philox_stream * const s, uint32_t * const w, const int n) {
+  for(int i = 0; i < n; i++) {
+    w[i] = philox_word(s);
+  }
+  return;
+}
+
+static inline double philox_to_double(const uint32_t a, const uint32_t b) {
+  return(((a >> 5) * 67108864.0 + (b >> 6)) * (1.0 / 9007199254740992.0));
+}
+
+void philox_doubles(philox_stream * const s, double * const r, const int n) {
+  int i = 0;
+  uint32_t a, b, w[4], c[4][PHILOX_LANES];
+
+  /* words left from the last call */
+  for(; i < n && s->left != 0; i++) {
+    a = philox_word(s);
+    b = philox_word(s);
+    r[i] = philox_to_double(a, b);
+  }
+  /* PHILOX_LANES blocks at once, two numbers each */
+  for(; i + 2*PHILOX_LANES <= n; i += 2*PHILOX_LANES) {
+    for(int j = 0; j < PHILOX_LANES; j++) {
+      c[0][j] = s->ctr[0];
+      c[1][j] = s->ctr[1];
+      c[2][j] = s->ctr[2] + j;
+      c[3][j] = s->ctr[3];
+    }
+    philox4x32_lanes(c, s->key);
+    s->ctr[2] += PHILOX_LANES;
+    for(int j = 0; j < PHILOX_LANES; j++) {
+      r[i+2*j] = philox_to_double(c[0][j], c[1][j]);
+      r[i+2*j+1] = philox_to_double(c[2][j], c[3][j]);
+    }
+  }
+  /* remaining whole blocks */
+  for(; i + 1 < n; i += 2) {
+    w[0] = s->ctr[0];
+    w[1] = s->ctr[1];
+    w[2] = s->ctr[2];
+    w[3] = s->ctr[3];
+    philox4x32(w, s->key);
+    s->ctr[2]++;
+    r[i] = philox_to_double(w[0], w[1]);
+    r[i+1] = philox_to_double(w[2], w[3]);
+  }
+  for(; i < n; i++) {
+    a = philox_word(s);
+    b = philox_word(s);
+    r[i] = philox_to_double(a, b);
+  }
+  return;
+}
@@ -0,0 +1,51 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _PHILOX_H
+#define _PHILOX_H
+
+#include <stdint.h>
+
+/* Counter based random number generator Philox4x32-10 of          */
+/* Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"   */
+/* (SC11). The random numbers are a function of a key and a        */
+/* counter only, such that every site of the lattice can have its  */
+/* own stream, independent of the process grid and the threads.    */
+
+typedef struct {
+  uint32_t key[2];
+  uint32_t ctr[4];
+  uint32_t buf[4];
+  int left;
+} philox_stream;
+
+/* encrypts ctr with key in place, ten rounds */
+void philox4x32(uint32_t ctr[4], const uint32_t key[2]);
+
+/* initialises a stream, ctr[2] is used as the block counter and  */
+/* incremented for every four 32 bit words                         */
+void philox_init(philox_stream * const s, const uint32_t k0, const uint32_t k1,
+		 const uint32_t c0, const uint32_t c1, const uint32_t c3);
+
+/* n uniform random numbers in [0,1) with 53 bit mantissa */
+void philox_doubles(philox_stream * const s, double * const r, const int n);
+/* n random 32 bit words */
+void philox_words(philox_stream * const s, uint32_t * const w, const int n);
+
+#endif
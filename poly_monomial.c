@@ -45,7 +45,6 @@
 #include "linsolve.h"
 #include "tm_operators.h"
 #include "solver/solver.h"
-#include "solver/chrono_guess.h"
 #include "solver/eigenvalues.h"
 #include "Nondegenerate_Matrix.h"
 #include "Hopping_Matrix.h"
@@ -270,8 +269,6 @@ void poly_heatbath(const int id, hamiltonian_field_t * const hf){
   spinor* spinor1=g_spinor_field[2];
   spinor* spinor2=g_spinor_field[3];
 
-  mnl->csg_n = 0;
-  mnl->csg_n2 = 0;
   mnl->iter0 = 0;
   mnl->iter1 = 0;
 
@@ -315,14 +312,6 @@ void poly_heatbath(const int id, hamiltonian_field_t * const hf){
       if(mnl->solver == CG) ITER_MAX_BCG = 0;
       ITER_MAX_CG = mnl->maxiter;
       mnl->iter0 += bicg(mnl->pf, spinor1, mnl->accprec, g_relative_precision_flag);
-      
-      chrono_add_solution(mnl->pf, mnl->csg_field, mnl->csg_index_array,
-			  mnl->csg_N, &mnl->csg_n, VOLUME/2);
-      
-      if(mnl->solver != CG) {
-	chrono_add_solution(mnl->pf, mnl->csg_field2, mnl->csg_index_array2,
-			    mnl->csg_N2, &mnl->csg_n2, VOLUME/2);
-      }
     } else {
       /* store constructed phi field */
       assign(mnl->pf, spinor1, VOLUME/2);
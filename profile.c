@@ -0,0 +1,166 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Counters for the hot paths of the HMC, see profile.h
+ *
+ * Every counter accumulates the number of calls, the wall clock time
+ * and the nominal number of flops and bytes moved which the caller
+ * passes to profile_end. Recursive calls of the same counter are only
+ * timed once. Inside an OpenMP parallel region a counter is taken by
+ * the first thread which starts it, such that the exchange routines
+ * called by a single thread are counted, but of the calls made by
+ * all threads at the same time only one is.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef OMP
+# include <omp.h>
+#endif
+#include "global.h"
+#include "gettime.h"
+#include "profile.h"
+
+#ifdef _PROFILE
+
+#define MAX_PROFILE_COUNTERS 256
+
+typedef struct {
+  char name[64];
+  unsigned long calls;
+  int depth, owner;
+  double start, time, flops, bytes;
+} profile_counter;
+
+static profile_counter counters[MAX_PROFILE_COUNTERS];
+static int no_counters = 0;
+
+int profile_register(const char * const name) {
+  int id = -1;
+#ifdef OMP
+#pragma omp critical(profile)
+#endif
+  {
+    for(int i = 0; i < no_counters && id < 0; i++) {
+      if(strcmp(counters[i].name, name) == 0) {
+        id = i;
+      }
+    }
+    if(id < 0 && no_counters < MAX_PROFILE_COUNTERS) {
+      memset(&counters[no_counters], 0, sizeof(profile_counter));
+      strncpy(counters[no_counters].name, name, 63);
+      id = no_counters++;
+    }
+  }
+  return(id);
+}
+
+static inline int thread_num() {
+#ifdef OMP
+  return(omp_get_thread_num());
+#else
+  return(0);
+#endif
+}
+
+/* a counter is owned by the thread which started it, the others */
+/* are not counted until it is stopped again                     */
+void profile_begin(const int id) {
+  const int me = thread_num();
+  if(id < 0) return;
+#ifdef OMP
+#pragma omp critical(profile)
+#endif
+  {
+    if(counters[id].depth == 0) {
+      counters[id].owner = me;
+      counters[id].depth = 1;
+      counters[id].start = gettime();
+    }
+    else if(counters[id].owner == me) {
+      counters[id].depth++;
+    }
+  }
+  return;
+}
+
+void profile_end(const int id, const double flops, const double bytes) {
+  const int me = thread_num();
+  if(id < 0) return;
+#ifdef OMP
+#pragma omp critical(profile)
+#endif
+  {
+    if(counters[id].depth > 0 && counters[id].owner == me) {
+      counters[id].calls++;
+      counters[id].flops += flops;
+      counters[id].bytes += bytes;
+      if(--counters[id].depth == 0) {
+        counters[id].time += gettime() - counters[id].start;
+      }
+    }
+  }
+  return;
+}
+
+void profile_reset() {
+  for(int i = 0; i < no_counters; i++) {
+    counters[i].calls = 0;
+    counters[i].time = 0.;
+    counters[i].flops = 0.;
+    counters[i].bytes = 0.;
+  }
+  return;
+}
+
+static int cmp_time(const void * a, const void * b) {
+  const double ta = counters[*(const int*)a].time, tb = counters[*(const int*)b].time;
+  return((ta < tb) - (ta > tb));
+}
+
+void profile_print(const char * const title) {
+  int index[MAX_PROFILE_COUNTERS];
+  if(g_proc_id != 0) return;
+
+  for(int i = 0; i < no_counters; i++) {
+    index[i] = i;
+  }
+  qsort(index, no_counters, sizeof(int), cmp_time);
+
+  printf("# Profile of the %s on process 0 (inclusive times)\n", title);
+  printf("# %-40s %10s %12s %13s %10s %10s\n", "routine", "calls", "time [s]", "per call [us]", "Gflop/s", "GB/s");
+  for(int i = 0; i < no_counters; i++) {
+    const profile_counter * const c = &counters[index[i]];
+    if(c->calls == 0) continue;
+    printf("# %-40s %10lu %12.4e %13.4e %10.3f %10.3f\n", c->name, c->calls, c->time,
+           1.e6*c->time/c->calls,
+           (c->time > 0.) ? 1.e-9*c->flops/c->time : 0.,
+           (c->time > 0.) ? 1.e-9*c->bytes/c->time : 0.);
+  }
+  fflush(stdout);
+  return;
+}
+
+#endif
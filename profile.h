@@ -0,0 +1,64 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+/* Counters for the calls, the wall clock time, the flops and the      */
+/* bytes moved of the hot paths, compiled in with --enable-profiling.  */
+/* A routine is instrumented with                                     */
+/*                                                                     */
+/*   _PROFILE_BEGIN("name");                                           */
+/*   ...                                                               */
+/*   _PROFILE_END(flops, bytes);                                       */
+/*                                                                     */
+/* in the same block, both expand to nothing without _PROFILE. The    */
+/* times are inclusive, a solver contains the time of the operators   */
+/* and of the linear algebra it calls. For the exchange routines the  */
+/* bytes are the ones sent.                                            */
+
+#ifdef _PROFILE
+
+/* returns the index of the counter name, a new one is created if    */
+/* there is none of this name yet                                     */
+int profile_register(const char * const name);
+void profile_begin(const int id);
+void profile_end(const int id, const double flops, const double bytes);
+/* sets all counters to zero */
+void profile_reset();
+/* prints the counters of process 0 sorted by time, with title as   */
+/* the heading                                                      */
+void profile_print(const char * const title);
+
+# define _PROFILE_BEGIN(name)                                   \
+  static int _profile_id = -1;                                  \
+  if(_profile_id < 0) _profile_id = profile_register(name);     \
+  profile_begin(_profile_id)
+
+# define _PROFILE_END(flops, bytes)             \
+  profile_end(_profile_id, flops, bytes)
+
+#else
+
+# define _PROFILE_BEGIN(name)
+# define _PROFILE_END(flops, bytes)
+
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+/*******************************************************************************
+ *
+ * Rational HMC monomial for a single flavour
+ *
+ *   S = phi^dagger r(\hat Q^2) phi ,  r(x) ~ 1/sqrt(x)
+ *
+ * with the hermitian even/odd operator \hat Q at mu = 0 and the
+ * Zolotarev approximation r(x) = A (1 + sum_i rmu_i/(x + mu_i)) of
+ * rational.h. All poles are solved for at once with cg_mms_tm_shifts.
+ *
+ * The heatbath uses r^{-1} = W W^dagger with
+ *   W = A^{-1/2} prod_i (\hat Q + i sqrt(mu_i))/(\hat Q + i sqrt(nu_i))
+ * such that phi = W R needs one multi-shift solve with the shifts nu_i
+ * and the energy is |R|^2.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include "global.h"
+#include "su3.h"
+#include "start.h"
+#include "linalg_eo.h"
+#include "deriv_Sb.h"
+#include "Hopping_Matrix.h"
+#include "tm_operators.h"
+#include "solver/cg_mms_tm.h"
+#include "read_input.h"
+#include "hamiltonian_field.h"
+#include "boundary.h"
+#include "monomial.h"
+#include "rat_monomial.h"
+
+void rat_derivative(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+
+  g_mu = mnl->mu;
+  boundary(mnl->kappa);
+
+  /* X_i = (\hat Q^2 + mu_i)^{-1} phi for all poles */
+  mnl->iter1 += cg_mms_tm_shifts(mnl->rat_fields, mnl->pf, mnl->maxiter, mnl->forceprec,
+				 g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi, np, mnl->rat.mu);
+
+  for(int i = 0; i < np; i++) {
+    mnl->forcefactor = mnl->rat.A*mnl->rat.rmu[i];
+
+    /* Y_o -> DUM_DERI  */
+    Qtm_minus_psi(g_spinor_field[DUM_DERI], mnl->rat_fields[i]);
+
+    /* to get the even sites of X_e */
+    H_eo_tm_inv_psi(g_spinor_field[DUM_DERI+2], mnl->rat_fields[i], EO, -1.);
+    /* \delta Q sandwitched by Y_o^\dagger and X_e */
+    deriv_Sb(OE, g_spinor_field[DUM_DERI], g_spinor_field[DUM_DERI+2], hf, mnl->forcefactor);
+
+    /* to get the even sites of Y_e */
+    H_eo_tm_inv_psi(g_spinor_field[DUM_DERI+3], g_spinor_field[DUM_DERI], EO, +1);
+    /* \delta Q sandwitched by Y_e^\dagger and X_o */
+    deriv_Sb(EO, g_spinor_field[DUM_DERI+3], mnl->rat_fields[i], hf, mnl->forcefactor);
+  }
+
+  g_mu = g_mu1;
+  boundary(g_kappa);
+  return;
+}
+
+
+void rat_heatbath(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+
+  g_mu = mnl->mu;
+  boundary(mnl->kappa);
+  mnl->iter0 = 0;
+  mnl->iter1 = 0;
+
+  random_spinor_field(g_spinor_field[DUM_DERI+4], VOLUME/2, mnl->rngrepro);
+  mnl->energy0 = square_norm(g_spinor_field[DUM_DERI+4], VOLUME/2, 1);
+
+  /* X_i = (\hat Q^2 + nu_i)^{-1} R */
+  mnl->iter0 = cg_mms_tm_shifts(mnl->rat_fields, g_spinor_field[DUM_DERI+4], mnl->maxiter, mnl->accprec,
+				g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi, np, mnl->rat.nu);
+
+  /* phi = A^{-1/2} (R + \hat Q sum_i rnu_i X_i - i sum_i rnu_i sqrt(nu_i) X_i) */
+  zero_spinor_field(g_spinor_field[DUM_DERI], VOLUME/2);
+  zero_spinor_field(g_spinor_field[DUM_DERI+1], VOLUME/2);
+  for(int i = 0; i < np; i++) {
+    assign_add_mul(g_spinor_field[DUM_DERI], mnl->rat_fields[i], mnl->rat.rnu[i], VOLUME/2);
+    assign_add_mul(g_spinor_field[DUM_DERI+1], mnl->rat_fields[i],
+		   -I*sqrt(mnl->rat.nu[i])*mnl->rat.rnu[i], VOLUME/2);
+  }
+  Qtm_plus_psi(g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI]);
+  add(g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+1], VOLUME/2);
+  add(g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+2], g_spinor_field[DUM_DERI+4], VOLUME/2);
+  mul_r(mnl->pf, 1./sqrt(mnl->rat.A), g_spinor_field[DUM_DERI+2], VOLUME/2);
+
+  g_mu = g_mu1;
+  boundary(g_kappa);
+  if(g_proc_id == 0 && g_debug_level > 3) {
+    printf("called rat_heatbath for id %d %d\n", id, mnl->even_odd_flag);
+  }
+  return;
+}
+
+
+double rat_acc(const int id, hamiltonian_field_t * const hf) {
+  monomial * mnl = &monomial_list[id];
+  const int np = mnl->rat.np;
+  int save_sloppy = g_sloppy_precision_flag;
+
+  g_mu = mnl->mu;
+  boundary(mnl->kappa);
+  g_sloppy_precision_flag = 0;
+
+  /* X_i = (\hat Q^2 + mu_i)^{-1} phi */
+  mnl->iter0 += cg_mms_tm_shifts(mnl->rat_fields, mnl->pf, mnl->maxiter, mnl->accprec,
+				 g_relative_precision_flag, VOLUME/2, &Qtm_pm_psi, np, mnl->rat.mu);
+  g_sloppy_precision_flag = save_sloppy;
+
+  /* the partial fractions reuse the same solutions */
+  mnl->energy1 = square_norm(mnl->pf, VOLUME/2, 1);
+  for(int i = 0; i < np; i++) {
+    mnl->energy1 += mnl->rat.rmu[i]*scalar_prod_r(mnl->pf, mnl->rat_fields[i], VOLUME/2, 1);
+  }
+  mnl->energy1 *= mnl->rat.A;
+
+  g_mu = g_mu1;
+  boundary(g_kappa);
+  if(g_proc_id == 0 && g_debug_level > 3) {
+    printf("called rat_acc for id %d %d dH = %1.4e\n", 
+	   id, mnl->even_odd_flag, mnl->energy1 - mnl->energy0);
+  }
+  return(mnl->energy1 - mnl->energy0);
+}
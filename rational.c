@@ -0,0 +1,187 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Zolotarev's optimal rational approximation of 1/sqrt(x), see rational.h
+ *
+ * With b = lmax/lmin, the modulus k = sqrt(1 - 1/b) and its complete
+ * elliptic integral K the coefficients
+ *
+ *   c_l = sn^2(l K/(2np+1); k) / cn^2(l K/(2np+1); k),  l = 1,...,2np
+ *
+ * give the shifts mu[i] = lmin c_{2i+1} and nu[i] = lmin c_{2i+2}.
+ * The constant A is fixed such that the relative error of the
+ * approximation is symmetric around zero, it is determined together
+ * with the maximal relative error delta on a logarithmic grid.
+ *
+ * The residues rmu and rnu of the partial fractions are computed from
+ * the products over the poles, all shifts are distinct and positive.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include <errno.h>
+#include "global.h"
+#include "rational.h"
+
+#define RATIONAL_GRID 10000
+
+/* sn, cn and dn of u with 1 - k^2 = emc by the descending */
+/* Landen transformation                                    */
+static void sncndn(const double uu, const double emmc, double * const sn,
+		   double * const cn, double * const dn) {
+  double a, b, c = 1., d, emc = emmc, u = uu;
+  double em[16], en[16];
+  int i, l = 0;
+
+  a = 1.;
+  *dn = 1.;
+  for(i = 0; i < 16; i++) {
+    l = i;
+    em[i] = a;
+    en[i] = (emc = sqrt(emc));
+    c = 0.5*(a + emc);
+    if(fabs(a - emc) <= 1.e-8*a) break;
+    emc *= a;
+    a = c;
+  }
+  u *= c;
+  *sn = sin(u);
+  *cn = cos(u);
+  if(*sn != 0.) {
+    a = (*cn)/(*sn);
+    c *= a;
+    for(i = l; i >= 0; i--) {
+      b = em[i];
+      a *= c;
+      c *= (*dn);
+      *dn = (en[i] + a)/(b + a);
+      a = c/b;
+    }
+    d = 1./sqrt(c*c + 1.);
+    *sn = (*sn >= 0.) ? d : -d;
+    *cn = c*(*sn);
+  }
+  return;
+}
+
+/* complete elliptic integral of the first kind with 1 - k^2 = emc */
+static double ellipticK(const double emc) {
+  double a = 1., b = sqrt(emc), t;
+
+  while(fabs(a - b) > 1.e-15*a) {
+    t = 0.5*(a + b);
+    b = sqrt(a*b);
+    a = t;
+  }
+  return(M_PI/(2.*a));
+}
+
+int init_rational(rational_t * const rat, const int np, const double lmin, const double lmax) {
+  const double b = lmax/lmin;
+  double K, sn, cn, dn, x, f, fmin = 0., fmax = 0.;
+  double * c;
+  _Complex double z;
+
+  if(np < 1 || lmin <= 0. || lmax <= lmin) {
+    fprintf(stderr, "init_rational: invalid order %d or interval [%e, %e]\n", np, lmin, lmax);
+    return(1);
+  }
+  rat->np = np;
+  rat->range[0] = lmin;
+  rat->range[1] = lmax;
+  if((void*)(c = (double*)calloc(2*np+1, sizeof(double))) == NULL ||
+     (void*)(rat->mu = (double*)calloc(np, sizeof(double))) == NULL ||
+     (void*)(rat->rmu = (double*)calloc(np, sizeof(double))) == NULL ||
+     (void*)(rat->nu = (double*)calloc(np, sizeof(double))) == NULL ||
+     (void*)(rat->rnu = (_Complex double*)calloc(np, sizeof(_Complex double))) == NULL) {
+    printf ("malloc errno in init_rational: %d\n",errno);
+    errno = 0;
+    return(2);
+  }
+
+  K = ellipticK(1./b);
+  for(int l = 1; l < 2*np+1; l++) {
+    sncndn(l*K/(2*np+1), 1./b, &sn, &cn, &dn);
+    c[l] = sn*sn/(cn*cn);
+  }
+  for(int i = 0; i < np; i++) {
+    rat->mu[i] = lmin*c[2*i+1];
+    rat->nu[i] = lmin*c[2*i+2];
+  }
+  free(c);
+
+  /* A and delta from the extrema of sqrt(x) prod_i (x+nu)/(x+mu) */
+  for(int j = 0; j < RATIONAL_GRID+1; j++) {
+    x = lmin*pow(b, (double)j/RATIONAL_GRID);
+    f = sqrt(x);
+    for(int i = 0; i < np; i++) {
+      f *= (x + rat->nu[i])/(x + rat->mu[i]);
+    }
+    if(j == 0 || f < fmin) fmin = f;
+    if(j == 0 || f > fmax) fmax = f;
+  }
+  rat->A = 2./(fmin + fmax);
+  rat->delta = (fmax - fmin)/(fmax + fmin);
+
+  /* residues of the partial fractions */
+  for(int l = 0; l < np; l++) {
+    rat->rmu[l] = 1.;
+    z = 1.;
+    for(int j = 0; j < np; j++) {
+      rat->rmu[l] *= rat->nu[j] - rat->mu[l];
+      z *= I*(sqrt(rat->mu[j]) - sqrt(rat->nu[l]));
+      if(j != l) {
+	rat->rmu[l] /= rat->mu[j] - rat->mu[l];
+	z /= I*(sqrt(rat->nu[j]) - sqrt(rat->nu[l]));
+      }
+    }
+    rat->rnu[l] = z;
+  }
+
+  if(g_proc_id == 0 && g_debug_level > 0) {
+    printf("# Rational approximation of 1/sqrt(x) with %d poles on [%e, %e]: A = %e, maximal relative error %e\n",
+	   np, lmin, lmax, rat->A, rat->delta);
+    if(g_debug_level > 2) {
+      for(int i = 0; i < np; i++) {
+	printf("# mu[%d] = %e rmu[%d] = %e nu[%d] = %e\n", i, rat->mu[i], i, rat->rmu[i], i, rat->nu[i]);
+      }
+    }
+  }
+  return(0);
+}
+
+void free_rational(rational_t * const rat) {
+  free(rat->mu);
+  free(rat->rmu);
+  free(rat->nu);
+  free(rat->rnu);
+  rat->mu = NULL;
+  rat->rmu = NULL;
+  rat->nu = NULL;
+  rat->rnu = NULL;
+  rat->np = 0;
+  return;
+}
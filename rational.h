@@ -0,0 +1,49 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _RATIONAL_H
+#define _RATIONAL_H
+
+#include <complex.h>
+
+/* Zolotarev's optimal rational approximation of 1/sqrt(x) */
+/* on [range[0], range[1]] with np poles                    */
+/*                                                          */
+/*   1/sqrt(x) ~ A prod_i (x + nu[i])/(x + mu[i])           */
+/*             = A (1 + sum_i rmu[i]/(x + mu[i]))           */
+/*                                                          */
+/* and for the heatbath with real y, x = y^2                */
+/*                                                          */
+/*   prod_i (y + i sqrt(mu[i]))/(y + i sqrt(nu[i]))         */
+/*             = 1 + sum_i rnu[i]/(y + i sqrt(nu[i]))       */
+
+typedef struct {
+  int np;
+  double range[2];
+  /* overall constant and maximal relative error */
+  double A, delta;
+  double * mu, * rmu, * nu;
+  _Complex double * rnu;
+} rational_t;
+
+/* computes the approximation, returns 0 on success */
+int init_rational(rational_t * const rat, const int np, const double lmin, const double lmax);
+void free_rational(rational_t * const rat);
+
+#endif
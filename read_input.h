@@ -54,6 +54,7 @@ extern "C"
   extern int crylov_space_dim;
   extern char rlxd_input_filename[500];
   extern char gauge_input_filename[500];
+  extern char tuning_filename[500];
   extern int subforwilson_flag;
   extern int eigenvalue_method_flag;
   extern int eigenvalue_max_iterations;
@@ -68,6 +69,7 @@ extern "C"
   extern int read_source_flag;
   extern int return_check_flag;
   extern int return_check_interval;
+  extern double csg_memory;
   extern int gauge_precision_read_flag;
   extern int gauge_precision_write_flag;
   extern int reproduce_randomnumber_flag;
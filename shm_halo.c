@@ -0,0 +1,287 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * MPI-3 shared memory for the halo exchange between processes on the
+ * same node.
+ *
+ * The processes of a node are collected in g_shm_comm. Memory for the
+ * fields which are exchanged is allocated with MPI_Win_allocate_shared,
+ * one window per allocation, such that every process can address the
+ * copy of a field of its neighbours on the node. The exchange routines
+ * then read the boundary sites of these neighbours directly into the
+ * RAND, only the faces to neighbours on other nodes are sent as
+ * messages.
+ *
+ * All processes allocate the fields in the same order with the same
+ * size, so the offset of a field in a window is the same on all of
+ * them.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "shm_halo.h"
+
+#if (defined _SHM_HALO && defined MPI)
+
+MPI_Comm g_shm_comm = MPI_COMM_NULL;
+int g_shm_nb[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+int * g_shm_field_dst[2][8], * g_shm_field_src[2][8];
+int g_shm_field_n[2][8], g_shm_field_cont[2][8];
+
+static int shm_lists_done = 0;
+
+/* the parallelised directions t, x, y, z */
+static const int shm_parallel[4] = {
+#if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT)
+  1,
+#else
+  0,
+#endif
+#if (defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT)
+  1,
+#else
+  0,
+#endif
+#if (defined PARALLELXY || defined PARALLELXYZ || defined PARALLELXYT || defined PARALLELXYZT)
+  1,
+#else
+  0,
+#endif
+#if (defined PARALLELXYZ || defined PARALLELXYZT)
+  1
+#else
+  0
+#endif
+};
+
+#define _MAX_SHM_WINDOWS 128
+
+typedef struct {
+  MPI_Win win;
+  char * base;
+  size_t size;
+  char * nb[8];
+} shm_window;
+
+static shm_window shm_windows[_MAX_SHM_WINDOWS];
+static int shm_nwin = 0;
+
+void init_shm_halo() {
+  MPI_Group cart_group, shm_group;
+  int L[4], nsize, non = 0, noff = 0;
+  L[0] = T; L[1] = LX; L[2] = LY; L[3] = LZ;
+
+  MPI_Comm_split_type(g_cart_grid, MPI_COMM_TYPE_SHARED, g_cart_id, MPI_INFO_NULL, &g_shm_comm);
+  MPI_Comm_size(g_shm_comm, &nsize);
+  MPI_Comm_group(g_cart_grid, &cart_group);
+  MPI_Comm_group(g_shm_comm, &shm_group);
+  MPI_Group_translate_ranks(cart_group, 8, g_nb_list, shm_group, g_shm_nb);
+  MPI_Group_free(&cart_group);
+  MPI_Group_free(&shm_group);
+
+  for(int mu = 0; mu < 4; mu++) {
+    /* the neighbour reads with our even/odd layout */
+    if(shm_parallel[mu] && L[mu]%2 != 0) {
+      if(g_proc_id == 0) {
+	fprintf(stderr, "--with-shmhalo needs even local lattice extents in the parallelised directions\n");
+	fprintf(stderr, "Aborting...!\n");
+      }
+      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Finalize();
+      exit(-1);
+    }
+    for(int i = 2*mu; i < 2*mu+2; i++) {
+      if(!shm_parallel[mu] || g_shm_nb[i] == MPI_UNDEFINED) {
+	g_shm_nb[i] = -1;
+      }
+      if(shm_parallel[mu]) {
+	if(g_shm_nb[i] > -1) non++;
+	else noff++;
+      }
+    }
+  }
+  if(g_proc_id == 0 && g_debug_level > 0) {
+    printf("# %d processes share memory with process 0, %d of its neighbours are on the same node, %d on other nodes\n",
+	   nsize, non, noff);
+  }
+  return;
+}
+
+void * shm_alloc(const size_t size) {
+  shm_window * w;
+  MPI_Info info;
+  MPI_Aint nbsize;
+  int disp;
+  char * nbbase;
+
+  if(g_shm_comm == MPI_COMM_NULL || shm_nwin == _MAX_SHM_WINDOWS) {
+    return(malloc(size));
+  }
+  w = &shm_windows[shm_nwin];
+  MPI_Info_create(&info);
+  /* every process gets its own pages, close to its threads */
+  MPI_Info_set(info, "alloc_shared_noncontig", "true");
+  if(MPI_Win_allocate_shared((MPI_Aint)size, 1, info, g_shm_comm, &w->base, &w->win) != MPI_SUCCESS) {
+    MPI_Info_free(&info);
+    return(NULL);
+  }
+  MPI_Info_free(&info);
+  /* passive target epoch for MPI_Win_sync */
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, w->win);
+  w->size = size;
+  for(int i = 0; i < 8; i++) {
+    w->nb[i] = NULL;
+    if(g_shm_nb[i] > -1) {
+      MPI_Win_shared_query(w->win, g_shm_nb[i], &nbsize, &disp, &nbbase);
+      /* the fields are aligned relative to the base address */
+      if((size_t)nbsize == size && ((size_t)nbbase & 0x3f) == ((size_t)w->base & 0x3f)) {
+	w->nb[i] = nbbase;
+      }
+    }
+  }
+  shm_nwin++;
+  return((void*)w->base);
+}
+
+static shm_window * find_window(const void * const ptr) {
+  const char * p = (const char*) ptr;
+  for(int i = 0; i < shm_nwin; i++) {
+    if(p >= shm_windows[i].base && p < shm_windows[i].base + shm_windows[i].size) {
+      return(&shm_windows[i]);
+    }
+  }
+  return(NULL);
+}
+
+void shm_free(void * const mem) {
+  shm_window * w = find_window(mem);
+  if(mem == NULL) return;
+  if(w == NULL) {
+    free(mem);
+    return;
+  }
+  MPI_Win_unlock_all(w->win);
+  MPI_Win_free(&w->win);
+  *w = shm_windows[--shm_nwin];
+  return;
+}
+
+int shm_is_shared(const void * const ptr) {
+  return(find_window(ptr) != NULL);
+}
+
+void * shm_nb_ptr(const void * const ptr, const int dir) {
+  shm_window * w = find_window(ptr);
+  if(w == NULL || w->nb[dir] == NULL) {
+    return(NULL);
+  }
+  return((void*)(w->nb[dir] + ((const char*)ptr - w->base)));
+}
+
+void shm_sync(const void * const ptr) {
+  shm_window * w = find_window(ptr);
+  if(w != NULL) MPI_Win_sync(w->win);
+  MPI_Barrier(g_shm_comm);
+  if(w != NULL) MPI_Win_sync(w->win);
+  return;
+}
+
+/* lexicographic index of a point with one coordinate -1 or L */
+static int ipt_ext(const int x0, const int x1, const int x2, const int x3) {
+  return(g_ipt[x0 < 0 ? T+1 : x0][x1 < 0 ? LX+1 : x1][x2 < 0 ? LY+1 : x2][x3 < 0 ? LZ+1 : x3]);
+}
+
+static int cmp_pair(const void * a, const void * b) {
+  return(((const int*)a)[0] - ((const int*)b)[0]);
+}
+
+int init_shm_field_lists() {
+  int L[4], x[4], y[4], n, s, * pairs;
+  if(shm_lists_done) return(0);
+  L[0] = T; L[1] = LX; L[2] = LY; L[3] = LZ;
+
+  for(int p = 0; p < 2; p++) {
+    for(int dir = 0; dir < 8; dir++) {
+      const int mu = dir/2, up = (dir%2 == 0);
+      const int face = VOLUME/L[mu];
+      g_shm_field_n[p][dir] = 0;
+      g_shm_field_cont[p][dir] = 1;
+      g_shm_field_dst[p][dir] = NULL;
+      g_shm_field_src[p][dir] = NULL;
+      if(!shm_parallel[mu]) continue;
+
+      if((void*)(pairs = (int*)malloc(2*face*sizeof(int))) == NULL) {
+	printf ("malloc error in init_shm_field_lists\n");
+	return(1);
+      }
+      n = 0;
+      for(int i = 0; i < face; i++) {
+	/* coordinates of the i-th site of the face, x[mu] is set below */
+	int r = i;
+	for(int nu = 3; nu >= 0; nu--) {
+	  if(nu == mu) continue;
+	  x[nu] = r%L[nu];
+	  r /= L[nu];
+	}
+	x[mu] = up ? L[mu] : -1;
+	s = x[0] + x[1] + x[2] + x[3] +
+	  g_proc_coords[0]*T + g_proc_coords[1]*LX +
+	  g_proc_coords[2]*LY + g_proc_coords[3]*LZ;
+	if((s%2 + 2)%2 != p) continue;
+	/* the same site is at the opposite face of the neighbour */
+	for(int nu = 0; nu < 4; nu++) y[nu] = x[nu];
+	y[mu] = up ? 0 : L[mu]-1;
+	pairs[2*n] = g_lexic2eosub[ ipt_ext(x[0], x[1], x[2], x[3]) ];
+	pairs[2*n+1] = g_lexic2eosub[ g_ipt[y[0]][y[1]][y[2]][y[3]] ];
+	n++;
+      }
+      qsort(pairs, n, 2*sizeof(int), cmp_pair);
+
+      g_shm_field_dst[p][dir] = (int*)malloc(n*sizeof(int));
+      g_shm_field_src[p][dir] = (int*)malloc(n*sizeof(int));
+      if(g_shm_field_dst[p][dir] == NULL || g_shm_field_src[p][dir] == NULL) {
+	printf ("malloc error in init_shm_field_lists\n");
+	free(pairs);
+	return(1);
+      }
+      for(int i = 0; i < n; i++) {
+	g_shm_field_dst[p][dir][i] = pairs[2*i];
+	g_shm_field_src[p][dir][i] = pairs[2*i+1];
+	if(pairs[2*i] != pairs[0] + i) g_shm_field_cont[p][dir] = 0;
+      }
+      g_shm_field_n[p][dir] = n;
+      free(pairs);
+    }
+  }
+  shm_lists_done = 1;
+  return(0);
+}
+
+#endif
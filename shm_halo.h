@@ -0,0 +1,62 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _SHM_HALO_H
+#define _SHM_HALO_H
+
+#if (defined _SHM_HALO && defined MPI)
+
+# include <mpi.h>
+# include <stddef.h>
+
+/* the processes sharing memory with this one */
+extern MPI_Comm g_shm_comm;
+/* rank in g_shm_comm of the neighbour in direction                 */
+/* t_up, t_dn, x_up, x_dn, y_up, y_dn, z_up, z_dn (as g_nb_list),     */
+/* -1 if it is on another node or the direction is not parallelised */
+extern int g_shm_nb[8];
+
+/* for the parity p (0 even, 1 odd) and the direction dir in the order  */
+/* of g_nb_list the RAND sites dst[i] of an even/odd spinor field are  */
+/* filled with the sites src[i] of the neighbour in direction dir.     */
+/* The pairs are ordered in dst, cont is 1 if dst is one block.        */
+extern int * g_shm_field_dst[2][8], * g_shm_field_src[2][8];
+extern int g_shm_field_n[2][8], g_shm_field_cont[2][8];
+
+/* called in tmlqcd_mpi_init after the cartesian grid is created */
+void init_shm_halo();
+/* the index lists above, they need the geometry */
+int init_shm_field_lists();
+
+/* Memory which neighbours on the same node can read directly. The     */
+/* allocation is collective on the node, all processes must allocate   */
+/* the same sizes in the same order. If no window is available plain   */
+/* malloc memory is returned, shm_free handles both cases.             */
+void * shm_alloc(const size_t size);
+void shm_free(void * const mem);
+/* 1 if ptr lies in memory from shm_alloc */
+int shm_is_shared(const void * const ptr);
+/* the address of the neighbours copy of ptr, NULL if it cannot be read */
+void * shm_nb_ptr(const void * const ptr, const int dir);
+/* barrier on the node, makes the stores to the window of ptr visible */
+void shm_sync(const void * const ptr);
+
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Order in which the halfspinor Dirac operator visits the sites of one
+ * parity.
+ *
+ * In the even/odd index the sites follow the lexicographic order with
+ * z running fastest. The eight neighbours of a site which the operator
+ * reads from (and writes to) the HalfSpinor field are then spread over
+ * the whole local volume and the ones in t and x direction have left
+ * the cache when they are needed again. Walking through the lattice in
+ * small 4d tiles, or along a Morton curve, keeps them close in time.
+ *
+ * Only the traversal changes, the fields keep the even/odd layout.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include "global.h"
+#include "site_order.h"
+
+typedef struct {
+  unsigned long long key;
+  int ix;
+} morton_site;
+
+static int cmp_morton(const void * a, const void * b) {
+  const unsigned long long ka = ((const morton_site*)a)->key, kb = ((const morton_site*)b)->key;
+  return((ka > kb) - (ka < kb));
+}
+
+/* appends the local site ix to the list of its parity */
+static void add_site(int * const n, const int ix) {
+  if(g_lexic2eo[ix] < (VOLUME+RAND)/2) {
+    g_eo_site_order[n[0]++] = g_lexic2eosub[ix];
+  }
+  else {
+    g_eo_site_order[VOLUME/2 + n[1]++] = g_lexic2eosub[ix];
+  }
+}
+
+int init_site_order(const int type, const int * const tile) {
+  int L[4], b[4], n[2] = {0, 0};
+  L[0] = T; L[1] = LX; L[2] = LY; L[3] = LZ;
+
+  if(type == SITE_ORDER_TILED) {
+    for(int mu = 0; mu < 4; mu++) {
+      if(tile[mu] < 1) {
+        if(g_proc_id == 0) {
+          fprintf(stderr, "init_site_order: tile extents must be positive\n");
+        }
+        return(1);
+      }
+      b[mu] = (tile[mu] < L[mu]) ? tile[mu] : L[mu];
+    }
+    for(int t0 = 0; t0 < T; t0 += b[0]) {
+      for(int x0 = 0; x0 < LX; x0 += b[1]) {
+        for(int y0 = 0; y0 < LY; y0 += b[2]) {
+          for(int z0 = 0; z0 < LZ; z0 += b[3]) {
+            /* the tiles at the upper boundary may be smaller */
+            for(int t = t0; t < t0+b[0] && t < T; t++) {
+              for(int x = x0; x < x0+b[1] && x < LX; x++) {
+                for(int y = y0; y < y0+b[2] && y < LY; y++) {
+                  for(int z = z0; z < z0+b[3] && z < LZ; z++) {
+                    add_site(n, g_ipt[t][x][y][z]);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  else if(type == SITE_ORDER_MORTON) {
+    morton_site * sites;
+    int nbits = 0, x[4];
+    while((1 << nbits) < T || (1 << nbits) < LX || (1 << nbits) < LY || (1 << nbits) < LZ) {
+      nbits++;
+    }
+    if((void*)(sites = (morton_site*)malloc(VOLUME*sizeof(morton_site))) == NULL) {
+      printf ("malloc error in init_site_order\n");
+      return(1);
+    }
+    for(int i = 0; i < VOLUME; i++) {
+      /* coordinates from the lexicographic index, z runs fastest */
+      int r = i;
+      for(int mu = 3; mu >= 0; mu--) {
+        x[mu] = r%L[mu];
+        r /= L[mu];
+      }
+      sites[i].ix = g_ipt[x[0]][x[1]][x[2]][x[3]];
+      sites[i].key = 0;
+      for(int bit = nbits-1; bit >= 0; bit--) {
+        for(int mu = 0; mu < 4; mu++) {
+          sites[i].key = (sites[i].key << 1) | ((x[mu] >> bit) & 1);
+        }
+      }
+    }
+    qsort(sites, VOLUME, sizeof(morton_site), cmp_morton);
+    for(int i = 0; i < VOLUME; i++) {
+      add_site(n, sites[i].ix);
+    }
+    free(sites);
+  }
+  else {
+    for(int i = 0; i < VOLUME/2; i++) {
+      g_eo_site_order[i] = i;
+      g_eo_site_order[VOLUME/2 + i] = i;
+    }
+    n[0] = n[1] = VOLUME/2;
+  }
+
+  if(n[0] != VOLUME/2 || n[1] != VOLUME/2) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "init_site_order: found %d even and %d odd sites, expected %d\n", n[0], n[1], VOLUME/2);
+    }
+    return(2);
+  }
+  return(0);
+}
+
+void site_order_name(char * const str, const int type, const int * const tile) {
+  if(type == SITE_ORDER_TILED) {
+    sprintf(str, "%dx%dx%dx%d", tile[0], tile[1], tile[2], tile[3]);
+  }
+  else if(type == SITE_ORDER_MORTON) {
+    sprintf(str, "morton");
+  }
+  else {
+    sprintf(str, "lexic");
+  }
+  return;
+}
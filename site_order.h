@@ -0,0 +1,40 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _SITE_ORDER_H
+#define _SITE_ORDER_H
+
+/* values of g_site_order_type                                    */
+/* lexicographic order of the even/odd index (the default)        */
+#define SITE_ORDER_LEXIC 0
+/* 4d tiles of g_site_tile[0] x ... x g_site_tile[3] sites        */
+#define SITE_ORDER_TILED 1
+/* Morton (Z) curve through the local lattice                     */
+#define SITE_ORDER_MORTON 2
+
+/* Fills g_eo_site_order for the even (p = 0) and the odd (p = 1) */
+/* sites, g_eo_site_order[p*VOLUME/2 + n] is the even/odd sub     */
+/* index of the n-th site of parity p the halfspinor Dirac        */
+/* operator works on. Needs the geometry, returns 0 on success.   */
+int init_site_order(const int type, const int * const tile);
+
+/* writes a description of the order, e.g. "2x4x4x4", into str    */
+void site_order_name(char * const str, const int type, const int * const tile);
+
+#endif
@@ -0,0 +1,612 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * File: bcg_her.c
+ *
+ * block CG solver for hermitian f only!
+ *
+ * The externally accessible function is
+ *
+ *   int bcg_her(spinor ** const P, spinor ** const Q, const int nrhs,
+ *               const int max_iter, double eps_sq, const int rel_prec,
+ *               const int N, matrix_mult_nrhs f)
+ *
+ * input:
+ *   Q: nrhs sources
+ *   f: applies the operator to all fields of a block at once,
+ *      e.g. Qtm_pm_psi_nrhs with Hopping_Matrix_nrhs
+ * inout:
+ *   P: nrhs initial guesses and results
+ *
+ * All nrhs systems share one block Krylov space (O'Leary 1980).
+ * The residual block is orthonormalised in every iteration with the
+ * Cholesky factor L of R^dagger R (Dubrulle 2001), which keeps the
+ * small matrices well conditioned when some of the right hand sides
+ * converge faster than others. With W = A R the iteration reads
+ *
+ *   alpha = mu^-1 L^dagger
+ *   X = X + P alpha,  R = R - AP alpha,  W = A R
+ *   gamma = R^dagger R,  delta = R^dagger W
+ *   L' = chol(gamma),  beta = L^-1 gamma L'^-dagger
+ *   P = R L'^-dagger + P beta,  AP = W L'^-dagger + AP beta
+ *   mu = L'^-1 delta L'^-dagger - beta^dagger mu beta
+ *
+ * with mu = P^dagger A P. gamma and delta are computed together,
+ * so there is only one global reduction per iteration, with
+ * _REPRODUCIBLE_REDUCTIONS it is done with repro_sum as in linalg.
+ *
+ * Right hand sides that reached the requested precision are
+ * removed from the block (deflated), the remaining ones continue
+ * with the search directions built so far. Right hand sides whose
+ * residue became numerically linearly dependent on the others are
+ * removed as well and solved in a second pass afterwards.
+ *
+ * returns the number of block iterations or -1 if not all
+ * right hand sides converged within max_iter iterations.
+ *
+ **************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#ifdef OMP
+# include <omp.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "linalg_eo.h"
+#include "start.h"
+#include "gettime.h"
+#include "linalg/lapack.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "linalg/repro_sum.h"
+#endif
+#include "solver/matrix_mult_typedef.h"
+#include "solver_field.h"
+#include "bcg_her.h"
+#include "profile.h"
+
+/* a residue whose part orthogonal to the other residues is smaller */
+/* than this (squared and relative) is taken out of the block       */
+#define _BCG_DEP_TOL 1.e-10
+
+/* the small matrices are stored column major with leading dimension ld */
+
+/* G = V^dagger V and H = V^dagger W for the first m columns,      */
+/* W = A V with A hermitian, so only the upper triangles are summed */
+#ifdef _REPRODUCIBLE_REDUCTIONS
+
+/* the real and imaginary parts of both upper triangles are summed */
+/* exactly and reduced in one repro_sum_finalize                   */
+static void block_gram(_Complex double * const G, _Complex double * const H,
+                       spinor ** const V, spinor ** const W,
+                       const int m, const int ld, const int N) {
+  const int nm = 2*m*(m+1);
+  repro_sum * acc = (repro_sum*)malloc(nm*sizeof(repro_sum));
+  double * res = (double*)malloc(nm*sizeof(double));
+  int k;
+
+  repro_sum_zero(acc, nm);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum * lacc = (repro_sum*)malloc(nm*sizeof(repro_sum));
+  const double *v, *u, *w;
+  int t;
+  repro_sum_zero(lacc, nm);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    t = 0;
+    for(int j = 0; j < m; j++) {
+      u = (const double*)(V[j] + ix);
+      w = (const double*)(W[j] + ix);
+      for(int i = 0; i <= j; i++) {
+        v = (const double*)(V[i] + ix);
+        repro_sum_add(&lacc[t], repro_site_dot(v, u, 24));
+        repro_sum_add(&lacc[t+1], repro_site_dot_i(v, u, 24));
+        repro_sum_add(&lacc[t+2], repro_site_dot(v, w, 24));
+        repro_sum_add(&lacc[t+3], repro_site_dot_i(v, w, 24));
+        t += 4;
+      }
+    }
+  }
+  repro_sum_merge(acc, lacc, nm);
+  free(lacc);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  repro_sum_finalize(res, acc, nm, 1);
+  k = 0;
+  for(int j = 0; j < m; j++) {
+    for(int i = 0; i <= j; i++) {
+      G[i + j*ld] = res[k] + I*res[k+1];
+      G[j + i*ld] = conj(G[i + j*ld]);
+      H[i + j*ld] = res[k+2] + I*res[k+3];
+      H[j + i*ld] = conj(H[i + j*ld]);
+      k += 4;
+    }
+  }
+  free(res);
+  free(acc);
+  return;
+}
+
+#else
+
+/* the local sums of both matrices are reduced in one MPI_Allreduce */
+static void block_gram(_Complex double * const G, _Complex double * const H,
+                       spinor ** const V, spinor ** const W,
+                       const int m, const int ld, const int N) {
+  const int nm = 2*ld*ld;
+  _Complex double * acc, * res;
+  int nthreads = 1;
+#ifdef OMP
+  nthreads = omp_num_threads;
+#endif
+  acc = (_Complex double*)calloc((nthreads+1)*nm, sizeof(_Complex double));
+
+#ifdef OMP
+#pragma omp parallel
+  {
+  _Complex double * g = acc + omp_get_thread_num()*nm;
+#else
+  _Complex double * g = acc;
+#endif
+  _Complex double * h = g + ld*ld;
+  _Complex double sg, sh;
+  _Complex double *v, *u, *w;
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    for(int j = 0; j < m; j++) {
+      u = (_Complex double*)(V[j] + ix);
+      w = (_Complex double*)(W[j] + ix);
+      for(int i = 0; i <= j; i++) {
+        v = (_Complex double*)(V[i] + ix);
+        sg = 0.;
+        sh = 0.;
+        for(int c = 0; c < 12; c++) {
+          sg += conj(v[c]) * u[c];
+          sh += conj(v[c]) * w[c];
+        }
+        g[i + j*ld] += sg;
+        h[i + j*ld] += sh;
+      }
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  /* sum the thread contributions in a fixed order */
+  for(int t = 1; t < nthreads; t++) {
+    for(int i = 0; i < nm; i++) {
+      acc[i] += acc[t*nm + i];
+    }
+  }
+  res = acc;
+#ifdef MPI
+  res = acc + nthreads*nm;
+  MPI_Allreduce(acc, res, nm, MPI_DOUBLE_COMPLEX, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  for(int j = 0; j < m; j++) {
+    for(int i = 0; i <= j; i++) {
+      G[i + j*ld] = res[i + j*ld];
+      G[j + i*ld] = conj(res[i + j*ld]);
+      H[i + j*ld] = res[ld*ld + i + j*ld];
+      H[j + i*ld] = conj(res[ld*ld + i + j*ld]);
+    }
+  }
+  free(acc);
+  return;
+}
+
+#endif
+
+/* Y_j = sum_k Z_k c_kj + sum_k Y_k d_kj for j < m, in place for Y */
+/* Z has m columns, Y has my columns on input                       */
+static void block_combine(spinor ** const Y, _Complex double * const d, const int my,
+                          spinor ** const Z, _Complex double * const c,
+                          const int m, const int ld, const int N) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _Complex double y[my > 0 ? my : 1][12];
+  _Complex double *r, *z;
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    for(int k = 0; k < my; k++) {
+      memcpy(y[k], Y[k] + ix, sizeof(spinor));
+    }
+    for(int j = 0; j < m; j++) {
+      r = (_Complex double*)(Y[j] + ix);
+      for(int e = 0; e < 12; e++) {
+        r[e] = 0.;
+      }
+      for(int k = 0; k < m; k++) {
+        z = (_Complex double*)(Z[k] + ix);
+        for(int e = 0; e < 12; e++) {
+          r[e] += z[e] * c[k + j*ld];
+        }
+      }
+      for(int k = 0; k < my; k++) {
+        for(int e = 0; e < 12; e++) {
+          r[e] += y[k][e] * d[k + j*ld];
+        }
+      }
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
+
+/* Y_j = Y_j + s * sum_k V_k c_kj for j < m */
+static void block_axpy(spinor ** const Y, spinor ** const V, _Complex double * const c,
+                       const double s, const int m, const int ld, const int N) {
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    _Complex double *r, *v;
+    _Complex double t;
+    for(int j = 0; j < m; j++) {
+      r = (_Complex double*)(Y[j] + ix);
+      for(int k = 0; k < m; k++) {
+        v = (_Complex double*)(V[k] + ix);
+        t = s * c[k + j*ld];
+        for(int e = 0; e < 12; e++) {
+          r[e] += t * v[e];
+        }
+      }
+    }
+  }
+  return;
+}
+
+/* C = op(A) op(B) with op(A) n x k and op(B) k x m,  */
+/* op is the identity or for ta, tb = 1 the adjoint   */
+static void small_mult(_Complex double * const C, _Complex double * const A, const int ta,
+                       _Complex double * const B, const int tb,
+                       const int n, const int k, const int m, const int ld) {
+  _Complex double a, b;
+  for(int j = 0; j < m; j++) {
+    for(int i = 0; i < n; i++) {
+      C[i + j*ld] = 0.;
+      for(int l = 0; l < k; l++) {
+        a = ta ? conj(A[l + i*ld]) : A[i + l*ld];
+        b = tb ? conj(B[j + l*ld]) : B[l + j*ld];
+        C[i + j*ld] += a * b;
+      }
+    }
+  }
+  return;
+}
+
+/* Cholesky factor L of the hermitian m x m matrix G = L L^dagger */
+/* and its inverse Linv, both lower triangular. Returns j+1 if    */
+/* column j is numerically dependent on the columns before it     */
+static int small_chol(_Complex double * const L, _Complex double * const Linv,
+                      _Complex double * const G, const int m, const int ld) {
+  double d;
+  for(int j = 0; j < m; j++) {
+    for(int i = 0; i < m; i++) {
+      L[i + j*ld] = 0.;
+      Linv[i + j*ld] = 0.;
+    }
+  }
+  for(int j = 0; j < m; j++) {
+    d = creal(G[j + j*ld]);
+    for(int k = 0; k < j; k++) {
+      d -= creal(L[j + k*ld] * conj(L[j + k*ld]));
+    }
+    if(d <= _BCG_DEP_TOL * creal(G[j + j*ld])) return(j+1);
+    L[j + j*ld] = sqrt(d);
+    for(int i = j+1; i < m; i++) {
+      L[i + j*ld] = G[i + j*ld];
+      for(int k = 0; k < j; k++) {
+        L[i + j*ld] -= L[i + k*ld] * conj(L[j + k*ld]);
+      }
+      L[i + j*ld] /= L[j + j*ld];
+    }
+  }
+  /* forward substitution for the columns of the inverse */
+  for(int j = 0; j < m; j++) {
+    Linv[j + j*ld] = 1. / L[j + j*ld];
+    for(int i = j+1; i < m; i++) {
+      for(int k = j; k < i; k++) {
+        Linv[i + j*ld] -= L[i + k*ld] * Linv[k + j*ld];
+      }
+      Linv[i + j*ld] /= L[i + i*ld];
+    }
+  }
+  return(0);
+}
+
+/* solve A x = b for m right hand sides with LAPACK, A is kept */
+static int block_solve(_Complex double * const x, _Complex double * const A,
+                       _Complex double * const b, const int m, const int ld) {
+  int info = 0, n = m, lda = ld;
+  int * ipiv = (int*)malloc(ld*sizeof(int));
+  _Complex double * a = (_Complex double*)malloc(ld*ld*sizeof(_Complex double));
+  memcpy(a, A, ld*ld*sizeof(_Complex double));
+  memcpy(x, b, ld*ld*sizeof(_Complex double));
+  _FT(zgesv)(&n, &n, a, &lda, ipiv, x, &lda, &info);
+  free(a);
+  free(ipiv);
+  return(info);
+}
+
+int bcg_her(spinor ** const P, spinor ** const Q, const int nrhs, const int max_iter,
+            double eps_sq, const int rel_prec, const int N, matrix_mult_nrhs f) {
+  _PROFILE_BEGIN(__func__);
+
+  const int ld = nrhs;
+  int iteration = 0, m = 0, ma = 0, info = 0, matvecs = 0, npark = 0, dep = 0, itmp;
+  double atime, etime, err;
+  spinor ** solver_field = NULL;
+  spinor ** x, ** r, ** p, ** ap, ** w, * stmp;
+  spinor ** cols[3];
+  double * bnorm;
+  int * act, * idx, * parked;
+  _Complex double * gamma, * delta, * mu, * alpha, * beta, * L, * Linv, * Loldinv;
+  _Complex double * ga, * tmp, * tmp2;
+  const int nr_sf = 4*nrhs;
+
+  if(N == VOLUME) {
+    init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
+  }
+  else {
+    init_solver_field(&solver_field, VOLUMEPLUSRAND/2, nr_sf);
+  }
+  /* column pointers, inactive columns are moved behind the active ones */
+  x = (spinor**)malloc(5*nrhs*sizeof(spinor*));
+  r = x + nrhs;
+  w = r + nrhs;
+  p = w + nrhs;
+  ap = p + nrhs;
+  cols[0] = x; cols[1] = r; cols[2] = w;
+  bnorm = (double*)malloc(nrhs*sizeof(double));
+  act = (int*)malloc(3*nrhs*sizeof(int));
+  idx = act + nrhs;
+  parked = idx + nrhs;
+  gamma = (_Complex double*)malloc(11*ld*ld*sizeof(_Complex double));
+  delta = gamma + ld*ld;
+  mu = delta + ld*ld;
+  alpha = mu + ld*ld;
+  beta = alpha + ld*ld;
+  L = beta + ld*ld;
+  Linv = L + ld*ld;
+  Loldinv = Linv + ld*ld;
+  ga = Loldinv + ld*ld;
+  tmp = ga + ld*ld;
+  tmp2 = tmp + ld*ld;
+
+  atime = gettime();
+  for(int j = 0; j < nrhs; j++) {
+    x[j] = P[j];
+    r[j] = solver_field[j];
+    w[j] = solver_field[nrhs + j];
+    p[j] = solver_field[2*nrhs + j];
+    ap[j] = solver_field[3*nrhs + j];
+    idx[j] = j;
+    parked[j] = 0;
+    bnorm[j] = square_norm(Q[j], N, 1);
+  }
+
+  /* initial residues R = Q - A X and W = A R */
+  m = nrhs;
+  f(w, x, m);
+  for(int j = 0; j < m; j++) {
+    diff(r[j], Q[j], w[j], N);
+  }
+  f(w, r, m);
+  matvecs += 2*m;
+
+  for(iteration = 0; iteration <= max_iter; iteration++) {
+    /* the only global reduction of the iteration */
+    block_gram(gamma, delta, r, w, m, ld, N);
+
+    /* deflate converged right hand sides */
+    ma = 0;
+    for(int j = 0; j < m; j++) {
+      err = creal(gamma[j + j*ld]);
+      if(((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*bnorm[j]) && (rel_prec == 1))) {
+        if(g_proc_id == g_stdio_proc && g_debug_level > 2) {
+          printf("BCG: right hand side %d converged in iteration %d, res^2 %e\n", idx[j], iteration, err);
+          fflush(stdout);
+        }
+      }
+      else {
+        act[ma] = j;
+        ma++;
+      }
+    }
+    if(g_proc_id == g_stdio_proc && g_debug_level > 1) {
+      err = 0.;
+      for(int j = 0; j < m; j++) {
+        if(creal(gamma[j + j*ld]) > err) err = creal(gamma[j + j*ld]);
+      }
+      printf("BCG: iterations: %d active: %d max res^2 %e\n", iteration, ma, err);
+      fflush(stdout);
+    }
+    if(ma == 0 || iteration == max_iter) {
+      break;
+    }
+
+    /* Cholesky factor of gamma_aa, residues that became linearly    */
+    /* dependent on the others are parked for the second pass        */
+    do {
+      for(int j = 0; j < ma; j++) {
+        for(int i = 0; i < ma; i++) {
+          ga[i + j*ld] = gamma[act[i] + act[j]*ld];
+        }
+      }
+      if((dep = small_chol(L, Linv, ga, ma, ld)) != 0) {
+        if(g_proc_id == g_stdio_proc && g_debug_level > 2) {
+          printf("BCG: right hand side %d parked in iteration %d\n", idx[act[dep-1]], iteration);
+          fflush(stdout);
+        }
+        parked[idx[act[dep-1]]] = 1;
+        npark++;
+        for(int j = dep-1; j < ma-1; j++) {
+          act[j] = act[j+1];
+        }
+        ma--;
+      }
+    } while(dep != 0 && ma > 0);
+    if(ma == 0) {
+      break;
+    }
+    for(int j = 0; j < ma; j++) {
+      for(int i = 0; i < ma; i++) {
+        tmp2[i + j*ld] = delta[act[i] + act[j]*ld];
+      }
+      for(int i = 0; i < m; i++) {
+        tmp[i + j*ld] = gamma[i + act[j]*ld];
+      }
+    }
+
+    /* beta = Lold^-1 gamma_.a Linv^dagger, zero in the first iteration */
+    if(iteration > 0) {
+      small_mult(alpha, Loldinv, 0, tmp, 0, m, m, ma, ld);
+      small_mult(beta, alpha, 0, Linv, 1, m, ma, ma, ld);
+    }
+
+    /* compact the active columns of X, R and W, the search directions */
+    /* P and AP keep all m old columns for the update                  */
+    for(int j = 0; j < ma; j++) {
+      if(act[j] != j) {
+        for(int a = 0; a < 3; a++) {
+          stmp = cols[a][j];
+          cols[a][j] = cols[a][act[j]];
+          cols[a][act[j]] = stmp;
+        }
+        err = bnorm[j];
+        bnorm[j] = bnorm[act[j]];
+        bnorm[act[j]] = err;
+        itmp = idx[j];
+        idx[j] = idx[act[j]];
+        idx[act[j]] = itmp;
+      }
+    }
+
+    /* P = R Linv^dagger + P beta, AP = W Linv^dagger + AP beta */
+    for(int j = 0; j < ma; j++) {
+      for(int i = 0; i < ma; i++) {
+        alpha[i + j*ld] = conj(Linv[j + i*ld]);
+      }
+    }
+    block_combine(p, beta, (iteration > 0 ? m : 0), r, alpha, ma, ld, N);
+    block_combine(ap, beta, (iteration > 0 ? m : 0), w, alpha, ma, ld, N);
+
+    /* mu = Linv delta_aa Linv^dagger - beta^dagger mu beta */
+    small_mult(alpha, Linv, 0, tmp2, 0, ma, ma, ma, ld);
+    small_mult(tmp2, alpha, 0, Linv, 1, ma, ma, ma, ld);
+    if(iteration > 0) {
+      small_mult(alpha, mu, 0, beta, 0, m, m, ma, ld);
+      small_mult(tmp, beta, 1, alpha, 0, ma, m, ma, ld);
+      for(int j = 0; j < ma; j++) {
+        for(int i = 0; i < ma; i++) {
+          tmp2[i + j*ld] -= tmp[i + j*ld];
+        }
+      }
+    }
+    memcpy(mu, tmp2, ld*ld*sizeof(_Complex double));
+    m = ma;
+
+    /* alpha = mu^-1 L^dagger */
+    for(int j = 0; j < m; j++) {
+      for(int i = 0; i < m; i++) {
+        tmp[i + j*ld] = conj(L[j + i*ld]);
+      }
+    }
+    if((info = block_solve(alpha, mu, tmp, m, ld)) != 0) break;
+    block_axpy(x, p, alpha, 1., m, ld, N);
+    block_axpy(r, ap, alpha, -1., m, ld, N);
+    f(w, r, m);
+    matvecs += m;
+    memcpy(Loldinv, Linv, ld*ld*sizeof(_Complex double));
+  }
+  etime = gettime();
+
+  if(info != 0 && g_proc_id == g_stdio_proc) {
+    printf("BCG: zgesv returned info = %d in iteration %d\n", info, iteration);
+    fflush(stdout);
+  }
+  if(g_debug_level > 0 && g_proc_id == 0) {
+    printf("# BCG: nrhs: %d iter: %d parked: %d matrix applications: %d eps_sq: %1.4e t/s: %1.4e\n",
+           nrhs, iteration, npark, matvecs, eps_sq, etime-atime);
+    fflush(stdout);
+  }
+
+  free(gamma);
+  free(bnorm);
+  free(x);
+  finalize_solver(solver_field, nr_sf);
+
+  if(info != 0 || ma > 0) {
+    free(act);
+    _PROFILE_END(0., 0.);
+    return(-1);
+  }
+  /* second pass for the parked right hand sides, */
+  /* starting from the solution reached so far     */
+  if(npark > 0) {
+    spinor ** pq = (spinor**)malloc(2*npark*sizeof(spinor*));
+    int k = 0, iter2;
+    for(int j = 0; j < nrhs; j++) {
+      if(parked[j]) {
+        pq[k] = P[j];
+        pq[npark + k] = Q[j];
+        k++;
+      }
+    }
+    free(act);
+    iter2 = bcg_her(pq, pq + npark, npark, max_iter - iteration, eps_sq, rel_prec, N, f);
+    free(pq);
+    _PROFILE_END(0., 0.);
+    if(iter2 < 0) return(-1);
+    return(iteration + iter2);
+  }
+  free(act);
+  _PROFILE_END(0., 0.);
+  return(iteration);
+}
@@ -42,9 +42,11 @@
 #include "solver/matrix_mult_typedef.h"
 #include "solver_field.h"
 #include "bicgstab2.h"
+#include "profile.h"
 
 int bicgstab2(spinor * const x0, spinor * const b, const int max_iter, 
 		double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
 
   const int l = 2;
   double err;
@@ -204,6 +206,7 @@ int bicgstab2(spinor * const x0, spinor * const b, const int max_iter,
   }
   assign_add_mul_r(x, xp, 1., N);
   assign(x0, x, N);
+  _PROFILE_END(0., 0.);
   if(k == max_iter) return(-1);
   return(k);
 }
@@ -42,6 +42,7 @@
 #include "start.h"
 #include "solver_field.h"
 #include "bicgstab_complex.h"
+#include "profile.h"
 
 /* P inout (guess for the solving spinor)
    Q input
@@ -49,6 +50,7 @@
 int bicgstab_complex(spinor * const P,spinor * const Q, const int max_iter, 
 		     double eps_sq, const int rel_prec, 
 		     const int N, matrix_mult f){
+  _PROFILE_BEGIN(__func__);
   double err, squarenorm;
   _Complex double rho0, rho1, omega, alpha, beta, nom, denom;
   int i;
@@ -85,6 +87,7 @@ int bicgstab_complex(spinor * const P,spinor * const Q, const int max_iter,
   
     if((((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*squarenorm) && (rel_prec == 1))) && i>0) {
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(i);
     }
     f(v, p);
@@ -102,6 +105,7 @@ int bicgstab_complex(spinor * const P,spinor * const Q, const int max_iter,
     if(fabs(creal(rho1)) < 1.e-25 && fabs(cimag(rho1)) < 1.e-25)
     {
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(-1);
     }
     nom = alpha * rho1;
@@ -112,5 +116,6 @@ int bicgstab_complex(spinor * const P,spinor * const Q, const int max_iter,
     rho0 = rho1;
   }
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return -1;
 }
@@ -42,11 +42,13 @@
 #include "start.h"
 #include "solver_field.h"
 #include "bicgstab_complex_bi.h"
+#include "profile.h"
 
 /* P inout (guess for the solving bispinor)
    Q input
 */
 int bicgstab_complex_bi(bispinor * const P, bispinor * const Q, const int max_iter, double eps_sq, const int rel_prec, const int N, matrix_mult_bi f){
+  _PROFILE_BEGIN(__func__);
 
   double err, squarenorm;
   _Complex double rho0, rho1, omega, alpha, beta, nom, denom;
@@ -85,6 +87,7 @@ int bicgstab_complex_bi(bispinor * const P, bispinor * const Q, const int max_it
   
     if((((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*squarenorm) && (rel_prec == 1))) && i>0) {
       finalize_bisolver(bisolver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(i);
     }
     f(v, p);
@@ -107,5 +110,6 @@ int bicgstab_complex_bi(bispinor * const P, bispinor * const Q, const int max_it
     rho0 = rho1;
   }
   finalize_bisolver(bisolver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return -1;
 }
@@ -41,9 +41,11 @@
 #include "solver/matrix_mult_typedef.h"
 #include "solver_field.h"
 #include "bicgstabell.h"
+#include "profile.h"
 
 int bicgstabell(spinor * const x0, spinor * const b, const int max_iter, 
 		double eps_sq, const int rel_prec, const int _l, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
 
   double err;
   int i, j, k, l;
@@ -152,6 +154,7 @@ int bicgstabell(spinor * const x0, spinor * const b, const int max_iter,
     }
   }
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   if(k == max_iter) return(-1);
   return(k);
 }
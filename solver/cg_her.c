@@ -58,16 +58,17 @@
 #include "poly_precon.h"
 #include "solver_field.h"
 #include "cg_her.h"
+#include "profile.h"
 
 int cg_her(spinor * const P, spinor * const Q, const int max_iter, 
            double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
 
   static double normsq,pro,err,alpha_cg,beta_cg,squarenorm;
   int iteration;
   int save_sloppy = g_sloppy_precision;
   double atime, etime, flops;
   spinor ** solver_field = NULL;
-  spinor * stmp;
   const int nr_sf = 3;
 
   if(N == VOLUME) {
@@ -91,14 +92,8 @@ int cg_her(spinor * const P, spinor * const Q, const int max_iter,
     f(solver_field[0], solver_field[2]);
     pro = scalar_prod_r(solver_field[2], solver_field[0], N, 1);
     alpha_cg = normsq / pro;
-    assign_add_mul_r(P, solver_field[2], alpha_cg, N);
-
-#if (defined SSE2 || defined SSE3)
-    assign_mul_add_r(solver_field[0], -alpha_cg, solver_field[1], N);
-    err = square_norm(solver_field[0], N, 1);
-#else
-    err = assign_mul_add_r_and_square(solver_field[0], -alpha_cg, solver_field[1], N, 1);
-#endif
+    /* x and r in one sweep */
+    err = update_x_and_r_and_square(P, solver_field[1], solver_field[2], solver_field[0], alpha_cg, N, 1);
 
     if(g_proc_id == g_stdio_proc && g_debug_level > 1) {
       printf("CG: iterations: %d res^2 %e\n", iteration, err);
@@ -118,10 +113,7 @@ int cg_her(spinor * const P, spinor * const Q, const int max_iter,
 #endif
 
     beta_cg = err / normsq;
-    assign_mul_add_r(solver_field[2], beta_cg, solver_field[0], N);
-    stmp = solver_field[0];
-    solver_field[0] = solver_field[1];
-    solver_field[1] = stmp;
+    assign_mul_add_r(solver_field[2], beta_cg, solver_field[1], N);
     normsq = err;
   }
   etime = gettime();
@@ -135,6 +127,7 @@ int cg_her(spinor * const P, spinor * const Q, const int max_iter,
            etime-atime, flops/(etime-atime), g_nproc*flops/(etime-atime));
   }
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   if(iteration > max_iter) return(-1);
   return(iteration);
 }
@@ -60,11 +60,13 @@
 #include "cg_her_bi.h"
 #include "solver_field.h"
 #include"solver/matrix_mult_typedef_bi.h"
+#include "profile.h"
 
 
 /* P output = solution , Q input = source */
 int cg_her_bi(bispinor * const P, bispinor * const Q, const int max_iter, 
        double eps_sq, const int rel_prec, const int N, matrix_mult_bi f) {
+  _PROFILE_BEGIN(__func__);
   
   double normsp, normsq, pro, err, alpha_cg, beta_cg, squarenorm;
   int iteration;
@@ -123,6 +125,7 @@ int cg_her_bi(bispinor * const P, bispinor * const Q, const int max_iter,
     if(((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*squarenorm) && (rel_prec == 1))) {
       assign_bi(P, bisolver_field[0], N);
       finalize_bisolver(bisolver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(iteration+1);
     }
      
@@ -135,6 +138,7 @@ int cg_her_bi(bispinor * const P, bispinor * const Q, const int max_iter,
   
   assign_bi(P, bisolver_field[0], N);  
   finalize_bisolver(bisolver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
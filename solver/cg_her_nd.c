@@ -52,11 +52,13 @@
 #include "sub_low_ev.h"
 #include "solver_field.h"
 #include "cg_her.h"
+#include "profile.h"
 
 /* P output = solution , Q input = source */
 int cg_her_nd(spinor * const P_up,spinor * P_dn, spinor * const Q_up, spinor * const Q_dn, 
 	      const int max_iter, double eps_sq, const int rel_prec, 
 	      const int N, matrix_mult_nd f) {
+  _PROFILE_BEGIN(__func__);
   double normsp, normsq, pro, err, alpha_cg, beta_cg, squarenorm;
   int iteration;
   double err1, err2;
@@ -135,6 +137,7 @@ int cg_her_nd(spinor * const P_up,spinor * P_dn, spinor * const Q_up, spinor * c
       g_sloppy_precision = 0;
       finalize_solver(up_field, nr_sf);
       finalize_solver(dn_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(iteration+1);
     }
 #ifdef _USE_HALFSPINOR
@@ -159,6 +162,7 @@ int cg_her_nd(spinor * const P_up,spinor * P_dn, spinor * const Q_up, spinor * c
   
   finalize_solver(up_field, nr_sf);
   finalize_solver(dn_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
@@ -29,16 +29,26 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#ifdef OMP
+# include <omp.h>
+#endif
 #include "global.h"
 #include "su3.h"
 #include <io/spinor.h>
 #include "gamma.h"
 #include "linalg_eo.h"
+#ifdef _REPRODUCIBLE_REDUCTIONS
+# include "linalg/repro_sum.h"
+#endif
 #include "start.h"
 #include "solver/matrix_mult_typedef.h"
 #include "cg_mms_tm.h"
 #include "solver_field.h"
 #include <io/params.h>
+#include "profile.h"
 
 static spinor * xs_qmms;
 static spinor * ps_qmms;
@@ -47,28 +57,293 @@ static spinor ** ps_mms_solver;
 static double * sigma;
 static double * zitam1, * zita;
 static double * alphas, * betas;
+static int * active;
 
 extern int index_start;
 
 void init_mms_tm(const int nr);
+static void init_mms_xs(const int nr);
+
+/* with MPI-3 the global sums are started before and completed
+ * after the next application of the operator. The reproducible
+ * sums are global already when they are returned */
+#if (defined MPI && !defined _REPRODUCIBLE_REDUCTIONS)
+#  define _MMS_LOCAL_SUMS
+#  if (defined MPI_VERSION && MPI_VERSION >= 3)
+#    define _MMS_IALLREDUCE
+#  endif
+#endif
+
+/*
+ * The whole vector update of one iteration in a single sweep:
+ *
+ *   ps = zita(i) r + betas ps,  xs += alphas ps   for the nas active shifts
+ *   z = q + beta z, s = w + beta s, p = r + beta p
+ *   x += alpha p,   r -= alpha s,   w -= alpha z
+ *
+ * and the local parts of (r,r) and (w,r) with the new r and w
+ * (the global ones with _REPRODUCIBLE_REDUCTIONS).
+ * zita(i) is in zitam1 at this point
+ */
+static void update_mms_fields(double * const res, spinor ** const sf,
+                              spinor ** const xsf, spinor ** const psf,
+                              const double alpha, const double beta,
+                              const int nas, const int N) {
+  double * const x = (double*)sf[0];
+  double * const r = (double*)sf[1];
+  double * const p = (double*)sf[2];
+  double * const s = (double*)sf[3];
+  double * const w = (double*)sf[4];
+  double * const q = (double*)sf[5];
+  double * const z = (double*)sf[6];
+#ifdef _REPRODUCIBLE_REDUCTIONS
+  repro_sum acc[2];
+
+  repro_sum_zero(acc, 2);
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  repro_sum lacc[2];
+  repro_sum_zero(lacc, 2);
+#ifdef OMP
+#pragma omp for
+#endif
+#else
+  double rr = 0., wr = 0.;
+
+#ifdef OMP
+#pragma omp parallel for reduction(+:rr,wr)
+#endif
+#endif
+  for(int ix = 0; ix < N; ix++) {
+    const int i0 = 24*ix;
+#ifdef _REPRODUCIBLE_REDUCTIONS
+    double rr = 0., wr = 0.;
+#endif
+    for(int j = 0; j < nas; j++) {
+      const int im = active[j];
+      double * const xs = (double*)xsf[im] + i0;
+      double * const ps = (double*)psf[im] + i0;
+      for(int k = 0; k < 24; k++) {
+        ps[k] = zitam1[im]*r[i0+k] + betas[im]*ps[k];
+        xs[k] += alphas[im]*ps[k];
+      }
+    }
+    for(int k = i0; k < i0+24; k++) {
+      z[k] = q[k] + beta*z[k];
+      s[k] = w[k] + beta*s[k];
+      p[k] = r[k] + beta*p[k];
+      x[k] += alpha*p[k];
+      r[k] -= alpha*s[k];
+      w[k] -= alpha*z[k];
+      rr += r[k]*r[k];
+      wr += w[k]*r[k];
+    }
+#ifdef _REPRODUCIBLE_REDUCTIONS
+    repro_sum_add(&lacc[0], rr);
+    repro_sum_add(&lacc[1], wr);
+#endif
+  }
+#ifdef _REPRODUCIBLE_REDUCTIONS
+  repro_sum_merge(acc, lacc, 2);
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  repro_sum_finalize(res, acc, 2, 1);
+#else
+  res[0] = rr;
+  res[1] = wr;
+#endif
+}
+
+/* out = f(in) for a single flavour or the doublet */
+static void mms_apply(spinor ** const out, spinor ** const in, const int nf,
+                      matrix_mult f, matrix_mult_nd f_nd) {
+  if(nf == 1) {
+    f(out[0], in[0]);
+  }
+  else {
+    f_nd(out[0], out[1], in[0], in[1]);
+  }
+}
+
+/*
+ * pipelined multi-shift CG: there is only one global reduction per iteration,
+ * (r,r) and (w,r) with w = f(r), and it is overlapped with the application
+ * of f in q = f(w). All shifted solutions are updated in the same sweep as
+ * the base fields and converged shifts are removed from the sweep.
+ *
+ * It works on nf = 1 flavour with f or on the nf = 2 flavours of a doublet
+ * with f_nd, the flavours only enter the scalar products and f. The solution
+ * of (f + sigma[im]) x = Q for flavour fl ends up in xsf[fl][im], the one of
+ * f x = Q in sf[fl][0]. With need_base = 0 the iteration stops as soon as all
+ * shifts are converged, the shifts must be positive then. Returns the number
+ * of iterations, max_iter if not converged.
+ */
+static int mms_iterate(spinor * xsf[2][MAX_EXTRA_MASSES], spinor * sf[2][7],
+                       spinor * const Q[2], const int nf, const int max_iter,
+                       const double eps, const int N, matrix_mult f, matrix_mult_nd f_nd,
+                       const int no_shifts, const int need_base) {
+  double normsq = 0., err, alpha_cg = 1., beta_cg = 0., gamma, alpham1;
+  double ALIGN res[2], tmp[2];
+  spinor * psf[2][MAX_EXTRA_MASSES];
+  int iteration, im, j, fl, nas, converged = 0;
+#ifdef _MMS_LOCAL_SUMS
+  double ALIGN mres[2];
+#endif
+#ifdef _MMS_IALLREDUCE
+  MPI_Request request;
+#endif
+
+  for(im = 0; im < no_shifts; im++) {
+    for(fl = 0; fl < nf; fl++) {
+      psf[fl][im] = ps_mms_solver[im] + fl*(VOLUMEPLUSRAND/2);
+      zero_spinor_field(xsf[fl][im], N);
+      assign(psf[fl][im], Q[fl], N);
+    }
+    zitam1[im] = 1.0;
+    zita[im] = 1.0;
+    alphas[im] = 1.0;
+    betas[im] = 0.0;
+    active[im] = im;
+  }
+  nas = no_shifts;
+
+  /* x = 0, r = Q, w = f(r) and the auxiliary fields set to zero */
+  res[0] = 0.;
+  res[1] = 0.;
+  for(fl = 0; fl < nf; fl++) {
+    zero_spinor_field(sf[fl][0], N);
+    assign(sf[fl][1], Q[fl], N);
+    for(j = 2; j < 7; j++) {
+      if(j != 4) zero_spinor_field(sf[fl][j], N);
+    }
+  }
+  {
+    spinor * w[2] = {sf[0][4], (nf == 2) ? sf[1][4] : NULL};
+    spinor * r[2] = {sf[0][1], (nf == 2) ? sf[1][1] : NULL};
+    mms_apply(w, r, nf, f, f_nd);
+  }
+  for(fl = 0; fl < nf; fl++) {
+#ifdef _MMS_LOCAL_SUMS
+    square_and_prod_r(&tmp[0], &tmp[1], sf[fl][1], sf[fl][4], N, 0);
+#else
+    square_and_prod_r(&tmp[0], &tmp[1], sf[fl][1], sf[fl][4], N, 1);
+#endif
+    res[0] += tmp[0];
+    res[1] += tmp[1];
+  }
 
+  /* main loop */
+  for(iteration = 0; iteration < max_iter; iteration++) {
+
+    /* start the global sum of (r,r) and (w,r) and compute q = f(w) meanwhile */
+#ifdef _MMS_IALLREDUCE
+    MPI_Iallreduce(res, mres, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &request);
+#elif defined _MMS_LOCAL_SUMS
+    MPI_Allreduce(res, mres, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+    {
+      spinor * q[2] = {sf[0][5], (nf == 2) ? sf[1][5] : NULL};
+      spinor * w[2] = {sf[0][4], (nf == 2) ? sf[1][4] : NULL};
+      mms_apply(q, w, nf, f, f_nd);
+    }
+#ifdef _MMS_IALLREDUCE
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+#ifdef _MMS_LOCAL_SUMS
+    res[0] = mres[0];
+    res[1] = mres[1];
+#endif
+    err = res[0];
+
+    if(g_debug_level > 2 && g_proc_id == g_stdio_proc) {
+      printf("CGMMS iteration: %d residue: %g active shifts: %d\n", iteration, err, nas); fflush( stdout );
+    }
+
+    /* the residue of a shifted system is zita r, remove converged shifts */
+    for(j = 0; j < nas; j++) {
+      im = active[j];
+      if(zita[im]*zita[im]*err <= eps) {
+        active[j] = active[nas-1];
+        active[nas-1] = im;
+        nas--;
+        j--;
+        if(g_debug_level > 1 && g_proc_id == g_stdio_proc) {
+          printf("# CG MMS shift %d converged in iteration %d\n", im+1, iteration); fflush( stdout );
+        }
+      }
+    }
+    if(err <= eps || !need_base) {
+      converged = 1;
+    }
+    if(converged && nas == 0) {
+      break;
+    }
+
+    /* For the update of the coeff. of the shifted pol. we need alpha_cg(i-1) and alpha_cg(i).
+       This is the reason why we need this double definition of alpha */
+    alpham1 = alpha_cg;
+    /* beta_cg(i) = (r(i),r(i))/(r(i-1),r(i-1)) and 
+       alpha_cg(i) = (r(i),r(i))/((w(i),r(i)) - beta_cg(i) (r(i),r(i))/alpha_cg(i-1)) */
+    if(iteration > 0) {
+      beta_cg = err/normsq;
+      alpha_cg = err/(res[1] - beta_cg*err/alpham1);
+    }
+    else {
+      beta_cg = 0.;
+      alpha_cg = err/res[1];
+    }
+    normsq = err;
+
+    for(j = 0; j < nas; j++) {
+      im = active[j];
+      /* betas(i) = beta_cg(i)*(zita(i)/zita(i-1))^2 */
+      betas[im] = beta_cg*zita[im]*zita[im]/(zitam1[im]*zitam1[im]);
+      /* Now gamma is a temp variable that corresponds to zita(i+1) */ 
+      gamma = zita[im]*alpham1/(alpha_cg*beta_cg*(1.-zita[im]/zitam1[im]) 
+				+ alpham1*(1.+sigma[im]*alpha_cg));
+      /* Now zita(i-1) is put equal to the old zita(i) */
+      zitam1[im] = zita[im];
+      /* Now zita(i+1) is updated */
+      zita[im] = gamma;
+      /* Update of alphas(i) = alpha_cg(i)*zita(i+1)/zita(i) */ 
+      alphas[im] = alpha_cg*zita[im]/zitam1[im];
+    }
+
+    /* all vector updates in one sweep per flavour */
+    res[0] = 0.;
+    res[1] = 0.;
+    for(fl = 0; fl < nf; fl++) {
+      update_mms_fields(tmp, sf[fl], xsf[fl], psf[fl], alpha_cg, beta_cg, nas, N);
+      res[0] += tmp[0];
+      res[1] += tmp[1];
+    }
+  }
+  return(iteration);
+}
 
-/* P output = solution , Q input = source */
+/* P output = solution , Q input = source 
+ *
+ * the solutions for all extra masses are written to disk
+ */
 int cg_mms_tm(spinor * const P, spinor * const Q, const int max_iter, 
 	      double eps_sq, const int rel_prec, const int N, matrix_mult f,
         const int no_extra_masses, double * const extra_masses, const int id) {
+  _PROFILE_BEGIN(__func__);
 
-  static double normsq, pro, err, alpha_cg = 1., beta_cg = 0., squarenorm;
+  double err, squarenorm, eps;
   int iteration, im, append = 0;
   char filename[300];
-  static double gamma, alpham1;
   double tmp_mu = g_mu;
   WRITER * writer = NULL;
   paramsInverterInfo *inverterInfo = NULL;
   paramsPropagatorFormat *propagatorFormat = NULL;
   spinor * temp_save; //used to save all the masses
   spinor ** solver_field = NULL;
-  const int nr_sf = 5;
+  spinor * xsf[2][MAX_EXTRA_MASSES], * sf[2][7], * Qf[2] = {Q, NULL};
+  const int nr_sf = 7;
 
   init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
 
@@ -76,168 +351,181 @@ int cg_mms_tm(spinor * const P, spinor * const Q, const int max_iter,
    * because we have no way to figure out what is the actual maximum number
    * of extra masses configured in the set of operators with extra masses */
   init_mms_tm(MAX_EXTRA_MASSES);
+  init_mms_xs(MAX_EXTRA_MASSES);
 
-  /* currently only implemented for P=0 */
-  zero_spinor_field(P, N);
   /*  Value of the bare MMS-masses (\mu^2 - \mu_0^2) */
   for(im = 0; im < no_extra_masses; im++) {
     sigma[im] = extra_masses[im]*extra_masses[im] - g_mu*g_mu;
-    assign(xs_mms_solver[im], P, N);
-    assign(ps_mms_solver[im], Q, N);
-    zitam1[im] = 1.0;
-    zita[im] = 1.0;
-    alphas[im] = 1.0;
-    betas[im] = 0.0;
+    xsf[0][im] = xs_mms_solver[im];
+  }
+  for(int j = 0; j < nr_sf; j++) {
+    sf[0][j] = solver_field[j];
   }
 
   squarenorm = square_norm(Q, N, 1);
-  assign(solver_field[0], P, N);
-/*   normsp = square_norm(P, N, 1); */
-
-  /* initialize residue r and search vector p */
-/*   if(normsp == 0){ */
-  /* currently only implemented for P=0 */
-  if(1) {
-    /* if a starting solution vector equal to zero is chosen */
-    assign(solver_field[1], Q, N);
-    assign(solver_field[2], Q, N);
-    normsq = square_norm(Q, N, 1);
-  }
-  else{
-    /* if a starting solution vector different from zero is chosen */
-    f(solver_field[3], solver_field[0]);
+  eps = (rel_prec == 1) ? eps_sq*squarenorm : eps_sq;
 
-    diff(solver_field[1], Q, solver_field[3], N);
-    assign(solver_field[2], solver_field[1], N);
-    normsq = square_norm(solver_field[2], N, 1);
-  }
+  iteration = mms_iterate(xsf, sf, Qf, 1, max_iter, eps, N, f, NULL, no_extra_masses, 1);
 
-  /* main loop */
-  for(iteration = 0; iteration < max_iter; iteration++) {
+  assign(P, solver_field[0], N);
+  if(iteration == max_iter) {
+    g_sloppy_precision = 0;
+    finalize_solver(solver_field, nr_sf);
+    _PROFILE_END(0., 0.);
+    return(-1);
+  }
 
-    /*   Q^2*p and then (p,Q^2*p)  */
-    f(solver_field[4], solver_field[2]);
-    pro = scalar_prod_r(solver_field[2], solver_field[4], N, 1);
+  f(solver_field[2], P);
+  diff(solver_field[3], solver_field[2], Q, N);
+  err = square_norm(solver_field[3], N, 1);
+  if(g_debug_level > 0 && g_proc_id == g_stdio_proc) {
+    printf("# CG MMS true residue at final iteration (%d) was %g.\n", iteration, err); 
+    fflush( stdout);
+  }
+  g_sloppy_precision = 0;
+  g_mu = tmp_mu;
+
+  /* save all the results of (Q^dagger Q)^(-1) \gamma_5 \phi */
+  /* here ... */
+  /* when im == -1 save the base mass*/
+  for(im = -1; im < no_extra_masses; im++) {
+    if(im==-1) {
+      temp_save=solver_field[0];
+    } else {
+      temp_save=xs_mms_solver[im];
+    }
 
-    /* For the update of the coeff. of the shifted pol. we need alpha_cg(i-1) and alpha_cg(i).
-       This is the reason why we need this double definition of alpha */
-    alpham1 = alpha_cg;
+    if(SourceInfo.type != 1) {
+      if (PropInfo.splitted) {
+        sprintf(filename, "%s.%.2d.%.4d.%.2d.%.2d.%.2d.cgmms.%.2d.inverted", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.t, SourceInfo.ix, im+1);
+      } else {
+        sprintf(filename, "%s.%.2d.%.4d.%.2d.%.2d.cgmms.%.2d.inverted", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.t, im+1);
+      }
+    }
+    else {
+      sprintf(filename, "%s.%.2d.%.4d.%.5d.cgmms.%.2d.0", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.sample, im+1);
+    }
+    if(g_kappa != 0) {
+      mul_r(temp_save, (2*g_kappa)*(2*g_kappa), temp_save, N);
+    }
 
-    /* Compute alpha_cg(i+1) */
-    alpha_cg = normsq/pro;
-    for(im = 0; im < no_extra_masses; im++) {
+    append = !PropInfo.splitted;
 
-      /* Now gamma is a temp variable that corresponds to zita(i+1) */ 
-      gamma = zita[im]*alpham1/(alpha_cg*beta_cg*(1.-zita[im]/zitam1[im]) 
-				+ alpham1*(1.+sigma[im]*alpha_cg));
+    construct_writer(&writer, filename, append);
 
-      /* Now zita(i-1) is put equal to the old zita(i) */
-      zitam1[im] = zita[im];
-      /* Now zita(i+1) is updated */
-      zita[im] = gamma;
-      /* Update of alphas(i) = alpha_cg(i)*zita(i+1)/zita(i) */ 
-      alphas[im] = alpha_cg*zita[im]/zitam1[im];
-      /* Compute xs(i+1) = xs(i) + alphas(i)*ps(i) */
-      assign_add_mul_r(xs_mms_solver[im], ps_mms_solver[im], alphas[im], N); 
+    if (PropInfo.splitted || SourceInfo.ix == index_start) {
+      //Create the inverter info NOTE: always set to TWILSON=12 and 1 flavour (to be adjusted)
+      inverterInfo = construct_paramsInverterInfo(err, iteration, 12, 1);
+      if (im == -1) {
+        inverterInfo->cgmms_mass = inverterInfo->mu;
+      } else {
+        inverterInfo->cgmms_mass = extra_masses[im]/(2 * inverterInfo->kappa);
+      }
+      write_spinor_info(writer, PropInfo.format, inverterInfo, append);
+      //Create the propagatorFormat NOTE: always set to 1 flavour (to be adjusted)
+      propagatorFormat = construct_paramsPropagatorFormat(PropInfo.precision, 1);
+      write_propagator_format(writer, propagatorFormat);
+      free(inverterInfo);
+      free(propagatorFormat);
     }
+    convert_lexic_to_eo(solver_field[2], solver_field[1], temp_save);
+    write_spinor(writer, &solver_field[2], &solver_field[1], 1, PropInfo.precision);
+    destruct_writer(writer);
+  }
+  finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
+  return(iteration);
+}
 
-    /*  Compute x_(i+1) = x_i + alpha_cg(i+1) p_i    */
-    assign_add_mul_r(solver_field[0], solver_field[2],  alpha_cg, N);
-    /*  Compute r_(i+1) = r_i - alpha_cg(i+1) Qp_i   */
-    assign_add_mul_r(solver_field[1], solver_field[4], -alpha_cg, N);
 
-    /* Check whether the precision eps_sq is reached */
+int cg_mms_tm_shifts(spinor ** const P, spinor * const Q, const int max_iter,
+                     double eps_sq, const int rel_prec, const int N, matrix_mult f,
+                     const int no_shifts, const double * const shifts) {
+  _PROFILE_BEGIN(__func__);
+  int iteration;
+  double eps;
+  spinor ** solver_field = NULL;
+  spinor * xsf[2][MAX_EXTRA_MASSES], * sf[2][7], * Qf[2] = {Q, NULL};
+  const int nr_sf = 7;
 
-    err = square_norm(solver_field[1], N, 1);
-    if(g_debug_level > 2 && g_proc_id == g_stdio_proc) {
-      printf("CGMMS iteration: %d residue: %g\n", iteration, err); fflush( stdout );
+  if(no_shifts > MAX_EXTRA_MASSES) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "cg_mms_tm_shifts: at most %d shifts are supported\n", MAX_EXTRA_MASSES);
     }
+    _PROFILE_END(0., 0.);
+    return(-1);
+  }
+  init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
+  init_mms_tm(MAX_EXTRA_MASSES);
 
-    if( ((err <= eps_sq) && (rel_prec == 0)) ||
-      ((err <= eps_sq*squarenorm) && (rel_prec == 1)) ) {
+  for(int im = 0; im < no_shifts; im++) {
+    sigma[im] = shifts[im];
+    xsf[0][im] = P[im];
+  }
+  for(int j = 0; j < nr_sf; j++) {
+    sf[0][j] = solver_field[j];
+  }
+  eps = (rel_prec == 1) ? eps_sq*square_norm(Q, N, 1) : eps_sq;
 
-      assign(P, solver_field[0], N);
-      f(solver_field[2], P);
-      diff(solver_field[3], solver_field[2], Q, N);
-      err = square_norm(solver_field[3], N, 1);
-      if(g_debug_level > 0 && g_proc_id == g_stdio_proc) {
-        printf("# CG MMS true residue at final iteration (%d) was %g.\n", iteration, err); 
-        fflush( stdout);
-      }
-      g_sloppy_precision = 0;
-      g_mu = tmp_mu;
-
-      /* save all the results of (Q^dagger Q)^(-1) \gamma_5 \phi */
-      /* here ... */
-      /* when im == -1 save the base mass*/
-      for(im = -1; im < no_extra_masses; im++) {
-        if(im==-1) {
-          temp_save=solver_field[0];
-        } else {
-          temp_save=xs_mms_solver[im];
-        }
+  iteration = mms_iterate(xsf, sf, Qf, 1, max_iter, eps, N, f, NULL, no_shifts, 0);
 
-        if(SourceInfo.type != 1) {
-          if (PropInfo.splitted) {
-            sprintf(filename, "%s.%.2d.%.4d.%.2d.%.2d.%.2d.cgmms.%.2d.inverted", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.t, SourceInfo.ix, im+1);
-          } else {
-            sprintf(filename, "%s.%.2d.%.4d.%.2d.%.2d.cgmms.%.2d.inverted", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.t, im+1);
-          }
-        }
-        else {
-          sprintf(filename, "%s.%.2d.%.4d.%.5d.cgmms.%.2d.0", SourceInfo.basename, id, SourceInfo.nstore, SourceInfo.sample, im+1);
-        }
-        if(g_kappa != 0) {
-          mul_r(temp_save, (2*g_kappa)*(2*g_kappa), temp_save, N);
-        }
+  if(g_debug_level > 0 && g_proc_id == g_stdio_proc) {
+    printf("# CG MMS: %d shifts converged in %d iterations\n", no_shifts, iteration);
+    fflush(stdout);
+  }
+  g_sloppy_precision = 0;
+  finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
+  return((iteration == max_iter) ? -1 : iteration);
+}
 
-        append = !PropInfo.splitted;
-
-        construct_writer(&writer, filename, append);
-
-        if (PropInfo.splitted || SourceInfo.ix == index_start) {
-          //Create the inverter info NOTE: always set to TWILSON=12 and 1 flavour (to be adjusted)
-          inverterInfo = construct_paramsInverterInfo(err, iteration+1, 12, 1);
-          if (im == -1) {
-            inverterInfo->cgmms_mass = inverterInfo->mu;
-          } else {
-            inverterInfo->cgmms_mass = extra_masses[im]/(2 * inverterInfo->kappa);
-          }
-          write_spinor_info(writer, PropInfo.format, inverterInfo, append);
-          //Create the propagatorFormat NOTE: always set to 1 flavour (to be adjusted)
-          propagatorFormat = construct_paramsPropagatorFormat(PropInfo.precision, 1);
-          write_propagator_format(writer, propagatorFormat);
-          free(inverterInfo);
-          free(propagatorFormat);
-        }
-        convert_lexic_to_eo(solver_field[2], solver_field[1], temp_save);
-        write_spinor(writer, &solver_field[2], &solver_field[1], 1, PropInfo.precision);
-        destruct_writer(writer);
-      }
-      finalize_solver(solver_field, nr_sf);
-      return(iteration+1);
+int cg_mms_tm_nd(spinor ** const Pup, spinor ** const Pdn,
+                 spinor * const Qup, spinor * const Qdn, const int max_iter,
+                 double eps_sq, const int rel_prec, matrix_mult_nd f,
+                 const int no_shifts, const double * const shifts) {
+  _PROFILE_BEGIN(__func__);
+  const int N = VOLUME/2;
+  int iteration;
+  double eps;
+  spinor ** solver_field = NULL;
+  spinor * xsf[2][MAX_EXTRA_MASSES], * sf[2][7], * Qf[2] = {Qup, Qdn};
+  const int nr_sf = 7;
+
+  if(no_shifts > MAX_EXTRA_MASSES) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "cg_mms_tm_nd: at most %d shifts are supported\n", MAX_EXTRA_MASSES);
     }
+    _PROFILE_END(0., 0.);
+    return(-1);
+  }
+  /* the two flavours are the two halves of full size fields */
+  init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
+  init_mms_tm(MAX_EXTRA_MASSES);
 
-    /* Compute beta_cg(i+1) = (r(i+1),r(i+1))/(r(i),r(i))
-       Compute p(i+1) = r(i+1) + beta(i+1)*p(i)  */
-    beta_cg = err/normsq;
-    assign_mul_add_r(solver_field[2], beta_cg, solver_field[1], N);
-    normsq = err;
+  for(int im = 0; im < no_shifts; im++) {
+    sigma[im] = shifts[im];
+    xsf[0][im] = Pup[im];
+    xsf[1][im] = Pdn[im];
+  }
+  for(int j = 0; j < nr_sf; j++) {
+    sf[0][j] = solver_field[j];
+    sf[1][j] = solver_field[j] + VOLUMEPLUSRAND/2;
+  }
+  eps = square_norm(Qup, N, 1) + square_norm(Qdn, N, 1);
+  eps = (rel_prec == 1) ? eps_sq*eps : eps_sq;
 
-    /* Compute betas(i+1) = beta_cg(i)*(zita(i+1)*alphas(i))/(zita(i)*alpha_cg(i))
-       Compute ps(i+1) = zita(i+1)*r(i+1) + betas(i+1)*ps(i)  */
-    for(im = 0; im < no_extra_masses; im++) {
-      betas[im] = beta_cg*zita[im]*alphas[im]/(zitam1[im]*alpha_cg);
-      assign_mul_add_mul_r(ps_mms_solver[im], solver_field[1], betas[im], zita[im], N);
-    }
+  iteration = mms_iterate(xsf, sf, Qf, 2, max_iter, eps, N, NULL, f, no_shifts, 0);
+
+  if(g_debug_level > 0 && g_proc_id == g_stdio_proc) {
+    printf("# CG MMS ND: %d shifts converged in %d iterations\n", no_shifts, iteration);
+    fflush(stdout);
   }
-  assign(P, solver_field[0], N);
   g_sloppy_precision = 0;
   finalize_solver(solver_field, nr_sf);
-  return(-1);
+  _PROFILE_END(0., 0.);
+  return((iteration == max_iter) ? -1 : iteration);
 }
 
-
 void init_mms_tm(const int nr) {
   static int ini = 0;
   int i;
@@ -248,30 +536,48 @@ void init_mms_tm(const int nr) {
     zita = (double*)calloc((nr), sizeof(double));
     alphas = (double*)calloc((nr), sizeof(double));
     betas = (double*)calloc((nr), sizeof(double));
+    active = (int*)calloc((nr), sizeof(int));
 
 #if (defined SSE2 || defined SSE)
-    xs_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr)+1,sizeof(spinor));
-    xs_mms_solver = (spinor**)calloc((nr)+1,sizeof(spinor*));
-    
     ps_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr)+1,sizeof(spinor));
     ps_mms_solver = (spinor**)calloc((nr)+1,sizeof(spinor*));
 
     for(i = 0; i < nr; i++) {
-      xs_mms_solver[i]=(spinor*)(((unsigned long int)(xs_qmms)+ALIGN_BASE)&~ALIGN_BASE) + i*VOLUMEPLUSRAND;
       ps_mms_solver[i]=(spinor*)(((unsigned long int)(ps_qmms)+ALIGN_BASE)&~ALIGN_BASE) + i*VOLUMEPLUSRAND;
     }
 #else
-    xs_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr),sizeof(spinor));
-    xs_mms_solver = (spinor**)calloc((nr),sizeof(spinor*));
-
     ps_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr),sizeof(spinor));
     ps_mms_solver = (spinor**)calloc((nr),sizeof(spinor*));
 
     for(i = 0; i < nr; i++) {
-      xs_mms_solver[i] = xs_qmms + i*VOLUMEPLUSRAND;
       ps_mms_solver[i] = ps_qmms + i*VOLUMEPLUSRAND;
     }
 #endif
     ini=1;
   }
 }
+
+/* the shifted solutions of cg_mms_tm, the other versions */
+/* write them directly to the fields given by the caller  */
+static void init_mms_xs(const int nr) {
+  static int ini = 0;
+  int i;
+  if(ini == 0) {
+#if (defined SSE2 || defined SSE)
+    xs_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr)+1,sizeof(spinor));
+    xs_mms_solver = (spinor**)calloc((nr)+1,sizeof(spinor*));
+
+    for(i = 0; i < nr; i++) {
+      xs_mms_solver[i]=(spinor*)(((unsigned long int)(xs_qmms)+ALIGN_BASE)&~ALIGN_BASE) + i*VOLUMEPLUSRAND;
+    }
+#else
+    xs_qmms = (spinor*)calloc(VOLUMEPLUSRAND*(nr),sizeof(spinor));
+    xs_mms_solver = (spinor**)calloc((nr),sizeof(spinor*));
+
+    for(i = 0; i < nr; i++) {
+      xs_mms_solver[i] = xs_qmms + i*VOLUMEPLUSRAND;
+    }
+#endif
+    ini=1;
+  }
+}
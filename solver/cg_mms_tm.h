@@ -25,6 +25,7 @@
 #define _CG_MMS_TM_H
 
 #include"matrix_mult_typedef.h"
+#include"matrix_mult_typedef_nd.h"
 #include"su3.h"
 
 int cg_mms_tm(spinor * const P,spinor * const Q, const int max_iter, 
@@ -32,4 +33,18 @@ int cg_mms_tm(spinor * const P,spinor * const Q, const int max_iter,
         const int no_extra_masses, double * const extra_masses, 
         const int id );
 
+/* solves (f + shifts[i]) P[i] = Q for i = 0,...,no_shifts-1 with */
+/* a single multi-shift CG, the shifts must be positive. Nothing  */
+/* is written to disk, returns the number of iterations or -1     */
+int cg_mms_tm_shifts(spinor ** const P, spinor * const Q, const int max_iter,
+                     double eps_sq, const int rel_prec, const int N, matrix_mult f,
+                     const int no_shifts, const double * const shifts);
+
+/* the same for the flavour doublet (Qup, Qdn) and the non-degenerate */
+/* operator f on even/odd fields                                       */
+int cg_mms_tm_nd(spinor ** const Pup, spinor ** const Pdn,
+                 spinor * const Qup, spinor * const Qdn, const int max_iter,
+                 double eps_sq, const int rel_prec, matrix_mult_nd f,
+                 const int no_shifts, const double * const shifts);
+
 #endif
@@ -0,0 +1,147 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  
+ * File: cgcg_her.c
+ *
+ * CG solver for hermitian f only, in the variant of Chronopoulos and
+ * Gear (J. Comput. Appl. Math. 25 (1989) 153)
+ *
+ * Both inner products of an iteration, (r,r) and (r,Ar), are
+ * computed after the matrix multiplication in one sweep and one
+ * global reduction, instead of two separate reductions in cg_her.
+ * With s = Ap the recurrences are
+ *
+ *   p = r + beta p,  s = w + beta s,  x = x + alpha p,  r = r - alpha s
+ *   w = A r,  gamma = (r,r),  delta = (r,w)
+ *   beta = gamma/gamma_old,  alpha = gamma/(delta - beta gamma/alpha)
+ *
+ * which costs one more vector update per iteration.
+ *
+ * The externally accessible functions are
+ *
+ *
+ *   int cgcg_her(spinor * const P, spinor * const Q, const int max_iter, 
+ *                double eps_sq, const int rel_prec, const int N, matrix_mult f)
+ *     CG solver
+ *
+ * input:
+ *   Q: source
+ * inout:
+ *   P: initial guess and result
+ * 
+ *
+ **************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#include "global.h"
+#include "su3.h"
+#include "linalg_eo.h"
+#include "start.h"
+#include "gettime.h"
+#include "solver/matrix_mult_typedef.h"
+#include "solver_field.h"
+#include "cgcg_her.h"
+#include "profile.h"
+
+int cgcg_her(spinor * const P, spinor * const Q, const int max_iter, 
+	     double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
+
+  double gamma, gamma_old, delta, alpha_cg, beta_cg, squarenorm;
+  int iteration;
+  int save_sloppy = g_sloppy_precision;
+  double atime, etime, flops;
+  spinor ** solver_field = NULL;
+  spinor * r, * p, * s, * w;
+  const int nr_sf = 4;
+
+  if(N == VOLUME) {
+    init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
+  } 
+  else {
+    init_solver_field(&solver_field, VOLUMEPLUSRAND/2, nr_sf); 
+  } 
+  r = solver_field[0];
+  p = solver_field[1];
+  s = solver_field[2];
+  w = solver_field[3];
+
+  /* initialize residue r and w = A r */
+  atime = gettime();
+  squarenorm = square_norm(Q, N, 1);
+
+  f(w, P);
+  diff(r, Q, w, N);
+  f(w, r);
+  square_and_prod_r(&gamma, &delta, r, w, N, 1);
+  zero_spinor_field(p, N);
+  zero_spinor_field(s, N);
+  alpha_cg = gamma / delta;
+  beta_cg = 0.;
+
+  /* main loop */
+  for(iteration = 1; iteration <= max_iter; iteration++) {
+    update_x_r_p_and_s(P, r, p, s, w, alpha_cg, beta_cg, N);
+    f(w, r);
+    gamma_old = gamma;
+    square_and_prod_r(&gamma, &delta, r, w, N, 1);
+
+    if(g_proc_id == g_stdio_proc && g_debug_level > 1) {
+      printf("CGCG: iterations: %d res^2 %e\n", iteration, gamma);
+      fflush(stdout);
+    }
+
+    if (((gamma <= eps_sq) && (rel_prec == 0)) || ((gamma <= eps_sq*squarenorm) && (rel_prec == 1))) {
+      break;
+    }
+#ifdef _USE_HALFSPINOR
+    if(((gamma*gamma <= eps_sq) && (rel_prec == 0)) || ((gamma*gamma <= eps_sq*squarenorm) && (rel_prec == 1))) {
+      g_sloppy_precision = 1;
+      if(g_debug_level > 2 && g_proc_id == g_stdio_proc && g_sloppy_precision_flag == 1) {
+        printf("sloppy precision on\n"); fflush( stdout);
+      }
+    }
+#endif
+
+    beta_cg = gamma / gamma_old;
+    alpha_cg = gamma / (delta - beta_cg * gamma / alpha_cg);
+  }
+  etime = gettime();
+  g_sloppy_precision = save_sloppy;
+  /* 4 A + 2 Nc Ns + N_Count ( 2 A + 16 Nc Ns ) */
+  /* 2*1608.0 because the linalg is over VOLUME/2 */
+  flops = (4*(2*1608.0+2*3*4) + 2*3*4 + iteration*(2.*(2*1608.0+2*3*4) + 16*3*4))*N/1.0e6f;
+  if(g_debug_level > 0 && g_proc_id == 0 && N != VOLUME) {
+    printf("# CGCG: iter: %d eps_sq: %1.4e t/s: %1.4e\n", iteration, eps_sq, etime-atime); 
+    printf("# CGCG: flopcount (for e/o tmWilson only): t/s: %1.4e mflops_local: %.1f mflops: %.1f\n", 
+           etime-atime, flops/(etime-atime), g_nproc*flops/(etime-atime));
+  }
+  finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
+  if(iteration > max_iter) return(-1);
+  return(iteration);
+}
@@ -32,6 +32,7 @@
 #include "solver/matrix_mult_typedef.h"
 #include "solver_field.h"
 #include "cgs_real.h"
+#include "profile.h"
 
 
 /* P inout (guess for the solving spinor)
@@ -40,6 +41,7 @@
 
 int cgs_real(spinor * const P, spinor * const Q, const int max_iter, 
 	     double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
   static double alpha, beta,rjr0,nom,denom,one;
   static double res_sq, squarenorm;
   int i;
@@ -72,6 +74,7 @@ int cgs_real(spinor * const P, spinor * const Q, const int max_iter,
     /*     square_and_prod(&res_sq,&rjr0,solver_field[0],solver_field[5]); */
     if(((res_sq<eps_sq) && (rel_prec == 0)) || ((res_sq<eps_sq*squarenorm) && (rel_prec == 1))) {
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return i;
     }
     f(solver_field[3],solver_field[1]);	/* calc v */
@@ -104,6 +107,7 @@ int cgs_real(spinor * const P, spinor * const Q, const int max_iter,
 			     solver_field[2], beta, one, N);
   }
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return -1;
 }
 
@@ -16,6 +16,40 @@
  * You should have received a copy of the GNU General Public License
  * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
  ***********************************************************************/
+/*******************************************************************************
+ *
+ * Chronological inverter: the start vector of a solve is the minimal
+ * residual extrapolation (MRE) of the solutions of earlier solves with
+ * the same operator. For hermitian positive f it minimises the f-norm
+ * of the error in the span of the last n solutions, x = V y with
+ *
+ *   (V^dagger f V) y = V^dagger phi
+ *
+ * The history is orthonormalised on the fly from the gram matrix of
+ * the stored solutions, nearly linear dependent solutions are dropped.
+ * The guess depends only on the span of the history and not on the
+ * order of the solutions. Together with chrono_reset at the beginning
+ * of the forward and of the backward integration this keeps the
+ * violation of reversibility at the level of the solver precision.
+ *
+ * The histories are kept per operator and shared between all
+ * monomials calling chrono_guess with the same operator. Their memory
+ * is allocated when needed, limited by CSGMemory.
+ *
+ * The history length used for the guess is adapted per operator: the
+ * cost of the guess and of the following solve is measured in
+ * applications of the hopping matrix (g_hopping_count) between
+ * chrono_guess and chrono_add_solution and averaged per length. Every
+ * CHRONO_PROBE-th solve uses the length next to the current one and
+ * the current length moves to the cheaper one. N of the monomials is
+ * the maximal length.
+ *
+ * Between chrono_pause(1) and chrono_pause(0) the histories are used
+ * for the guess, but solutions are not added and the cost is not
+ * accounted, e.g. for the force at the displaced gauge field of the
+ * force gradient integrator.
+ *
+ *******************************************************************************/
 
 #ifdef HAVE_CONFIG_H
 # include<config.h>
@@ -23,150 +57,393 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <errno.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
 #include "global.h"
 #include "su3.h"
 #include "start.h"
+#include "read_input.h"
 #include "linalg_eo.h"
 #include "solver/matrix_mult_typedef.h"
 #include "solver/lu_solve.h"
 #include "solver/chrono_guess.h"
 
+#define CHRONO_MAX_HISTORIES 16
+#define CHRONO_MAX_N 32
+/* every CHRONO_PROBE-th solve uses a neighbouring length */
+#define CHRONO_PROBE 8
+/* number of solves the cost per length is averaged over */
+#define CHRONO_AVERAGE 20
+/* solutions with a smaller part orthogonal to the more */
+/* recent ones are dropped from the guess               */
+#define CHRONO_EPS 1.e-10
 
-/* N is the number of vectors to be stored maximally */
-/* _n is the last added vector                       */
-/* index_array holds the indices of all the vectors  */
-/*  to avoid copying things around                   */
-/* V is the volume                                   */
-/* trial is the vector to be added                   */
-/* v is the array of vectors                         */
+typedef struct {
+  /* the operator */
+  matrix_mult f;
+  int V;
+  double kappa, mu, mu3, c_sw;
+  /* the history, idx[0] is the most recent solution */
+  int N, n, allocated, capped;
+  int idx[CHRONO_MAX_N];
+  spinor * v_[CHRONO_MAX_N];
+  spinor * v[CHRONO_MAX_N];
+  /* adaptive history length */
+  int n_use, probe, solves_all;
+  double cost[CHRONO_MAX_N+1];
+  int cnt[CHRONO_MAX_N+1];
+  double hop_per_apply;
+  /* the solve following the last guess */
+  int pending, pending_n;
+  unsigned long pending_start;
+  /* statistics of the trajectory */
+  int solves;
+  unsigned long hopping;
+  double saved;
+} chrono_history;
 
-void chrono_add_solution(spinor * const trial, spinor ** const v, int index_array[],
-			const int N, int * _n, const int V) {
+static chrono_history histories[CHRONO_MAX_HISTORIES];
+static int no_histories = 0;
+static double chrono_memory = 0.;
+static int chrono_paused = 0;
 
-  double norm = 0.;
-  int i;
+void chrono_pause(const int pause) {
+  chrono_paused = pause;
+}
 
-  if(N > 0) {
-    if(g_proc_id == 0 && g_debug_level > 1) {
-      printf("CSG: adding vector %d to the list of length %d\n", (*_n)+1, N);
-      fflush(stdout);
+static chrono_history * get_history(const int N, const int V, matrix_mult f) {
+  chrono_history * h;
+  const int Nmax = (N > CHRONO_MAX_N) ? CHRONO_MAX_N : N;
+
+  for(int i = 0; i < no_histories; i++) {
+    h = &histories[i];
+    if(h->f == f && h->V == V && h->kappa == g_kappa && h->mu == g_mu
+       && h->mu3 == g_mu3 && h->c_sw == g_c_sw) {
+      if(Nmax > h->N && !h->capped) {
+	h->N = Nmax;
+      }
+      return(h);
     }
-    if((*_n) < N) {
-      index_array[(*_n)] = *_n;
-      (*_n)= (*_n)+1;
-      /* normalise vector */
-      norm = sqrt(square_norm(trial, V, 1));
-      mul_r(v[index_array[(*_n)-1]], 1/norm, trial, V);
+  }
+  if(no_histories == CHRONO_MAX_HISTORIES) {
+    if(g_proc_id == 0 && g_debug_level > 0) {
+      printf("CSG: more than %d operators, using zero trial vector\n", CHRONO_MAX_HISTORIES);
     }
-    else {
-      /* Reorder the index_array */
-      /* Keep most recent first  */
-      for(i = 1; i < N; i++) {
-	index_array[i-1] = index_array[i];
+    return(NULL);
+  }
+  h = &histories[no_histories];
+  no_histories++;
+  h->f = f;
+  h->V = V;
+  h->kappa = g_kappa;
+  h->mu = g_mu;
+  h->mu3 = g_mu3;
+  h->c_sw = g_c_sw;
+  h->N = Nmax;
+  h->n = 0;
+  h->allocated = 0;
+  h->capped = 0;
+  h->n_use = Nmax;
+  h->probe = 0;
+  h->solves_all = 0;
+  for(int i = 0; i < CHRONO_MAX_N+1; i++) {
+    h->cost[i] = 0.;
+    h->cnt[i] = 0;
+  }
+  h->hop_per_apply = 0.;
+  h->pending = 0;
+  h->solves = 0;
+  h->hopping = 0;
+  h->saved = 0.;
+  return(h);
+}
+
+/* allocates a further vector for h, returns 1 if the  */
+/* memory budget does not allow for it or if the        */
+/* allocation failed on any process, so that all of     */
+/* them keep the same history length                    */
+static int chrono_alloc(chrono_history * const h) {
+  const int VR = (h->V == VOLUME) ? VOLUMEPLUSRAND : VOLUMEPLUSRAND/2;
+  const double size = (VR+1)*sizeof(spinor);
+  const int i = h->allocated;
+  int failed = 0;
+
+  if(csg_memory > 0. && chrono_memory + size > csg_memory*1024.*1024.) {
+    return(1);
+  }
+  if((void*)(h->v_[i] = (spinor*)calloc(VR+1, sizeof(spinor))) == NULL) {
+    printf ("malloc errno : %d\n",errno);
+    errno = 0;
+    failed = 1;
+  }
+#ifdef MPI
+  MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  if(failed) {
+    free(h->v_[i]);
+    h->v_[i] = NULL;
+    return(1);
+  }
+#if ( defined SSE || defined SSE2 || defined SSE3)
+  h->v[i] = (spinor*)(((unsigned long int)(h->v_[i])+ALIGN_BASE)&~ALIGN_BASE);
+#else
+  h->v[i] = h->v_[i];
+#endif
+  h->allocated++;
+  chrono_memory += size;
+  return(0);
+}
+
+/* accounts the cost of the last guess and solve, */
+/* and adapts the history length                  */
+static void chrono_account(chrono_history * const h, const unsigned long cost) {
+  const int n = h->pending_n;
+  int best = h->n_use;
+
+  h->solves++;
+  h->solves_all++;
+  h->hopping += cost;
+  if(n > 0 && h->cnt[0] > 0) {
+    h->saved += h->cost[0] - (double)cost;
+  }
+  if(h->cnt[n] < CHRONO_AVERAGE) {
+    h->cnt[n]++;
+  }
+  h->cost[n] += ((double)cost - h->cost[n])/h->cnt[n];
+
+  if(h->cnt[h->n_use] > 0) {
+    for(int k = h->n_use-1; k < h->n_use+2; k++) {
+      if(k > -1 && k < h->N+1 && h->cnt[k] > 0 && h->cost[k] < h->cost[best]) {
+	best = k;
       }
-      index_array[N-1] = (index_array[N-2]+1)%N;
-      /* and normalise */
-      norm = sqrt(square_norm(trial, V, 1));
-      mul_r(v[index_array[N-1]], 1/norm, trial, V);
     }
   }
+  if(g_proc_id == 0 && g_debug_level > 1 && best != h->n_use) {
+    printf("CSG: history length changed from %d to %d\n", h->n_use, best);
+  }
+  h->n_use = best;
+  return;
+}
+
+/* N is the maximal number of vectors to be stored */
+/* V is the volume                                 */
+/* trial is the vector to be added                 */
+/* f is the operator trial is a solution for       */
+
+void chrono_add_solution(spinor * const trial, const int N, const int V, matrix_mult f) {
+  chrono_history * h;
+  double norm;
+  int i, slot;
 
+  if(N < 1 || chrono_paused || (h = get_history(N, V, f)) == NULL) {
+    return;
+  }
+  if(h->pending) {
+    chrono_account(h, g_hopping_count - h->pending_start);
+    h->pending = 0;
+  }
+  /* a zero solution carries no information for the guess */
+  norm = sqrt(square_norm(trial, V, 1));
+  if(norm == 0.) {
+    return;
+  }
+  if(h->n < h->N && h->n == h->allocated && !h->capped) {
+    if(chrono_alloc(h) != 0) {
+      if(g_proc_id == 0) {
+	printf("CSG: memory budget reached, history length limited to %d\n", h->n);
+      }
+      h->N = h->n;
+      h->capped = 1;
+      if(h->n_use > h->N) h->n_use = h->N;
+    }
+  }
+  if(h->N == 0) {
+    return;
+  }
+  if(g_proc_id == 0 && g_debug_level > 1) {
+    printf("CSG: adding vector %d to the list of length %d\n", h->n+1, h->N);
+    fflush(stdout);
+  }
+
+  /* the oldest slot is reused once the history is full */
+  if(h->n < h->N) {
+    slot = h->n;
+    h->n++;
+  }
+  else {
+    slot = h->idx[h->n-1];
+  }
+  for(i = h->n-1; i > 0; i--) {
+    h->idx[i] = h->idx[i-1];
+  }
+  h->idx[0] = slot;
+
+  /* normalise vector */
+  mul_r(h->v[slot], 1/norm, trial, V);
   return;
 }
 
-/* index_array, _N, _n, V as explained above         */
+/* sum_lm conj(a_l) S_lm b_m */
+static _Complex double sprod(const _Complex double * const a, const _Complex double * const S,
+			     const _Complex double * const b, const int n) {
+  _Complex double s = 0.;
+  for(int l = 0; l < n; l++) {
+    for(int m = 0; m < n; m++) {
+      s += conj(a[l]) * S[l*CHRONO_MAX_N + m] * b[m];
+    }
+  }
+  return(s);
+}
+
 /* trial is the guess vector to be returned          */
-/* phi is the right hand side of A*x = b to be       */
+/* phi is the right hand side of f*x = phi to be     */
 /*   solved                                          */
+/* N, V as explained above, f must be hermitian      */
 
-int chrono_guess(spinor * const trial, spinor * const phi, spinor ** const v, int index_array[], 
-		 const int _N, const int _n, const int V, matrix_mult f) {
-  int info = 0;
-  int i, j, N=_N, n=_n;
-  _Complex double s;
-  static int init_csg = 0;
-  static _Complex double *bn = NULL;
-  static _Complex double *G = NULL;
-  int max_N = 20;
+int chrono_guess(spinor * const trial, spinor * const phi, const int N, const int V, matrix_mult f) {
+  static _Complex double S[CHRONO_MAX_N*CHRONO_MAX_N], G[CHRONO_MAX_N*CHRONO_MAX_N];
+  static _Complex double C[CHRONO_MAX_N*CHRONO_MAX_N], H[CHRONO_MAX_N*CHRONO_MAX_N];
+  _Complex double c[CHRONO_MAX_N], bn[CHRONO_MAX_N], y[CHRONO_MAX_N], s;
+  chrono_history * h = NULL;
+  int keep[CHRONO_MAX_N];
+  int i, j, k, l, n, m, nk;
+  unsigned long hop;
+  double norm;
 
   if(N > 0) {
+    h = get_history(N, V, f);
+  }
+  if(h != NULL) {
+    /* history length for this guess */
+    n = h->n_use;
+    if(!chrono_paused) {
+      h->pending = 1;
+      h->pending_start = g_hopping_count;
+      if(h->n >= h->n_use && h->solves_all % CHRONO_PROBE == CHRONO_PROBE-1) {
+	h->probe = !h->probe;
+	n = h->probe ? h->n_use+1 : h->n_use-1;
+	if(n > h->N) n = h->N;
+	if(n < 0) n = 0;
+      }
+    }
+    if(n > h->n) n = h->n;
+    if(!chrono_paused) h->pending_n = n;
+  }
+  if(h == NULL || n == 0) {
     if(g_proc_id == 0 && g_debug_level > 1) {
-      printf("CSG: preparing  trial vector \n");
+      printf("CSG: using zero trial vector \n");
       fflush(stdout);
     }
-    if(init_csg == 0) {
-      init_csg = 1;
-      bn = (_Complex double*) malloc(max_N*sizeof(_Complex double));
-      G = (_Complex double*) malloc(max_N*max_N*sizeof(_Complex double));
-    }
+    zero_spinor_field(trial, V);
+    return(0);
+  }
 
-    /* Construct an orthogonal basis */
-    for(j = n-1; j > n-2; j--) {
-      for(i = j-1; i > -1; i--) {
-	s = scalar_prod(v[index_array[j]], v[index_array[i]], V, 1);
-	assign_diff_mul(v[index_array[i]], v[index_array[j]], s, V);
-	if(g_debug_level > 2) {
-	  s = scalar_prod(v[index_array[i]], v[index_array[j]], V, 1);
-	  if(g_proc_id == 0) {
-	    printf("CSG: <%d,%d> = %e +i %e \n", i, j, creal(s), cimag(s));fflush(stdout);
-	  }
-	}
-      }
+  if(g_proc_id == 0 && g_debug_level > 1) {
+    printf("CSG: preparing  trial vector \n");
+    fflush(stdout);
+  }
+
+  /* gram matrix of the n most recent solutions */
+  for(i = 0; i < n; i++) {
+    for(j = i; j < n; j++) {
+      S[i*CHRONO_MAX_N + j] = scalar_prod(h->v[h->idx[i]], h->v[h->idx[j]], V, 1);
+      S[j*CHRONO_MAX_N + i] = conj(S[i*CHRONO_MAX_N + j]);
     }
-    
-    /* Generate "interaction matrix" V^\dagger f V */
-    /* We assume that f is hermitian               */
-    /* Generate also the right hand side           */
-    
-    for (j = 0; j < n; j++){
-      f(trial, v[index_array[j]]);
-      
-      /* Only the upper triangular part is stored      */
-      for(i = 0; i < j+1; i++){
-	G[i*N + j] = scalar_prod(v[index_array[i]], trial, V, 1);  
-	if(j != i) {
-	  (G[j*N + i]) = conj(G[i*N + j]);
-	}
-	if(g_proc_id == 0 && g_debug_level > 2) {
-	  printf("CSG: G[%d*N + %d]= %e + i %e  \n", i, j, creal(G[i*N + j]), cimag(G[i*N + j]));
-	  fflush(stdout);
-	}
+  }
+
+  /* orthonormal basis q_k = sum_l C_kl v_l, twice modified */
+  /* Gram-Schmidt, most recent solution first               */
+  m = 0;
+  nk = 0;
+  for(i = 0; i < n; i++) {
+    for(l = 0; l < n; l++) c[l] = 0.;
+    c[i] = 1.;
+    for(int pass = 0; pass < 2; pass++) {
+      for(k = 0; k < m; k++) {
+	s = sprod(&C[k*CHRONO_MAX_N], S, c, n);
+	for(l = 0; l < n; l++) c[l] -= s * C[k*CHRONO_MAX_N + l];
       }
-      /* The right hand side */
-      bn[j] = scalar_prod(v[index_array[j]], phi, V, 1);  
     }
-    
-    /* Solver G y = bn for y and store it in bn */
-    LUSolve(n, G, N, bn);
-
-    /* Construct the new guess vector */
-    if(info == 0) {
-      mul(trial, bn[n-1], v[index_array[n-1]], V); 
-      if(g_proc_id == 0 && g_debug_level > 2) {
-	printf("CSG: bn[%d] = %f %f\n", index_array[n-1], creal(bn[index_array[n-1]]), cimag(bn[index_array[n-1]]));
-      }
-      for(i = n-2; i > -1; i--) {
-	assign_add_mul(trial, v[index_array[i]], bn[i], V);
-	if(g_proc_id == 0 && g_debug_level > 2) {
-	  printf("CSG: bn[%d] = %f %f\n", index_array[i], creal(bn[index_array[i]]), cimag(bn[index_array[i]]));
-	}
-      }
+    norm = creal(sprod(c, S, c, n));
+    if(norm > CHRONO_EPS * creal(S[i*CHRONO_MAX_N + i])) {
+      norm = 1./sqrt(norm);
+      for(l = 0; l < n; l++) C[m*CHRONO_MAX_N + l] = norm * c[l];
+      m++;
+      keep[nk] = i;
+      nk++;
     }
-    else {
-      assign(trial, phi, V);
+    else if(g_proc_id == 0 && g_debug_level > 2) {
+      printf("CSG: vector %d dropped as linear dependent\n", i);
     }
+  }
+  if(nk == 0) {
+    zero_spinor_field(trial, V);
+    return(0);
+  }
 
-    if(g_proc_id == 0 && g_debug_level > 1) {
-      printf("CSG: done! n= %d N=%d \n", n, N);fflush(stdout);
+  /* G_lj = v_l^dagger f v_j and the right hand side, */
+  /* only needed for the solutions kept                */
+  for(l = 0; l < n; l++) {
+    bn[l] = 0.;
+    for(j = 0; j < n; j++) G[l*CHRONO_MAX_N + j] = 0.;
+  }
+  for(j = 0; j < nk; j++) {
+    hop = g_hopping_count;
+    f(trial, h->v[h->idx[keep[j]]]);
+    h->hop_per_apply = (double)(g_hopping_count - hop);
+    for(l = 0; l < nk; l++) {
+      G[keep[l]*CHRONO_MAX_N + keep[j]] = scalar_prod(h->v[h->idx[keep[l]]], trial, V, 1);
     }
+    bn[keep[j]] = scalar_prod(h->v[h->idx[keep[j]]], phi, V, 1);
   }
-  else {
-    if(g_proc_id == 0 && g_debug_level > 1) {
-      printf("CSG: using zero trial vector \n");
-      fflush(stdout);
+
+  /* project to the orthonormal basis and solve */
+  for(i = 0; i < m; i++) {
+    for(j = 0; j < m; j++) {
+      H[i*CHRONO_MAX_N + j] = sprod(&C[i*CHRONO_MAX_N], G, &C[j*CHRONO_MAX_N], n);
     }
-    zero_spinor_field(trial, V);
+    y[i] = 0.;
+    for(l = 0; l < n; l++) y[i] += conj(C[i*CHRONO_MAX_N + l]) * bn[l];
   }
+  LUSolve(m, H, CHRONO_MAX_N, y);
 
-  return(info);
+  /* trial = sum_l (sum_k C_kl y_k) v_l */
+  for(l = 0; l < n; l++) {
+    c[l] = 0.;
+    for(k = 0; k < m; k++) c[l] += C[k*CHRONO_MAX_N + l] * y[k];
+  }
+  mul(trial, c[keep[0]], h->v[h->idx[keep[0]]], V);
+  for(k = 1; k < nk; k++) {
+    assign_add_mul(trial, h->v[h->idx[keep[k]]], c[keep[k]], V);
+  }
+
+  if(g_proc_id == 0 && g_debug_level > 1) {
+    printf("CSG: done! n= %d N=%d \n", m, h->N);fflush(stdout);
+  }
+  return(0);
+}
+
+void chrono_reset() {
+  for(int i = 0; i < no_histories; i++) {
+    histories[i].n = 0;
+    histories[i].pending = 0;
+  }
+  return;
+}
+
+void chrono_print_stats() {
+  for(int i = 0; i < no_histories; i++) {
+    chrono_history * const h = &histories[i];
+    if(h->solves > 0 && g_proc_id == 0) {
+      const double hop = (h->hop_per_apply > 0.) ? h->hop_per_apply : 1.;
+      printf("# CSG: operator %d (kappa = %f, 2kappamu = %f): history length %d of %d, %d solves, %.0f iterations, %.0f saved\n",
+	     i, h->kappa, 2.*h->kappa*h->mu, h->n_use, h->N, h->solves, h->hopping/hop, h->saved/hop);
+    }
+    h->solves = 0;
+    h->hopping = 0;
+    h->saved = 0.;
+  }
+  return;
 }
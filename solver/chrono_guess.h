@@ -22,10 +22,25 @@
 
 #include "solver/matrix_mult_typedef.h"
 
-void chrono_add_solution(spinor * const trial, spinor ** const v, int index_array[],
-			const int _N, int * _n, const int V);
+/* The histories of solutions are kept per operator, identified  */
+/* by f, V and the values of g_kappa, g_mu, g_mu3 and g_c_sw at  */
+/* the time of the call, so monomials inverting the same operator */
+/* share them. N is the maximal history length of the monomial,  */
+/* with N = 0 the chronological guess is not used.                */
 
-int chrono_guess(spinor * const trial, spinor * const phi, spinor ** const v, int index_array[], 
-		 const int N, const int n, const int V, matrix_mult f);
+void chrono_add_solution(spinor * const trial, const int N, const int V, matrix_mult f);
+
+int chrono_guess(spinor * const trial, spinor * const phi, const int N, const int V, matrix_mult f);
+
+/* empties all histories, at the beginning of every integration */
+void chrono_reset();
+
+/* with pause = 1 the following solutions are not added to the  */
+/* histories and their cost is not accounted, until called again */
+/* with pause = 0                                                 */
+void chrono_pause(const int pause);
+
+/* prints the statistics of the last trajectory and resets them */
+void chrono_print_stats();
 
 #endif
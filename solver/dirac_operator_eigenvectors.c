@@ -35,7 +35,7 @@
 
 /*   typedef enum tm_operator_ {PRECWS_DTM,PRECWS_QTM,PRECWS_D_DAGGER_D} tm_operator; */
 
-tm_operator PRECWSOPERATORSELECT[14]={PRECWS_DTM,           /* BICGSTAB 0 */    
+tm_operator PRECWSOPERATORSELECT[NO_OF_SOLVERS]={PRECWS_DTM,           /* BICGSTAB 0 */    
 				      PRECWS_D_DAGGER_D,    /* CG 1 */          
 				      PRECWS_DTM,           /* GMRES 2 */       
 				      PRECWS_DTM,	    /* CGS 3 */         
@@ -48,7 +48,9 @@ tm_operator PRECWSOPERATORSELECT[14]={PRECWS_DTM,           /* BICGSTAB 0 */
 				      PRECWS_NO,	    /* DFLGCR 10 */     
 				      PRECWS_NO,	    /* DFLFGMRES 11 */  
 				      PRECWS_NO,            /* CGMMS 12 */
-				      PRECWS_DOV_DAGGER_DOV /* MIXEDCG 13 */
+				      PRECWS_DOV_DAGGER_DOV, /* MIXEDCG 13 */
+				      PRECWS_NO,            /* BCG 14 */
+				      PRECWS_NO             /* CGCG 15 */
 };
 
 const char opstrings[][32]={"NO","Dtm","QTM","D^\\dagger D","D_Overlap","D_Overlap^\\dagger D_overlap"};
@@ -8,6 +8,7 @@
 
 #include <complex.h>
 #include "linalg/lapack.h"
+#include "solver/solver.h"
 
 /* some macros for 4d loops */
 #define FORXYZT(t,x,y,z,tt,ll) for(t=0;t<tt;t++){ for(x=0;x<ll;x++){ for(y=0;y<ll;y++){ for(z=0;z<ll;z++){ 
@@ -38,7 +39,7 @@ typedef enum tm_operator_ {PRECWS_NO=-1,
 			   PRECWS_DOV_DAGGER_DOV
 } tm_operator;
 /* this is a map telling which preconditioner to use for which solver */
-extern tm_operator PRECWSOPERATORSELECT[14];
+extern tm_operator PRECWSOPERATORSELECT[NO_OF_SOLVERS];
 
 
 /* */
@@ -53,6 +53,7 @@
 #include "start.h"
 #include "solver_field.h"
 #include"fgmres.h"
+#include "profile.h"
 
 static void init_gmres(const int _M, const int _V);
 
@@ -74,6 +75,7 @@ int fgmres(spinor * const P,spinor * const Q,
 	   const int m, const int max_restarts,
 	   const double eps_sq, const int rel_prec,
 	   const int N, const int precon, matrix_mult f){
+  _PROFILE_BEGIN(__func__);
 
   int restart, i, j, k;
   double beta, eps, norm;
@@ -126,6 +128,7 @@ int fgmres(spinor * const P,spinor * const Q,
     if(creal(alpha[0])==0.){ 
       assign(P, solver_field[2], N);
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(restart*m);
     }
 
@@ -191,6 +194,7 @@ int fgmres(spinor * const P,spinor * const Q,
 	}
 	assign(P, solver_field[2], N);
 	finalize_solver(solver_field, nr_sf);
+	_PROFILE_END(0., 0.);
 	return(restart*m+j);
       }
       /* if not */
@@ -221,6 +225,7 @@ int fgmres(spinor * const P,spinor * const Q,
   /* If maximal number of restarts is reached */
   assign(P, solver_field[2], N);
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
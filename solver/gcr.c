@@ -36,6 +36,7 @@
 #include"dfl_projector.h"
 #include "solver_field.h"
 #include"gcr.h"
+#include "profile.h"
 
 static void init_gcr(const int _M, const int _V);
 
@@ -54,6 +55,7 @@ int gcr(spinor * const P, spinor * const Q,
 	const int m, const int max_restarts,
 	const double eps_sq, const int rel_prec,
 	const int N, const int precon, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
 
   int k, l, restart, i, iter = 0;
   double norm_sq, err;
@@ -90,6 +92,7 @@ int gcr(spinor * const P, spinor * const Q,
     }
     if(((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*norm_sq) && (rel_prec == 1))) {
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(iter);
     }
     for(k = 0; k < m; k++) {
@@ -144,6 +147,7 @@ int gcr(spinor * const P, spinor * const Q,
     }
   }
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
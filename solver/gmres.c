@@ -56,6 +56,7 @@
 #include"linalg_eo.h"
 #include "solver_field.h"
 #include"gmres.h"
+#include "profile.h"
 
 
 static void init_gmres(const int _M, const int _V);
@@ -75,6 +76,7 @@ int gmres(spinor * const P,spinor * const Q,
 	  const int m, const int max_restarts,
 	  const double eps_sq, const int rel_prec,
 	  const int N, const int parallel, matrix_mult f){
+  _PROFILE_BEGIN(__func__);
 
   int restart, i, j, k;
   double beta, eps, norm;
@@ -111,6 +113,7 @@ int gmres(spinor * const P,spinor * const Q,
     if(creal(alpha[0])==0.){
       assign(P, solver_field[2], N);
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(restart*m);
     }
 
@@ -169,6 +172,7 @@ int gmres(spinor * const P,spinor * const Q,
 	}
 	assign(P, solver_field[2], N);
 	finalize_solver(solver_field, nr_sf);
+	_PROFILE_END(0., 0.);
 	return(restart*m+j);
       }
       /* if not */
@@ -199,6 +203,7 @@ int gmres(spinor * const P,spinor * const Q,
   /* If maximal number of restarts is reached */
   assign(P, solver_field[2], N);
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
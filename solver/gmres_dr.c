@@ -53,6 +53,7 @@
 #include"solver/gmres.h"
 #include "solver/solver_field.h"
 #include"gmres_dr.h"
+#include "profile.h"
 
 #ifndef HAVE_LAPACK
 /* In case there is no lapack use normal gmres */
@@ -99,6 +100,7 @@ int gmres_dr(spinor * const P,spinor * const Q,
 	  const int m, const int nr_ev, const int max_restarts,
 	  const double eps_sq, const int rel_prec,
 	  const int N, matrix_mult f){
+  _PROFILE_BEGIN(__func__);
 
   int restart=0, i, j, k, l;
   double beta, eps, norm, beta2=0.;
@@ -148,6 +150,7 @@ int gmres_dr(spinor * const P,spinor * const Q,
   if(creal(alpha[0])==0.){
     assign(P, x0, N);
     finalize_solver(solver_field, nr_sf);
+    _PROFILE_END(0., 0.);
     return(restart*m);
   }
   
@@ -214,6 +217,7 @@ int gmres_dr(spinor * const P,spinor * const Q,
       }
       assign(P, x0, N);
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(restart*m+j);
     }
     /* if not */
@@ -285,6 +289,7 @@ int gmres_dr(spinor * const P,spinor * const Q,
     if(err < eps){
       assign(P, x0, N);
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(restart*m);
     }
 
@@ -444,6 +449,7 @@ int gmres_dr(spinor * const P,spinor * const Q,
   /* If maximal number of restart is reached */
   assign(P, x0, N);
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
 
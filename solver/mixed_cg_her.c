@@ -25,16 +25,22 @@
  *
  * CG solver for hermitian f only!
  *
+ * the inner CG runs entirely in single precision on spinor32
+ * fields with the operator f32, the outer loop corrects the
+ * solution with the true residue computed in double precision
+ * with f
+ *
  * The externally accessible functions are
  *
  *
- *   int cg(spinor * const P, spinor * const Q, double m, const int subtract_ev)
- *     CG solver
+ *   int mixed_cg_her(spinor * const P, spinor * const Q, const int max_iter, 
+ *                    double eps_sq, const int rel_prec, const int N, 
+ *                    matrix_mult f, matrix_mult32 f32)
+ *     mixed precision CG solver
  *
  * input:
- *   m: Mass to be use in D_psi
- *   subtrac_ev: if set to 1, the lowest eigenvectors of Q^2 will
- *               be projected out.
+ *   f: double precision operator
+ *   f32: single precision version of f
  *   Q: source
  * inout:
  *   P: initial guess and result
@@ -55,30 +61,47 @@
 #include "solver/matrix_mult_typedef.h"
 #include "solver_field.h"
 #include "solver/mixed_cg_her.h"
+#include "profile.h"
+
+/* relative reduction of the squared residue in the inner */
+/* single precision solve before the residue is recomputed */
+/* in double precision                                     */
+#define _INNER_EPS_SQ 1.e-8
 
 /* P output = solution , Q input = source */
 int mixed_cg_her(spinor * const P, spinor * const Q, const int max_iter, 
-		 double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+		 double eps_sq, const int rel_prec, const int N, matrix_mult f, 
+		 matrix_mult32 f32) {
+  _PROFILE_BEGIN(__func__);
 
   int i = 0, iter = 0, j = 0;
-  double sqnrm = 0., sqnrm2, squarenorm;
+  double sqnrm = 0., sqnrm2, squarenorm, inner_eps_sq;
   double pro, err, alpha_cg, beta_cg;
   spinor *x, *delta, *y;
+  spinor32 *x32, *r32, *p32, *q32;
   spinor ** solver_field = NULL;
-  const int nr_sf = 6;
+  spinor32 ** solver_field32 = NULL;
+  const int nr_sf = 3;
+  const int nr_sf32 = 4;
 
   if(N == VOLUME) {
     init_solver_field(&solver_field, VOLUMEPLUSRAND, nr_sf);
+    init_solver_field_32(&solver_field32, VOLUMEPLUSRAND, nr_sf32);
   }
   else {
     init_solver_field(&solver_field, VOLUMEPLUSRAND/2, nr_sf);
+    init_solver_field_32(&solver_field32, VOLUMEPLUSRAND/2, nr_sf32);
   }
   squarenorm = square_norm(Q, N, 1);
   sqnrm = squarenorm;
 
-  delta = solver_field[3];
-  x = solver_field[4];
-  y = solver_field[5];
+  delta = solver_field[0];
+  x = solver_field[1];
+  y = solver_field[2];
+  q32 = solver_field32[0];
+  r32 = solver_field32[1];
+  p32 = solver_field32[2];
+  x32 = solver_field32[3];
   assign(delta, Q, N);
     
   if(squarenorm > 1.e-7) { 
@@ -88,47 +111,48 @@ int mixed_cg_her(spinor * const P, spinor * const Q, const int max_iter,
     sqnrm = square_norm(delta, N, 1);
     if(((sqnrm <= eps_sq) && (rel_prec == 0)) || ((sqnrm <= eps_sq*squarenorm) && (rel_prec == 1))) {
       finalize_solver(solver_field, nr_sf);
+      finalize_solver_32(solver_field32, nr_sf32);
+      _PROFILE_END(0., 0.);
       return(0);
     }
   }
 
   for(i = 0; i < 20; i++) {
 
-    g_sloppy_precision = 1;
-    /* main CG loop in lower precision */
-    zero_spinor_field(x, N);
-    assign(solver_field[1], delta, N);
-    assign(solver_field[2], delta, N);
+    /* main CG loop in single precision */
+    inner_eps_sq = _INNER_EPS_SQ*sqnrm;
+    assign_to_32(r32, delta, N);
+    assign_to_32(p32, delta, N);
+    zero_spinor_field_32(x32, N);
     sqnrm2 = sqnrm;
     for(j = 0; j <= max_iter; j++) {
-      f(solver_field[0], solver_field[2]);
-      pro = scalar_prod_r(solver_field[2], solver_field[0], N, 1);
+      f32(q32, p32);
+      pro = scalar_prod_r_32(p32, q32, N, 1);
       alpha_cg = sqnrm2 / pro;
-      assign_add_mul_r(x, solver_field[2], alpha_cg, N);
-    
-      assign_mul_add_r(solver_field[0], -alpha_cg, solver_field[1], N);
-      err = square_norm(solver_field[0], N, 1);
+      assign_add_mul_r_32(x32, p32, (float)alpha_cg, N);
+      assign_add_mul_r_32(r32, q32, (float)(-alpha_cg), N);
+      err = square_norm_32(r32, N, 1);
 
       if(g_proc_id == g_stdio_proc && g_debug_level > 1) {
 	printf("inner CG: %d res^2 %g\n", iter+j, err);
 	fflush(stdout);
       }
     
-      if (((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*squarenorm) && (rel_prec == 1))){
+      if (((err <= eps_sq) && (rel_prec == 0)) || ((err <= eps_sq*squarenorm) && (rel_prec == 1))
+	  || (err <= inner_eps_sq)){
 	break;
       }
       beta_cg = err / sqnrm2;
-      assign_mul_add_r(solver_field[2], beta_cg, solver_field[0], N);
-      assign(solver_field[1], solver_field[0], N);
+      assign_mul_add_r_32(p32, (float)beta_cg, r32, N);
       sqnrm2 = err;
     }
     /* end main CG loop */
     iter += j;
-    g_sloppy_precision = 0;
+    assign_to_64(x, x32, N);
     add(P, P, x, N);
 
-    f(y, x);
-    diff(delta, delta, y, N);
+    f(y, P);
+    diff(delta, Q, y, N);
     sqnrm = square_norm(delta, N, 1);
     if(g_debug_level > 0 && g_proc_id == g_stdio_proc) {
       printf("mixed CG: true residue %d\t%g\t\n",iter, sqnrm); fflush( stdout);
@@ -136,19 +160,14 @@ int mixed_cg_her(spinor * const P, spinor * const Q, const int max_iter,
 
     if(((sqnrm <= eps_sq) && (rel_prec == 0)) || ((sqnrm <= eps_sq*squarenorm) && (rel_prec == 1))) {
       finalize_solver(solver_field, nr_sf);
+      finalize_solver_32(solver_field32, nr_sf32);
+      _PROFILE_END(0., 0.);
       return(iter+i);
     }
     iter++;
   }
   finalize_solver(solver_field, nr_sf);
+  finalize_solver_32(solver_field32, nr_sf32);
+  _PROFILE_END(0., 0.);
   return(-1);
 }
-
-
-
-
-
-
-
-
-
@@ -23,6 +23,7 @@
 #include"su3.h"
 
 int mixed_cg_her(spinor * const P, spinor * const Q, const int max_iter, 
-		 double eps_sq, const int rel_prec, const int N, matrix_mult f);
+		 double eps_sq, const int rel_prec, const int N, matrix_mult f, 
+		 matrix_mult32 f32);
 
 #endif
@@ -54,11 +54,13 @@
 #include "solver/solver.h"
 #include "solver_field.h"
 #include "mr.h"
+#include "profile.h"
 
 int mr(spinor * const P, spinor * const Q,
        const int max_iter, const double eps_sq,
        const int rel_prec, const int N, const int parallel, 
        matrix_mult f){
+  _PROFILE_BEGIN(__func__);
   int i=0;
   double norm_r,beta;
   _Complex double alpha;
@@ -105,8 +107,10 @@ int mr(spinor * const P, spinor * const Q,
   }
   finalize_solver(solver_field, nr_sf);
   if(norm_r > eps_sq){
+    _PROFILE_END(0., 0.);
     return(-1);
   }
+  _PROFILE_END(0., 0.);
   return(i);
 }
 
@@ -115,6 +119,7 @@ int mrblk(spinor * const P, spinor * const Q,
 	  const int max_iter, const double eps_sq,
 	  const int rel_prec, const int N, 
 	  matrix_mult_blk f, const int blk) {
+  _PROFILE_BEGIN(__func__);
   static int mr_init=0;
   int i = 0;
   double norm_r,beta;
@@ -176,7 +181,9 @@ int mrblk(spinor * const P, spinor * const Q,
   }
   /* free(s_); */
   if(norm_r > eps_sq){
+    _PROFILE_END(0., 0.);
     return(-1);
   }
+  _PROFILE_END(0., 0.);
   return(i);
 }
@@ -32,10 +32,12 @@
 #include "sub_low_ev.h"
 #include "solver_field.h"
 #include "pcg_her.h"
+#include "profile.h"
 
 /* P output = solution , Q input = source */
 int pcg_her(spinor * const P, spinor * const Q, const int max_iter, 
 	    double eps_sq, const int rel_prec, const int N, matrix_mult f) {
+  _PROFILE_BEGIN(__func__);
   double normsp, pro, pro2, err, alpha_cg, beta_cg, squarenorm;
   int iteration;
   spinor ** solver_field = NULL;
@@ -98,6 +100,7 @@ int pcg_her(spinor * const P, spinor * const Q, const int max_iter,
       assign(P, solver_field[0], N);
       g_sloppy_precision = 0;
       finalize_solver(solver_field, nr_sf);
+      _PROFILE_END(0., 0.);
       return(iteration+1);
     }
 #ifdef _USE_HALFSPINOR
@@ -121,6 +124,7 @@ int pcg_her(spinor * const P, spinor * const Q, const int max_iter,
   g_sloppy_precision = 0;
 /*   return(-1); */
   finalize_solver(solver_field, nr_sf);
+  _PROFILE_END(0., 0.);
   return(1);
 }
 
@@ -34,6 +34,10 @@
 #define DFLFGMRES 11
 #define CGMMS 12
 #define MIXEDCG 13
+#define BCG 14
+#define CGCG 15
+/* number of solver ids above */
+#define NO_OF_SOLVERS 16
 
 #include"solver/matrix_mult_typedef.h"
 
@@ -51,6 +55,8 @@
 #include"solver/eigenvalues.h"
 #include"solver/cg_mms_tm.h"
 #include"solver/mixed_cg_her.h"
+#include"solver/bcg_her.h"
+#include"solver/cgcg_her.h"
 
 #include"solver/sub_low_ev.h"
 #include"solver/gmres_precon.h"
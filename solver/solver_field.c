@@ -1,6 +1,6 @@
 /***********************************************************************
  *
- * Copyright (C) 2009,2011 Carsten Urbach
+ * Copyright (C) 2009,2011,2013 Carsten Urbach
  *
  * This file is part of tmLQCD.
  *
@@ -17,92 +17,190 @@
  * You should have received a copy of the GNU General Public License
  * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
  *
+ *
+ * The solver work fields are taken from a pool which lives for the
+ * whole run. A request for nr fields of volume V is served by a free
+ * pool entry with the same element size, V and nr, or by a new entry
+ * which is allocated aligned. The fields are zeroed on every request,
+ * as the calloc of the former init_solver_field did, with the same
+ * OpenMP schedule as the linalg routines (first touch). finalize_solver
+ * returns the fields to the pool, memory is only released with
+ * free_solver_field_pool(). If the pool is exhausted or the memory
+ * cannot be allocated the run is aborted with fatal_error.
+ *
  *******************************************************************************/
 
 #ifdef HAVE_CONFIG_H
 # include<config.h>
 #endif
 #include<stdlib.h>
+#include<stdio.h>
+#include<string.h>
 #include<errno.h>
+#ifdef OMP
+# include<omp.h>
+#endif
 #include"global.h"
 #include"su3.h"
 #include"solver_field.h"
+#ifdef _SHM_HALO
+# include"shm_halo.h"
+#endif
 
-int init_solver_field(spinor *** const solver_field, const int V, const int nr) {
-  int i=0;
+#define _MAX_SOLVER_POOL 64
 
-  /* allocate nr+1 to save the linear field in solver_field[nr] */
-  if((void*)((*solver_field) = (spinor**)malloc((nr+1)*sizeof(spinor*))) == NULL) {
-    printf ("malloc errno in init_solver_field: %d\n",errno); 
-    errno = 0;
-    return(2);
-  }
-  
-  /* allocate the full chunk of memory to solver_field[nr] */
-#if (defined _USE_SHMEM && !(defined _USE_HALFSPINOR))
-  if((void*)((*solver_field)[nr] = (spinor*)shmalloc((nr*V+1)*sizeof(spinor))) == NULL) {
-    fprintf (stderr, "malloc errno in init_solver_field: %d\n",errno); 
-    errno = 0;
-    return(1);
+typedef struct {
+  void * mem;
+  void ** fields;
+  size_t size;
+  int V, nr;
+  int in_use;
+} solver_pool_entry;
+
+static solver_pool_entry solver_pool[_MAX_SOLVER_POOL];
+static int solver_pool_n = 0;
+static size_t solver_pool_bytes = 0, solver_pool_bytes_in_use = 0, solver_pool_peak = 0;
+static int solver_pool_hits = 0, solver_pool_misses = 0;
+
+/* zero the fields with the same thread to site mapping as the */
+/* linalg routines, such that the pages of a new entry are      */
+/* placed close to the threads using them                       */
+static void first_touch(void ** const fields, const size_t size, const int V, const int nr) {
+  for(int i = 0; i < nr; i++) {
+    char * const f = (char*) fields[i];
+#ifdef OMP
+#pragma omp parallel for
+#endif
+    for(int ix = 0; ix < V; ix++) {
+      memset(f + ix*size, 0, size);
+    }
   }
-#else
-  if((void*)((*solver_field)[nr] = (spinor*)calloc(nr*V+1, sizeof(spinor))) == NULL) {
-    printf ("malloc errno in init_solver_field: %d\n",errno); 
-    errno = 0;
-    return(1);
+}
+
+static void ** get_pool_fields(const size_t size, const int V, const int nr) {
+  int i;
+  solver_pool_entry * e = NULL;
+
+  for(i = 0; i < solver_pool_n; i++) {
+    if(!solver_pool[i].in_use && solver_pool[i].size == size 
+       && solver_pool[i].V == V && solver_pool[i].nr == nr) {
+      e = &solver_pool[i];
+      solver_pool_hits++;
+      break;
+    }
   }
-#endif
 
-  /* now cut in pieces and distribute to solver_field[0]-solver_field[nr-1] */
-#if ( defined SSE || defined SSE2 || defined SSE3)
-  (*solver_field)[0] = (spinor*)(((unsigned long int)((*solver_field)[nr])+ALIGN_BASE)&~ALIGN_BASE);
+  if(e == NULL) {
+    if(solver_pool_n == _MAX_SOLVER_POOL) {
+      fatal_error("Solver field pool exhausted, increase _MAX_SOLVER_POOL in solver_field.c.", "init_solver_field");
+    }
+    e = &solver_pool[solver_pool_n];
+    /* allocate nr+1 to save the linear field in fields[nr] */
+    if((void*)(e->fields = (void**)malloc((nr+1)*sizeof(void*))) == NULL) {
+      printf ("malloc errno in init_solver_field: %d\n",errno); 
+      errno = 0;
+      fatal_error("Could not allocate the solver fields.", "init_solver_field");
+    }
+    /* allocate the full chunk of memory to fields[nr] */
+#if (defined _USE_SHMEM && !(defined _USE_HALFSPINOR))
+    if((void*)(e->mem = shmalloc(nr*V*size + ALIGN_BASE + 1)) == NULL) {
+#elif (defined _SHM_HALO && defined MPI)
+    /* spinor fields are exchanged, the neighbours on the node read them */
+    if((void*)(e->mem = (size == sizeof(spinor) ? shm_alloc(nr*V*size + ALIGN_BASE + 1) 
+			 : malloc(nr*V*size + ALIGN_BASE + 1))) == NULL) {
 #else
-  (*solver_field)[0] = (*solver_field)[nr];
+    if((void*)(e->mem = malloc(nr*V*size + ALIGN_BASE + 1)) == NULL) {
 #endif
-  for(i = 1; i < nr; i++){
-    (*solver_field)[i] = (*solver_field)[i-1]+V;
+      printf ("malloc errno in init_solver_field: %d\n",errno); 
+      errno = 0;
+      fatal_error("Could not allocate the solver fields.", "init_solver_field");
+    }
+    e->fields[nr] = e->mem;
+    /* now cut in pieces and distribute to fields[0]-fields[nr-1] */
+    e->fields[0] = (void*)(((unsigned long int)(e->mem)+ALIGN_BASE)&~ALIGN_BASE);
+    for(i = 1; i < nr; i++) {
+      e->fields[i] = (char*)e->fields[i-1] + V*size;
+    }
+    e->size = size;
+    e->V = V;
+    e->nr = nr;
+    solver_pool_n++;
+    solver_pool_misses++;
+    solver_pool_bytes += nr*V*size;
+  }
+  first_touch(e->fields, size, V, nr);
+  e->in_use = 1;
+  solver_pool_bytes_in_use += nr*V*size;
+  if(solver_pool_bytes_in_use > solver_pool_peak) {
+    solver_pool_peak = solver_pool_bytes_in_use;
+  }
+  return(e->fields);
+}
+
+static void return_pool_fields(void ** const fields) {
+  for(int i = 0; i < solver_pool_n; i++) {
+    if(solver_pool[i].fields == fields) {
+      solver_pool[i].in_use = 0;
+      solver_pool_bytes_in_use -= solver_pool[i].nr*solver_pool[i].V*solver_pool[i].size;
+      return;
+    }
+  }
+  if(g_proc_id == 0) {
+    fprintf(stderr, "finalize_solver: fields not from the solver field pool\n");
+  }
+}
+
+int init_solver_field(spinor *** const solver_field, const int V, const int nr) {
+  if(((*solver_field) = (spinor**)get_pool_fields(sizeof(spinor), V, nr)) == NULL) {
+    return(1);
   }
   return(0);
 }
 
 void finalize_solver(spinor ** solver_field, const int nr){
-  free(solver_field[nr]);
-  free(solver_field);
-  solver_field = NULL;
+  return_pool_fields((void**)solver_field);
 }
 
-
 int init_bisolver_field(bispinor *** const solver_field, const int V, const int nr) {
-  int i=0;
-
-  /* allocate nr+1 to save the linear field in solver_field[nr] */
-  if((void*)((*solver_field) = (bispinor**)malloc((nr+1)*sizeof(bispinor*))) == NULL) {
-    printf ("malloc errno in init_solver_field: %d\n",errno); 
-    errno = 0;
-    return(2);
-  }
-  
-  /* allocate the full chunk of memory to solver_field[nr] */
-  if((void*)((*solver_field)[nr] = (bispinor*)calloc(nr*V+1, sizeof(bispinor))) == NULL) {
-    printf ("malloc errno in init_solver_field: %d\n",errno); 
-    errno = 0;
+  if(((*solver_field) = (bispinor**)get_pool_fields(sizeof(bispinor), V, nr)) == NULL) {
     return(1);
   }
+  return(0);
+}
 
-  /* now cut in pieces and distribute to solver_field[0]-solver_field[nr-1] */
-#if ( defined SSE || defined SSE2 || defined SSE3)
-  (*solver_field)[0] = (bispinor*)(((unsigned long int)((*solver_field)[nr])+ALIGN_BASE)&~ALIGN_BASE);
-#else
-  (*solver_field)[0] = (*solver_field)[nr];
-#endif
-  for(i = 1; i < nr; i++){
-    (*solver_field)[i] = (*solver_field)[i-1]+V;
+void finalize_bisolver(bispinor ** solver_field, const int nr) {
+  return_pool_fields((void**)solver_field);
+}
+
+int init_solver_field_32(spinor32 *** const solver_field, const int V, const int nr) {
+  if(((*solver_field) = (spinor32**)get_pool_fields(sizeof(spinor32), V, nr)) == NULL) {
+    return(1);
   }
   return(0);
 }
 
-void finalize_bisolver(bispinor ** solver_field, const int nr) {
-  free(solver_field[nr]);
-  free(solver_field);
-  solver_field = NULL;
+void finalize_solver_32(spinor32 ** solver_field, const int nr) {
+  return_pool_fields((void**)solver_field);
+}
+
+void print_solver_field_pool_stats() {
+  printf("# solver field pool: %d entries, %.2f MB allocated, peak in use %.2f MB, %d reused, %d allocated\n",
+	 solver_pool_n, solver_pool_bytes/1048576., solver_pool_peak/1048576., 
+	 solver_pool_hits, solver_pool_misses);
+}
+
+void free_solver_field_pool() {
+  for(int i = 0; i < solver_pool_n; i++) {
+#if (defined _USE_SHMEM && !(defined _USE_HALFSPINOR))
+    shfree(solver_pool[i].mem);
+#elif (defined _SHM_HALO && defined MPI)
+    shm_free(solver_pool[i].mem);
+#else
+    free(solver_pool[i].mem);
+#endif
+    free(solver_pool[i].fields);
+  }
+  solver_pool_n = 0;
+  solver_pool_bytes = 0;
+  solver_pool_bytes_in_use = 0;
 }
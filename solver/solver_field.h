@@ -24,8 +24,14 @@
 
 #include"su3.h"
 
+/* the fields are taken from a pool and always handed out zeroed, */
+/* running out of pool entries or memory aborts with fatal_error  */
 int init_solver_field(spinor *** const solver_field, const int V, const int nr);
 void finalize_solver(spinor ** solver_field, const int nr);
 int init_bisolver_field(bispinor *** const solver_field, const int V, const int nr);
 void finalize_bisolver(bispinor ** solver_field, const int nr);
+int init_solver_field_32(spinor32 *** const solver_field, const int V, const int nr);
+void finalize_solver_32(spinor32 ** solver_field, const int nr);
+void print_solver_field_pool_stats();
+void free_solver_field_pool();
 #endif
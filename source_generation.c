@@ -26,12 +26,16 @@
 #include "global.h"
 #include "start.h"
 #include "ranlxd.h"
+#include "philox.h"
 #include "su3spinor.h"
 #include "source_generation.h"
 
 #ifndef M_PI
 # define M_PI           3.14159265358979323846
 #endif
+#ifndef M_SQRT2
+# define M_SQRT2        1.41421356237309504880
+#endif
 
 /* Generates normal distributed random numbers */
 /* using the box-muller method                 */
@@ -79,46 +83,32 @@ void rnormal(double * r, const int n)
 /* is the normalisation                          */
 /* this is corrected for in the contraction      */
 /* codes                                         */
+/*                                               */
+/* every site has its own philox stream with the */
+/* global site index as counter, so the source   */
+/* does not depend on the process grid           */
 void gaussian_volume_source(spinor * const P, spinor * const Q,
 			    const int sample, const int nstore, const int f) 
 {
-  int x, y, z, t, i, reset = 0, seed; 
-  int rlxd_state[105];
-  spinor * p;
-
-  /* save the ranlxd_state if neccessary */
-  if(ranlxd_init == 1) {
-    rlxd_get(rlxd_state);
-    reset = 1;
-  }
-
-  /* Compute the seed */
-  seed =(int) abs(1 + sample + f*10*97 + nstore*100*53 + g_cart_id*13);
-
-  rlxd_init(1, seed);
-
-  for(t = 0; t < T; t++) {
-    for(x = 0; x < LX; x++) {
-      for(y =0; y < LY; y++) {
-	for(z = 0; z < LZ; z++) {
-	  i = g_lexic2eosub[ g_ipt[t][x][y][z] ];
-	  if((t+x+y+z+g_proc_coords[3]*LZ+g_proc_coords[2]*LY 
-	      + g_proc_coords[0]*T+g_proc_coords[1]*LX)%2 == 0) {
-	    p = P + i;
-	  }
-	  else {
-	    p = Q + i;
-	  }
-	  rnormal((double*)p, 24);
-	}
-      }
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int ix = 0; ix < VOLUME; ix++) {
+    philox_stream st;
+    const int * const x = g_coord[ix];
+    const uint32_t site = ((((uint32_t)x[0]*LX*g_nproc_x + x[1])*LY*g_nproc_y
+			    + x[2])*LZ*g_nproc_z) + x[3];
+    double * const r = (double*)((((x[0]+x[1]+x[2]+x[3])%2 == 0) ? P : Q) + g_lexic2eosub[ix]);
+
+    /* the last counter word separates the sources from the */
+    /* random fields of start.c                             */
+    philox_init(&st, (uint32_t)sample, (uint32_t)nstore, site, (uint32_t)f, 0x80000000U);
+    philox_gauss_vector(&st, r, 24);
+    /* unit variance as for rnormal */
+    for(int i = 0; i < 24; i++) {
+      r[i] *= M_SQRT2;
     }
   }
-
-  /* reset the ranlxd if neccessary */
-  if(reset) {
-    rlxd_reset(rlxd_state);
-  }
   return;
 }
 
@@ -35,6 +35,10 @@
  *   void random_spinor_field(int k)
  *     Initializes the spinor field psi[k] to a Gaussian random field
  *
+ *   void start_repro_random(const int seed, const int trajectory)
+ *     Sets the key of the counter based random numbers used by
+ *     random_spinor_field and random_gauge_field with repro == 1
+ *
  * M.Hasenbusch:
  *   void zero_spinor_field(spinor * const k, const int V)
  *     Initializes the spinor field psi[k] to  zero
@@ -76,9 +80,22 @@
 #include "su3adj.h"
 #include "ranlxd.h"
 #include "ranlxs.h"
+#include "philox.h"
 #include "start.h"
 
-void gauss_vector(double v[],int n)
+/* source of n uniform random numbers in [0,1), ranlxd or a  */
+/* counter based philox stream for the reproducible fields    */
+typedef void (*uniform_gen)(double * const r, const int n, void * const state);
+
+static void ranlxd_gen(double * const r, const int n, void * const state) {
+  ranlxd(r, n);
+}
+
+static void philox_gen(double * const r, const int n, void * const state) {
+  philox_doubles((philox_stream*)state, r, n);
+}
+
+static void gauss_vector_gen(double v[], int n, uniform_gen gen, void * const state)
 {
    int k;
    double r[2];
@@ -87,7 +104,7 @@ void gauss_vector(double v[],int n)
 
    for (k=0;;k+=2)
    {
-      ranlxd(r,2);
+      gen(r,2,state);
       x1=r[0];
       x2=r[1];
 
@@ -106,6 +123,66 @@ void gauss_vector(double v[],int n)
    }
 }
 
+void gauss_vector(double v[],int n)
+{
+  gauss_vector_gen(v, n, ranlxd_gen, NULL);
+}
+
+/* number of Box-Muller pairs computed at once */
+#define GAUSS_BLOCK 12
+/* number of sites sharing one philox stream in the fields */
+/* generated with a key drawn from ranlxd                  */
+#define RANDOM_CHUNK 64
+
+/* The same numbers as gauss_vector_gen with a philox stream for */
+/* even n, but with the logarithms and the trigonometric         */
+/* functions computed in blocks of independent operations.       */
+void philox_gauss_vector(philox_stream * const st, double v[], const int n)
+{
+  double u[2*GAUSS_BLOCK], rho[GAUSS_BLOCK], phi[GAUSS_BLOCK];
+
+  for(int k = 0; k < n; k += 2*GAUSS_BLOCK) {
+    const int m = (n - k < 2*GAUSS_BLOCK) ? (n - k)/2 : GAUSS_BLOCK;
+    philox_doubles(st, u, 2*m);
+    for(int i = 0; i < m; i++) {
+      rho[i] = sqrt(-log(1.0 - u[2*i]));
+      phi[i] = u[2*i+1] * 6.2831853071796;
+    }
+    for(int i = 0; i < m; i++) {
+      v[k+2*i] = rho[i] * sin(phi[i]);
+      v[k+2*i+1] = rho[i] * cos(phi[i]);
+    }
+  }
+}
+
+/* a new key for the philox streams of one field, from ranlxd */
+static void ranlxd_key(uint32_t key[2])
+{
+  double r[2];
+
+  ranlxd(r, 2);
+  key[0] = (uint32_t)(r[0] * 4294967296.0);
+  key[1] = (uint32_t)(r[1] * 4294967296.0);
+}
+
+/* key and number of calls for the reproducible random fields */
+static uint32_t repro_key[2] = {0, 0};
+static uint32_t repro_calls = 0;
+
+void start_repro_random(const int seed, const int trajectory)
+{
+  repro_key[0] = (uint32_t)seed;
+  repro_key[1] = (uint32_t)trajectory;
+  repro_calls = 0;
+}
+
+/* global lexicographic index of the local lexicographic site ix */
+static inline uint32_t global_site_index(const int ix)
+{
+  return(((((uint32_t)g_coord[ix][0]*LX*g_nproc_x + g_coord[ix][1])*LY*g_nproc_y
+	   + g_coord[ix][2])*LZ*g_nproc_z) + g_coord[ix][3]);
+}
+
 
 static su3 unit_su3(void)
 {
@@ -148,7 +225,7 @@ su3_vector random_su3_vector(void)
    return(s);
 }
 
-su3_vector unif_su3_vector(void)
+static su3_vector unif_su3_vector_gen(uniform_gen gen, void * const state)
 {
    int i;
    double v[6],norm,fact;
@@ -156,7 +233,7 @@ su3_vector unif_su3_vector(void)
 
    for (;;)
    {
-      ranlxd(v,6);
+      gen(v,6,state);
       norm=0.0;
 
       for (i=0;i<6;i++){
@@ -178,6 +255,11 @@ su3_vector unif_su3_vector(void)
    return(s);
 }
 
+su3_vector unif_su3_vector(void)
+{
+  return(unif_su3_vector_gen(ranlxd_gen, NULL));
+}
+
 
 spinor random_spinor(void)
 {
@@ -310,136 +392,82 @@ void random_spinor_field_eo(spinor * const k) {
   return;
 }
 
-void random_spinor_field(spinor * const k, const int V, const int repro) {
-
-  int ix;
-  int rlxd_state[105];
-  spinor *s;
-  double v[6];
-#ifdef MPI
-  int j=0;
+/* With repro == 1 the random numbers of a site are taken from a    */
+/* philox stream with the global index of the site, the number of   */
+/* the call and the number of the sub-field as counter and the key  */
+/* set by start_repro_random. The field is then independent of the  */
+/* process grid and the number of threads. A field of length VOLUME */
+/* is taken to be in lexicographic order, otherwise the field is    */
+/* made of V/(VOLUME/2) even/odd sub-fields.                        */
+static void repro_spinor_field(spinor * const k, const int V) {
+  const int N = (V == VOLUME) ? VOLUME : VOLUME/2;
+  const uint32_t call = repro_calls++;
+
+#ifdef OMP
+#pragma omp parallel for
 #endif
+  for(int ix = 0; ix < V; ix++) {
+    philox_stream st;
+    const int i = ix % N;
+    const int lx = (V == VOLUME) ? i : g_eo2lexic[i];
 
-  if(g_proc_id==0 && repro == 1) {
-    for (ix = 0; ix < V; ix++) {
-      s = k + ix;
-      gauss_vector(v,6);
-      s->s0.c0 = v[0] + v[1] * I;
-      s->s0.c1 = v[2] + v[3] * I;
-      s->s0.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s1.c0 = v[0] + v[1] * I;
-      s->s1.c1 = v[2] + v[3] * I;
-      s->s1.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s2.c0 = v[0] + v[1] * I;
-      s->s2.c1 = v[2] + v[3] * I;
-      s->s2.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s3.c0 = v[0] + v[1] * I;
-      s->s3.c1 = v[2] + v[3] * I;
-      s->s3.c2 = v[4] + v[5] * I;
-    }
-    /* send the state for the random-number generator to 1 */
-    rlxd_get(rlxd_state);
-#ifdef MPI
-    if(g_nproc > 1) {
-      MPI_Send(&rlxd_state[0], 105, MPI_INT, 1, 102, MPI_COMM_WORLD);
-    }
-#endif
+    philox_init(&st, repro_key[0], repro_key[1], global_site_index(lx), call, (uint32_t)(ix / N));
+    philox_gauss_vector(&st, (double*)(k + ix), 24);
   }
-#ifdef MPI
-  if(g_proc_id != 0 && repro == 1) {
-    MPI_Recv(&rlxd_state[0], 105, MPI_INT, g_proc_id-1, 102, MPI_COMM_WORLD, &status);
-    rlxd_reset(rlxd_state);
-    for (ix=0;ix<V;ix++) {
-      s = k + ix;
-      gauss_vector(v,6);
-      s->s0.c0 = v[0] + v[1] * I;
-      s->s0.c1 = v[2] + v[3] * I;
-      s->s0.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s1.c0 = v[0] + v[1] * I;
-      s->s1.c1 = v[2] + v[3] * I;
-      s->s1.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s2.c0 = v[0] + v[1] * I;
-      s->s2.c1 = v[2] + v[3] * I;
-      s->s2.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s3.c0 = v[0] + v[1] * I;
-      s->s3.c1 = v[2] + v[3] * I;
-      s->s3.c2 = v[4] + v[5] * I;
-    }
-    /* send the state fo the random-number generator to k+1 */
-    
-    j=g_proc_id+1;
-    if(j==g_nproc){
-      j=0;
-    }
-    rlxd_get(rlxd_state);
-    MPI_Send(&rlxd_state[0], 105, MPI_INT, j, 102, MPI_COMM_WORLD);
-  }
-  if(g_nproc > 1 && g_proc_id==0 && repro == 1) {
-    MPI_Recv(&rlxd_state[0], 105, MPI_INT, g_nproc-1, 102, MPI_COMM_WORLD, &status);
-    rlxd_reset(rlxd_state);
+  return;
+}
+
+/* Otherwise every chunk of RANDOM_CHUNK sites is filled from its */
+/* own philox stream, with a key drawn from ranlxd for every call. */
+void random_spinor_field(spinor * const k, const int V, const int repro) {
+
+  uint32_t key[2];
+
+  if(repro == 1) {
+    repro_spinor_field(k, V);
+    return;
   }
+
+  ranlxd_key(key);
+#ifdef OMP
+#pragma omp parallel for
 #endif
-  if(repro != 1) {
-    for (ix = 0; ix < V; ix++) {
-      s = k + ix;
-      gauss_vector(v,6);
-      s->s0.c0 = v[0] + v[1] * I;
-      s->s0.c1 = v[2] + v[3] * I;
-      s->s0.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s1.c0 = v[0] + v[1] * I;
-      s->s1.c1 = v[2] + v[3] * I;
-      s->s1.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s2.c0 = v[0] + v[1] * I;
-      s->s2.c1 = v[2] + v[3] * I;
-      s->s2.c2 = v[4] + v[5] * I;
-      gauss_vector(v,6);
-      s->s3.c0 = v[0] + v[1] * I;
-      s->s3.c1 = v[2] + v[3] * I;
-      s->s3.c2 = v[4] + v[5] * I;
+  for(int c = 0; c < (V + RANDOM_CHUNK - 1) / RANDOM_CHUNK; c++) {
+    philox_stream st;
+    const int end = ((c + 1) * RANDOM_CHUNK < V) ? (c + 1) * RANDOM_CHUNK : V;
+
+    philox_init(&st, key[0], key[1], (uint32_t)c, 0, 0);
+    for(int ix = c * RANDOM_CHUNK; ix < end; ix++) {
+      philox_gauss_vector(&st, (double*)(k + ix), 24);
     }
   }
+  return;
 }
 
-/* Function provides a zero spinor field of length N with */
+/* Z2 noise with entries (+-1 +- i)/sqrt(2), one 32 bit word per */
+/* site from the philox streams as in random_spinor_field.       */
 void z2_random_spinor_field(spinor * const k, const int N) {
 
-  int ix;
-  spinor *s;
-  double r[24];
-  double z2noise[24];
-  int rv=0;
+  const double sqr2 = 1./sqrt(2.);
+  uint32_t key[2];
 
-  s = k;
-  for (ix = 0;ix < N; ix++) {
-    ranlxd(r,24);
-
-    for (rv = 0  ; rv < 24; rv++){
-      if(r[rv] < 0.5)
-        z2noise[rv]=1/sqrt(2);
-      else
-        z2noise[rv]=-1/sqrt(2);
+  ranlxd_key(key);
+#ifdef OMP
+#pragma omp parallel for
+#endif
+  for(int c = 0; c < (N + RANDOM_CHUNK - 1) / RANDOM_CHUNK; c++) {
+    philox_stream st;
+    uint32_t w;
+    const int end = ((c + 1) * RANDOM_CHUNK < N) ? (c + 1) * RANDOM_CHUNK : N;
+
+    philox_init(&st, key[0], key[1], (uint32_t)c, 0, 0);
+    for(int ix = c * RANDOM_CHUNK; ix < end; ix++) {
+      double * const r = (double*)(k + ix);
+      philox_words(&st, &w, 1);
+      for(int rv = 0; rv < 24; rv++) {
+	r[rv] = ((w >> rv) & 1) ? -sqr2 : sqr2;
+      }
     }
-    s->s0.c0 = z2noise[0] + z2noise[1] * I;
-    s->s0.c1 = z2noise[2] + z2noise[3] * I;
-    s->s0.c2 = z2noise[4] + z2noise[5] * I;
-    s->s1.c0 = z2noise[6] + z2noise[7] * I;
-    s->s1.c1 = z2noise[8] + z2noise[9] * I;
-    s->s1.c2 = z2noise[10] + z2noise[11] * I;
-    s->s2.c0 = z2noise[12] + z2noise[13] * I;
-    s->s2.c1 = z2noise[14] + z2noise[15] * I;
-    s->s2.c2 = z2noise[16] + z2noise[17] * I;
-    s->s3.c0 = z2noise[18] + z2noise[19] * I;
-    s->s3.c1 = z2noise[20] + z2noise[21] * I;
-    s->s3.c2 = z2noise[22] + z2noise[23] * I;
-    s++;
   }
   return;
 }
@@ -451,6 +479,11 @@ void zero_spinor_field(spinor * const k, const int N)
   memset(k, 0, sizeof(spinor) * N);
 }
 
+void zero_spinor_field_32(spinor32 * const k, const int N)
+{
+  memset(k, 0, sizeof(spinor32) * N);
+}
+
 /* Function provides a constant spinor field of length N with */
 void constant_spinor_field(spinor * const k, const int p, const int N)
 {
@@ -469,18 +502,18 @@ void constant_spinor_field(spinor * const k, const int p, const int N)
 }
 
 
-su3 random_su3(void)
+static su3 random_su3_gen(uniform_gen gen, void * const state)
 {
    double norm,fact;
    _Complex double z;
    su3_vector z1,z2,z3;
    su3 u;
 
-   z1=unif_su3_vector();
+   z1=unif_su3_vector_gen(gen, state);
 
    for (;;)
    {
-      z2=unif_su3_vector();
+      z2=unif_su3_vector_gen(gen, state);
 
       z = conj(z1.c0) * z2.c0 + conj(z1.c1) * z2.c1 + conj(z1.c2) * z2.c2;
 
@@ -514,6 +547,11 @@ su3 random_su3(void)
    return(u);
 }
 
+su3 random_su3(void)
+{
+  return(random_su3_gen(ranlxd_gen, NULL));
+}
+
 
 void unit_g_gauge_field(void)
 {
@@ -534,34 +572,30 @@ void unit_g_gauge_field(void)
 void random_gauge_field(const int repro) {
 
   int ix,mu;
-#ifdef MPI
-  int rlxd_state[105];
-  int j=0;
 
-  if(g_proc_id !=0 && repro == 1) {
-    MPI_Recv(&rlxd_state[0], 105, MPI_INT, g_proc_id-1, 102, MPI_COMM_WORLD, &status);
-    rlxd_reset(rlxd_state);
-  }
+  if(repro == 1) {
+    /* counter based, independent of the process grid, see */
+    /* random_spinor_field                                  */
+    const uint32_t call = repro_calls++;
+#ifdef OMP
+#pragma omp parallel for private(mu)
 #endif
-
-  for (ix = 0; ix < VOLUME; ix++) {
-    for (mu = 0; mu < 4; mu++) {
-      g_gauge_field[ix][mu] = random_su3();
+    for (ix = 0; ix < VOLUME; ix++) {
+      philox_stream st;
+      for (mu = 0; mu < 4; mu++) {
+	philox_init(&st, repro_key[0], repro_key[1], global_site_index(ix), call, (uint32_t)mu);
+	g_gauge_field[ix][mu] = random_su3_gen(philox_gen, &st);
+      }
     }
   }
-
-#ifdef MPI
-  if(repro == 1) {
-    j = (g_proc_id + 1) % g_nproc;
-    rlxd_get(rlxd_state);
-    MPI_Send(&rlxd_state[0], 105, MPI_INT, j, 102, MPI_COMM_WORLD);
-    
-    if(g_proc_id == 0) {
-      MPI_Recv(&rlxd_state[0], 105, MPI_INT, g_nproc-1, 102, MPI_COMM_WORLD, &status);
-      rlxd_reset(rlxd_state);
+  else {
+    for (ix = 0; ix < VOLUME; ix++) {
+      for (mu = 0; mu < 4; mu++) {
+	g_gauge_field[ix][mu] = random_su3();
+      }
     }
   }
-#endif
+
   g_update_gauge_copy = 1;
   g_update_gauge_energy = 1;
   g_update_rectangle_energy = 1;
@@ -801,6 +835,7 @@ void start_ranlux(int level, int seed)
 
    rlxs_init(level-1,loc_seed);
    rlxd_init(level,loc_seed);
+   start_repro_random(seed, 0);
 }
 
 void gen_test_spinor_field(spinor * const k, const int eoflag) {
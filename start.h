@@ -20,7 +20,11 @@
 #ifndef _START_H
 #define _START_H
 
+#include "philox.h"
+
 void gauss_vector(double v[],int n);
+/* n gaussian numbers as gauss_vector, n even, from a philox stream */
+void philox_gauss_vector(philox_stream * const st, double v[], const int n);
 su3_vector random_su3_vector(void);
 su3_vector unif_su3_vector(void);
 spinor random_spinor(void);
@@ -30,6 +34,7 @@ void random_spinor_field_lexic(spinor * const k);
 void random_spinor_field(spinor * const k, const int V, const int repro);
 void z2_random_spinor_field(spinor * const k, const int N);
 void zero_spinor_field(spinor * const k, const int N);
+void zero_spinor_field_32(spinor32 * const k, const int N);
 void constant_spinor_field(spinor * const k, const int p, const int N);
 su3 random_su3(void);
 void unit_g_gauge_field(void);
@@ -41,6 +46,9 @@ su3 set_su3(const double c);
 void source_spinor_field(spinor * const P, spinor * const Q, int is, int ic);
 void source_spinor_field_point_from_file(spinor * const P, spinor * const Q, int is, int ic, int source_indx);
 void start_ranlux(int level,int seed);
+/* key of the reproducible random fields, also set by start_ranlux */
+/* with trajectory = 0                                             */
+void start_repro_random(const int seed, const int trajectory);
 
 void gen_test_spinor_field(spinor * const k , const int eoflag);
 void write_test_spinor_field(spinor * const k , const int eoflag, char * postfix);
@@ -52,11 +52,42 @@ typedef struct
     _Complex float c0,c1,c2;
 } su3_vector32;
 
+typedef struct 
+{
+   _Complex float c00, c01, c02, c10, c11, c12, c20, c21, c22;
+} su3_32;
+
+/* first two rows of an SU(3) matrix, the third row is the     */
+/* complex conjugate of their cross product                    */
+typedef struct 
+{
+   _Complex double c00, c01, c02, c10, c11, c12;
+} su3_12;
+
+typedef struct 
+{
+   _Complex float c00, c01, c02, c10, c11, c12;
+} su3_32_12;
+
+/* element type of the gauge copies read by the Dirac operator */
+#ifdef _GAUGE_COMPRESSION
+typedef su3_12 su3_copy;
+typedef su3_32_12 su3_copy_32;
+#else
+typedef su3 su3_copy;
+typedef su3_32 su3_copy_32;
+#endif
+
 typedef struct
 {
    su3_vector s0,s1,s2,s3;
 } spinor;
 
+typedef struct
+{
+   su3_vector32 s0,s1,s2,s3;
+} spinor32;
+
 typedef struct
 {
   su3_vector s0, s1;
@@ -300,6 +331,49 @@ _sse_store_up(r);
 
 #endif
 
+/*******************************************************************************
+*
+* single precision variants of the macros above which have an SSE
+* implementation. They are always plain C99 complex, since the SSE
+* macros work on doubles only.
+*
+*******************************************************************************/
+
+#define _vector_add32(r,s1,s2)		\
+  (r).c0 = (s1).c0 + (s2).c0;		\
+  (r).c1 = (s1).c1 + (s2).c1;		\
+  (r).c2 = (s1).c2 + (s2).c2;
+
+#define _vector_sub32(r,s1,s2)		\
+  (r).c0 = (s1).c0 - (s2).c0;		\
+  (r).c1 = (s1).c1 - (s2).c1;		\
+  (r).c2 = (s1).c2 - (s2).c2;
+
+#define _vector_add_assign32(r,s)		\
+  (r).c0 += (s).c0;				\
+  (r).c1 += (s).c1;				\
+  (r).c2 += (s).c2;
+
+#define _vector_sub_assign32(r,s)		\
+  (r).c0 -= (s).c0;				\
+  (r).c1 -= (s).c1;				\
+  (r).c2 -= (s).c2;
+
+#define _su3_multiply32(r,u,s)					        \
+  (r).c0 = (u).c00 * (s).c0 + (u).c01 * (s).c1 + (u).c02 * (s).c2;	\
+  (r).c1 = (u).c10 * (s).c0 + (u).c11 * (s).c1 + (u).c12 * (s).c2;	\
+  (r).c2 = (u).c20 * (s).c0 + (u).c21 * (s).c1 + (u).c22 * (s).c2;
+
+#define _su3_inverse_multiply32(r,u,s)		\
+(r).c0 = conjf((u).c00) * (s).c0 + conjf((u).c10) * (s).c1 + conjf((u).c20) * (s).c2;	\
+(r).c1 = conjf((u).c01) * (s).c0 + conjf((u).c11) * (s).c1 + conjf((u).c21) * (s).c2;	\
+(r).c2 = conjf((u).c02) * (s).c0 + conjf((u).c12) * (s).c1 + conjf((u).c22) * (s).c2;   
+
+#define _complexcjg_times_vector32(r,c,s)	\
+  (r).c0 = conjf(c) * (s).c0;			\
+  (r).c1 = conjf(c) * (s).c1;			\
+  (r).c2 = conjf(c) * (s).c2;
+
 /*******************************************************************************
 *
 * Macros for SU(3) matrices
@@ -346,6 +420,60 @@ _sse_store_up(r);
   (u).c21 = (v).c21;				\
   (u).c22 = (v).c22;
 
+/*
+ * store only the first two rows of u in c and
+ * reconstruct the third one from them
+ */
+#define _su3_compress_12(c,u)			\
+  (c).c00 = (u).c00;				\
+  (c).c01 = (u).c01;				\
+  (c).c02 = (u).c02;				\
+  (c).c10 = (u).c10;				\
+  (c).c11 = (u).c11;				\
+  (c).c12 = (u).c12;
+
+#define _su3_reconstruct_12(u,c)				\
+  (u).c00 = (c).c00;						\
+  (u).c01 = (c).c01;						\
+  (u).c02 = (c).c02;						\
+  (u).c10 = (c).c10;						\
+  (u).c11 = (c).c11;						\
+  (u).c12 = (c).c12;						\
+  (u).c20 = conj((c).c01 * (c).c12 - (c).c02 * (c).c11);	\
+  (u).c21 = conj((c).c02 * (c).c10 - (c).c00 * (c).c12);	\
+  (u).c22 = conj((c).c00 * (c).c11 - (c).c01 * (c).c10);
+
+#define _su3_reconstruct_12_32(u,c)				\
+  (u).c00 = (c).c00;						\
+  (u).c01 = (c).c01;						\
+  (u).c02 = (c).c02;						\
+  (u).c10 = (c).c10;						\
+  (u).c11 = (c).c11;						\
+  (u).c12 = (c).c12;						\
+  (u).c20 = conjf((c).c01 * (c).c12 - (c).c02 * (c).c11);	\
+  (u).c21 = conjf((c).c02 * (c).c10 - (c).c00 * (c).c12);	\
+  (u).c22 = conjf((c).c00 * (c).c11 - (c).c01 * (c).c10);
+
+/*
+ * access to a link of the gauge copies (su3_copy or su3_copy_32):
+ * _su3_copy_store writes the link u to the copy c, _su3_copy_load
+ * prepares the link c points to and _su3_copy_link(w, c) is the
+ * su3 to be used afterwards. With _GAUGE_COMPRESSION the link is
+ * reconstructed into the local su3 w, otherwise the copy is used
+ * directly and w is not touched.
+ */
+#ifdef _GAUGE_COMPRESSION
+#  define _su3_copy_store(c,u) _su3_compress_12(c,u)
+#  define _su3_copy_load(w,c) _su3_reconstruct_12(w,(*(c)))
+#  define _su3_copy_load32(w,c) _su3_reconstruct_12_32(w,(*(c)))
+#  define _su3_copy_link(w,c) (w)
+#else
+#  define _su3_copy_store(c,u) _su3_assign(c,u)
+#  define _su3_copy_load(w,c)
+#  define _su3_copy_load32(w,c)
+#  define _su3_copy_link(w,c) (*(c))
+#endif
+
 #define _su3_minus_assign(u,v)			\
   (u).c00 = -(v).c00;				\
   (u).c01 = -(v).c01;				\
@@ -0,0 +1,190 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * site fused (structure of arrays) versions of the types in su3.h
+ *
+ * SOA_W lattice sites are packed lane-wise: every real and imaginary
+ * part of a soa_spinor or soa_su3 is an array of SOA_W doubles, one
+ * per site. All macros below are plain loops over the lanes without
+ * any shuffles, they vectorise to full width with SOA_W a multiple
+ * of the SIMD width in doubles.
+ *
+ ***********************************************************************/
+
+#ifndef _SU3_SOA_H
+#define _SU3_SOA_H
+
+#ifndef SOA_W
+#  if defined AVX512
+#    define SOA_W 8
+#  else
+#    define SOA_W 4
+#  endif
+#endif
+
+typedef struct
+{
+  double re[SOA_W], im[SOA_W];
+} soa_complex;
+
+typedef struct
+{
+  soa_complex c0, c1, c2;
+} soa_su3_vector;
+
+typedef struct
+{
+  soa_su3_vector s0, s1, s2, s3;
+} soa_spinor;
+
+typedef struct
+{
+  soa_complex c00, c01, c02, c10, c11, c12, c20, c21, c22;
+} soa_su3;
+
+#define _soa_cmplx_assign(r, a)			\
+  for(int _l = 0; _l < SOA_W; _l++) {		\
+    (r).re[_l] = (a).re[_l];			\
+    (r).im[_l] = (a).im[_l];			\
+  }
+
+#define _soa_vector_assign(r, s)		\
+  _soa_cmplx_assign((r).c0, (s).c0);		\
+  _soa_cmplx_assign((r).c1, (s).c1);		\
+  _soa_cmplx_assign((r).c2, (s).c2);
+
+/* r = s1 + s2 */
+#define _soa_vector_add(r, s1, s2)				\
+  for(int _l = 0; _l < SOA_W; _l++) {				\
+    (r).c0.re[_l] = (s1).c0.re[_l] + (s2).c0.re[_l];		\
+    (r).c0.im[_l] = (s1).c0.im[_l] + (s2).c0.im[_l];		\
+    (r).c1.re[_l] = (s1).c1.re[_l] + (s2).c1.re[_l];		\
+    (r).c1.im[_l] = (s1).c1.im[_l] + (s2).c1.im[_l];		\
+    (r).c2.re[_l] = (s1).c2.re[_l] + (s2).c2.re[_l];		\
+    (r).c2.im[_l] = (s1).c2.im[_l] + (s2).c2.im[_l];		\
+  }
+
+/* r = s1 - s2 */
+#define _soa_vector_sub(r, s1, s2)				\
+  for(int _l = 0; _l < SOA_W; _l++) {				\
+    (r).c0.re[_l] = (s1).c0.re[_l] - (s2).c0.re[_l];		\
+    (r).c0.im[_l] = (s1).c0.im[_l] - (s2).c0.im[_l];		\
+    (r).c1.re[_l] = (s1).c1.re[_l] - (s2).c1.re[_l];		\
+    (r).c1.im[_l] = (s1).c1.im[_l] - (s2).c1.im[_l];		\
+    (r).c2.re[_l] = (s1).c2.re[_l] - (s2).c2.re[_l];		\
+    (r).c2.im[_l] = (s1).c2.im[_l] - (s2).c2.im[_l];		\
+  }
+
+/* r = s1 + i*s2 */
+#define _soa_vector_i_add(r, s1, s2)				\
+  for(int _l = 0; _l < SOA_W; _l++) {				\
+    (r).c0.re[_l] = (s1).c0.re[_l] - (s2).c0.im[_l];		\
+    (r).c0.im[_l] = (s1).c0.im[_l] + (s2).c0.re[_l];		\
+    (r).c1.re[_l] = (s1).c1.re[_l] - (s2).c1.im[_l];		\
+    (r).c1.im[_l] = (s1).c1.im[_l] + (s2).c1.re[_l];		\
+    (r).c2.re[_l] = (s1).c2.re[_l] - (s2).c2.im[_l];		\
+    (r).c2.im[_l] = (s1).c2.im[_l] + (s2).c2.re[_l];		\
+  }
+
+/* r = s1 - i*s2 */
+#define _soa_vector_i_sub(r, s1, s2)				\
+  for(int _l = 0; _l < SOA_W; _l++) {				\
+    (r).c0.re[_l] = (s1).c0.re[_l] + (s2).c0.im[_l];		\
+    (r).c0.im[_l] = (s1).c0.im[_l] - (s2).c0.re[_l];		\
+    (r).c1.re[_l] = (s1).c1.re[_l] + (s2).c1.im[_l];		\
+    (r).c1.im[_l] = (s1).c1.im[_l] - (s2).c1.re[_l];		\
+    (r).c2.re[_l] = (s1).c2.re[_l] + (s2).c2.im[_l];		\
+    (r).c2.im[_l] = (s1).c2.im[_l] - (s2).c2.re[_l];		\
+  }
+
+#define _soa_vector_add_assign(r, s) _soa_vector_add(r, r, s)
+#define _soa_vector_sub_assign(r, s) _soa_vector_sub(r, r, s)
+#define _soa_vector_i_add_assign(r, s) _soa_vector_i_add(r, r, s)
+#define _soa_vector_i_sub_assign(r, s) _soa_vector_i_sub(r, r, s)
+
+/* r = c*s for a complex double c, the same for all lanes */
+#define _soa_complex_times_vector(r, c, s)				\
+  {									\
+    const double _cr = creal(c), _ci = cimag(c);			\
+    for(int _l = 0; _l < SOA_W; _l++) {					\
+      (r).c0.re[_l] = _cr * (s).c0.re[_l] - _ci * (s).c0.im[_l];	\
+      (r).c0.im[_l] = _cr * (s).c0.im[_l] + _ci * (s).c0.re[_l];	\
+      (r).c1.re[_l] = _cr * (s).c1.re[_l] - _ci * (s).c1.im[_l];	\
+      (r).c1.im[_l] = _cr * (s).c1.im[_l] + _ci * (s).c1.re[_l];	\
+      (r).c2.re[_l] = _cr * (s).c2.re[_l] - _ci * (s).c2.im[_l];	\
+      (r).c2.im[_l] = _cr * (s).c2.im[_l] + _ci * (s).c2.re[_l];	\
+    }									\
+  }
+
+/* r = conj(c)*s */
+#define _soa_complexcjg_times_vector(r, c, s)	\
+  _soa_complex_times_vector(r, conj(c), s)
+
+/* r += u*s for one matrix element, lane _l */
+#define _soa_cmul_add(rr, ri, u, s)			\
+  rr += (u).re[_l] * (s).re[_l] - (u).im[_l] * (s).im[_l];	\
+  ri += (u).re[_l] * (s).im[_l] + (u).im[_l] * (s).re[_l];
+
+/* r += conj(u)*s */
+#define _soa_cjgmul_add(rr, ri, u, s)			\
+  rr += (u).re[_l] * (s).re[_l] + (u).im[_l] * (s).im[_l];	\
+  ri += (u).re[_l] * (s).im[_l] - (u).im[_l] * (s).re[_l];
+
+/* r = u*s, r and s must be different */
+#define _soa_su3_multiply(r, u, s)					\
+  for(int _l = 0; _l < SOA_W; _l++) {					\
+    double _r0r = 0., _r0i = 0., _r1r = 0., _r1i = 0., _r2r = 0., _r2i = 0.; \
+    _soa_cmul_add(_r0r, _r0i, (u).c00, (s).c0);				\
+    _soa_cmul_add(_r0r, _r0i, (u).c01, (s).c1);				\
+    _soa_cmul_add(_r0r, _r0i, (u).c02, (s).c2);				\
+    _soa_cmul_add(_r1r, _r1i, (u).c10, (s).c0);				\
+    _soa_cmul_add(_r1r, _r1i, (u).c11, (s).c1);				\
+    _soa_cmul_add(_r1r, _r1i, (u).c12, (s).c2);				\
+    _soa_cmul_add(_r2r, _r2i, (u).c20, (s).c0);				\
+    _soa_cmul_add(_r2r, _r2i, (u).c21, (s).c1);				\
+    _soa_cmul_add(_r2r, _r2i, (u).c22, (s).c2);				\
+    (r).c0.re[_l] = _r0r; (r).c0.im[_l] = _r0i;				\
+    (r).c1.re[_l] = _r1r; (r).c1.im[_l] = _r1i;				\
+    (r).c2.re[_l] = _r2r; (r).c2.im[_l] = _r2i;				\
+  }
+
+/* r = u^dagger*s, r and s must be different */
+#define _soa_su3_inverse_multiply(r, u, s)				\
+  for(int _l = 0; _l < SOA_W; _l++) {					\
+    double _r0r = 0., _r0i = 0., _r1r = 0., _r1i = 0., _r2r = 0., _r2i = 0.; \
+    _soa_cjgmul_add(_r0r, _r0i, (u).c00, (s).c0);			\
+    _soa_cjgmul_add(_r0r, _r0i, (u).c10, (s).c1);			\
+    _soa_cjgmul_add(_r0r, _r0i, (u).c20, (s).c2);			\
+    _soa_cjgmul_add(_r1r, _r1i, (u).c01, (s).c0);			\
+    _soa_cjgmul_add(_r1r, _r1i, (u).c11, (s).c1);			\
+    _soa_cjgmul_add(_r1r, _r1i, (u).c21, (s).c2);			\
+    _soa_cjgmul_add(_r2r, _r2i, (u).c02, (s).c0);			\
+    _soa_cjgmul_add(_r2r, _r2i, (u).c12, (s).c1);			\
+    _soa_cjgmul_add(_r2r, _r2i, (u).c22, (s).c2);			\
+    (r).c0.re[_l] = _r0r; (r).c0.im[_l] = _r0i;				\
+    (r).c1.re[_l] = _r1r; (r).c1.im[_l] = _r1i;				\
+    (r).c2.re[_l] = _r2r; (r).c2.im[_l] = _r2i;				\
+  }
+
+/* lane _l of a soa_complex from / to a complex double */
+#define _soa_cmplx_get(a, _l) ((a).re[_l] + I*(a).im[_l])
+#define _soa_cmplx_set(a, _l, z)		\
+  (a).re[_l] = creal(z);			\
+  (a).im[_l] = cimag(z);
+
+#endif
@@ -6,6 +6,7 @@
 #include <config.h>
 #include <complex.h>
 #include <time.h>
+#include <math.h>
 #include <cu/cu.h>
 #include "../su3.h"
 #include "../linalg_eo.h"
@@ -435,3 +436,31 @@ TEST(amadd_r) {
   etime = (double)clock()/(double)(CLOCKS_PER_SEC);
   printf("time assign_mul_add_r = %e\n", etime-atime);
 }
+
+TEST(assign_32) {
+  const int N = 1000;
+  int test = 0;
+  double snrm = 0., snrm32 = 0.;
+  double *s;
+  spinor R[N] ALIGN;
+  spinor S[N] ALIGN;
+  spinor32 S32[N] ALIGN;
+
+  for(int i = 0; i < N; i++) {
+    s = (double*)(S+i);
+    for(int j = 0; j < 24; j++) {
+      s[j] = (double)random()/(double)RAND_MAX;
+    }
+  }
+  assign_to_32(S32, S, N);
+  assign_to_64(R, S32, N);
+  snrm = square_norm(S, N, 0);
+  snrm32 = square_norm_32(S32, N, 0);
+  if(fabs(snrm - snrm32) > 1.e-6*snrm) test = 1;
+  assertFalseM(test, "square_norm_32 failed\n.");
+
+  diff(R, R, S, N);
+  snrm32 = square_norm(R, N, 0);
+  if(snrm32 > 1.e-12*snrm) test = 1;
+  assertFalseM(test, "assign_to_32/assign_to_64 failed\n.");
+}
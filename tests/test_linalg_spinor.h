@@ -8,6 +8,7 @@ TEST(snorm);
 TEST(sdiff);
 TEST(aaddm_r);
 TEST(amadd_r);
+TEST(assign_32);
 
 TEST_SUITE(LINALG){
   TEST_ADD(scalar_prod_real),
@@ -15,6 +16,7 @@ TEST_SUITE(LINALG){
     TEST_ADD(sdiff),
     TEST_ADD(aaddm_r),
     TEST_ADD(amadd_r),
+    TEST_ADD(assign_32),
     TEST_SUITE_CLOSURE
     };
 
@@ -0,0 +1,110 @@
+#define MAIN_PROGRAM
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#ifdef OMP
+# include <omp.h>
+# include "../init_omp_accumulators.h"
+#endif
+#include "../global.h"
+#include "../mpi_init.h"
+#include "../geometry_eo.h"
+#include "../boundary.h"
+#include "../start.h"
+#include "../ranlxd.h"
+#include "../init_gauge_field.h"
+#include "../init_geometry_indices.h"
+#include "../init_spinor_field.h"
+#include "../init_bispinor_field.h"
+#include "../update_backward_gauge.h"
+#ifdef MPI
+# include "../xchange_gauge.h"
+#endif
+#ifdef _USE_HALFSPINOR
+# include "../init_dirac_halfspinor.h"
+#endif
+#include "test_nd_operators.h"
+
+TEST_SUITES {
+  TEST_SUITE_ADD(ND_OPERATORS),
+  TEST_SUITES_CLOSURE
+};
+
+/* a random 8^4 lattice, the operators of the
+ * non-degenerate doublet need no input file */
+static void nd_setup(int argc, char *argv[]) {
+  T_global = 8;
+  L = LX = LY = LZ = 8;
+  N_PROC_X = N_PROC_Y = N_PROC_Z = 1;
+  g_kappa = 0.177;
+  g_mubar = 0.11;
+  g_epsbar = 0.07;
+  g_sloppy_precision_flag = 0;
+  g_sloppy_precision = 0;
+#ifdef OMP
+  omp_num_threads = 1;
+  omp_set_num_threads(omp_num_threads);
+  init_omp_accumulators(omp_num_threads);
+#endif
+  tmlqcd_mpi_init(argc, argv);
+
+#ifdef _GAUGE_COPY
+  init_gauge_field(VOLUMEPLUSRAND + g_dbw2rand, 1);
+#else
+  init_gauge_field(VOLUMEPLUSRAND + g_dbw2rand, 0);
+#endif
+  init_geometry_indices(VOLUMEPLUSRAND + g_dbw2rand);
+  DUM_DERI = 0;
+  DUM_SOLVER = 0;
+  DUM_MATRIX = 16;
+  NO_OF_SPINORFIELDS = DUM_MATRIX + 8;
+  if(init_spinor_field(VOLUMEPLUSRAND/2, NO_OF_SPINORFIELDS) != 0 ||
+     init_bispinor_field(VOLUMEPLUSRAND/2, 2) != 0) {
+    fprintf(stderr, "Not enough memory for spinor fields! Aborting...\n");
+    exit(-1);
+  }
+  geometry();
+  boundary(g_kappa);
+#ifdef _USE_HALFSPINOR
+  if(init_dirac_halfspinor() != 0) {
+    fprintf(stderr, "Not enough memory for halfspinor fields! Aborting...\n");
+    exit(-1);
+  }
+#endif
+
+  rlxd_init(1, 123456 + g_proc_id);
+  random_gauge_field(0);
+#ifdef MPI
+  xchange_gauge(g_gauge_field);
+#endif
+#ifdef _GAUGE_COPY
+  update_backward_gauge(g_gauge_field);
+#endif
+}
+
+int main(int argc,char *argv[]){
+#ifdef MPI
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &g_proc_id);
+#else
+  g_proc_id = 0;
+#endif
+  nd_setup(argc, argv);
+
+  CU_SET_OUT_PREFIX("regressions/");
+  CU_RUN(argc,argv);
+
+#ifdef MPI
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
+
+#undef MAIN_PROGRAM
@@ -0,0 +1,241 @@
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <cu/cu.h>
+#include "../global.h"
+#include "../su3.h"
+#include "../start.h"
+#include "../gamma.h"
+#include "../phmc.h"
+#include "../linalg_eo.h"
+#include "../linalg/comp_decomp.h"
+#include "../Hopping_Matrix.h"
+#include "../Hopping_Matrix_nrhs.h"
+#include "../Nondegenerate_Matrix.h"
+#ifdef _USE_HALFSPINOR
+# include "../init_dirac_halfspinor.h"
+#endif
+
+#define EPS 1e-14
+
+/* fields of the tests: input k, result l of the operator */
+/* under test, reference result r and work fields t       */
+#define ND_KS 0
+#define ND_KC 1
+#define ND_LS 2
+#define ND_LC 3
+#define ND_RS 4
+#define ND_RC 5
+#define ND_T 6
+
+/* The reference operators are the per flavour implementations */
+/* of Nondegenerate_Matrix.c before the doublet was stored     */
+/* interleaved, built from one Hopping_Matrix per flavour.     */
+
+static double ref_nrm() {
+  return(1./(1.+g_mubar*g_mubar-g_epsbar*g_epsbar));
+}
+
+/* (M_ee)^-1 of the doublet */
+static void ref_mee_inv(spinor * const l_strange, spinor * const l_charm,
+                        spinor * const k_strange, spinor * const k_charm) {
+  mul_one_minus_imubar(l_strange, k_strange);
+  mul_one_plus_imubar(l_charm, k_charm);
+  assign_add_mul_r(l_strange, k_charm, g_epsbar, VOLUME/2);
+  assign_add_mul_r(l_charm, k_strange, g_epsbar, VOLUME/2);
+  mul_r(l_strange, ref_nrm(), l_strange, VOLUME/2);
+  mul_r(l_charm, ref_nrm(), l_charm, VOLUME/2);
+}
+
+/* M_oo of the doublet */
+static void ref_moo(spinor * const l_strange, spinor * const l_charm,
+                    spinor * const k_strange, spinor * const k_charm) {
+  mul_one_plus_imubar(l_strange, k_strange);
+  mul_one_minus_imubar(l_charm, k_charm);
+  assign_add_mul_r(l_strange, k_charm, -g_epsbar, VOLUME/2);
+  assign_add_mul_r(l_charm, k_strange, -g_epsbar, VOLUME/2);
+}
+
+/* QNon_degenerate */
+static void ref_q(spinor * const l_strange, spinor * const l_charm,
+                  spinor * const k_strange, spinor * const k_charm) {
+  spinor ** const t = g_spinor_field + ND_T;
+
+  Hopping_Matrix(EO, t[0], k_strange);
+  Hopping_Matrix(EO, t[1], k_charm);
+  ref_mee_inv(t[2], t[3], t[0], t[1]);
+  Hopping_Matrix(OE, t[0], t[2]);
+  Hopping_Matrix(OE, t[1], t[3]);
+  ref_moo(t[2], t[3], k_strange, k_charm);
+  diff(l_strange, t[2], t[0], VOLUME/2);
+  diff(l_charm, t[3], t[1], VOLUME/2);
+  gamma5(l_strange, l_strange, VOLUME/2);
+  gamma5(l_charm, l_charm, VOLUME/2);
+  mul_r(l_strange, phmc_invmaxev, l_strange, VOLUME/2);
+  mul_r(l_charm, phmc_invmaxev, l_charm, VOLUME/2);
+}
+
+/* Qdagger = tau_1 Q tau_1 */
+static void ref_qdagger(spinor * const l_strange, spinor * const l_charm,
+                        spinor * const k_strange, spinor * const k_charm) {
+  ref_q(l_charm, l_strange, k_charm, k_strange);
+}
+
+static void ref_q_qdagger(spinor * const l_strange, spinor * const l_charm,
+                          spinor * const k_strange, spinor * const k_charm) {
+  spinor ** const t = g_spinor_field + ND_T;
+
+  ref_qdagger(t[4], t[5], k_strange, k_charm);
+  ref_q(l_strange, l_charm, t[4], t[5]);
+}
+
+/* random input doublet and parameters */
+static void nd_prepare() {
+  g_mubar = 0.11;
+  g_epsbar = 0.07;
+  phmc_invmaxev = 0.93;
+  phmc_Cpol = 1.27;
+  random_spinor_field(g_spinor_field[ND_KS], VOLUME/2, 0);
+  random_spinor_field(g_spinor_field[ND_KC], VOLUME/2, 0);
+}
+
+/* relative deviation of l from r */
+static double nd_deviation(spinor * const l, spinor * const r) {
+  spinor * const d = g_spinor_field[ND_T + 6];
+
+  diff(d, l, r, VOLUME/2);
+  return(sqrt(square_norm(d, VOLUME/2, 1) / square_norm(r, VOLUME/2, 1)));
+}
+
+static int nd_check() {
+  return(nd_deviation(g_spinor_field[ND_LS], g_spinor_field[ND_RS]) > EPS ||
+         nd_deviation(g_spinor_field[ND_LC], g_spinor_field[ND_RC]) > EPS);
+}
+
+TEST(nd_qnon_degenerate) {
+  spinor ** const f = g_spinor_field;
+
+  nd_prepare();
+  QNon_degenerate(f[ND_LS], f[ND_LC], f[ND_KS], f[ND_KC]);
+  ref_q(f[ND_RS], f[ND_RC], f[ND_KS], f[ND_KC]);
+  assertFalseM(nd_check(), "QNon_degenerate differs from the per flavour operator\n");
+}
+
+TEST(nd_qdagger_non_degenerate) {
+  spinor ** const f = g_spinor_field;
+
+  nd_prepare();
+  QdaggerNon_degenerate(f[ND_LS], f[ND_LC], f[ND_KS], f[ND_KC]);
+  ref_qdagger(f[ND_RS], f[ND_RC], f[ND_KS], f[ND_KC]);
+  assertFalseM(nd_check(), "QdaggerNon_degenerate differs from the per flavour operator\n");
+}
+
+TEST(nd_q_qdagger) {
+  spinor ** const f = g_spinor_field;
+
+  nd_prepare();
+  Q_Qdagger_ND(f[ND_LS], f[ND_LC], f[ND_KS], f[ND_KC]);
+  ref_q_qdagger(f[ND_RS], f[ND_RC], f[ND_KS], f[ND_KC]);
+  assertFalseM(nd_check(), "Q_Qdagger_ND differs from the per flavour operator\n");
+}
+
+TEST(nd_q_tau1_min_cconst) {
+  spinor ** const f = g_spinor_field;
+  const _Complex double z = 0.31 - 0.17*I;
+
+  nd_prepare();
+  Q_tau1_min_cconst_ND(f[ND_LS], f[ND_LC], f[ND_KS], f[ND_KC], z);
+  ref_q(f[ND_RS], f[ND_RC], f[ND_KC], f[ND_KS]);
+  assign_add_mul(f[ND_RS], f[ND_KS], -z, VOLUME/2);
+  assign_add_mul(f[ND_RC], f[ND_KC], -z, VOLUME/2);
+  mul_r(f[ND_RS], phmc_Cpol, f[ND_RS], VOLUME/2);
+  mul_r(f[ND_RC], phmc_Cpol, f[ND_RC], VOLUME/2);
+  assertFalseM(nd_check(), "Q_tau1_min_cconst_ND differs from the per flavour operator\n");
+}
+
+TEST(nd_q_qdagger_bi) {
+  spinor ** const f = g_spinor_field;
+
+  nd_prepare();
+  compact(g_bispinor_field[0], f[ND_KS], f[ND_KC]);
+  Q_Qdagger_ND_BI(g_bispinor_field[1], g_bispinor_field[0]);
+  decompact(f[ND_LS], f[ND_LC], g_bispinor_field[1]);
+  ref_q_qdagger(f[ND_RS], f[ND_RC], f[ND_KS], f[ND_KC]);
+  assertFalseM(nd_check(), "Q_Qdagger_ND_BI differs from the per flavour operator\n");
+}
+
+TEST(nd_h_eo) {
+  spinor ** const f = g_spinor_field;
+  spinor ** const t = g_spinor_field + ND_T;
+  int test = 0;
+
+  nd_prepare();
+  for(int ieo = 0; ieo < 2; ieo++) {
+    H_eo_ND(f[ND_LS], f[ND_LC], f[ND_KS], f[ND_KC], ieo);
+    Hopping_Matrix(ieo, t[0], f[ND_KS]);
+    Hopping_Matrix(ieo, t[1], f[ND_KC]);
+    ref_mee_inv(f[ND_RS], f[ND_RC], t[1], t[0]);
+    test += nd_check();
+  }
+  assertFalseM(test, "H_eo_ND differs from the per flavour operator\n");
+}
+
+/* H = \hat Q tau_1 of the rational monomial, unscaled with phmc_Cpol = 1 */
+TEST(nd_h_squared) {
+  spinor ** const f = g_spinor_field;
+  spinor ** const t = g_spinor_field + ND_T;
+
+  nd_prepare();
+  phmc_Cpol = 1.;
+  Q_tau1_min_cconst_ND(t[0], t[1], f[ND_KS], f[ND_KC], 0.);
+  Q_tau1_min_cconst_ND(f[ND_LS], f[ND_LC], t[0], t[1], 0.);
+  Q_Qdagger_ND(f[ND_RS], f[ND_RC], f[ND_KS], f[ND_KC]);
+  assertFalseM(nd_check(), "H^2 differs from Q_Qdagger_ND\n");
+}
+
+TEST(nd_h_hermitian) {
+  spinor ** const f = g_spinor_field;
+  spinor ** const t = g_spinor_field + ND_T;
+  _Complex double ahb, hab;
+
+  nd_prepare();
+  phmc_Cpol = 1.;
+  random_spinor_field(t[2], VOLUME/2, 0);
+  random_spinor_field(t[3], VOLUME/2, 0);
+  /* <a, H k> and <H a, k> */
+  Q_tau1_min_cconst_ND(t[0], t[1], f[ND_KS], f[ND_KC], 0.);
+  ahb = scalar_prod(t[2], t[0], VOLUME/2, 1) + scalar_prod(t[3], t[1], VOLUME/2, 1);
+  Q_tau1_min_cconst_ND(t[0], t[1], t[2], t[3], 0.);
+  hab = scalar_prod(t[0], f[ND_KS], VOLUME/2, 1) + scalar_prod(t[1], f[ND_KC], VOLUME/2, 1);
+  assertFalseM(cabs(ahb - hab) > EPS*cabs(ahb), "H = Q tau_1 is not hermitian\n");
+}
+
+/* the 32 bit halfspinors of Hopping_Matrix_nrhs against */
+/* those of Hopping_Matrix applied to every field        */
+TEST(nd_hopping_nrhs_sloppy) {
+  spinor ** const f = g_spinor_field;
+  spinor * const in = (spinor*)g_bispinor_field[0];
+  spinor * const out = (spinor*)g_bispinor_field[1];
+
+  nd_prepare();
+#ifdef _USE_HALFSPINOR
+  if(init_dirac_halfspinor32() != 0) {
+    fprintf(stderr, "Not enough memory for 32-Bit halfspinor fields! Aborting...\n");
+    exit(-1);
+  }
+#endif
+  g_sloppy_precision_flag = 1;
+  g_sloppy_precision = 1;
+  spinor_fields_to_nrhs(in, f + ND_KS, 2, VOLUME/2);
+  Hopping_Matrix_nrhs(EO, out, in, 2);
+  nrhs_to_spinor_fields(f + ND_LS, out, 2, VOLUME/2);
+  Hopping_Matrix(EO, f[ND_RS], f[ND_KS]);
+  Hopping_Matrix(EO, f[ND_RC], f[ND_KC]);
+  g_sloppy_precision = 0;
+  g_sloppy_precision_flag = 0;
+  assertFalseM(nd_check(), "Hopping_Matrix_nrhs differs from Hopping_Matrix in 32 bit\n");
+}
@@ -0,0 +1,29 @@
+#ifndef _TEST_ND_OPERATORS_H
+#define _TEST_ND_OPERATORS_H
+
+#include <cu/cu.h>
+
+TEST(nd_qnon_degenerate);
+TEST(nd_qdagger_non_degenerate);
+TEST(nd_q_qdagger);
+TEST(nd_q_tau1_min_cconst);
+TEST(nd_q_qdagger_bi);
+TEST(nd_h_eo);
+TEST(nd_h_squared);
+TEST(nd_h_hermitian);
+TEST(nd_hopping_nrhs_sloppy);
+
+TEST_SUITE(ND_OPERATORS){
+  TEST_ADD(nd_qnon_degenerate),
+    TEST_ADD(nd_qdagger_non_degenerate),
+    TEST_ADD(nd_q_qdagger),
+    TEST_ADD(nd_q_tau1_min_cconst),
+    TEST_ADD(nd_q_qdagger_bi),
+    TEST_ADD(nd_h_eo),
+    TEST_ADD(nd_h_squared),
+    TEST_ADD(nd_h_hermitian),
+    TEST_ADD(nd_hopping_nrhs_sloppy),
+    TEST_SUITE_CLOSURE
+    };
+
+#endif
@@ -0,0 +1,444 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * fused versions of Qtm_pm_psi, Qtm_pm_sym_psi and Qsw_pm_psi
+ *
+ * The four hopping matrix applications of Q_+ Q_- are done in one
+ * sweep over the time slices of the lattice. Stage j (j=1..4) is the
+ * j-th hopping matrix together with the site local part following it
+ * (twisted mass or clover term). In step s stage j works on the time
+ * slice t = s-j+1, so that stage j+1 finds the three time slices
+ * t-1, t, t+1 of its input already computed by stage j. The
+ * intermediate fields are only kept in ring buffers of three time
+ * slices each, which stay in cache for reasonable spatial volumes,
+ * instead of being written to and read back from memory.
+ *
+ * Time slices are counted unwrapped, stage j starts at t=j-4 and the
+ * slice t=0 of every intermediate field is kept separately, because
+ * it is needed again as t=T at the end of the sweep. The redundant
+ * work are six time slices of hopping matrix per application.
+ *
+ * This relies on the even (odd) sites of every time slice forming a
+ * contiguous range of even (odd) indices, which is the case for a
+ * single process only.
+ *
+ ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include "global.h"
+#include "su3.h"
+#include "boundary.h"
+#include "clover.h"
+#include "tiled_operators.h"
+
+#define TILED_TM 0
+#define TILED_TM_SYM 1
+#define TILED_SW 2
+
+/* 0 switches the tiled operators off at runtime */
+int g_tiled_operators = 1;
+
+/* 1: ready, -1: not available, 0: not yet checked */
+static int tiled_status = 0;
+/* number of even (odd) sites per time slice */
+static int tiled_slab = 0;
+static spinor * tiled_buffer_ = NULL;
+/* three ring buffer slabs plus the t=0 slab for each of the three
+   intermediate fields */
+static spinor * tiled_ring[3][4];
+/* lexicographic index and the eight neighbours (even/odd sub index)
+   of every even/odd site, in the order +t,-t,+x,-x,+y,-y,+z,-z */
+static int * tiled_site = NULL;
+
+int init_tiled_operators() {
+  spinor * buffer;
+
+  if(tiled_status != 0) {
+    return((tiled_status == 1) ? 0 : -1);
+  }
+  tiled_status = -1;
+  if(g_nproc != 1 || (LX*LY*LZ) % 2 != 0) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "The tiled operators are only available for a single process with even spatial volume\n");
+    }
+    return(-1);
+  }
+  tiled_slab = LX*LY*LZ/2;
+  for(int t = 0; t < T; t++) {
+    for(int x = 0; x < LX; x++) {
+      for(int y = 0; y < LY; y++) {
+	for(int z = 0; z < LZ; z++) {
+	  const int sub = g_lexic2eosub[ g_ipt[t][x][y][z] ];
+	  if(sub < 0 || sub >= VOLUME/2 || sub/tiled_slab != t) {
+	    if(g_proc_id == 0) {
+	      fprintf(stderr, "The even/odd ordering does not allow for the tiled operators\n");
+	    }
+	    return(-1);
+	  }
+	}
+      }
+    }
+  }
+
+  tiled_buffer_ = (spinor*)calloc(12*tiled_slab+1, sizeof(spinor));
+  tiled_site = (int*)malloc(9*VOLUME*sizeof(int));
+  if(tiled_buffer_ == NULL || tiled_site == NULL) {
+    free_tiled_operators();
+    tiled_status = -1;
+    fprintf(stderr, "Could not allocate memory for the tiled operators\n");
+    return(-1);
+  }
+  buffer = (spinor*)(((unsigned long int)(tiled_buffer_)+ALIGN_BASE)&~ALIGN_BASE);
+  for(int j = 0; j < 3; j++) {
+    for(int i = 0; i < 4; i++) {
+      tiled_ring[j][i] = buffer + (4*j + i)*tiled_slab;
+    }
+  }
+  for(int ieo = 0; ieo < 2; ieo++) {
+    for(int i = 0; i < VOLUME/2; i++) {
+      const int ix = g_eo2lexic[ieo*(VOLUME+RAND)/2 + i];
+      int * const st = tiled_site + 9*(ieo*VOLUME/2 + i);
+      st[0] = ix;
+      for(int mu = 0; mu < 4; mu++) {
+	st[1+2*mu] = g_lexic2eosub[ g_iup[ix][mu] ];
+	st[2+2*mu] = g_lexic2eosub[ g_idn[ix][mu] ];
+      }
+    }
+  }
+  tiled_status = 1;
+  return(0);
+}
+
+void free_tiled_operators() {
+  free(tiled_buffer_);
+  free(tiled_site);
+  tiled_buffer_ = NULL;
+  tiled_site = NULL;
+  tiled_status = 0;
+}
+
+static inline int tiled_phys(const int u) {
+  return(((u % T) + T) % T);
+}
+
+/* output slab of stage j+1 for unwrapped time slice u */
+static inline spinor * tiled_buf(const int j, const int u) {
+  if(u == 0 || u == T) return(tiled_ring[j][3]);
+  return(tiled_ring[j][((u % 3) + 3) % 3]);
+}
+
+/* r = H k at site st, the neighbours in time slice t-1, t, t+1 are
+   found in in[0], in[1], in[2] shifted by off[] */
+static inline void tiled_hop(spinor * const r, const int * const st,
+			     spinor * const * const in, const int * const off) {
+  const int ix = st[0];
+  su3_vector ALIGN psi, chi;
+  const spinor * s;
+  const su3 * u;
+
+  /* +t */
+  s = in[2] + st[1] - off[2];
+  u = &g_gauge_field[ix][0];
+  _vector_add(psi, s->s0, s->s2);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka0, chi);
+  _vector_assign(r->s0, psi);
+  _vector_assign(r->s2, psi);
+  _vector_add(psi, s->s1, s->s3);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka0, chi);
+  _vector_assign(r->s1, psi);
+  _vector_assign(r->s3, psi);
+
+  /* -t */
+  s = in[0] + st[2] - off[0];
+  u = &g_gauge_field[ g_idn[ix][0] ][0];
+  _vector_sub(psi, s->s0, s->s2);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka0, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_sub_assign(r->s2, psi);
+  _vector_sub(psi, s->s1, s->s3);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka0, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_sub_assign(r->s3, psi);
+
+  /* +x */
+  s = in[1] + st[3] - off[1];
+  u = &g_gauge_field[ix][1];
+  _vector_i_add(psi, s->s0, s->s3);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka1, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_i_sub_assign(r->s3, psi);
+  _vector_i_add(psi, s->s1, s->s2);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka1, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_i_sub_assign(r->s2, psi);
+
+  /* -x */
+  s = in[1] + st[4] - off[1];
+  u = &g_gauge_field[ g_idn[ix][1] ][1];
+  _vector_i_sub(psi, s->s0, s->s3);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka1, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_i_add_assign(r->s3, psi);
+  _vector_i_sub(psi, s->s1, s->s2);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka1, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_i_add_assign(r->s2, psi);
+
+  /* +y */
+  s = in[1] + st[5] - off[1];
+  u = &g_gauge_field[ix][2];
+  _vector_add(psi, s->s0, s->s3);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka2, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_add_assign(r->s3, psi);
+  _vector_sub(psi, s->s1, s->s2);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka2, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_sub_assign(r->s2, psi);
+
+  /* -y */
+  s = in[1] + st[6] - off[1];
+  u = &g_gauge_field[ g_idn[ix][2] ][2];
+  _vector_sub(psi, s->s0, s->s3);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka2, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_sub_assign(r->s3, psi);
+  _vector_add(psi, s->s1, s->s2);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka2, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_add_assign(r->s2, psi);
+
+  /* +z */
+  s = in[1] + st[7] - off[1];
+  u = &g_gauge_field[ix][3];
+  _vector_i_add(psi, s->s0, s->s2);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka3, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_i_sub_assign(r->s2, psi);
+  _vector_i_sub(psi, s->s1, s->s3);
+  _su3_multiply(chi, (*u), psi);
+  _complex_times_vector(psi, ka3, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_i_add_assign(r->s3, psi);
+
+  /* -z */
+  s = in[1] + st[8] - off[1];
+  u = &g_gauge_field[ g_idn[ix][3] ][3];
+  _vector_i_sub(psi, s->s0, s->s2);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka3, chi);
+  _vector_add_assign(r->s0, psi);
+  _vector_i_add_assign(r->s2, psi);
+  _vector_i_add(psi, s->s1, s->s3);
+  _su3_inverse_multiply(chi, (*u), psi);
+  _complexcjg_times_vector(psi, ka3, chi);
+  _vector_add_assign(r->s1, psi);
+  _vector_i_sub_assign(r->s3, psi);
+}
+
+/* r = (1 -+ i mu gamma5)^{-1} t with z the upper component factor */
+static inline void tiled_tm_inv(spinor * const r, const spinor * const t, const _Complex double z) {
+  _complex_times_vector(r->s0, z, t->s0);
+  _complex_times_vector(r->s1, z, t->s1);
+  _complexcjg_times_vector(r->s2, z, t->s2);
+  _complexcjg_times_vector(r->s3, z, t->s3);
+}
+
+/* r = sw_inv[icy] t */
+static inline void tiled_sw_inv(spinor * const r, const spinor * const t, const int icy) {
+  su3_vector ALIGN psi, chi;
+  const su3 *w1, *w2, *w3, *w4;
+
+  w1 = &sw_inv[icy][0][0];
+  w2 = w1+2;
+  w3 = w1+4;
+  w4 = w1+6;
+  _su3_multiply(psi, *w1, t->s0);
+  _su3_multiply(chi, *w2, t->s1);
+  _vector_add(r->s0, psi, chi);
+  _su3_multiply(psi, *w4, t->s0);
+  _su3_multiply(chi, *w3, t->s1);
+  _vector_add(r->s1, psi, chi);
+
+  w1++;
+  w2++;
+  w3++;
+  w4++;
+  _su3_multiply(psi, *w1, t->s2);
+  _su3_multiply(chi, *w2, t->s3);
+  _vector_add(r->s2, psi, chi);
+  _su3_multiply(psi, *w4, t->s2);
+  _su3_multiply(chi, *w3, t->s3);
+  _vector_add(r->s3, psi, chi);
+}
+
+/* r = gamma5 ((sw[ix] + i mu gamma5) p - t) as in clover_gamma5 */
+static inline void tiled_sw_gamma5(spinor * const r, const spinor * const p, const spinor * const t,
+				   const int ix, const double mu) {
+  su3_vector ALIGN chi, psi1, psi2;
+  const su3 *w1, *w2, *w3;
+
+  w1 = &sw[ix][0][0];
+  w2 = w1+2;
+  w3 = w1+4;
+  _su3_multiply(psi1, *w1, p->s0);
+  _su3_multiply(chi, *w2, p->s1);
+  _vector_add_assign(psi1, chi);
+  _su3_inverse_multiply(psi2, *w2, p->s0);
+  _su3_multiply(chi, *w3, p->s1);
+  _vector_add_assign(psi2, chi);
+  _vector_add_i_mul(psi1, mu, p->s0);
+  _vector_add_i_mul(psi2, mu, p->s1);
+  _vector_sub(r->s0, psi1, t->s0);
+  _vector_sub(r->s1, psi2, t->s1);
+
+  w1++;
+  w2++;
+  w3++;
+  _su3_multiply(psi1, *w1, p->s2);
+  _su3_multiply(chi, *w2, p->s3);
+  _vector_add_assign(psi1, chi);
+  _su3_inverse_multiply(psi2, *w2, p->s2);
+  _su3_multiply(chi, *w3, p->s3);
+  _vector_add_assign(psi2, chi);
+  _vector_add_i_mul(psi1, -mu, p->s2);
+  _vector_add_i_mul(psi2, -mu, p->s3);
+  _vector_sub(r->s2, t->s2, psi1);
+  _vector_sub(r->s3, t->s3, psi2);
+}
+
+/* stage j (1..4) of operator op for the unwrapped time slice u,
+   must be called by all threads of a parallel region */
+static void tiled_stage(const int op, const int j, const int u,
+			spinor * const l, spinor * const k) {
+  const int S = tiled_slab;
+  const int pt = tiled_phys(u);
+  /* j = 1, 2 is Q_-, j = 3, 4 is Q_+ */
+  const double sign = (j < 3) ? -1. : 1.;
+  const double nrm = 1./(1.+g_mu*g_mu);
+  const _Complex double zinv = nrm - sign*nrm*g_mu*I;
+  const _Complex double z = 1. + sign*g_mu*I;
+  const double mu = sign*(g_mu + g_mu3);
+  const int ioff = (j % 2 == 1) ? 0 : VOLUME/2;
+  const int swoff = (sign*g_mu < 0) ? VOLUME/2 : 0;
+  spinor * in[3], * out, * p = NULL;
+  int off[3];
+
+  for(int d = 0; d < 3; d++) {
+    if(j == 1) {
+      in[d] = k;
+      off[d] = 0;
+    }
+    else {
+      in[d] = tiled_buf(j-2, u-1+d);
+      off[d] = tiled_phys(u-1+d)*S;
+    }
+  }
+  out = (j == 4) ? l + pt*S : tiled_buf(j-1, u);
+  if(j == 2) p = k + pt*S;
+  else if(j == 4) p = tiled_buf(1, u);
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(int i = 0; i < S; i++) {
+    spinor ALIGN temp, h;
+    const int * const st = tiled_site + 9*(ioff + pt*S + i);
+
+    tiled_hop(&temp, st, in, off);
+    if(j % 2 == 1) {
+      if(op == TILED_SW) {
+	tiled_sw_inv(out + i, &temp, swoff + pt*S + i);
+      }
+      else {
+	tiled_tm_inv(out + i, &temp, zinv);
+      }
+    }
+    else if(op == TILED_TM) {
+      _complex_times_vector(h.s0, z, p[i].s0);
+      _vector_sub(out[i].s0, h.s0, temp.s0);
+      _complex_times_vector(h.s1, z, p[i].s1);
+      _vector_sub(out[i].s1, h.s1, temp.s1);
+      _complexcjg_times_vector(h.s2, z, p[i].s2);
+      _vector_sub(out[i].s2, temp.s2, h.s2);
+      _complexcjg_times_vector(h.s3, z, p[i].s3);
+      _vector_sub(out[i].s3, temp.s3, h.s3);
+    }
+    else if(op == TILED_TM_SYM) {
+      tiled_tm_inv(&h, &temp, zinv);
+      _vector_sub(out[i].s0, p[i].s0, h.s0);
+      _vector_sub(out[i].s1, p[i].s1, h.s1);
+      _vector_sub(out[i].s2, h.s2, p[i].s2);
+      _vector_sub(out[i].s3, h.s3, p[i].s3);
+    }
+    else {
+      tiled_sw_gamma5(out + i, p + i, &temp, st[0], mu);
+    }
+  }
+}
+
+static void tiled_pm_psi(const int op, spinor * const l, spinor * const k) {
+  /* the four hopping matrices of the fused sweep */
+  g_hopping_count += 4;
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  for(int s = -3; s < T+3; s++) {
+    for(int j = 1; j < 5; j++) {
+      const int u = s-j+1;
+      if(u >= j-4 && u < T) {
+	tiled_stage(op, j, u, l, k);
+      }
+    }
+  }
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+  return;
+}
+
+void Qtm_pm_psi_tiled(spinor * const l, spinor * const k) {
+  tiled_pm_psi(TILED_TM, l, k);
+}
+
+void Qtm_pm_sym_psi_tiled(spinor * const l, spinor * const k) {
+  tiled_pm_psi(TILED_TM_SYM, l, k);
+}
+
+void Qsw_pm_psi_tiled(spinor * const l, spinor * const k) {
+  tiled_pm_psi(TILED_SW, l, k);
+}
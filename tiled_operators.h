@@ -0,0 +1,38 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _TILED_OPERATORS_H
+#define _TILED_OPERATORS_H
+
+#include "su3.h"
+
+/* with _TILED_OPERATORS the operators below are used by */
+/* Qtm_pm_psi, Qtm_pm_sym_psi and Qsw_pm_psi if this is 1  */
+extern int g_tiled_operators;
+
+/* returns 0 if the tiled operators can be used, -1 otherwise */
+int init_tiled_operators();
+void free_tiled_operators();
+
+/* l = Q_+ Q_- k, l and k must be different fields */
+void Qtm_pm_psi_tiled(spinor * const l, spinor * const k);
+void Qtm_pm_sym_psi_tiled(spinor * const l, spinor * const k);
+void Qsw_pm_psi_tiled(spinor * const l, spinor * const k);
+
+#endif
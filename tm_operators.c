@@ -33,6 +33,7 @@
 #include "su3.h"
 #include "Hopping_Matrix.h"
 #include "Hopping_Matrix_nocom.h"
+#include "Hopping_Matrix_nrhs.h"
 #include "tm_times_Hopping_Matrix.h"
 #include "tm_sub_Hopping_Matrix.h"
 #include "sse.h"
@@ -49,6 +50,7 @@
 #include "solver/dirac_operator_eigenvectors.h"
 
 #include "tm_operators.h"
+#include "tiled_operators.h"
 
 #if (defined SSE2 || defined SSE3 || defined BGL)
 const int predist=2;
@@ -307,6 +309,12 @@ void Mtm_minus_sym_psi_nocom(spinor * const l, spinor * const k) {
  * on a half spinor
  ******************************************/
 void Qtm_pm_psi(spinor * const l, spinor * const k){
+#if (defined _TILED_OPERATORS && !defined MPI)
+  if(g_tiled_operators && l != k && init_tiled_operators() == 0) {
+    Qtm_pm_psi_tiled(l, k);
+    return;
+  }
+#endif
   /* Q_{-} */
   H_eo_tm_inv_psi(g_spinor_field[DUM_MATRIX+1], k, EO, -1);
   tm_sub_H_eo_gamma5(g_spinor_field[DUM_MATRIX], k, g_spinor_field[DUM_MATRIX+1], OE, -1);
@@ -316,22 +324,25 @@ void Qtm_pm_psi(spinor * const l, spinor * const k){
 }
 
 void Qtm_pm_sym_psi(spinor * const l, spinor * const k){
+#if (defined _TILED_OPERATORS && !defined MPI)
+  if(g_tiled_operators && l != k && init_tiled_operators() == 0) {
+    Qtm_pm_sym_psi_tiled(l, k);
+    return;
+  }
+#endif
   /* Q_{-} */
   Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], k);
   mul_one_pm_imu_inv(g_spinor_field[DUM_MATRIX+1], -1., VOLUME/2);
   Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+1]);
   mul_one_pm_imu_inv(g_spinor_field[DUM_MATRIX], -1., VOLUME/2);
-  diff(l, k, g_spinor_field[DUM_MATRIX], VOLUME/2);
-  gamma5(l, l, VOLUME/2);
+  mul_one_sub_mul_gamma5(g_spinor_field[DUM_MATRIX], k, g_spinor_field[DUM_MATRIX]);
 
   /* Q_{+} */
-  Hopping_Matrix(EO, l, g_spinor_field[DUM_MATRIX]);
+  Hopping_Matrix(EO, g_spinor_field[DUM_MATRIX+1], g_spinor_field[DUM_MATRIX]);
+  mul_one_pm_imu_inv(g_spinor_field[DUM_MATRIX+1], +1., VOLUME/2);
+  Hopping_Matrix(OE, l, g_spinor_field[DUM_MATRIX+1]);
   mul_one_pm_imu_inv(l, +1., VOLUME/2);
-  Hopping_Matrix(OE, g_spinor_field[DUM_MATRIX+1], l);
-  mul_one_pm_imu_inv(g_spinor_field[DUM_MATRIX], +1., VOLUME/2);
-  diff(l, k, g_spinor_field[DUM_MATRIX], VOLUME/2);
-  gamma5(l, l, VOLUME/2);
-
+  mul_one_sub_mul_gamma5(l, g_spinor_field[DUM_MATRIX], l);
 }
 
 void Qtm_pm_psi_nocom(spinor * const l, spinor * const k){
@@ -347,6 +358,67 @@ void Qtm_pm_psi_nocom(spinor * const l, spinor * const k){
   mul_one_pm_imu_sub_mul_gamma5(l, g_spinor_field[DUM_MATRIX], g_spinor_field[DUM_MATRIX+1], +1.);
 }
 
+/* interleaved work fields of Qtm_pm_psi_nrhs for up to nrhs_work_size fields */
+static spinor * nrhs_work_ = NULL;
+static spinor * nrhs_work[3];
+static int nrhs_work_size = 0;
+
+static void init_nrhs_work(const int nrhs) {
+  if(nrhs > nrhs_work_size) {
+    free(nrhs_work_);
+    if((void*)(nrhs_work_ = (spinor*)calloc(3*nrhs*(VOLUMEPLUSRAND/2)+1, sizeof(spinor))) == NULL) {
+      fprintf(stderr, "Not enough memory for the work fields of Qtm_pm_psi_nrhs! Aborting...\n");
+      exit(-1);
+    }
+    nrhs_work[0] = (spinor*)(((unsigned long int)(nrhs_work_)+ALIGN_BASE)&~ALIGN_BASE);
+    nrhs_work[1] = nrhs_work[0] + nrhs*(VOLUMEPLUSRAND/2);
+    nrhs_work[2] = nrhs_work[1] + nrhs*(VOLUMEPLUSRAND/2);
+    nrhs_work_size = nrhs;
+  }
+  return;
+}
+
+/* l = \hat Q_{\pm} k on interleaved fields of nrhs right hand  */
+/* sides, the site local parts act on them as on one field of    */
+/* nrhs*VOLUME/2 sites. b is a work field, l must differ from k. */
+static void Qtm_pm_nrhs_interleaved(spinor * const l, spinor * const k, spinor * const b,
+                                    const double _sign, const int nrhs) {
+  const int N = nrhs*(VOLUME/2);
+  Hopping_Matrix_nrhs(EO, b, k, nrhs);
+  mul_one_pm_imu_inv(b, _sign, N);
+  Hopping_Matrix_nrhs(OE, l, b, nrhs);
+  mul_one_pm_imu_sub_mul(l, k, l, _sign, N);
+  gamma5(l, l, N);
+}
+
+/******************************************
+ *
+ * Qtm_pm_psi and Qtm_minus_psi for the nrhs
+ * fields k[r], the results are stored in l[r]
+ *
+ * the fields are copied into one interleaved
+ * field, such that the hopping matrices are
+ * applied to all of them at once with
+ * Hopping_Matrix_nrhs. l may be equal to k.
+ *
+ ******************************************/
+void Qtm_pm_psi_nrhs(spinor ** const l, spinor ** const k, const int nrhs){
+  init_nrhs_work(nrhs);
+  spinor_fields_to_nrhs(nrhs_work[0], k, nrhs, VOLUME/2);
+  /* Q_{-} */
+  Qtm_pm_nrhs_interleaved(nrhs_work[2], nrhs_work[0], nrhs_work[1], -1., nrhs);
+  /* Q_{+} */
+  Qtm_pm_nrhs_interleaved(nrhs_work[0], nrhs_work[2], nrhs_work[1], +1., nrhs);
+  nrhs_to_spinor_fields(l, nrhs_work[0], nrhs, VOLUME/2);
+}
+
+void Qtm_minus_psi_nrhs(spinor ** const l, spinor ** const k, const int nrhs){
+  init_nrhs_work(nrhs);
+  spinor_fields_to_nrhs(nrhs_work[0], k, nrhs, VOLUME/2);
+  Qtm_pm_nrhs_interleaved(nrhs_work[2], nrhs_work[0], nrhs_work[1], -1., nrhs);
+  nrhs_to_spinor_fields(l, nrhs_work[2], nrhs, VOLUME/2);
+}
+
 /* the "full" operators */
 void Q_pm_psi(spinor * const l, spinor * const k)
 {
@@ -0,0 +1,171 @@
+/***********************************************************************
+ * Copyright (C) 2002,2003,2004,2005,2006,2007,2008 Carsten Urbach
+ *               2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * single precision versions of the twisted mass operators
+ * for even/odd preconditioning, used in the inner solver
+ * of mixed_cg_her
+ *
+ * the three temporary spinor32 fields are allocated at the
+ * first call and kept until free_tm_operators_32() is called
+ *
+ ***********************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <complex.h>
+#include "global.h"
+#include "su3.h"
+#include "Hopping_Matrix_32.h"
+#include "tm_operators_32.h"
+
+static spinor32 * tmp32_ = NULL;
+static spinor32 * tmp32[3];
+
+static int init_tm_operators_32() {
+  if((void*)(tmp32_ = (spinor32*)calloc(3*(VOLUMEPLUSRAND/2)+1, sizeof(spinor32))) == NULL) {
+    printf ("malloc errno in init_tm_operators_32: %d\n",errno); 
+    errno = 0;
+    return(1);
+  }
+#if ( defined SSE || defined SSE2 || defined SSE3)
+  tmp32[0] = (spinor32*)(((unsigned long int)(tmp32_)+ALIGN_BASE)&~ALIGN_BASE);
+#else
+  tmp32[0] = tmp32_;
+#endif
+  tmp32[1] = tmp32[0] + VOLUMEPLUSRAND/2;
+  tmp32[2] = tmp32[1] + VOLUMEPLUSRAND/2;
+  return(0);
+}
+
+void free_tm_operators_32() {
+  free(tmp32_);
+  tmp32_ = NULL;
+}
+
+/* l = Q_{+} Q_{-} k in single precision, see Qtm_pm_psi */
+void Qtm_pm_psi_32(spinor32 * const l, spinor32 * const k) {
+  if(tmp32_ == NULL) {
+    if(init_tm_operators_32() != 0) {
+      exit(-1);
+    }
+  }
+  /* Q_{-} */
+  Hopping_Matrix_32(EO, tmp32[1], k);
+  mul_one_pm_imu_inv_32(tmp32[1], -1., VOLUME/2);
+  Hopping_Matrix_32(OE, tmp32[2], tmp32[1]);
+  mul_one_pm_imu_sub_mul_gamma5_32(tmp32[0], k, tmp32[2], -1.);
+  /* Q_{+} */
+  Hopping_Matrix_32(EO, tmp32[1], tmp32[0]);
+  mul_one_pm_imu_inv_32(tmp32[1], +1., VOLUME/2);
+  Hopping_Matrix_32(OE, tmp32[2], tmp32[1]);
+  mul_one_pm_imu_sub_mul_gamma5_32(l, tmp32[0], tmp32[2], +1.);
+}
+
+void mul_one_pm_imu_inv_32(spinor32 * const l, const double _sign, const int N){
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _Complex float ALIGN z,w;
+  int ix;
+  double sign=-1.; 
+  spinor32 *r;
+
+  su3_vector32 ALIGN phi1;
+
+  double ALIGN nrm = 1./(1.+g_mu*g_mu);
+
+  if(_sign < 0.){
+    sign = 1.; 
+  }
+
+  z = nrm + (sign * nrm * g_mu) * I;
+  w = conjf(z);
+  /************ loop over all lattice sites ************/
+#ifdef OMP
+#pragma omp for
+#endif
+  for(ix = 0; ix < N; ix++){
+    r=l + ix;
+    /* Multiply the spinorfield with the inverse of 1+imu\gamma_5 */
+    _complex_times_vector(phi1, z, r->s0);
+    _vector_assign(r->s0, phi1);
+    _complex_times_vector(phi1, z, r->s1);
+    _vector_assign(r->s1, phi1);
+    _complex_times_vector(phi1, w, r->s2);
+    _vector_assign(r->s2, phi1);
+    _complex_times_vector(phi1, w, r->s3);
+    _vector_assign(r->s3, phi1);
+  }
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+}
+
+void mul_one_pm_imu_sub_mul_gamma5_32(spinor32 * const l, spinor32 * const k, 
+				      spinor32 * const j, const double _sign){
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+  _Complex float z,w;
+  int ix;
+  double sign=1.;
+  spinor32 *r, *s, *t;
+
+  su3_vector32 ALIGN phi1, phi2, phi3, phi4;
+
+  if(_sign < 0.){
+    sign = -1.;
+  }
+
+  z = 1. + (sign * g_mu) * I;
+  w = conjf(z);
+  
+  /************ loop over all lattice sites ************/
+#ifdef OMP
+#pragma omp for
+#endif
+  for(ix = 0; ix < (VOLUME/2); ix++){
+    r = k+ix;
+    s = j+ix;
+    t = l+ix;
+    /* Multiply the spinorfield with 1+imu\gamma_5 */
+    _complex_times_vector(phi1, z, r->s0);
+    _complex_times_vector(phi2, z, r->s1);
+    _complex_times_vector(phi3, w, r->s2);
+    _complex_times_vector(phi4, w, r->s3);
+    /* Subtract s and store the result in t */
+    /* multiply with  gamma5 included by    */
+    /* reversed order of s and phi3|4       */
+    _vector_sub32(t->s0, phi1, s->s0);
+    _vector_sub32(t->s1, phi2, s->s1);
+    _vector_sub32(t->s2, s->s2, phi3);
+    _vector_sub32(t->s3, s->s3, phi4);
+  }
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+}
@@ -0,0 +1,34 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _TM_OPERATORS_32_H
+#define _TM_OPERATORS_32_H
+
+#include "su3.h"
+
+/* single precision versions of the even/odd preconditioned */
+/* twisted mass operators in tm_operators.h                 */
+
+void Qtm_pm_psi_32(spinor32 * const l, spinor32 * const k);
+void mul_one_pm_imu_inv_32(spinor32 * const l, const double _sign, const int N);
+void mul_one_pm_imu_sub_mul_gamma5_32(spinor32 * const l, spinor32 * const k, 
+				      spinor32 * const j, const double _sign);
+void free_tm_operators_32();
+
+#endif
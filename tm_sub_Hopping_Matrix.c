@@ -50,7 +50,9 @@
 #include "boundary.h"
 #include "init_dirac_halfspinor.h"
 #include "update_backward_gauge.h"
+#include "Hopping_Matrix.h"
 #include "tm_sub_Hopping_Matrix.h"
+#include "profile.h"
 
 // now comes the definition of tm_times_Hopping_Matrix
 // which does (a + g5 i b - Hopping_Matrix)
@@ -63,6 +65,9 @@
 #  if ((defined SSE2)||(defined SSE3))
 #    include "sse.h"
 
+#  elif defined AVX2
+#    include "avx.h"
+
 #  elif (defined BGL && defined XLC)
 #    include "bgl.h"
 
@@ -75,6 +80,8 @@
 
 void tm_sub_Hopping_Matrix(const int ieo, spinor * const l, spinor * const p, spinor * const k, 
 			   complex double const cfactor) {
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
   
 #  ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
@@ -85,7 +92,7 @@ void tm_sub_Hopping_Matrix(const int ieo, spinor * const l, spinor * const p, sp
 #  ifdef OMP
 #  pragma omp parallel
   {
-    su3 * restrict u0 ALIGN;
+    su3_copy * restrict u0 ALIGN;
 #  endif
 
 #  define _TM_SUB_HOP
@@ -96,12 +103,15 @@ void tm_sub_Hopping_Matrix(const int ieo, spinor * const l, spinor * const p, sp
 #  elif (defined SSE2 || defined SSE3)
     _Complex double ALIGN cf = cfactor;
     su3_vector ALIGN psi, psi2;
+#  elif defined AVX2
+    _Complex double ALIGN cf = cfactor;
 #  endif
 #  include "operator/halfspinor_body.c"
 #  undef _TM_SUB_HOP    
 #  ifdef OMP
   } /* OpenMP closing brace */
 #  endif
+  _PROFILE_END(_HOPPING_FLOPS + 96.*(VOLUME/2), _HOPPING_BYTES(spinor, su3) + sizeof(spinor)*(VOLUME/2));
   return;
 }
 
@@ -127,6 +137,8 @@ void tm_sub_Hopping_Matrix(const int ieo, spinor * const l, spinor * p, spinor *
 #  ifdef XLC
 #    pragma disjoint(*l, *k)
 #  endif
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
 #  ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
     update_backward_gauge(g_gauge_field);
@@ -155,6 +167,7 @@ void tm_sub_Hopping_Matrix(const int ieo, spinor * const l, spinor * p, spinor *
 #  ifdef OMP
   } /* OpenMP closing brace */
 #  endif
+  _PROFILE_END(_HOPPING_FLOPS + 96.*(VOLUME/2), _HOPPING_BYTES(spinor, su3) + sizeof(spinor)*(VOLUME/2));
   return;
 }
 #endif
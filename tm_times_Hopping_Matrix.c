@@ -50,7 +50,9 @@
 #include "boundary.h"
 #include "init_dirac_halfspinor.h"
 #include "update_backward_gauge.h"
+#include "Hopping_Matrix.h"
 #include "tm_times_Hopping_Matrix.h"
+#include "profile.h"
 
 // now comes the definition of tm_times_Hopping_Matrix
 // which does (a + g5 i b) * Hopping_Matrix
@@ -63,6 +65,9 @@
 #  if ((defined SSE2)||(defined SSE3))
 #    include "sse.h"
 
+#  elif defined AVX2
+#    include "avx.h"
+
 #  elif (defined BGL && defined XLC)
 #    include "bgl.h"
 
@@ -74,6 +79,8 @@
 #  endif
 
 void tm_times_Hopping_Matrix(const int ieo, spinor * const l, spinor * const k, complex double const cfactor) {
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
   
 #  ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
@@ -84,14 +91,14 @@ void tm_times_Hopping_Matrix(const int ieo, spinor * const l, spinor * const k,
 #  ifdef OMP
 #  pragma omp parallel
   {
-    su3 * restrict u0 ALIGN;
+    su3_copy * restrict u0 ALIGN;
 #  endif
 
 #  define _MUL_G5_CMPLX
 #  if (defined BGQ && defined XLC)
     complex double ALIGN bla = cfactor;
     vector4double ALIGN cf = vec_ld2(0, (double*) &bla);
-#  elif (defined SSE2 || defined SSE3)
+#  elif (defined SSE2 || defined SSE3 || defined AVX2)
     _Complex double ALIGN cf = cfactor;
 #  endif
 #  include "operator/halfspinor_body.c"
@@ -99,6 +106,7 @@ void tm_times_Hopping_Matrix(const int ieo, spinor * const l, spinor * const k,
 #  ifdef OMP
   } /* OpenMP closing brace */
 #  endif
+  _PROFILE_END(_HOPPING_FLOPS + 72.*(VOLUME/2), _HOPPING_BYTES(spinor, su3));
   return;
 }
 
@@ -123,6 +131,8 @@ void tm_times_Hopping_Matrix(const int ieo, spinor * const l, spinor * const k,
 #  ifdef XLC
 #    pragma disjoint(*l, *k)
 #  endif
+  _PROFILE_BEGIN(__func__);
+  g_hopping_count++;
 #  ifdef _GAUGE_COPY
   if(g_update_gauge_copy) {
     update_backward_gauge(g_gauge_field);
@@ -149,6 +159,7 @@ void tm_times_Hopping_Matrix(const int ieo, spinor * const l, spinor * const k,
 #  ifdef OMP
   } /* OpenMP closing brace */
 #  endif
+  _PROFILE_END(_HOPPING_FLOPS + 72.*(VOLUME/2), _HOPPING_BYTES(spinor, su3));
   return;
 }
 #endif
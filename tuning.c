@@ -0,0 +1,437 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+/*******************************************************************************
+ *
+ * Autotuning of the runtime selectable variants of the Dirac operator.
+ *
+ * tune_operators (called by benchmark) goes through the variants one
+ * after the other, each time keeping the fastest one:
+ *
+ * 1. the number of OpenMP threads, 1, 2, 4, ... up to OmpNumThreads
+ * 2. the site order of the halfspinor operator, see site_order.c
+ * 3. overlapping the halfspinor exchange with computation (_OVERLAP_COMM)
+ * 4. the tiled operators (_TILED_OPERATORS)
+ *
+ * The measure is the time of Qtm_pm_psi, Qsw_pm_psi and the linalg
+ * kernels of one CG iteration. Hopping_Matrix is printed as well. The
+ * result is written to a small text file
+ *
+ *   LocalLattice = 8 8 8 8
+ *   OMPNumThreads = 4
+ *   SiteOrder = 2x4x4x4
+ *
+ * which hmc_tm and invert read with read_tuning_file. The single
+ * precision Hopping_Matrix_32 is only timed for comparison: using it
+ * (UseSloppyPrecision) changes the precision of the molecular dynamics
+ * and is not a decision for the tuner.
+ *
+ *******************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include<config.h>
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef MPI
+# include <mpi.h>
+#endif
+#ifdef OMP
+# include <omp.h>
+# include "init_omp_accumulators.h"
+#endif
+#include "global.h"
+#include "su3.h"
+#include "gettime.h"
+#include "read_input.h"
+#include "start.h"
+#include "Hopping_Matrix.h"
+#include "Hopping_Matrix_32.h"
+#include "tm_operators.h"
+#include "clover.h"
+#include "clover_leaf.h"
+#include "linalg_eo.h"
+#include "linalg/assign_to_32.h"
+#include "site_order.h"
+#include "init_dirac_halfspinor.h"
+#include "xchange_halffield.h"
+#include "tiled_operators.h"
+#include "tuning.h"
+
+/* minimal time for one measurement in seconds */
+#define _TUNE_MIN_TIME 0.2
+#define _TUNE_KERNELS 4
+/* there is a runtime setting to tune */
+#if (defined OMP || defined _USE_HALFSPINOR || (defined _TILED_OPERATORS && !defined MPI))
+# define _TUNE_SETTINGS
+#endif
+
+static const char * tune_kernel_name[_TUNE_KERNELS + 1] = {
+  "Hopping_Matrix", "Qtm_pm_psi", "Qsw_pm_psi", "linalg", "Hopping_Matrix_32"};
+
+#ifdef _TUNE_SETTINGS
+static spinor32 * tune_field32[2];
+
+static void tune_run(const int kernel) {
+  spinor ** const f = g_spinor_field;
+  switch(kernel) {
+  case 0:
+    Hopping_Matrix(EO, f[1], f[0]);
+    Hopping_Matrix(OE, f[2], f[1]);
+    break;
+  case 1:
+    Qtm_pm_psi(f[1], f[0]);
+    break;
+  case 2:
+    Qsw_pm_psi(f[1], f[0]);
+    break;
+  case 3:
+    /* the linear algebra of one CG iteration, the fields stay bounded */
+    square_norm(f[0], VOLUME/2, 1);
+    scalar_prod_r(f[0], f[1], VOLUME/2, 1);
+    assign_add_mul_r(f[2], f[0], 0.5, VOLUME/2);
+    assign_add_mul_r(f[2], f[1], -0.5, VOLUME/2);
+    assign_mul_add_r(f[2], 0.5, f[1], VOLUME/2);
+    break;
+  case 4:
+    Hopping_Matrix_32(EO, tune_field32[1], tune_field32[0]);
+    Hopping_Matrix_32(OE, tune_field32[0], tune_field32[1]);
+    break;
+  }
+  return;
+}
+
+/* time per call of kernel in seconds, the maximum over the processes */
+static double tune_time(const int kernel) {
+  double t1, dt, mdt;
+  int n = 1;
+  for(;;) {
+#ifdef MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    t1 = gettime();
+    for(int i = 0; i < n; i++) {
+      tune_run(kernel);
+    }
+    dt = gettime() - t1;
+#ifdef MPI
+    MPI_Allreduce(&dt, &mdt, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#else
+    mdt = dt;
+#endif
+    if(mdt > _TUNE_MIN_TIME || n >= (1 << 20)) break;
+    n *= 2;
+  }
+  return(mdt/n);
+}
+
+/* times all kernels and returns the cost of the current variant */
+static double tune_measure(const char * const label) {
+  double t[_TUNE_KERNELS];
+  for(int kernel = 0; kernel < _TUNE_KERNELS; kernel++) {
+    t[kernel] = tune_time(kernel);
+  }
+  if(g_proc_id == 0) {
+    printf("#   %-26s", label);
+    for(int kernel = 0; kernel < _TUNE_KERNELS; kernel++) {
+      printf(" %10.3f", 1.0e3*t[kernel]);
+    }
+    printf("\n");
+    fflush(stdout);
+  }
+  return(t[1] + t[2] + t[3]);
+}
+#endif
+
+#ifdef _USE_HALFSPINOR
+static void tune_site_order(const int type, const int * const tile) {
+  init_site_order(type, tile);
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+  init_nborder();
+#endif
+  return;
+}
+#endif
+
+int tune_operators(const char * const filename) {
+#ifdef _TUNE_SETTINGS
+  double cost, best;
+  char label[80];
+#endif
+#ifdef _USE_HALFSPINOR
+  char name[64];
+  spinor32 * field32_ = NULL;
+#endif
+  FILE * ofs;
+
+  /* the clover term for Qsw_pm_psi */
+  init_sw_fields();
+  sw_term((const su3**) g_gauge_field, g_kappa, g_c_sw);
+  sw_invert(EE, g_mu);
+  random_spinor_field(g_spinor_field[0], VOLUME/2, 0);
+  random_spinor_field(g_spinor_field[2], VOLUME/2, 0);
+
+  if(g_proc_id == 0) {
+    printf("# Tuning for the local lattice %d x %d x %d x %d, time per call in ms:\n", T, LX, LY, LZ);
+    printf("#   %-26s", "");
+    for(int kernel = 0; kernel < _TUNE_KERNELS; kernel++) {
+      printf(" %10.10s", tune_kernel_name[kernel]);
+    }
+    printf("\n");
+  }
+
+#ifdef OMP
+  {
+    const int nmax = omp_num_threads;
+    int n = 1, best_threads = 1;
+    best = 0.;
+    for(;;) {
+      omp_set_num_threads(n);
+      snprintf(label, sizeof(label), "OMPNumThreads = %d", n);
+      cost = tune_measure(label);
+      if(best == 0. || cost < best) {
+        best = cost;
+        best_threads = n;
+      }
+      if(n == nmax) break;
+      n = (2*n < nmax) ? 2*n : nmax;
+    }
+    /* the accumulators are large enough, there are fewer threads */
+    omp_num_threads = best_threads;
+    omp_set_num_threads(omp_num_threads);
+  }
+#endif
+
+#ifdef _USE_HALFSPINOR
+  {
+    const int bt[3] = {1, 2, 4}, bs[3] = {2, 4, 8};
+    int type, tile[4] = {0, 0, 0, 0}, best_type = SITE_ORDER_LEXIC, best_tile[4] = {0, 0, 0, 0};
+    best = 0.;
+    for(int c = -2; c < 9; c++) {
+      if(c == -2) {
+        type = SITE_ORDER_LEXIC;
+      }
+      else if(c == -1) {
+        type = SITE_ORDER_MORTON;
+      }
+      else {
+        type = SITE_ORDER_TILED;
+        tile[0] = bt[c/3];
+        tile[1] = tile[2] = tile[3] = bs[c%3];
+        if(tile[0] > T || tile[1] > LX || tile[2] > LY || tile[3] > LZ) continue;
+      }
+      tune_site_order(type, tile);
+      site_order_name(name, type, tile);
+      snprintf(label, sizeof(label), "SiteOrder = %s", name);
+      cost = tune_measure(label);
+      if(best == 0. || cost < best) {
+        best = cost;
+        best_type = type;
+        for(int mu = 0; mu < 4; mu++) best_tile[mu] = tile[mu];
+      }
+    }
+    g_site_order_type = best_type;
+    for(int mu = 0; mu < 4; mu++) g_site_tile[mu] = best_tile[mu];
+    tune_site_order(g_site_order_type, g_site_tile);
+  }
+#endif
+
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+  {
+    int best_overlap = 1;
+    best = 0.;
+    for(int v = 1; v >= 0; v--) {
+      g_overlap_comm = v;
+      snprintf(label, sizeof(label), "OverlapComm = %s", v ? "yes" : "no");
+      cost = tune_measure(label);
+      if(best == 0. || cost < best) {
+        best = cost;
+        best_overlap = v;
+      }
+    }
+    g_overlap_comm = best_overlap;
+  }
+#endif
+
+#if (defined _TILED_OPERATORS && !defined MPI)
+  {
+    int best_tiled = 1;
+    best = 0.;
+    for(int v = 1; v >= 0; v--) {
+      g_tiled_operators = v;
+      snprintf(label, sizeof(label), "TiledOperators = %s", v ? "yes" : "no");
+      cost = tune_measure(label);
+      if(best == 0. || cost < best) {
+        best = cost;
+        best_tiled = v;
+      }
+    }
+    g_tiled_operators = best_tiled;
+  }
+#endif
+
+#ifdef _USE_HALFSPINOR
+  /* single precision for comparison */
+  if(g_sloppy_precision_flag == 1) {
+    double t64, t32;
+    if((void*)(field32_ = (spinor32*)calloc(2*(VOLUMEPLUSRAND/2)+1, sizeof(spinor32))) == NULL) {
+      printf ("malloc error in tune_operators\n");
+      return(1);
+    }
+    tune_field32[0] = (spinor32*)(((unsigned long int)(field32_)+ALIGN_BASE)&~ALIGN_BASE);
+    tune_field32[1] = tune_field32[0] + VOLUMEPLUSRAND/2;
+    assign_to_32(tune_field32[0], g_spinor_field[0], VOLUME/2);
+    t64 = tune_time(0);
+    t32 = tune_time(4);
+    if(g_proc_id == 0) {
+      printf("# %s %.3f ms, %s %.3f ms\n", tune_kernel_name[0], 1.0e3*t64, tune_kernel_name[4], 1.0e3*t32);
+    }
+    free(field32_);
+  }
+#endif
+
+  if(g_proc_id == 0) {
+    if((ofs = fopen(filename, "w")) == NULL) {
+      fprintf(stderr, "Could not open tuning file %s for writing\n", filename);
+      return(1);
+    }
+    fprintf(ofs, "# written by benchmark, the settings override the input file of hmc_tm and invert\n");
+    fprintf(ofs, "LocalLattice = %d %d %d %d\n", T, LX, LY, LZ);
+#ifdef OMP
+    fprintf(ofs, "OMPNumThreads = %d\n", omp_num_threads);
+#endif
+#ifdef _USE_HALFSPINOR
+    site_order_name(name, g_site_order_type, g_site_tile);
+    fprintf(ofs, "SiteOrder = %s\n", name);
+#endif
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+    fprintf(ofs, "OverlapComm = %s\n", g_overlap_comm ? "yes" : "no");
+#endif
+#if (defined _TILED_OPERATORS && !defined MPI)
+    fprintf(ofs, "TiledOperators = %s\n", g_tiled_operators ? "yes" : "no");
+#endif
+    fclose(ofs);
+    printf("# The fastest settings were written to %s\n\n", filename);
+    fflush(stdout);
+  }
+  return(0);
+}
+
+int read_tuning_file(const char * const filename) {
+  FILE * ifs;
+  char line[256], value[64];
+  int lattice[4], tile[4], n;
+  int found_lattice = 0, status = 0;
+  int order = -1;
+#ifdef OMP
+  int threads = 0;
+#endif
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+  int overlap = -1;
+#endif
+#if (defined _TILED_OPERATORS && !defined MPI)
+  int tiled = -1;
+#endif
+
+  if((ifs = fopen(filename, "r")) == NULL) {
+    if(g_proc_id == 0 && g_debug_level > 1) {
+      printf("# No tuning file %s found\n", filename);
+    }
+    return(1);
+  }
+  while(fgets(line, sizeof(line), ifs) != NULL) {
+    if(line[0] == '#' || sscanf(line, "%63s", value) != 1) continue;
+    if(sscanf(line, "LocalLattice = %d %d %d %d", &lattice[0], &lattice[1], &lattice[2], &lattice[3]) == 4) {
+      found_lattice = 1;
+      if(lattice[0] != T || lattice[1] != LX || lattice[2] != LY || lattice[3] != LZ) {
+        status = 2;
+      }
+    }
+    else if(sscanf(line, "OMPNumThreads = %d", &n) == 1) {
+#ifdef OMP
+      threads = n;
+#endif
+    }
+    else if(sscanf(line, "SiteOrder = %63s", value) == 1) {
+      if(strcmp(value, "lexic") == 0) {
+        order = SITE_ORDER_LEXIC;
+      }
+      else if(strcmp(value, "morton") == 0) {
+        order = SITE_ORDER_MORTON;
+      }
+      else if(sscanf(value, "%dx%dx%dx%d", &tile[0], &tile[1], &tile[2], &tile[3]) == 4) {
+        order = SITE_ORDER_TILED;
+      }
+      else {
+        status = 2;
+      }
+    }
+    else if(sscanf(line, "OverlapComm = %63s", value) == 1) {
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+      overlap = (strcmp(value, "yes") == 0);
+#endif
+    }
+    else if(sscanf(line, "TiledOperators = %63s", value) == 1) {
+#if (defined _TILED_OPERATORS && !defined MPI)
+      tiled = (strcmp(value, "yes") == 0);
+#endif
+    }
+    else {
+      status = 2;
+    }
+  }
+  fclose(ifs);
+
+  if(status != 0 || !found_lattice) {
+    if(g_proc_id == 0) {
+      fprintf(stderr, "Ignoring the tuning file %s, it was written for another local lattice or cannot be parsed\n", filename);
+    }
+    return(2);
+  }
+
+#ifdef OMP
+  if(threads > 0 && threads != omp_num_threads) {
+    omp_num_threads = threads;
+    omp_set_num_threads(omp_num_threads);
+    free_omp_accumulators();
+    init_omp_accumulators(omp_num_threads);
+  }
+#endif
+  if(order > -1) {
+    g_site_order_type = order;
+    if(order == SITE_ORDER_TILED) {
+      for(int mu = 0; mu < 4; mu++) g_site_tile[mu] = tile[mu];
+    }
+  }
+#if (defined MPI && defined _USE_HALFSPINOR && defined _OVERLAP_COMM)
+  if(overlap > -1) g_overlap_comm = overlap;
+#endif
+#if (defined _TILED_OPERATORS && !defined MPI)
+  if(tiled > -1) g_tiled_operators = tiled;
+#endif
+
+  if(g_proc_id == 0) {
+    site_order_name(value, g_site_order_type, g_site_tile);
+    printf("# Using the tuning file %s, site order %s\n", filename, value);
+#ifdef OMP
+    printf("# Number of OpenMP threads set to %d by the tuning file\n", omp_num_threads);
+#endif
+  }
+  return(0);
+}
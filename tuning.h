@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of tmLQCD.
+ *
+ * tmLQCD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * tmLQCD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with tmLQCD.  If not, see <http://www.gnu.org/licenses/>.
+ ***********************************************************************/
+
+#ifndef _TUNING_H
+#define _TUNING_H
+
+/* Times Hopping_Matrix, Qtm_pm_psi, Qsw_pm_psi and the linalg       */
+/* kernels of a CG iteration for the runtime variants of this build  */
+/* (OpenMP threads, site order, overlap of the exchange, tiled       */
+/* operators), keeps the fastest and writes it to filename.          */
+/* Needs the geometry, the gauge field, the halfspinor fields and    */
+/* g_spinor_field[0..2] next to the DUM_MATRIX fields. Returns 0 on  */
+/* success.                                                          */
+int tune_operators(const char * const filename);
+
+/* Applies the settings of a file written by tune_operators, to be   */
+/* called after tmlqcd_mpi_init and before geometry. The settings    */
+/* override the input file. Returns 0 if the file was used, 1 if it  */
+/* does not exist and 2 if it was written for another local lattice  */
+/* or cannot be parsed.                                              */
+int read_tuning_file(const char * const filename);
+
+#endif
@@ -41,22 +41,22 @@ void update_backward_gauge(su3 ** const gf) {
   for(ix = 0; ix < VOLUME/2; ix++) {
     iy = (VOLUME+RAND)/2+ix;
     kb = g_idn[ g_eo2lexic[iy] ][0];
-    _su3_assign(g_gauge_field_copy[0][ix][0], gf[kb][0]);
+    _su3_copy_store(g_gauge_field_copy[0][ix][0], gf[kb][0]);
     kb = g_idn[ g_eo2lexic[iy] ][1];
-    _su3_assign(g_gauge_field_copy[0][ix][1], gf[kb][1]);
+    _su3_copy_store(g_gauge_field_copy[0][ix][1], gf[kb][1]);
     kb = g_idn[ g_eo2lexic[iy] ][2];
-    _su3_assign(g_gauge_field_copy[0][ix][2], gf[kb][2]);
+    _su3_copy_store(g_gauge_field_copy[0][ix][2], gf[kb][2]);
     kb = g_idn[ g_eo2lexic[iy] ][3];
-    _su3_assign(g_gauge_field_copy[0][ix][3], gf[kb][3]);
+    _su3_copy_store(g_gauge_field_copy[0][ix][3], gf[kb][3]);
 
     kb = g_idn[ g_eo2lexic[ix] ][0];
-    _su3_assign(g_gauge_field_copy[1][ix][0], gf[kb][0]);
+    _su3_copy_store(g_gauge_field_copy[1][ix][0], gf[kb][0]);
     kb = g_idn[ g_eo2lexic[ix] ][1];
-    _su3_assign(g_gauge_field_copy[1][ix][1], gf[kb][1]);
+    _su3_copy_store(g_gauge_field_copy[1][ix][1], gf[kb][1]);
     kb = g_idn[ g_eo2lexic[ix] ][2];
-    _su3_assign(g_gauge_field_copy[1][ix][2], gf[kb][2]);
+    _su3_copy_store(g_gauge_field_copy[1][ix][2], gf[kb][2]);
     kb = g_idn[ g_eo2lexic[ix] ][3];
-    _su3_assign(g_gauge_field_copy[1][ix][3], gf[kb][3]);
+    _su3_copy_store(g_gauge_field_copy[1][ix][3], gf[kb][3]);
   }
 
 #ifdef OMP
@@ -64,6 +64,7 @@ void update_backward_gauge(su3 ** const gf) {
 #endif
 
   g_update_gauge_copy = 0;
+  g_update_gauge_copy_32 = 1;
   return;
 }
 
@@ -125,6 +126,7 @@ void update_backward_gauge(su3 ** const gf) {
 #endif
 
   g_update_gauge_copy = 0;
+  g_update_gauge_copy_32 = 1;
   return;
 }
 
@@ -186,6 +188,85 @@ void update_backward_gauge(su3 ** const gf) {
 #endif
 
   g_update_gauge_copy = 0;
+  g_update_gauge_copy_32 = 1;
+  return;
+}
+
+#endif
+
+/* single precision copy of the gauge field, same layout */
+/* as g_gauge_field_copy                                 */
+
+#if defined _USE_HALFSPINOR
+void update_backward_gauge_32(su3 ** const gf) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+
+  int ix=0, kb=0, iy=0;
+
+#ifdef OMP
+#pragma omp for
+#endif 
+  for(ix = 0; ix < VOLUME/2; ix++) {
+    iy = (VOLUME+RAND)/2+ix;
+    for(int mu = 0; mu < 4; mu++) {
+      kb = g_idn[ g_eo2lexic[iy] ][mu];
+      _su3_copy_store(g_gauge_field_copy_32[0][ix][mu], gf[kb][mu]);
+    }
+    for(int mu = 0; mu < 4; mu++) {
+      kb = g_idn[ g_eo2lexic[ix] ][mu];
+      _su3_copy_store(g_gauge_field_copy_32[1][ix][mu], gf[kb][mu]);
+    }
+  }
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  g_update_gauge_copy_32 = 0;
+  return;
+}
+
+#elif !defined _USE_TSPLITPAR
+
+void update_backward_gauge_32(su3 ** const gf) {
+#ifdef OMP
+#pragma omp parallel
+  {
+#endif
+
+  int ix=0, kb=0, kb2=0;
+
+#ifdef OMP
+#pragma omp for
+#endif
+  for(ix = 0; ix < VOLUME/2; ix++) {
+    kb2=g_eo2lexic[ix];
+    for(int mu = 0; mu < 4; mu++) {
+      _su3_copy_store(g_gauge_field_copy_32[ix][2*mu],gf[kb2][mu]);
+      kb=g_idn[kb2][mu];
+      _su3_copy_store(g_gauge_field_copy_32[ix][2*mu+1],gf[kb][mu]);
+    }
+  }
+#ifdef OMP
+#pragma omp for
+#endif
+  for(ix = (VOLUME+RAND)/2; ix < (VOLUME+RAND)/2+VOLUME/2; ix++) {
+    kb2=g_eo2lexic[ix];
+    for(int mu = 0; mu < 4; mu++) {
+      _su3_copy_store(g_gauge_field_copy_32[ix][2*mu],gf[kb2][mu]);
+      kb=g_idn[kb2][mu];
+      _su3_copy_store(g_gauge_field_copy_32[ix][2*mu+1],gf[kb][mu]);
+    }
+  }
+
+#ifdef OMP
+  } /* OpenMP closing brace */
+#endif
+
+  g_update_gauge_copy_32 = 0;
   return;
 }
 
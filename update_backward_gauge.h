@@ -23,5 +23,6 @@
 #include "su3.h"
 
 void update_backward_gauge(su3 ** const gf);
+void update_backward_gauge_32(su3 ** const gf);
 
 #endif
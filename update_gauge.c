@@ -37,6 +37,7 @@
 #include "xchange.h"
 #include "hamiltonian_field.h"
 #include "update_gauge.h"
+#include "integrator_tuning.h"
 
 
 /*******************************************************
@@ -99,6 +100,7 @@ void update_gauge(const double step, hamiltonian_field_t * const hf) {
   g_update_gauge_energy = 1;
   hf->update_rectangle_energy = 1;
   g_update_rectangle_energy = 1;
+  integrator_tuning_gauge(step);
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(updategauge)
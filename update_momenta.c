@@ -37,6 +37,8 @@
 #include "hamiltonian_field.h"
 #include "update_momenta.h"
 #include "gettime.h"
+#include "monomial_cost.h"
+#include "integrator_tuning.h"
 
 /* Updates the momenta: equation 16 of Gottlieb */
 void update_momenta(int * mnllist, double step, const int no, 
@@ -53,13 +55,20 @@ void update_momenta(int * mnllist, double step, const int no,
 
   for(int k = 0; k < no; k++) {
     if(monomial_list[ mnllist[k] ].derivativefunction != NULL) {
+      if(g_monomial_force_flag) save_monomial_force(hf->derivative);
+      _MONOMIAL_COST_BEGIN;
+      _PROFILE_MONOMIAL_BEGIN(mnllist[k], "derivative");
       monomial_list[ mnllist[k] ].derivativefunction(mnllist[k], hf);
+      _PROFILE_MONOMIAL_END();
+      _MONOMIAL_COST_END(mnllist[k], deri_time);
+      if(g_monomial_force_flag) add_monomial_force(mnllist[k], hf->derivative);
     }
   }
 
 #ifdef MPI
   xchange_deri(hf->derivative);
 #endif
+  integrator_tuning_force(monomial_list[ mnllist[0] ].timescale, hf);
 
 #ifdef OMP
 #pragma omp parallel for
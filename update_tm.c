@@ -61,6 +61,10 @@
 #include "hamiltonian_field.h"
 #include "update_tm.h"
 #include "gettime.h"
+#include "profile.h"
+#include "monomial_cost.h"
+#include "integrator_tuning.h"
+#include "solver/chrono_guess.h"
 
 extern su3 ** g_gauge_field_saved;
 
@@ -105,6 +109,13 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
     }
     ini_g_tmp = 1;
   }
+#ifdef _PROFILE
+  profile_reset();
+#endif
+  reset_monomial_cost();
+  integrator_tuning_begin();
+  chrono_reset();
+  _PROFILE_BEGIN(__func__);
   atime = gettime();
 
   /*
@@ -129,7 +140,11 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
   /* heatbath for all monomials */
   for(i = 0; i < Integrator.no_timescales; i++) {
     for(j = 0; j < Integrator.no_mnls_per_ts[i]; j++) {
+      _MONOMIAL_COST_BEGIN;
+      _PROFILE_MONOMIAL_BEGIN(Integrator.mnls_per_ts[i][j], "heatbath");
       monomial_list[ Integrator.mnls_per_ts[i][j] ].hbfunction(Integrator.mnls_per_ts[i][j], &hf);
+      _PROFILE_MONOMIAL_END();
+      _MONOMIAL_COST_END(Integrator.mnls_per_ts[i][j], hb_time);
     }
   }
 
@@ -148,7 +163,11 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
   dh = 0.;
   for(i = 0; i < Integrator.no_timescales; i++) {
     for(j = 0; j < Integrator.no_mnls_per_ts[i]; j++) {
+      _MONOMIAL_COST_BEGIN;
+      _PROFILE_MONOMIAL_BEGIN(Integrator.mnls_per_ts[i][j], "acc");
       dh += monomial_list[ Integrator.mnls_per_ts[i][j] ].accfunction(Integrator.mnls_per_ts[i][j], &hf);
+      _PROFILE_MONOMIAL_END();
+      _MONOMIAL_COST_END(Integrator.mnls_per_ts[i][j], acc_time);
     }
   }
 
@@ -212,6 +231,8 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
       free(xlfInfo);
     }
     g_sloppy_precision = 1;
+    /* the chronological guess must not know the forward trajectory */
+    chrono_reset();
     /* run the trajectory back */
     Integrator.integrate[Integrator.no_timescales-1](-Integrator.tau, 
                          Integrator.no_timescales-1, 1);
@@ -222,7 +243,11 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
     ret_dh = 0.;
     for(i = 0; i < Integrator.no_timescales; i++) {
       for(j = 0; j < Integrator.no_mnls_per_ts[i]; j++) {
+        _MONOMIAL_COST_BEGIN;
+        _PROFILE_MONOMIAL_BEGIN(Integrator.mnls_per_ts[i][j], "acc");
         ret_dh += monomial_list[ Integrator.mnls_per_ts[i][j] ].accfunction(Integrator.mnls_per_ts[i][j], &hf);
+        _PROFILE_MONOMIAL_END();
+        _MONOMIAL_COST_END(Integrator.mnls_per_ts[i][j], acc_time);
       }
     }
 
@@ -377,6 +402,12 @@ int update_tm(double *plaquette_energy, double *rectangle_energy,
     fflush(datafile);
     fclose(datafile);
   }
+  integrator_tuning_end(dh);
+  chrono_print_stats();
+  _PROFILE_END(0., 0.);
+#ifdef _PROFILE
+  profile_print("trajectory");
+#endif
   return(accept);
 }
 
@@ -43,6 +43,7 @@
 #include "mpi_init.h"
 #include "su3.h"
 #include "xchange_2fields.h"
+#include "profile.h"
 
 #if (defined _NON_BLOCKING)
 
@@ -58,6 +59,7 @@
 /* this if statement will be removed in future and _INDEX_INDEP_GEOM will be the default */
 
 void xchange_2fields(spinor * const l, spinor * const k, const int ieo) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
   MPI_Request requests[32];
@@ -205,6 +207,7 @@ void xchange_2fields(spinor * const l, spinor * const k, const int ieo) {
 
   MPI_Waitall(reqcount, requests, status);
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange2fields)
@@ -214,6 +217,7 @@ void xchange_2fields(spinor * const l, spinor * const k, const int ieo) {
 # else /*  _INDEX_INDEP_GEOM */
 
 void xchange_2fields(spinor * const l, spinor * const k, const int ieo) {
+  _PROFILE_BEGIN(__func__);
 
   MPI_Request requests[32];
   MPI_Status status[32];
@@ -393,6 +397,7 @@ void xchange_2fields(spinor * const l, spinor * const k, const int ieo) {
 
   MPI_Waitall(reqcount, requests, status);
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange2fields)
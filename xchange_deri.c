@@ -37,6 +37,7 @@
 #include "su3.h"
 #include "su3adj.h"
 #include "xchange_deri.h"
+#include "profile.h"
 
 inline void addup_ddummy(su3adj** const df, const int ix, const int iy) {
   for(int mu = 0; mu < 4; mu++) {
@@ -57,6 +58,7 @@ inline void addup_ddummy(su3adj** const df, const int ix, const int iy) {
 
 void xchange_deri(su3adj ** const df)
 {
+  _PROFILE_BEGIN(__func__);
 #  ifdef MPI
   int ix,mu, t, y, z, x;
   MPI_Status status;
@@ -175,6 +177,7 @@ void xchange_deri(su3adj ** const df)
   /* send the data to the neighbour on the right is not needed*/  
 #    endif /* (defined PARALLELXYZT || defined PARALLELXYZ ) */
 #  endif /* MPI */
+  _PROFILE_END(0., 4*RAND*sizeof(su3adj));
   return;
 }
 
@@ -182,6 +185,7 @@ void xchange_deri(su3adj ** const df)
 
 void xchange_deri(su3adj ** const df)
 {
+  _PROFILE_BEGIN(__func__);
 #  ifdef MPI
   int ix,iy, t, y, z, x;
   MPI_Status status;
@@ -608,6 +612,7 @@ void xchange_deri(su3adj ** const df)
 
 #    endif /* PARALLELXYZT */
 #  endif /* MPI */
+  _PROFILE_END(0., 4*RAND*sizeof(su3adj));
   return;
 }
 
@@ -46,19 +46,113 @@
 #include "mpi_init.h"
 #include "su3.h"
 #include "xchange_field.h"
+#include "profile.h"
+#ifdef _SHM_HALO
+#  include "shm_halo.h"
+#endif
 
 #if (defined XLC && defined PARALLELXYZT)
 #pragma disjoint(*field_buffer_z2, *field_buffer_z)
 #endif
 
+/* this version reads the faces of the neighbours on the same node     */
+/* directly from their copy of the field if it is in shared memory,    */
+/* only the faces of the neighbours on other nodes are sent. The       */
+/* messages are packed in the order of the receiving RAND sites.       */
+#if (defined _SHM_HALO && defined MPI)
+
+static spinor * shm_sendbuf[8], * shm_recvbuf[8];
+
+void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
+  MPI_Request requests[16];
+  MPI_Status status[16];
+  spinor * nb[8];
+  int reqcount = 0;
+  /* ieo = 1 is an even field */
+  const int p = (ieo == 1) ? 0 : 1;
+  const int shared = shm_is_shared(l);
+
+  if(shm_sendbuf[0] == NULL) {
+    if(init_shm_field_lists() != 0) {
+      fprintf(stderr, "xchange_field: could not set up the exchange lists\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    for(int dir = 0; dir < 8; dir++) {
+      const int n = g_shm_field_n[0][dir] > g_shm_field_n[1][dir] ? g_shm_field_n[0][dir] : g_shm_field_n[1][dir];
+      shm_sendbuf[dir] = (spinor*)malloc((n+1)*sizeof(spinor));
+      shm_recvbuf[dir] = (spinor*)malloc((n+1)*sizeof(spinor));
+    }
+  }
+
+  for(int dir = 0; dir < 8; dir++) {
+    const int n = g_shm_field_n[p][dir];
+    nb[dir] = NULL;
+    if(n == 0) continue;
+    /* receive the RAND in direction dir from the neighbour there */
+    nb[dir] = (spinor*)shm_nb_ptr(l, dir);
+    if(nb[dir] == NULL) {
+      spinor * r = g_shm_field_cont[p][dir] ? l + g_shm_field_dst[p][dir][0] : shm_recvbuf[dir];
+      MPI_Irecv((void*)r, 24*n, MPI_DOUBLE, g_nb_list[dir], 600+dir, g_cart_grid, &requests[reqcount++]);
+    }
+    /* the neighbour in the opposite direction needs our sites for its */
+    /* RAND in direction dir, unless it reads them itself              */
+    if(shm_nb_ptr(l, dir^1) == NULL) {
+      const int * src = g_shm_field_src[p][dir];
+      spinor * const buf = shm_sendbuf[dir];
+#ifdef OMP
+#pragma omp parallel for
+#endif
+      for(int i = 0; i < n; i++) {
+	buf[i] = l[src[i]];
+      }
+      MPI_Isend((void*)buf, 24*n, MPI_DOUBLE, g_nb_list[dir^1], 600+dir, g_cart_grid, &requests[reqcount++]);
+    }
+  }
+
+  if(shared) {
+    /* all processes on the node have finished writing l */
+    shm_sync(l);
+    for(int dir = 0; dir < 8; dir++) {
+      if(nb[dir] != NULL) {
+	const int n = g_shm_field_n[p][dir];
+	const int * dst = g_shm_field_dst[p][dir], * src = g_shm_field_src[p][dir];
+	spinor * const r = nb[dir];
+#ifdef OMP
+#pragma omp parallel for
+#endif
+	for(int i = 0; i < n; i++) {
+	  l[dst[i]] = r[src[i]];
+	}
+      }
+    }
+    /* nobody changes l before the neighbours have read it */
+    shm_sync(l);
+  }
+
+  MPI_Waitall(reqcount, requests, status);
+
+  for(int dir = 0; dir < 8; dir++) {
+    if(g_shm_field_n[p][dir] > 0 && nb[dir] == NULL && !g_shm_field_cont[p][dir]) {
+      const int * dst = g_shm_field_dst[p][dir];
+      for(int i = 0; i < g_shm_field_n[p][dir]; i++) {
+	l[dst[i]] = shm_recvbuf[dir][i];
+      }
+    }
+  }
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
+  return;
+}
+
 /* this version uses non-blocking MPI calls */
-#if (defined _NON_BLOCKING)
+#elif (defined _NON_BLOCKING)
 
 /* this is the version independent of the content of the function Index  */
 /* this if statement will be removed in future and _INDEX_INDEP_GEOM will be the default */
 # ifdef  _INDEX_INDEP_GEOM
 
 void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
   MPI_Request requests[16];
@@ -257,6 +351,7 @@ void xchange_field(spinor * const l, const int ieo) {
 
 
 #  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangefield)
@@ -267,6 +362,7 @@ void xchange_field(spinor * const l, const int ieo) {
 # else /* _INDEX_INDEP_GEOM */
 
 void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
   MPI_Request requests[16];
@@ -459,6 +555,7 @@ void xchange_field(spinor * const l, const int ieo) {
 #  endif
 
 
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangefield)
@@ -472,6 +569,7 @@ void xchange_field(spinor * const l, const int ieo) {
 /* Here comes the version with shared memory */
 /* exchanges the field  l */
 void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
 
 #  ifdef MPI
   int i,ix, mu, x0, x1, x2, x3, k;
@@ -564,6 +662,7 @@ void xchange_field(spinor * const l, const int ieo) {
 
   shmem_barrier_all();
 #  endif // MPI
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangefield)
@@ -581,6 +680,7 @@ void xchange_field(spinor * const l, const int ieo) {
 
 /* exchanges the field  l */
 void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
   
 #  ifdef PARALLELXYZT
   int x0=0, x1=0, x2=0, ix=0;
@@ -664,6 +764,7 @@ void xchange_field(spinor * const l, const int ieo) {
 
 #    endif
 #  endif // MPI
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangefield)
@@ -675,6 +776,7 @@ void xchange_field(spinor * const l, const int ieo) {
 
 /* exchanges the field  l */
 void xchange_field(spinor * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
   
 #  ifdef PARALLELXYZT
   int x0=0, x1=0, x2=0, ix=0;
@@ -770,6 +872,7 @@ void xchange_field(spinor * const l, const int ieo) {
     
 #    endif
 #  endif // MPI
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangefield)
@@ -793,3 +896,103 @@ void xchange_field(spinor * const l, const int ieo) {
 
 
 
+
+
+/* single precision version, blocking MPI calls only              */
+/* used by the non-halfspinor version of Hopping_Matrix_32        */
+void xchange_field_32(spinor32 * const l, const int ieo) {
+  _PROFILE_BEGIN(__func__);
+
+#  ifdef MPI
+#    if (defined PARALLELXYZT || defined PARALLELXYZ )
+#      ifdef _INDEX_INDEP_GEOM
+  MPI_Datatype z_slice_dn = (ieo == 1) ? field_z_slice_even_dn32 : field_z_slice_odd_dn32;
+  MPI_Datatype z_slice_up = (ieo == 1) ? field_z_slice_even_up32 : field_z_slice_odd_up32;
+#      else
+  int ix=0;
+  int * z_ipt = (ieo == 1) ? g_field_z_ipt_even : g_field_z_ipt_odd;
+  /* field_buffer_z holds T*LX*LY/2 double spinors, large enough */
+  spinor32 * buffer_z = (spinor32*) field_buffer_z;
+#      endif
+#    endif
+  MPI_Status status;
+
+#    ifdef _INDEX_INDEP_GEOM
+
+#      if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  MPI_Sendrecv((void*)(l+g_1st_t_int_dn), 1, field_time_slice_cont32, g_nb_t_dn, 81,
+	       (void*)(l+g_1st_t_ext_up), 1, field_time_slice_cont32, g_nb_t_up, 81,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+g_1st_t_int_up), 1, field_time_slice_cont32, g_nb_t_up, 82,
+	       (void*)(l+g_1st_t_ext_dn), 1, field_time_slice_cont32, g_nb_t_dn, 82,
+	       g_cart_grid, &status);
+#      endif
+#      if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  MPI_Sendrecv((void*)(l+g_1st_x_int_dn), 1, field_x_slice_gath32, g_nb_x_dn, 91, 
+	       (void*)(l+g_1st_x_ext_up), 1, field_x_slice_cont32, g_nb_x_up, 91,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+g_1st_x_int_up), 1, field_x_slice_gath32, g_nb_x_up, 92, 
+	       (void*)(l+g_1st_x_ext_dn), 1, field_x_slice_cont32, g_nb_x_dn, 92,
+	       g_cart_grid, &status);
+#      endif
+#      if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+  MPI_Sendrecv((void*)(l+g_1st_y_int_dn), 1, field_y_slice_gath32, g_nb_y_dn, 101, 
+	       (void*)(l+g_1st_y_ext_up), 1, field_y_slice_cont32, g_nb_y_up, 101,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+g_1st_y_int_up), 1, field_y_slice_gath32, g_nb_y_up, 102, 
+	       (void*)(l+g_1st_y_ext_dn), 1, field_y_slice_cont32, g_nb_y_dn, 102,
+	       g_cart_grid, &status);
+#      endif
+#      if (defined PARALLELXYZT || defined PARALLELXYZ )
+  MPI_Sendrecv((void*)(l+g_1st_z_int_dn), 1, z_slice_dn, g_nb_z_dn, 503,  
+	       (void*)(l+g_1st_z_ext_up), 1, field_z_slice_cont32, g_nb_z_up, 503, 
+	       g_cart_grid, &status); 
+  MPI_Sendrecv((void*)(l+g_1st_z_int_up), 1, z_slice_up, g_nb_z_up, 504, 
+	       (void*)(l+g_1st_z_ext_dn), 1, field_z_slice_cont32, g_nb_z_dn, 504, 
+	       g_cart_grid, &status); 
+#      endif
+
+#    else /* _INDEX_INDEP_GEOM */
+
+  MPI_Sendrecv((void*)l,                1, field_time_slice_cont32, g_nb_t_dn, 81,
+	       (void*)(l+T*LX*LY*LZ/2), 1, field_time_slice_cont32, g_nb_t_up, 81,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+(T-1)*LX*LY*LZ/2), 1, field_time_slice_cont32, g_nb_t_up, 82,
+	       (void*)(l+(T+1)*LX*LY*LZ/2), 1, field_time_slice_cont32, g_nb_t_dn, 82,
+	       g_cart_grid, &status);
+#      if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT)
+  MPI_Sendrecv((void*)l,                    1, field_x_slice_gath32, g_nb_x_dn, 91, 
+	       (void*)(l+(T+2)*LX*LY*LZ/2), 1, field_x_slice_cont32, g_nb_x_up, 91,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+(LX-1)*LY*LZ/2),               1, field_x_slice_gath32, g_nb_x_up, 92, 
+	       (void*)(l+((T+2)*LX*LY*LZ + T*LY*LZ)/2), 1, field_x_slice_cont32, g_nb_x_dn, 92,
+	       g_cart_grid, &status);
+#      endif
+#      if (defined PARALLELXYT || defined PARALLELXYZT)
+  MPI_Sendrecv((void*)l,                                  1, field_y_slice_gath32, g_nb_y_dn, 101, 
+	       (void*)(l+((T+2)*LX*LY*LZ + 2*T*LY*LZ)/2), 1, field_y_slice_cont32, g_nb_y_up, 101,
+	       g_cart_grid, &status);
+  MPI_Sendrecv((void*)(l+(LY-1)*LZ/2),                              1, field_y_slice_gath32, g_nb_y_up, 102, 
+	       (void*)(l+((T+2)*LX*LY*LZ + 2*T*LY*LZ + T*LX*LZ)/2), 1, field_y_slice_cont32, g_nb_y_dn, 102,
+	       g_cart_grid, &status);
+#      endif
+#      if (defined PARALLELXYZT)
+  for(ix = 0; ix < T*LX*LY/2; ix++) {
+    buffer_z[ix] = l[ z_ipt[ix] ]; 
+  }
+  MPI_Sendrecv((void*)buffer_z, 1, field_z_slice_cont32, g_nb_z_dn, 503,  
+	       (void*)(l+(VOLUME/2 + LX*LY*LZ + T*LY*LZ +T*LX*LZ)), 1, field_z_slice_cont32, g_nb_z_up, 503, 
+	       g_cart_grid, &status); 
+  for(ix = T*LX*LY/2; ix < T*LX*LY; ix++) {
+    buffer_z[ix-T*LX*LY/2] = l[ z_ipt[ix] ]; 
+  }
+  MPI_Sendrecv((void*)buffer_z, 1, field_z_slice_cont32, g_nb_z_up, 504, 
+	       (void*)(l+(VOLUME + 2*LX*LY*LZ + 2*T*LY*LZ + 2*T*LX*LZ + T*LX*LY)/2), 1, field_z_slice_cont32, g_nb_z_dn, 504, 
+	       g_cart_grid, &status); 
+#      endif
+
+#    endif /* _INDEX_INDEP_GEOM */
+#  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(spinor32));
+  return;
+}
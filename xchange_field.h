@@ -32,5 +32,6 @@
 #define  ODD 0 
 
 void xchange_field(spinor * const l, const int ieo);  
+void xchange_field_32(spinor32 * const l, const int ieo);
 
 #endif
@@ -37,6 +37,7 @@
 #include "su3.h"
 #include "su3adj.h"
 #include "xchange_gauge.h"
+#include "profile.h"
 
 #if defined _NON_BLOCKING
 
@@ -44,6 +45,7 @@
 # if defined _INDEX_INDEP_GEOM
 
 void xchange_gauge(su3 ** const gf) {
+  _PROFILE_BEGIN(__func__);
   int cntr=0;
 #  ifdef MPI
   MPI_Request request[105];
@@ -598,6 +600,7 @@ void xchange_gauge(su3 ** const gf) {
 #    endif
 
 #  endif /* MPI */
+  _PROFILE_END(0., 4*RAND*sizeof(su3));
   return;
 }
 
@@ -605,6 +608,7 @@ void xchange_gauge(su3 ** const gf) {
 # else /* _INDEX_INDEP_GEOM */
 
 void xchange_gauge(su3 ** const gf) {
+  _PROFILE_BEGIN(__func__);
   int cntr=0;
 #  ifdef MPI
   MPI_Request request[105];
@@ -1184,6 +1188,7 @@ void xchange_gauge(su3 ** const gf) {
   /* end of if defined PARALLELXYZT */
 #    endif
 #  endif
+  _PROFILE_END(0., 4*RAND*sizeof(su3));
   return;
 }
 
@@ -1194,6 +1199,7 @@ void xchange_gauge(su3 ** const gf) {
 # if defined _INDEX_INDEP_GEOM
 
 void xchange_gauge(su3 ** const gf) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
 
@@ -1615,11 +1621,13 @@ void xchange_gauge(su3 ** const gf) {
   }
 
 #endif  /* MPI */
+  _PROFILE_END(0., 4*RAND*sizeof(su3));
   return;
 }
 
 # else /* _INDEX_INDEP_GEOM */
 void xchange_gauge(su3 ** const gf) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
 
@@ -2084,6 +2092,7 @@ void xchange_gauge(su3 ** const gf) {
   /* end of if defined PARALLELXYZT */
 #  endif
 #endif
+  _PROFILE_END(0., 4*RAND*sizeof(su3));
   return;
 }
 
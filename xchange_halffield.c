@@ -43,10 +43,116 @@
 #include "su3.h"
 #include "init_dirac_halfspinor.h"
 #include "xchange_halffield.h"
+#include "profile.h"
+#include "gettime.h"
+#ifdef _SHM_HALO
+#  include "shm_halo.h"
+#endif
 
 #if (defined _USE_HALFSPINOR)
 
-#if (defined _PERSISTENT)
+#if (defined _SHM_HALO && defined MPI)
+
+/* the faces in direction mu start at shift[mu] in the buffers and */
+/* consist of two halves of n[mu] halfspinors, the first one goes  */
+/* to the neighbour in positive direction                          */
+static void halffield_faces(int shift[4], int n[4]) {
+#  ifdef _INDEX_INDEP_GEOM
+  shift[0] = g_HS_shift_t; shift[1] = g_HS_shift_x;
+  shift[2] = g_HS_shift_y; shift[3] = g_HS_shift_z;
+#  else
+  shift[0] = 0; shift[1] = LX*LY*LZ;
+  shift[2] = LX*LY*LZ + T*LY*LZ; shift[3] = LX*LY*LZ + T*LY*LZ + T*LX*LZ;
+#  endif
+  n[0] = n[1] = n[2] = n[3] = 0;
+#  if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  n[0] = LX*LY*LZ/2;
+#  endif
+#  if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  n[1] = T*LY*LZ/2;
+#  endif
+#  if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+  n[2] = T*LX*LZ/2;
+#  endif
+#  if (defined PARALLELXYZT || defined PARALLELXYZ )
+  n[3] = T*LX*LY/2;
+#  endif
+}
+
+/* posts the messages for the faces of neighbours on other nodes, */
+/* returns the number of requests                                 */
+static int halffield_post_offnode(MPI_Request * const requests) {
+  static const int tag_up[4] = {81, 91, 101, 503}, tag_dn[4] = {82, 92, 102, 504};
+  int shift[4], n[4], reqcount = 0;
+  halffield_faces(shift, n);
+
+  for(int mu = 0; mu < 4; mu++) {
+    if(n[mu] == 0) continue;
+    /* the first half comes from and goes to the neighbour in negative */
+    /* direction, except if it is read directly                        */
+    if(shm_nb_ptr(sendBuffer, 2*mu+1) == NULL) {
+      MPI_Irecv((void*)(recvBuffer + shift[mu] + n[mu]), 12*n[mu], MPI_DOUBLE, 
+		g_nb_list[2*mu+1], tag_up[mu], g_cart_grid, &requests[reqcount++]);
+    }
+    if(shm_nb_ptr(sendBuffer, 2*mu) == NULL) {
+      MPI_Irecv((void*)(recvBuffer + shift[mu]), 12*n[mu], MPI_DOUBLE, 
+		g_nb_list[2*mu], tag_dn[mu], g_cart_grid, &requests[reqcount++]);
+      MPI_Isend((void*)(sendBuffer + shift[mu]), 12*n[mu], MPI_DOUBLE, 
+		g_nb_list[2*mu], tag_up[mu], g_cart_grid, &requests[reqcount++]);
+    }
+    if(shm_nb_ptr(sendBuffer, 2*mu+1) == NULL) {
+      MPI_Isend((void*)(sendBuffer + shift[mu] + n[mu]), 12*n[mu], MPI_DOUBLE, 
+		g_nb_list[2*mu+1], tag_dn[mu], g_cart_grid, &requests[reqcount++]);
+    }
+  }
+  return(reqcount);
+}
+
+/* copies the faces of the neighbours on the same node from their */
+/* send buffer into recvBuffer                                    */
+static void halffield_copy_onnode() {
+  int shift[4], n[4];
+  halfspinor * nb;
+  if(!shm_is_shared(sendBuffer)) return;
+  halffield_faces(shift, n);
+
+  shm_sync(sendBuffer);
+  for(int mu = 0; mu < 4; mu++) {
+    if(n[mu] == 0) continue;
+    if((nb = (halfspinor*)shm_nb_ptr(sendBuffer, 2*mu+1)) != NULL) {
+      memcpy(recvBuffer + shift[mu] + n[mu], nb + shift[mu], n[mu]*sizeof(halfspinor));
+    }
+    if((nb = (halfspinor*)shm_nb_ptr(sendBuffer, 2*mu)) != NULL) {
+      memcpy(recvBuffer + shift[mu], nb + shift[mu] + n[mu], n[mu]*sizeof(halfspinor));
+    }
+  }
+  /* the send buffers are only refilled after all reads */
+  shm_sync(sendBuffer);
+  return;
+}
+
+/* shared memory on the node, messages between nodes */
+void xchange_halffield() {
+  _PROFILE_BEGIN(__func__);
+  MPI_Request requests[16];
+  MPI_Status status[16];
+  int reqcount;
+#ifdef _KOJAK_INST
+#pragma pomp inst begin(xchangehalf)
+#endif
+
+  reqcount = halffield_post_offnode(requests);
+  halffield_copy_onnode();
+  MPI_Waitall(reqcount, requests, status); 
+
+#ifdef _KOJAK_INST
+#pragma pomp inst end(xchangehalf)
+#endif
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor));
+  return;
+}
+
+#elif (defined _PERSISTENT)
 
 MPI_Request prequests[16];
 
@@ -145,6 +251,7 @@ void init_xchange_halffield() {
 
 /* 3. */
 void xchange_halffield() {
+  _PROFILE_BEGIN(__func__);
 #  ifdef MPI
 
   MPI_Status status[16];
@@ -165,6 +272,7 @@ void xchange_halffield() {
 
   MPI_Waitall(reqcount, prequests, status); 
 #  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor));
   return;
 }
 
@@ -174,6 +282,7 @@ void xchange_halffield() {
 
 /* 4. -IIG */
 void xchange_halffield() {
+  _PROFILE_BEGIN(__func__);
 
 #  ifdef MPI
 
@@ -255,6 +364,7 @@ void xchange_halffield() {
 
   MPI_Waitall(reqcount, requests, status); 
 #  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor));
   return;
 
 #ifdef _KOJAK_INST
@@ -266,6 +376,7 @@ void xchange_halffield() {
 
 /* 4. */
 void xchange_halffield() {
+  _PROFILE_BEGIN(__func__);
 
 #  ifdef MPI
 
@@ -352,6 +463,7 @@ void xchange_halffield() {
   
   MPI_Waitall(reqcount, requests, status); 
 #  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor));
   return;
   
 #ifdef _KOJAK_INST
@@ -363,12 +475,290 @@ void xchange_halffield() {
 
 #endif /* def (_USE_SHMEM || _PERSISTENT) */ 
 
+#if (defined _OVERLAP_COMM)
+
+/* 5. */
+/* split version of xchange_halffield for overlapping the     */
+/* exchange with the interior part of Hopping_Matrix          */
+/* xchange_halffield_start posts all sends and receives,      */
+/* xchange_halffield_wait completes them. The time between    */
+/* the two calls and the time spent blocking in the wait are  */
+/* accumulated for print_xchange_halffield_stats              */
+
+static double hs_start_time = 0., hs_overlap_time = 0., hs_wait_time = 0.;
+static unsigned long int hs_calls = 0;
+
+static int hs_done = 1;
+
+/* 0 switches the overlap off at runtime, Hopping_Matrix then */
+/* uses xchange_halffield                                      */
+int g_overlap_comm = 1;
+
+#  if (defined MPI && !defined _PERSISTENT)
+static MPI_Request hs_requests[16];
+static int hs_reqcount = 0;
+#  endif
+
+void xchange_halffield_start() {
+  _PROFILE_BEGIN(__func__);
+#  ifdef MPI
+#    ifdef _PERSISTENT
+#      ifdef PARALLELT
+  int reqcount = 4;
+#      elif defined PARALLELXT
+  int reqcount = 8;
+#      elif defined PARALLELXYT
+  int reqcount = 12;
+#      elif defined PARALLELXYZT
+  int reqcount = 16;
+#      endif
+  hs_start_time = gettime();
+  hs_done = 0;
+  MPI_Startall(reqcount, prequests);
+#    elif (defined _SHM_HALO)
+  hs_start_time = gettime();
+  hs_done = 0;
+  hs_reqcount = halffield_post_offnode(hs_requests);
+  halffield_copy_onnode();
+#    else
+#      ifdef _INDEX_INDEP_GEOM
+  const int shift_t = g_HS_shift_t, shift_x = g_HS_shift_x;
+  const int shift_y = g_HS_shift_y, shift_z = g_HS_shift_z;
+#      else
+  const int shift_t = 0, shift_x = LX*LY*LZ;
+  const int shift_y = LX*LY*LZ + T*LY*LZ, shift_z = LX*LY*LZ + T*LY*LZ + T*LX*LZ;
+#      endif
+  hs_reqcount = 0;
+  hs_start_time = gettime();
+  hs_done = 0;
+
+#      if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  /* t direction, receives are posted first */
+  MPI_Irecv((void*)(recvBuffer + shift_t + LX*LY*LZ/2), LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_dn, 81, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Irecv((void*)(recvBuffer + shift_t), LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_up, 82, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_t), LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_up, 81, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_t + LX*LY*LZ/2), LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_dn, 82, g_cart_grid, &hs_requests[hs_reqcount++]);
+#      endif
+#      if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  /* x direction */
+  MPI_Irecv((void*)(recvBuffer + shift_x + T*LY*LZ/2), T*LY*LZ*12/2, MPI_DOUBLE,
+	    g_nb_x_dn, 91, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Irecv((void*)(recvBuffer + shift_x), T*LY*LZ*12/2, MPI_DOUBLE,
+ 	    g_nb_x_up, 92, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_x), T*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_x_up, 91, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_x + T*LY*LZ/2), T*LY*LZ*12/2, MPI_DOUBLE,
+ 	    g_nb_x_dn, 92, g_cart_grid, &hs_requests[hs_reqcount++]);
+#      endif
+#      if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+  /* y direction */
+  MPI_Irecv((void*)(recvBuffer + shift_y + T*LX*LZ/2), T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_dn, 101, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Irecv((void*)(recvBuffer + shift_y), T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_up, 102, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_y), T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_up, 101, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_y + T*LX*LZ/2), T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_dn, 102, g_cart_grid, &hs_requests[hs_reqcount++]);
+#      endif
+#      if (defined PARALLELXYZT || defined PARALLELXYZ )
+  /* z direction */
+  MPI_Irecv((void*)(recvBuffer + shift_z + T*LX*LY/2), T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_dn, 503, g_cart_grid, &hs_requests[hs_reqcount++]); 
+  MPI_Irecv((void*)(recvBuffer + shift_z), T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_up, 504, g_cart_grid, &hs_requests[hs_reqcount++]); 
+  MPI_Isend((void*)(sendBuffer + shift_z), T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_up, 503, g_cart_grid, &hs_requests[hs_reqcount++]);
+  MPI_Isend((void*)(sendBuffer + shift_z + T*LX*LY/2), T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_dn, 504, g_cart_grid, &hs_requests[hs_reqcount++]);
+#      endif
+#    endif /* _PERSISTENT */
+#  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor));
+  return;
+}
+
+/* returns 1 if the exchange started last is complete, otherwise */
+/* it only makes progress. Called by the communication thread     */
+int xchange_halffield_test() {
+#  ifdef MPI
+  int flag = 0;
+  MPI_Status status[16];
+  if(hs_done) return(1);
+#    ifdef _PERSISTENT
+#      ifdef PARALLELT
+  int reqcount = 4;
+#      elif defined PARALLELXT
+  int reqcount = 8;
+#      elif defined PARALLELXYT
+  int reqcount = 12;
+#      elif defined PARALLELXYZT
+  int reqcount = 16;
+#      endif
+  MPI_Testall(reqcount, prequests, &flag, status);
+#    else
+  MPI_Testall(hs_reqcount, hs_requests, &flag, status);
+#    endif
+  if(flag) {
+    hs_overlap_time += gettime() - hs_start_time;
+    hs_calls++;
+    hs_done = 1;
+  }
+  return(flag);
+#  else
+  return(1);
+#  endif /* MPI */
+}
+
+void xchange_halffield_wait() {
+#  ifdef MPI
+  MPI_Status status[16];
+  double atime;
+  if(hs_done) return;
+  _PROFILE_BEGIN(__func__);
+  atime = gettime();
+#    ifdef _PERSISTENT
+#      ifdef PARALLELT
+  int reqcount = 4;
+#      elif defined PARALLELXT
+  int reqcount = 8;
+#      elif defined PARALLELXYT
+  int reqcount = 12;
+#      elif defined PARALLELXYZT
+  int reqcount = 16;
+#      endif
+  MPI_Waitall(reqcount, prequests, status);
+#    else
+  MPI_Waitall(hs_reqcount, hs_requests, status);
+#    endif
+  hs_overlap_time += atime - hs_start_time;
+  hs_wait_time += gettime() - atime;
+  hs_calls++;
+  hs_done = 1;
+  _PROFILE_END(0., 0.);
+#  endif /* MPI */
+  return;
+}
+
+/* prints the accumulated timings of the split exchange of this  */
+/* process. If the wait blocks, the exchange took overlap + wait  */
+/* and the hidden fraction is overlap/(overlap + wait)            */
+void print_xchange_halffield_stats() {
+  if(hs_calls > 0) {
+    printf("# halfspinor exchange: %lu calls, %e s overlapped with interior sites, %e s exposed waiting\n",
+	   hs_calls, hs_overlap_time, hs_wait_time);
+    printf("# halfspinor exchange: per call %e s overlapped, %e s exposed, %.1f%% of the exchange hidden\n",
+	   hs_overlap_time/hs_calls, hs_wait_time/hs_calls,
+	   100.*hs_overlap_time/(hs_overlap_time + hs_wait_time));
+  }
+  return;
+}
+
+#endif /* _OVERLAP_COMM */
+
 
 # if defined _INDEX_INDEP_GEOM
-// IIG xchange_halffield32 still Missing
+
+/* 32-1. -IIG */
+void xchange_halffield32() {
+  _PROFILE_BEGIN(__func__);
+
+#  ifdef MPI
+
+  MPI_Request requests[16];
+  MPI_Status status[16];
+#  if ((defined PARALLELT) || (defined PARALLELX))
+  int reqcount = 4;
+#  elif ((defined PARALLELXT) || (defined PARALLELXY))
+  int reqcount = 8;
+#  elif ((defined PARALLELXYT) || (defined PARALLELXYZ))
+  int reqcount = 12;
+#  elif defined PARALLELXYZT
+  int reqcount = 16;
+#  endif
+#  if (defined XLC && defined BGL)
+  __alignx(16, HalfSpinor32);
+#  endif
+
+#ifdef _KOJAK_INST
+#pragma pomp inst begin(xchangehalf32)
+#endif
+
+#    if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  /* send the data to the neighbour on the right in t direction */
+  /* recieve the data from the neighbour on the left in t direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_t), LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_up, 81, g_cart_grid, &requests[0]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_t + LX*LY*LZ/2), LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_dn, 81, g_cart_grid, &requests[1]);
+  /* send the data to the neighbour on the left in t direction */
+  /* recieve the data from the neighbour on the right in t direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_t + LX*LY*LZ/2), LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_dn, 82, g_cart_grid, &requests[2]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_t), LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_up, 82, g_cart_grid, &requests[3]);
+#    endif
+#    if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in x direction */
+  /* recieve the data from the neighbour on the left in x direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_x), T*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_x_up, 91, g_cart_grid, &requests[4]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_x + T*LY*LZ/2), T*LY*LZ*12/2, MPI_FLOAT,
+	    g_nb_x_dn, 91, g_cart_grid, &requests[5]);
+  /* send the data to the neighbour on the left in x direction */
+  /* recieve the data from the neighbour on the right in x direction */  
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_x + T*LY*LZ/2), T*LY*LZ*12/2, MPI_FLOAT,
+ 	    g_nb_x_dn, 92, g_cart_grid, &requests[6]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_x), T*LY*LZ*12/2, MPI_FLOAT,
+ 	    g_nb_x_up, 92, g_cart_grid, &requests[7]);
+#    endif
+#    if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+    /* send the data to the neighbour on the right in y direction */
+    /* recieve the data from the neighbour on the left in y direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_y), T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_up, 101, g_cart_grid, &requests[8]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_y + T*LX*LZ/2), T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_dn, 101, g_cart_grid, &requests[9]);
+    /* send the data to the neighbour on the leftt in y direction */
+    /* recieve the data from the neighbour on the right in y direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_y + T*LX*LZ/2), T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_dn, 102, g_cart_grid, &requests[10]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_y), T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_up, 102, g_cart_grid, &requests[11]);
+#    endif
+#    if (defined PARALLELXYZT || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in z direction */
+  /* recieve the data from the neighbour on the left in z direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_z), T*LX*LY*12/2, MPI_FLOAT, 
+		g_nb_z_up, 503, g_cart_grid, &requests[12]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_z + T*LX*LY/2), T*LX*LY*12/2, MPI_FLOAT, 
+		g_nb_z_dn, 503, g_cart_grid, &requests[13]); 
+  /* send the data to the neighbour on the left in z direction */
+  /* recieve the data from the neighbour on the right in z direction */
+  MPI_Isend((void*)(sendBuffer32 + g_HS_shift_z + T*LX*LY/2), 12*T*LX*LY/2, MPI_FLOAT, 
+		g_nb_z_dn, 504, g_cart_grid, &requests[14]);
+  MPI_Irecv((void*)(recvBuffer32 + g_HS_shift_z), T*LX*LY*12/2, MPI_FLOAT, 
+		g_nb_z_up, 504, g_cart_grid, &requests[15]); 
+#    endif
+
+  MPI_Waitall(reqcount, requests, status); 
+#  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor32));
+  return;
+
+#ifdef _KOJAK_INST
+#pragma pomp inst end(xchangehalf32)
+#endif
+}
+
 # else // defined _INDEX_INDEP_GEOM
 /* 32-2. */
 void xchange_halffield32() {
+  _PROFILE_BEGIN(__func__);
 
 #  ifdef MPI
 
@@ -455,12 +845,178 @@ void xchange_halffield32() {
 
   MPI_Waitall(reqcount, requests, status); 
 #  endif /* MPI */
+  _PROFILE_END(0., (RAND/2)*sizeof(halfspinor32));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchangehalf32)
 #endif
 }
 # endif /* defined _INDEX_INDEP_GEOM */
+
+
+/* nrhs-1. */
+/* exchanges the halfspinor buffers of Hopping_Matrix_nrhs      */
+/* nrhs halfspinors per boundary site are stored consecutively, */
+/* so every message is simply nrhs times longer                 */
+void xchange_halffield_nrhs(const int nrhs) {
+  _PROFILE_BEGIN(__func__);
+
+#  ifdef MPI
+
+  MPI_Request requests[16];
+  MPI_Status status[16];
+  int reqcount = 0;
+#    ifdef _INDEX_INDEP_GEOM
+  const int shift_t = g_HS_shift_t, shift_x = g_HS_shift_x;
+  const int shift_y = g_HS_shift_y, shift_z = g_HS_shift_z;
+#    else
+  const int shift_t = 0, shift_x = LX*LY*LZ;
+  const int shift_y = LX*LY*LZ + T*LY*LZ, shift_z = LX*LY*LZ + T*LY*LZ + T*LX*LZ;
+#    endif
+
+#    if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  /* send the data to the neighbour on the right in t direction */
+  /* recieve the data from the neighbour on the left in t direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + shift_t*nrhs), nrhs*LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_up, 81, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + (shift_t + LX*LY*LZ/2)*nrhs), nrhs*LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_dn, 81, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the left in t direction */
+  /* recieve the data from the neighbour on the right in t direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + (shift_t + LX*LY*LZ/2)*nrhs), nrhs*LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_dn, 82, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + shift_t*nrhs), nrhs*LX*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_t_up, 82, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in x direction */
+  /* recieve the data from the neighbour on the left in x direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + shift_x*nrhs), nrhs*T*LY*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_x_up, 91, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + (shift_x + T*LY*LZ/2)*nrhs), nrhs*T*LY*LZ*12/2, MPI_DOUBLE,
+	    g_nb_x_dn, 91, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the left in x direction */
+  /* recieve the data from the neighbour on the right in x direction */  
+  MPI_Isend((void*)(sendBuffer_nrhs + (shift_x + T*LY*LZ/2)*nrhs), nrhs*T*LY*LZ*12/2, MPI_DOUBLE,
+ 	    g_nb_x_dn, 92, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + shift_x*nrhs), nrhs*T*LY*LZ*12/2, MPI_DOUBLE,
+ 	    g_nb_x_up, 92, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in y direction */
+  /* recieve the data from the neighbour on the left in y direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + shift_y*nrhs), nrhs*T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_up, 101, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + (shift_y + T*LX*LZ/2)*nrhs), nrhs*T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_dn, 101, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the leftt in y direction */
+  /* recieve the data from the neighbour on the right in y direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + (shift_y + T*LX*LZ/2)*nrhs), nrhs*T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_dn, 102, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + shift_y*nrhs), nrhs*T*LX*LZ*12/2, MPI_DOUBLE, 
+	    g_nb_y_up, 102, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXYZT || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in z direction */
+  /* recieve the data from the neighbour on the left in z direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + shift_z*nrhs), nrhs*T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_up, 503, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + (shift_z + T*LX*LY/2)*nrhs), nrhs*T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_dn, 503, g_cart_grid, &requests[reqcount++]); 
+  /* send the data to the neighbour on the left in z direction */
+  /* recieve the data from the neighbour on the right in z direction */
+  MPI_Isend((void*)(sendBuffer_nrhs + (shift_z + T*LX*LY/2)*nrhs), nrhs*T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_dn, 504, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer_nrhs + shift_z*nrhs), nrhs*T*LX*LY*12/2, MPI_DOUBLE, 
+	    g_nb_z_up, 504, g_cart_grid, &requests[reqcount++]); 
+#    endif
+
+  MPI_Waitall(reqcount, requests, status); 
+#  endif /* MPI */
+  _PROFILE_END(0., nrhs*(RAND/2)*sizeof(halfspinor));
+  return;
+}
+
+/* nrhs-2. */
+/* 32 bit version of xchange_halffield_nrhs */
+void xchange_halffield32_nrhs(const int nrhs) {
+  _PROFILE_BEGIN(__func__);
+
+#  ifdef MPI
+
+  MPI_Request requests[16];
+  MPI_Status status[16];
+  int reqcount = 0;
+#    ifdef _INDEX_INDEP_GEOM
+  const int shift_t = g_HS_shift_t, shift_x = g_HS_shift_x;
+  const int shift_y = g_HS_shift_y, shift_z = g_HS_shift_z;
+#    else
+  const int shift_t = 0, shift_x = LX*LY*LZ;
+  const int shift_y = LX*LY*LZ + T*LY*LZ, shift_z = LX*LY*LZ + T*LY*LZ + T*LX*LZ;
+#    endif
+
+#    if (defined PARALLELT || defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT )
+  /* send the data to the neighbour on the right in t direction */
+  /* recieve the data from the neighbour on the left in t direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + shift_t*nrhs), nrhs*LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_up, 81, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + (shift_t + LX*LY*LZ/2)*nrhs), nrhs*LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_dn, 81, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the left in t direction */
+  /* recieve the data from the neighbour on the right in t direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + (shift_t + LX*LY*LZ/2)*nrhs), nrhs*LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_dn, 82, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + shift_t*nrhs), nrhs*LX*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_t_up, 82, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXT || defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELX || defined PARALLELXY || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in x direction */
+  /* recieve the data from the neighbour on the left in x direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + shift_x*nrhs), nrhs*T*LY*LZ*12/2, MPI_FLOAT, 
+	    g_nb_x_up, 91, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + (shift_x + T*LY*LZ/2)*nrhs), nrhs*T*LY*LZ*12/2, MPI_FLOAT,
+	    g_nb_x_dn, 91, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the left in x direction */
+  /* recieve the data from the neighbour on the right in x direction */  
+  MPI_Isend((void*)(sendBuffer32_nrhs + (shift_x + T*LY*LZ/2)*nrhs), nrhs*T*LY*LZ*12/2, MPI_FLOAT,
+ 	    g_nb_x_dn, 92, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + shift_x*nrhs), nrhs*T*LY*LZ*12/2, MPI_FLOAT,
+ 	    g_nb_x_up, 92, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXYT || defined PARALLELXYZT || defined PARALLELXY || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in y direction */
+  /* recieve the data from the neighbour on the left in y direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + shift_y*nrhs), nrhs*T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_up, 101, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + (shift_y + T*LX*LZ/2)*nrhs), nrhs*T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_dn, 101, g_cart_grid, &requests[reqcount++]);
+  /* send the data to the neighbour on the leftt in y direction */
+  /* recieve the data from the neighbour on the right in y direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + (shift_y + T*LX*LZ/2)*nrhs), nrhs*T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_dn, 102, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + shift_y*nrhs), nrhs*T*LX*LZ*12/2, MPI_FLOAT, 
+	    g_nb_y_up, 102, g_cart_grid, &requests[reqcount++]);
+#    endif
+#    if (defined PARALLELXYZT || defined PARALLELXYZ )
+  /* send the data to the neighbour on the right in z direction */
+  /* recieve the data from the neighbour on the left in z direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + shift_z*nrhs), nrhs*T*LX*LY*12/2, MPI_FLOAT, 
+	    g_nb_z_up, 503, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + (shift_z + T*LX*LY/2)*nrhs), nrhs*T*LX*LY*12/2, MPI_FLOAT, 
+	    g_nb_z_dn, 503, g_cart_grid, &requests[reqcount++]); 
+  /* send the data to the neighbour on the left in z direction */
+  /* recieve the data from the neighbour on the right in z direction */
+  MPI_Isend((void*)(sendBuffer32_nrhs + (shift_z + T*LX*LY/2)*nrhs), nrhs*T*LX*LY*12/2, MPI_FLOAT, 
+	    g_nb_z_dn, 504, g_cart_grid, &requests[reqcount++]);
+  MPI_Irecv((void*)(recvBuffer32_nrhs + shift_z*nrhs), nrhs*T*LX*LY*12/2, MPI_FLOAT, 
+	    g_nb_z_up, 504, g_cart_grid, &requests[reqcount++]); 
+#    endif
+
+  MPI_Waitall(reqcount, requests, status); 
+#  endif /* MPI */
+  _PROFILE_END(0., nrhs*(RAND/2)*sizeof(halfspinor32));
+  return;
+}
 #endif /* defined _USE_HALFSPINOR */
 
 
@@ -22,4 +22,12 @@
 void init_xchange_halffield();
 void xchange_halffield();
 void xchange_halffield32();
+void xchange_halffield_nrhs(const int nrhs);
+void xchange_halffield32_nrhs(const int nrhs);
+void xchange_halffield_start();
+void xchange_halffield_wait();
+int xchange_halffield_test();
+void print_xchange_halffield_stats();
+/* with _OVERLAP_COMM: 1 if Hopping_Matrix overlaps the exchange */
+extern int g_overlap_comm;
 #endif
@@ -44,6 +44,7 @@
 #include "mpi_init.h"
 #include "su3.h"
 #include "xchange_lexicfield.h"
+#include "profile.h"
 
 /* this version uses non-blocking MPI calls */
 #if (defined _NON_BLOCKING)
@@ -53,6 +54,7 @@
 # if defined _INDEX_INDEP_GEOM
 
 void xchange_lexicfield(spinor * const l) {
+  _PROFILE_BEGIN(__func__);
 
 #ifdef MPI
   MPI_Request requests[16];
@@ -151,6 +153,7 @@ void xchange_lexicfield(spinor * const l) {
   MPI_Waitall(reqcount, requests, status);
 
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange_lexicfield)
@@ -159,6 +162,7 @@ void xchange_lexicfield(spinor * const l) {
 # else /* _INDEX_INDEP_GEOM */
 
 void xchange_lexicfield(spinor * const l) {
+  _PROFILE_BEGIN(__func__);
 
   MPI_Request requests[16];
   MPI_Status status[16];
@@ -237,6 +241,7 @@ void xchange_lexicfield(spinor * const l) {
   MPI_Waitall(reqcount, requests, status);
 
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange_lexicfield)
@@ -255,6 +260,7 @@ void xchange_lexicfield(spinor * const l) {
 
 /* exchanges the field  l */
 void xchange_lexicfield(spinor * const l) {
+  _PROFILE_BEGIN(__func__);
   
 #  ifdef PARALLELXYZT
   int x0=0, x1=0, x2=0, ix=0;
@@ -324,6 +330,7 @@ void xchange_lexicfield(spinor * const l) {
     
 #    endif
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange_lexicfield)
@@ -334,6 +341,7 @@ void xchange_lexicfield(spinor * const l) {
 
 /* exchanges the field  l */
 void xchange_lexicfield(spinor * const l) {
+  _PROFILE_BEGIN(__func__);
   
 #  ifdef PARALLELXYZT
   int x0=0, x1=0, x2=0, ix=0;
@@ -406,6 +414,7 @@ void xchange_lexicfield(spinor * const l) {
     
 #    endif
 #  endif
+  _PROFILE_END(0., RAND*sizeof(spinor));
   return;
 #ifdef _KOJAK_INST
 #pragma pomp inst end(xchange_lexicfield)